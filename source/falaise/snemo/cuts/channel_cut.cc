@@ -77,7 +77,9 @@ namespace snemo {
         DT_THROW_IF(! configuration_.has_key(a_name + ".measurement_label"), std::logic_error,
                     "Missing associated measurement label to '" << a_name << "' cut!");
         const std::string a_meas_label = configuration_.fetch_string(a_name + ".measurement_label");
-        _cuts_.push_back(std::make_pair(a_meas_label, a_cut_handle));
+        // Resolve the label once, measurements are then looked up by key
+        const snemo::datamodel::measurement_key a_meas_key(a_meas_label);
+        _cuts_.push_back(std::make_pair(a_meas_key, a_cut_handle));
         DT_LOG_DEBUG(get_logging_priority(),
                      "Adding cut '" << a_name << " for measurement '" << a_meas_label << "'");
       }
@@ -86,6 +88,21 @@ namespace snemo {
       return;
     }
 
+    // static
+    void channel_cut::extract_measurement_labels(const datatools::properties & configuration_,
+                                                 std::set<std::string> & labels_)
+    {
+      if (! configuration_.has_key("cuts")) return;
+      std::vector<std::string> cuts;
+      configuration_.fetch("cuts", cuts);
+      for (size_t i = 0; i < cuts.size(); i++) {
+        const std::string a_key = cuts.at(i) + ".measurement_label";
+        if (! configuration_.has_key(a_key)) continue;
+        labels_.insert(configuration_.fetch_string(a_key));
+      }
+      return;
+    }
+
     int channel_cut::_accept()
     {
       // Get event record
@@ -105,7 +122,7 @@ namespace snemo {
       // Loop over cuts
       for (cut_collection_type::iterator icut = _cuts_.begin();
            icut != _cuts_.end(); ++icut) {
-        const std::string & a_meas_label = icut->first;
+        const snemo::datamodel::measurement_key & a_meas_label = icut->first;
         if (! a_pattern.has_measurement(a_meas_label)) {
           DT_LOG_DEBUG(get_logging_priority(), "Missing '" << a_meas_label << "' measurement !");
           return cuts::SELECTION_INAPPLICABLE;
@@ -31,10 +31,17 @@
 #ifndef FALAISE_SNEMO_CUT_CHANNEL_CUT_H
 #define FALAISE_SNEMO_CUT_CHANNEL_CUT_H 1
 
+// Standard library:
+#include <set>
+#include <string>
+
 // Third party:
 // - Bayeux/cuts
 #include <bayeux/cuts/i_cut.h>
 
+// This project:
+#include <falaise/snemo/datamodels/topology_keys.h>
+
 namespace snemo {
 
   namespace cut {
@@ -45,7 +52,7 @@ namespace snemo {
     public:
 
       /// Alias type associating measurement with cut
-      typedef std::pair<std::string, cuts::cut_handle_type> pair_type;
+      typedef std::pair<snemo::datamodel::measurement_key, cuts::cut_handle_type> pair_type;
 
       /// Alias to collection of meas./cut association
       typedef std::vector<pair_type> cut_collection_type;
@@ -64,6 +71,10 @@ namespace snemo {
       /// Reset
       virtual void reset();
 
+      /// Collect the measurement labels consumed by a channel cut configuration
+      static void extract_measurement_labels(const datatools::properties & configuration_,
+                                             std::set<std::string> & labels_);
+
     protected :
 
       /// Default values
@@ -0,0 +1,226 @@
+// falaise/snemo/cuts/cut_graph.cc
+
+// Ourselves:
+#include <falaise/snemo/cuts/cut_graph.h>
+
+// Standard library:
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+// - Bayeux/cuts:
+#include <cuts/cut_manager.h>
+
+namespace snemo {
+
+  namespace cut {
+
+    const int cut_graph::NOT_EVALUATED;
+
+    cut_graph::cut_graph()
+    {
+      _cut_manager_ = 0;
+      return;
+    }
+
+    cut_graph::~cut_graph()
+    {
+      return;
+    }
+
+    void cut_graph::set_cut_manager(cuts::cut_manager & cut_manager_)
+    {
+      DT_THROW_IF(! _nodes_.empty(), std::logic_error, "Graph has already some nodes !");
+      _cut_manager_ = &cut_manager_;
+      return;
+    }
+
+    bool cut_graph::has_cut_manager() const
+    {
+      return _cut_manager_ != 0;
+    }
+
+    size_t cut_graph::add_cut(const std::string & cut_name_)
+    {
+      DT_THROW_IF(! has_cut_manager(), std::logic_error, "No cut manager is setup !");
+      std::set<std::string> visiting;
+      const size_t a_node = _add_node(cut_name_, visiting);
+      _results_.assign(_nodes_.size(), NOT_EVALUATED);
+      return a_node;
+    }
+
+    bool cut_graph::has_cut(const std::string & cut_name_) const
+    {
+      return _names_.count(cut_name_) != 0;
+    }
+
+    size_t cut_graph::get_node_index(const std::string & cut_name_) const
+    {
+      std::map<std::string, size_t>::const_iterator found = _names_.find(cut_name_);
+      DT_THROW_IF(found == _names_.end(), std::logic_error,
+                  "Cut '" << cut_name_ << "' is not part of the graph !");
+      return found->second;
+    }
+
+    size_t cut_graph::get_number_of_nodes() const
+    {
+      return _nodes_.size();
+    }
+
+    const cut_graph::node_type & cut_graph::get_node(const size_t node_) const
+    {
+      DT_THROW_IF(node_ >= _nodes_.size(), std::range_error,
+                  "Invalid node index (" << node_ << ") !");
+      return _nodes_[node_];
+    }
+
+    void cut_graph::reset_results()
+    {
+      std::fill(_results_.begin(), _results_.end(), NOT_EVALUATED);
+      return;
+    }
+
+    void cut_graph::clear()
+    {
+      _nodes_.clear();
+      _names_.clear();
+      _signatures_.clear();
+      _results_.clear();
+      return;
+    }
+
+    void cut_graph::fetch_required_leaves(const size_t node_, std::vector<size_t> & leaves_) const
+    {
+      std::set<size_t> required;
+      _fetch_required_leaves(node_, cuts::SELECTION_ACCEPTED, required);
+      leaves_.insert(leaves_.end(), required.begin(), required.end());
+      return;
+    }
+
+    void cut_graph::_fetch_required_leaves(const size_t node_, const int status_,
+                                           std::set<size_t> & leaves_) const
+    {
+      const node_type & a_node = get_node(node_);
+      const bool accepted = (status_ == cuts::SELECTION_ACCEPTED);
+      switch (a_node.kind) {
+      case NODE_LEAF:
+        if (accepted) leaves_.insert(node_);
+        break;
+      case NODE_NOT:
+        _fetch_required_leaves(a_node.children.front(),
+                               accepted ? cuts::SELECTION_REJECTED : cuts::SELECTION_ACCEPTED,
+                               leaves_);
+        break;
+      case NODE_AND:
+      case NODE_OR:
+        {
+          // Every child must give the status (AND accepting, OR rejecting)
+          // or only one of them is known to give it (AND rejecting, OR accepting)
+          const bool all_children = (accepted == (a_node.kind == NODE_AND));
+          std::set<size_t> common;
+          for (size_t i = 0; i < a_node.children.size(); ++i) {
+            std::set<size_t> child_leaves;
+            _fetch_required_leaves(a_node.children[i], status_, child_leaves);
+            if (all_children) {
+              leaves_.insert(child_leaves.begin(), child_leaves.end());
+            } else if (i == 0) {
+              common.swap(child_leaves);
+            } else {
+              std::set<size_t> both;
+              std::set_intersection(common.begin(), common.end(),
+                                    child_leaves.begin(), child_leaves.end(),
+                                    std::inserter(both, both.begin()));
+              common.swap(both);
+            }
+          }
+          leaves_.insert(common.begin(), common.end());
+        }
+        break;
+      }
+      return;
+    }
+
+    size_t cut_graph::_add_node(const std::string & cut_name_, std::set<std::string> & visiting_)
+    {
+      std::map<std::string, size_t>::const_iterator found = _names_.find(cut_name_);
+      if (found != _names_.end()) return found->second;
+      DT_THROW_IF(visiting_.count(cut_name_), std::logic_error,
+                  "Cut '" << cut_name_ << "' depends on itself !");
+      cuts::cut_handle_dict_type::const_iterator ientry = _cut_manager_->get_cuts().find(cut_name_);
+      DT_THROW_IF(ientry == _cut_manager_->get_cuts().end(), std::logic_error,
+                  "Cut '" << cut_name_ << "' is missing !");
+
+      node_type a_node;
+      a_node.cut_name = cut_name_;
+      a_node.cut_id = ientry->second.get_cut_id();
+      a_node.config = &ientry->second.get_cut_config();
+      a_node.cut = 0;
+      std::vector<std::string> children;
+      if (a_node.cut_id == "cuts::multi_and_cut" || a_node.cut_id == "cuts::multi_or_cut") {
+        a_node.kind = (a_node.cut_id == "cuts::multi_and_cut") ? NODE_AND : NODE_OR;
+        DT_THROW_IF(! a_node.config->has_key("cuts"), std::logic_error,
+                    "Missing 'cuts' list for cut '" << cut_name_ << "' !");
+        a_node.config->fetch("cuts", children);
+      } else if (a_node.cut_id == "cuts::not_cut") {
+        a_node.kind = NODE_NOT;
+        DT_THROW_IF(! a_node.config->has_key("cut"), std::logic_error,
+                    "Missing 'cut' name for cut '" << cut_name_ << "' !");
+        children.push_back(a_node.config->fetch_string("cut"));
+      } else {
+        a_node.kind = NODE_LEAF;
+        a_node.cut = &_cut_manager_->grab(cut_name_);
+      }
+
+      // Build a signature to merge the cuts doing the same thing under different names
+      std::ostringstream signature;
+      if (a_node.kind == NODE_LEAF && a_node.cut_id == "cuts::random_cut") {
+        // Random cuts with the same configuration still draw their own numbers
+        signature << "name=" << cut_name_;
+      } else if (a_node.kind == NODE_LEAF) {
+        std::map<std::string, std::string> a_dict;
+        a_node.config->export_to_string_based_dictionary(a_dict, true);
+        signature << a_node.cut_id;
+        for (std::map<std::string, std::string>::const_iterator i = a_dict.begin();
+             i != a_dict.end(); ++i) {
+          // Description and logging do not change the selection
+          if (i->first == "cut.description" || i->first.find("logging.") == 0) continue;
+          signature << ';' << i->first << '=' << i->second;
+        }
+      } else {
+        visiting_.insert(cut_name_);
+        signature << a_node.kind;
+        for (size_t i = 0; i < children.size(); ++i) {
+          const size_t a_child = _add_node(children[i], visiting_);
+          a_node.children.push_back(a_child);
+          signature << ';' << a_child;
+        }
+        visiting_.erase(cut_name_);
+      }
+
+      size_t a_index = _nodes_.size();
+      std::map<std::string, size_t>::const_iterator same = _signatures_.find(signature.str());
+      if (same != _signatures_.end()) {
+        a_index = same->second;
+      } else {
+        _nodes_.push_back(a_node);
+        _signatures_[signature.str()] = a_index;
+      }
+      _names_[cut_name_] = a_index;
+      return a_index;
+    }
+
+  }  // end of namespace cut
+
+}  // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
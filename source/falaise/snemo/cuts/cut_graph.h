@@ -0,0 +1,183 @@
+/// \file falaise/snemo/cuts/cut_graph.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Shared graph of cuts evaluated once per user data
+ */
+
+#ifndef FALAISE_SNEMO_CUT_CUT_GRAPH_H
+#define FALAISE_SNEMO_CUT_CUT_GRAPH_H 1
+
+// Standard library:
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+// - Bayeux/cuts:
+#include <cuts/i_cut.h>
+
+namespace cuts {
+  class cut_manager;
+}
+
+namespace snemo {
+
+  namespace cut {
+
+    /// \brief Graph of the cuts of a cut manager sharing their sub-cuts
+    ///
+    /// The ``cuts::multi_and_cut``, ``cuts::multi_or_cut`` and ``cuts::not_cut``
+    /// trees are expanded from the cut manager configuration. Sub-cuts with the
+    /// same name, or with the same type and configuration, share a single node.
+    /// Node results are kept until reset so that, for a given user data, each
+    /// node is evaluated at most once whatever the number of cuts using it.
+    ///
+    /// Merging and caching assume the cuts are pure, i.e. their result only
+    /// depends on the user data and on their configuration. Random cuts are
+    /// never merged with other cuts; other cuts with an internal state
+    /// (counters, prescales...) should not be used within the graph.
+    class cut_graph
+    {
+    public:
+
+      /// Kind of node
+      enum node_kind {
+        NODE_LEAF = 0, //!< Cut evaluated by itself
+        NODE_AND  = 1, //!< Logical AND of the child nodes
+        NODE_OR   = 2, //!< Logical OR of the child nodes
+        NODE_NOT  = 3  //!< Negation of the child node
+      };
+
+      /// Result of a node not evaluated yet
+      static const int NOT_EVALUATED = cuts::SELECTION_INAPPLICABLE - 1;
+
+      /// \brief Node of the graph
+      struct node_type {
+        node_kind kind;                       //!< Kind of node
+        std::string cut_name;                 //!< Name of the cut
+        std::string cut_id;                   //!< Type of the cut
+        const datatools::properties * config; //!< Configuration of the cut
+        cuts::i_cut * cut;                    //!< Cut evaluated by leaf nodes
+        std::vector<size_t> children;         //!< Child nodes of logical nodes
+      };
+
+      /// Constructor
+      cut_graph();
+
+      /// Destructor
+      ~cut_graph();
+
+      /// Set the cut manager
+      void set_cut_manager(cuts::cut_manager & cut_manager_);
+
+      /// Check the cut manager
+      bool has_cut_manager() const;
+
+      /// Add a cut and its sub-cuts to the graph and return its node
+      size_t add_cut(const std::string & cut_name_);
+
+      /// Check if a cut has been added to the graph
+      bool has_cut(const std::string & cut_name_) const;
+
+      /// Return the node of a cut added to the graph
+      size_t get_node_index(const std::string & cut_name_) const;
+
+      /// Return the number of nodes
+      size_t get_number_of_nodes() const;
+
+      /// Return a node
+      const node_type & get_node(const size_t node_) const;
+
+      /// Forget the node results (to be called when the user data changes)
+      void reset_results();
+
+      /// Remove all the nodes
+      void clear();
+
+      /// Evaluate a node, reusing the results already known for the user data
+      template<class T>
+      int evaluate(const size_t node_, const T & data_)
+      {
+        if (_results_[node_] != NOT_EVALUATED) return _results_[node_];
+        const node_type & a_node = _nodes_[node_];
+        int status = cuts::SELECTION_INAPPLICABLE;
+        switch (a_node.kind) {
+        case NODE_LEAF:
+          a_node.cut->set_user_data(data_);
+          status = a_node.cut->process();
+          a_node.cut->reset_user_data();
+          break;
+        case NODE_AND:
+          status = cuts::SELECTION_ACCEPTED;
+          for (size_t i = 0; i < a_node.children.size(); ++i) {
+            const int a_status = evaluate(a_node.children[i], data_);
+            if (a_status != cuts::SELECTION_ACCEPTED) {
+              status = a_status;
+              break;
+            }
+          }
+          break;
+        case NODE_OR:
+          status = cuts::SELECTION_REJECTED;
+          for (size_t i = 0; i < a_node.children.size(); ++i) {
+            const int a_status = evaluate(a_node.children[i], data_);
+            if (a_status != cuts::SELECTION_REJECTED) {
+              status = a_status;
+              break;
+            }
+          }
+          break;
+        case NODE_NOT:
+          status = evaluate(a_node.children.front(), data_);
+          if (status == cuts::SELECTION_ACCEPTED) {
+            status = cuts::SELECTION_REJECTED;
+          } else if (status == cuts::SELECTION_REJECTED) {
+            status = cuts::SELECTION_ACCEPTED;
+          }
+          break;
+        }
+        _results_[node_] = status;
+        return status;
+      }
+
+      /// Collect the leaves which must accept for a node to accept
+      ///
+      /// AND, OR and NOT nodes are expanded: a leaf is required by an OR node
+      /// if it is required by all its children, and negations are followed
+      /// down to the leaves (i.e. NOT(OR(NOT(a), NOT(b))) requires a and b).
+      void fetch_required_leaves(const size_t node_, std::vector<size_t> & leaves_) const;
+
+    protected:
+
+      /// Collect the leaves which must accept for a node to give a status (accepted or rejected)
+      void _fetch_required_leaves(const size_t node_, const int status_, std::set<size_t> & leaves_) const;
+
+      /// Add a node given the cut name
+      size_t _add_node(const std::string & cut_name_, std::set<std::string> & visiting_);
+
+    private:
+
+      cuts::cut_manager * _cut_manager_;              //!< The cut manager
+      std::vector<node_type> _nodes_;                 //!< Nodes
+      std::map<std::string, size_t> _names_;          //!< Nodes indexed by cut name
+      std::map<std::string, size_t> _signatures_;     //!< Nodes indexed by signature
+      std::vector<int> _results_;                     //!< Results of the nodes
+    };
+
+  }  // end of namespace cut
+
+}  // end of namespace snemo
+
+#endif // FALAISE_SNEMO_CUT_CUT_GRAPH_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,469 @@
+// falaise/snemo/cuts/event_time_measurement_cut.cc
+
+// Ourselves:
+#include <falaise/snemo/cuts/event_time_measurement_cut.h>
+
+// Standard library:
+#include <stdexcept>
+#include <sstream>
+#include <cmath>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+#include <datatools/things.h>
+#include <datatools/clhep_units.h>
+
+// SuperNEMO data models :
+#include <falaise/snemo/datamodels/event_time_measurement.h>
+
+namespace snemo {
+
+  namespace cut {
+
+    namespace {
+
+      /// Fetch the '<prefix>.min' and '<prefix>.max' probabilities
+      void fetch_probability_range(const datatools::properties & configuration_,
+                                   const std::string & prefix_,
+                                   double & min_, double & max_)
+      {
+        size_t count = 0;
+        if (configuration_.has_key(prefix_ + ".min")) {
+          min_ = configuration_.fetch_real_with_explicit_dimension(prefix_ + ".min", "fraction");
+          DT_THROW_IF(min_ < 0.0*CLHEP::perCent || min_ > 100.0*CLHEP::perCent, std::range_error,
+                      "Invalid '" << prefix_ << ".min' probability (" << min_ << ") !");
+          count++;
+        }
+        if (configuration_.has_key(prefix_ + ".max")) {
+          max_ = configuration_.fetch_real_with_explicit_dimension(prefix_ + ".max", "fraction");
+          DT_THROW_IF(max_ < 0.0*CLHEP::perCent || max_ > 100.0*CLHEP::perCent, std::range_error,
+                      "Invalid '" << prefix_ << ".max' probability (" << max_ << ") !");
+          count++;
+        }
+        DT_THROW_IF(count == 0, std::logic_error,
+                    "Missing '" << prefix_ << ".min' or '" << prefix_ << ".max' property !");
+        DT_THROW_IF(count == 2 && min_ > max_, std::logic_error,
+                    "Invalid '" << prefix_ << ".min' > '" << prefix_ << ".max' values !");
+        return;
+      }
+
+      /// Check if a probability is within [min_, max_] (invalid bounds are ignored)
+      bool is_in_range(const double value_, const double min_, const double max_)
+      {
+        if (datatools::is_valid(min_) && value_ < min_) return false;
+        if (datatools::is_valid(max_) && value_ > max_) return false;
+        return true;
+      }
+
+    }
+
+    // Registration instantiation macro :
+    CUT_REGISTRATION_IMPLEMENT(event_time_measurement_cut, "snemo::cut::event_time_measurement_cut")
+
+    void event_time_measurement_cut::_set_defaults()
+    {
+      _mode_ = MODE_UNDEFINED;
+      datatools::invalidate(_int_prob_range_min_);
+      datatools::invalidate(_int_prob_range_max_);
+      datatools::invalidate(_ext_prob_range_min_);
+      datatools::invalidate(_ext_prob_range_max_);
+      datatools::invalidate(_int_pull_range_max_);
+      return;
+    }
+
+    uint32_t event_time_measurement_cut::get_mode() const
+    {
+      return _mode_;
+    }
+
+    bool event_time_measurement_cut::is_mode_has_internal_fit() const
+    {
+      return _mode_ & MODE_HAS_INTERNAL_FIT;
+    }
+
+    bool event_time_measurement_cut::is_mode_has_external_fit() const
+    {
+      return _mode_ & MODE_HAS_EXTERNAL_FIT;
+    }
+
+    bool event_time_measurement_cut::is_mode_range_internal_probability() const
+    {
+      return _mode_ & MODE_RANGE_INTERNAL_PROBABILITY;
+    }
+
+    bool event_time_measurement_cut::is_mode_range_external_probability() const
+    {
+      return _mode_ & MODE_RANGE_EXTERNAL_PROBABILITY;
+    }
+
+    bool event_time_measurement_cut::is_mode_range_internal_pull() const
+    {
+      return _mode_ & MODE_RANGE_INTERNAL_PULL;
+    }
+
+    event_time_measurement_cut::event_time_measurement_cut(datatools::logger::priority logger_priority_)
+      : cuts::i_cut(logger_priority_)
+    {
+      _set_defaults();
+      this->register_supported_user_data_type<snemo::datamodel::base_topology_measurement>();
+      this->register_supported_user_data_type<snemo::datamodel::event_time_measurement>();
+      return;
+    }
+
+    event_time_measurement_cut::~event_time_measurement_cut()
+    {
+      if (is_initialized()) this->event_time_measurement_cut::reset();
+      return;
+    }
+
+    void event_time_measurement_cut::reset()
+    {
+      _set_defaults();
+      this->i_cut::_reset();
+      this->i_cut::_set_initialized(false);
+      return;
+    }
+
+    void event_time_measurement_cut::initialize(const datatools::properties & configuration_,
+                                                datatools::service_manager  & /* service_manager_ */,
+                                                cuts::cut_handle_dict_type  & /* cut_dict_ */)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Cut '" << get_name() << "' is already initialized ! ");
+
+      this->i_cut::_common_initialize(configuration_);
+
+      if (_mode_ == MODE_UNDEFINED) {
+        if (configuration_.has_flag("mode.has_internal_fit")) {
+          _mode_ |= MODE_HAS_INTERNAL_FIT;
+        }
+        if (configuration_.has_flag("mode.has_external_fit")) {
+          _mode_ |= MODE_HAS_EXTERNAL_FIT;
+        }
+        if (configuration_.has_flag("mode.range_internal_probability")) {
+          _mode_ |= MODE_RANGE_INTERNAL_PROBABILITY;
+        }
+        if (configuration_.has_flag("mode.range_external_probability")) {
+          _mode_ |= MODE_RANGE_EXTERNAL_PROBABILITY;
+        }
+        if (configuration_.has_flag("mode.range_internal_pull")) {
+          _mode_ |= MODE_RANGE_INTERNAL_PULL;
+        }
+        DT_THROW_IF(_mode_ == MODE_UNDEFINED, std::logic_error,
+                    "Missing at least a 'mode.XXX' property !");
+
+        // mode RANGE_INTERNAL_PROBABILITY:
+        if (is_mode_range_internal_probability()) {
+          DT_LOG_DEBUG(get_logging_priority(), "Using RANGE_INTERNAL_PROBABILITY mode...");
+          fetch_probability_range(configuration_, "range_internal_probability",
+                                  _int_prob_range_min_, _int_prob_range_max_);
+        } // end if is_mode_range_internal_probability
+
+        // mode RANGE_EXTERNAL_PROBABILITY:
+        if (is_mode_range_external_probability()) {
+          DT_LOG_DEBUG(get_logging_priority(), "Using RANGE_EXTERNAL_PROBABILITY mode...");
+          fetch_probability_range(configuration_, "range_external_probability",
+                                  _ext_prob_range_min_, _ext_prob_range_max_);
+        } // end if is_mode_range_external_probability
+
+        // mode RANGE_INTERNAL_PULL:
+        if (is_mode_range_internal_pull()) {
+          DT_LOG_DEBUG(get_logging_priority(), "Using RANGE_INTERNAL_PULL mode...");
+          DT_THROW_IF(! configuration_.has_key("range_internal_pull.max"), std::logic_error,
+                      "Missing 'range_internal_pull.max' property !");
+          _int_pull_range_max_ = configuration_.fetch_real("range_internal_pull.max");
+          DT_THROW_IF(_int_pull_range_max_ <= 0.0, std::range_error,
+                      "Invalid maximal internal pull (" << _int_pull_range_max_ << ") !");
+        } // end if is_mode_range_internal_pull
+      }
+
+      this->i_cut::_set_initialized(true);
+      return;
+    }
+
+    int event_time_measurement_cut::_accept()
+    {
+      DT_LOG_TRACE(get_logging_priority(), "Entering...");
+      uint32_t cut_returned = cuts::SELECTION_INAPPLICABLE;
+
+      // Get event time measurement
+      const snemo::datamodel::event_time_measurement * ptr_meas = 0;
+      if (is_user_data<snemo::datamodel::event_time_measurement>()) {
+        ptr_meas = &(get_user_data<snemo::datamodel::event_time_measurement>());
+      } else if (is_user_data<snemo::datamodel::base_topology_measurement>()) {
+        const snemo::datamodel::base_topology_measurement & btm
+          = get_user_data<snemo::datamodel::base_topology_measurement>();
+        ptr_meas = dynamic_cast<const snemo::datamodel::event_time_measurement *>(&btm);
+      } else {
+        DT_THROW_IF(true, std::logic_error, "Invalid data type !");
+      }
+      DT_THROW_IF(ptr_meas == 0, std::logic_error, "Measurement is not an event time measurement !");
+      const snemo::datamodel::event_time_measurement & a_meas = *ptr_meas;
+
+      // Check fit availability
+      if (is_mode_has_internal_fit() && ! a_meas.has_internal_fit()) {
+        DT_LOG_DEBUG(get_logging_priority(), "Missing internal fit !");
+        return cuts::SELECTION_REJECTED;
+      }
+      if (is_mode_has_external_fit() && ! a_meas.has_external_fit()) {
+        DT_LOG_DEBUG(get_logging_priority(), "Missing external fit !");
+        return cuts::SELECTION_REJECTED;
+      }
+
+      // Check internal fit
+      if (is_mode_range_internal_probability() || is_mode_range_internal_pull()) {
+        if (! a_meas.has_internal_fit()) {
+          DT_LOG_DEBUG(get_logging_priority(), "Missing internal fit !");
+          return cuts::SELECTION_INAPPLICABLE;
+        }
+      }
+      bool check_range_internal_probability = true;
+      if (is_mode_range_internal_probability()) {
+        const double pint = a_meas.get_internal_probability();
+        if (! is_in_range(pint, _int_prob_range_min_, _int_prob_range_max_)) {
+          DT_LOG_DEBUG(get_logging_priority(),
+                       "Internal probability (" << pint/CLHEP::perCent << "%) out of range");
+          check_range_internal_probability = false;
+        }
+      } // end of is_mode_range_internal_probability
+
+      bool check_range_internal_pull = true;
+      if (is_mode_range_internal_pull()) {
+        const snemo::datamodel::event_time_measurement::pull_collection_type & pulls
+          = a_meas.get_internal_pulls();
+        for (size_t i = 0; i < pulls.size(); ++i) {
+          if (std::abs(pulls[i]) > _int_pull_range_max_) {
+            DT_LOG_DEBUG(get_logging_priority(),
+                         "Internal pull of '" << a_meas.get_particle_labels()[i] << "' ("
+                         << pulls[i] << ") greater than " << _int_pull_range_max_);
+            check_range_internal_pull = false;
+            break;
+          }
+        }
+      } // end of is_mode_range_internal_pull
+
+      // Check external fit
+      bool check_range_external_probability = true;
+      if (is_mode_range_external_probability()) {
+        if (! a_meas.has_external_fit()) {
+          DT_LOG_DEBUG(get_logging_priority(), "Missing external fit !");
+          return cuts::SELECTION_INAPPLICABLE;
+        }
+        const double pext = a_meas.get_external_probability();
+        if (! is_in_range(pext, _ext_prob_range_min_, _ext_prob_range_max_)) {
+          DT_LOG_DEBUG(get_logging_priority(),
+                       "External probability (" << pext/CLHEP::perCent << "%) out of range");
+          check_range_external_probability = false;
+        }
+      } // end of is_mode_range_external_probability
+
+      cut_returned = cuts::SELECTION_REJECTED;
+      if (check_range_internal_probability &&
+          check_range_internal_pull &&
+          check_range_external_probability) {
+        DT_LOG_DEBUG(get_logging_priority(), "Event accepted by event time measurement cut!");
+        cut_returned = cuts::SELECTION_ACCEPTED;
+      }
+      return cut_returned;
+    }
+
+  }  // end of namespace cut
+
+}  // end of namespace snemo
+
+DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::cut::event_time_measurement_cut, ocd_)
+{
+  ocd_.set_class_name("snemo::cut::event_time_measurement_cut");
+  ocd_.set_class_description("Cut based on criteria applied to an event time measurement");
+  ocd_.set_class_library("falaise");
+  // ocd_.set_class_documentation("");
+
+  cuts::i_cut::common_ocd(ocd_);
+
+  {
+    // Description of the 'mode.has_internal_fit' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("mode.has_internal_fit")
+      .set_terse_description("Mode requiring the internal event time fit")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .add_example("Activate the mode::                     \n"
+                   "                                        \n"
+                   "  mode.has_internal_fit : boolean = true \n"
+                   "                                        \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'mode.has_external_fit' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("mode.has_external_fit")
+      .set_terse_description("Mode requiring the external event time fit")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .add_example("Activate the mode::                     \n"
+                   "                                        \n"
+                   "  mode.has_external_fit : boolean = true \n"
+                   "                                        \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'mode.range_internal_probability' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("mode.range_internal_probability")
+      .set_terse_description("Mode with a requested range of the internal fit probability")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .add_example("Activate the mode::                                \n"
+                   "                                                   \n"
+                   "  mode.range_internal_probability : boolean = true \n"
+                   "                                                   \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'mode.range_external_probability' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("mode.range_external_probability")
+      .set_terse_description("Mode with a requested range of the external fit probability")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .add_example("Activate the mode::                                \n"
+                   "                                                   \n"
+                   "  mode.range_external_probability : boolean = true \n"
+                   "                                                   \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'mode.range_internal_pull' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("mode.range_internal_pull")
+      .set_terse_description("Mode with a maximal absolute internal pull for every particle")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .add_example("Activate the mode::                         \n"
+                   "                                            \n"
+                   "  mode.range_internal_pull : boolean = true \n"
+                   "                                            \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'range_internal_probability.min' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("range_internal_probability.min")
+      .set_terse_description("Minimal value of the internal fit probability")
+      .set_triggered_by_flag("mode.range_internal_probability")
+      .set_traits(datatools::TYPE_REAL)
+      .set_explicit_unit(true)
+      .set_unit_label("fraction")
+      .set_unit_symbol("%")
+      .add_example("Set a specific minimal value of the internal probability:: \n"
+                   "                                                           \n"
+                   "  range_internal_probability.min : real as fraction = 4 %  \n"
+                   "                                                           \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'range_internal_probability.max' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("range_internal_probability.max")
+      .set_terse_description("Maximal value of the internal fit probability")
+      .set_triggered_by_flag("mode.range_internal_probability")
+      .set_traits(datatools::TYPE_REAL)
+      .set_explicit_unit(true)
+      .set_unit_label("fraction")
+      .set_unit_symbol("%")
+      .add_example("Set a specific maximal value of the internal probability::  \n"
+                   "                                                            \n"
+                   "  range_internal_probability.max : real as fraction = 100 % \n"
+                   "                                                            \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'range_external_probability.min' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("range_external_probability.min")
+      .set_terse_description("Minimal value of the external fit probability")
+      .set_triggered_by_flag("mode.range_external_probability")
+      .set_traits(datatools::TYPE_REAL)
+      .set_explicit_unit(true)
+      .set_unit_label("fraction")
+      .set_unit_symbol("%")
+      .add_example("Set a specific minimal value of the external probability:: \n"
+                   "                                                           \n"
+                   "  range_external_probability.min : real as fraction = 4 %  \n"
+                   "                                                           \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'range_external_probability.max' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("range_external_probability.max")
+      .set_terse_description("Maximal value of the external fit probability")
+      .set_triggered_by_flag("mode.range_external_probability")
+      .set_traits(datatools::TYPE_REAL)
+      .set_explicit_unit(true)
+      .set_unit_label("fraction")
+      .set_unit_symbol("%")
+      .add_example("Set a specific maximal value of the external probability:: \n"
+                   "                                                           \n"
+                   "  range_external_probability.max : real as fraction = 1 %  \n"
+                   "                                                           \n"
+                   )
+      ;
+  }
+
+  {
+    // Description of the 'range_internal_pull.max' configuration property :
+    datatools::configuration_property_description & cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("range_internal_pull.max")
+      .set_terse_description("Maximal absolute value of the internal pull of every particle")
+      .set_triggered_by_flag("mode.range_internal_pull")
+      .set_traits(datatools::TYPE_REAL)
+      .add_example("Reject events with a particle beyond 3 sigmas:: \n"
+                   "                                                \n"
+                   "  range_internal_pull.max : real = 3.0          \n"
+                   "                                                \n"
+                   )
+      ;
+  }
+
+  // Additional configuration hints :
+  ocd_.set_configuration_hints("Here is a full configuration example in the                  \n"
+                               "``datatools::properties`` ASCII format::                     \n"
+                               "                                                             \n"
+                               "   mode.has_internal_fit : boolean = true                    \n"
+                               "   mode.range_internal_probability : boolean = true          \n"
+                               "   range_internal_probability.min : real as fraction = 4 %   \n"
+                               "   mode.range_internal_pull : boolean = true                 \n"
+                               "   range_internal_pull.max : real = 3.0                      \n"
+                               "                                                             \n"
+                               "The cut is applied to the ``event_time`` measurement, for    \n"
+                               "instance through a ``snemo::cut::channel_cut``.              \n"
+                               );
+
+  ocd_.set_validation_support(true);
+  ocd_.lock();
+  return;
+}
+DOCD_CLASS_IMPLEMENT_LOAD_END() // Closing macro for implementation
+
+// Registration macro for class 'snemo::cut::event_time_measurement_cut' :
+DOCD_CLASS_SYSTEM_REGISTRATION(snemo::cut::event_time_measurement_cut, "snemo::cut::event_time_measurement_cut")
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** End: --
+*/
@@ -14,6 +14,7 @@
 
 // SuperNEMO data models :
 #include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/pid_data.h>
 #include <falaise/snemo/datamodels/data_model.h>
 #include <falaise/snemo/datamodels/particle_track_data.h>
 
@@ -57,6 +58,7 @@ namespace snemo {
     void pid_cut::_set_defaults()
     {
       _PTD_label_ = snemo::datamodel::data_info::default_particle_track_data_label();
+      _PID_label_ = "PID";
       return;
     }
 
@@ -94,6 +96,10 @@ namespace snemo {
         _PTD_label_ = configuration_.fetch_string("PTD_label");
       }
 
+      if (configuration_.has_key("PID_label")) {
+        _PID_label_ = configuration_.fetch_string("PID_label");
+      }
+
       _electron_range_.parse(configuration_, "electron");
       _positron_range_.parse(configuration_, "positron");
       _gamma_range_.parse(configuration_, "gamma");
@@ -112,36 +118,49 @@ namespace snemo {
       // Get event record
       const datatools::things & ER = get_user_data<datatools::things>();
 
-      if (! ER.has(_PTD_label_)) {
-        DT_LOG_DEBUG(get_logging_priority(), "Event record has no '" << _PTD_label_ << "' bank !");
-        return cut_returned;
-      }
-      const snemo::datamodel::particle_track_data & PTD
-        = ER.get<snemo::datamodel::particle_track_data>(_PTD_label_);
-
-      const datatools::properties & aux = PTD.get_auxiliaries();
-
       size_t nelectrons = 0;
       size_t npositrons = 0;
       size_t nalphas    = 0;
       size_t ngammas    = 0;
       size_t nundefined = 0;
 
-      std::string key;
-      if (aux.has_key(key = snemo::datamodel::pid_utils::electron_label())) {
-        nelectrons = aux.fetch_integer(key);
-      }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::positron_label())) {
-        npositrons = aux.fetch_integer(key);
-      }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::gamma_label())) {
-        ngammas = aux.fetch_integer(key);
-      }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::alpha_label())) {
-        nalphas = aux.fetch_integer(key);
-      }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::undefined_label())) {
-        nundefined = aux.fetch_integer(key);
+      if (ER.has(_PID_label_) && ER.is_a<snemo::datamodel::pid_data>(_PID_label_)) {
+        // Particle counters from the PID bank
+        typedef snemo::datamodel::pid_utils pu;
+        const snemo::datamodel::pid_data & PID
+          = ER.get<snemo::datamodel::pid_data>(_PID_label_);
+        nelectrons = PID.get_particle_count(pu::PARTICLE_ELECTRON);
+        npositrons = PID.get_particle_count(pu::PARTICLE_POSITRON);
+        ngammas    = PID.get_particle_count(pu::PARTICLE_GAMMA);
+        nalphas    = PID.get_particle_count(pu::PARTICLE_ALPHA);
+        nundefined = PID.get_particle_count(pu::PARTICLE_UNDEFINED);
+      } else {
+        // Particle counters exported within particle track data auxiliaries
+        if (! ER.has(_PTD_label_)) {
+          DT_LOG_DEBUG(get_logging_priority(), "Event record has no '" << _PTD_label_ << "' bank !");
+          return cut_returned;
+        }
+        const snemo::datamodel::particle_track_data & PTD
+          = ER.get<snemo::datamodel::particle_track_data>(_PTD_label_);
+
+        const datatools::properties & aux = PTD.get_auxiliaries();
+
+        std::string key;
+        if (aux.has_key(key = snemo::datamodel::pid_utils::electron_label())) {
+          nelectrons = aux.fetch_integer(key);
+        }
+        if (aux.has_key(key = snemo::datamodel::pid_utils::positron_label())) {
+          npositrons = aux.fetch_integer(key);
+        }
+        if (aux.has_key(key = snemo::datamodel::pid_utils::gamma_label())) {
+          ngammas = aux.fetch_integer(key);
+        }
+        if (aux.has_key(key = snemo::datamodel::pid_utils::alpha_label())) {
+          nalphas = aux.fetch_integer(key);
+        }
+        if (aux.has_key(key = snemo::datamodel::pid_utils::undefined_label())) {
+          nundefined = aux.fetch_integer(key);
+        }
       }
 
       DT_LOG_TRACE(get_logging_priority(), "nelectron  = " << nelectrons);
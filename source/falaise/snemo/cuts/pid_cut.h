@@ -89,6 +89,7 @@ namespace snemo {
     private:
 
       std::string _PTD_label_; //!< Name of the "Particle track data" bank
+      std::string _PID_label_; //!< Name of the "PID data" bank
 
       particle_range _electron_range_; //!< Number of electrons
       particle_range _positron_range_; //!< Number of positrons
@@ -242,36 +242,24 @@ namespace snemo {
           DT_LOG_DEBUG(get_logging_priority(), "Missing internal probability !");
           return cuts::SELECTION_INAPPLICABLE;
         }
+        // Every probability has to lie within the range: only the extreme
+        // values of the collection are checked
         const snemo::datamodel::tof_measurement::probability_type & pints
           = a_tof_meas.get_internal_probabilities();
-        for (snemo::datamodel::tof_measurement::probability_type::const_iterator
-               ip = pints.begin(); ip != pints.end(); ++ip) {
-          const double pint = *ip;
-          if (datatools::is_valid(_int_prob_range_min_)) {
-            if (pint < _int_prob_range_min_) {
-              DT_LOG_DEBUG(get_logging_priority(),
-                           "Internal probability (" << pint/CLHEP::perCent << "%) lower than "
-                           << _int_prob_range_min_/CLHEP::perCent << "%");
-              check_range_internal_probability = false;
-              if (_int_prob_range_mode_ == MODE_RANGE_STRICT) {
-                break;
-              }
-            }
+        if (datatools::is_valid(_int_prob_range_min_)) {
+          if (pints.get_min() < _int_prob_range_min_) {
+            DT_LOG_DEBUG(get_logging_priority(),
+                         "Internal probability (" << pints.get_min()/CLHEP::perCent << "%) lower than "
+                         << _int_prob_range_min_/CLHEP::perCent << "%");
+            check_range_internal_probability = false;
           }
         }
-        for (snemo::datamodel::tof_measurement::probability_type::const_iterator
-               ip = pints.begin(); ip != pints.end(); ++ip) {
-          const double pint = *ip;
-          if (datatools::is_valid(_int_prob_range_max_)) {
-            if (pint > _int_prob_range_max_) {
-              DT_LOG_DEBUG(get_logging_priority(),
-                           "Internal probability (" << pint/CLHEP::perCent << "%) greater than "
-                           << _int_prob_range_max_/CLHEP::perCent << "%");
-              check_range_internal_probability = false;
-              if (_int_prob_range_mode_ == MODE_RANGE_STRICT) {
-                break;
-              }
-            }
+        if (datatools::is_valid(_int_prob_range_max_)) {
+          if (pints.get_max() > _int_prob_range_max_) {
+            DT_LOG_DEBUG(get_logging_priority(),
+                         "Internal probability (" << pints.get_max()/CLHEP::perCent << "%) greater than "
+                         << _int_prob_range_max_/CLHEP::perCent << "%");
+            check_range_internal_probability = false;
           }
         }
       } // end of is_mode_range_internal_probability
@@ -291,36 +279,24 @@ namespace snemo {
           DT_LOG_DEBUG(get_logging_priority(), "Missing external probability !");
           return cuts::SELECTION_INAPPLICABLE;
         }
+        // Every probability has to lie within the range: only the extreme
+        // values of the collection are checked
         const snemo::datamodel::tof_measurement::probability_type & pexts
           = a_tof_meas.get_external_probabilities();
-        for (snemo::datamodel::tof_measurement::probability_type::const_iterator
-               ip = pexts.begin(); ip != pexts.end(); ++ip) {
-          const double pext = *ip;
-          if (datatools::is_valid(_ext_prob_range_min_)) {
-            if (pext < _ext_prob_range_min_) {
-              DT_LOG_DEBUG(get_logging_priority(),
-                           "External probability (" << pext/CLHEP::perCent << "%) lower than "
-                           << _ext_prob_range_min_/CLHEP::perCent << "%");
-              check_range_external_probability = false;
-              if (_ext_prob_range_mode_ == MODE_RANGE_STRICT) {
-                break;
-              }
-            }
+        if (datatools::is_valid(_ext_prob_range_min_)) {
+          if (pexts.get_min() < _ext_prob_range_min_) {
+            DT_LOG_DEBUG(get_logging_priority(),
+                         "External probability (" << pexts.get_min()/CLHEP::perCent << "%) lower than "
+                         << _ext_prob_range_min_/CLHEP::perCent << "%");
+            check_range_external_probability = false;
           }
         }
-        for (snemo::datamodel::tof_measurement::probability_type::const_iterator
-               ip = pexts.begin(); ip != pexts.end(); ++ip) {
-          const double pext = *ip;
-          if (datatools::is_valid(_ext_prob_range_max_)) {
-            if (pext > _ext_prob_range_max_) {
-              DT_LOG_DEBUG(get_logging_priority(),
-                           "External probability (" << pext/CLHEP::perCent << "%) greater than "
-                           << _ext_prob_range_max_/CLHEP::perCent << "%");
-              check_range_external_probability = false;
-              if (_ext_prob_range_mode_ == MODE_RANGE_STRICT) {
-                break;
-              }
-            }
+        if (datatools::is_valid(_ext_prob_range_max_)) {
+          if (pexts.get_max() > _ext_prob_range_max_) {
+            DT_LOG_DEBUG(get_logging_priority(),
+                         "External probability (" << pexts.get_max()/CLHEP::perCent << "%) greater than "
+                         << _ext_prob_range_max_/CLHEP::perCent << "%");
+            check_range_external_probability = false;
           }
         }
       } // end of is_mode_range_external_probability
@@ -13,11 +13,13 @@
 // - Bayeux/datatools:
 #include <datatools/properties.h>
 #include <datatools/things.h>
+#include <datatools/service_manager.h>
 
 // SuperNEMO data models :
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/topology_data.h>
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/calorimeter_index_service.h>
 
 namespace snemo {
 
@@ -30,6 +32,14 @@ namespace snemo {
     {
       _mode_ = MODE_UNDEFINED;
       _TD_label_ = "TD";//snemo::datamodel::data_info::default_topology_data_label();
+      _classification_label_.clear();
+      _classification_exact_ = false;
+      _classification_code_ = 0;
+      _classification_regex_ = std::regex();
+      _calorimeter_ids_.clear();
+      _calorimeter_index_ = 0;
+      _calorimeter_seen_.clear();
+      _calorimeter_indexes_.clear();
       return;
     }
 
@@ -80,7 +90,7 @@ namespace snemo {
     }
 
     void topology_data_cut::initialize(const datatools::properties & configuration_,
-                                       datatools::service_manager  & /* service_manager_ */,
+                                       datatools::service_manager  & service_manager_,
                                        cuts::cut_handle_dict_type  & /* cut_dict_ */)
     {
       DT_THROW_IF(is_initialized(), std::logic_error,
@@ -111,6 +121,24 @@ namespace snemo {
         DT_THROW_IF(! configuration_.has_key("classification.label"), std::logic_error,
                     "Missing 'classification.label' !");
         _classification_label_ = configuration_.fetch_string("classification.label");
+        // Plain labels are compared through their classification code, other
+        // labels are regular expressions compiled once for all
+        _classification_exact_
+          = snemo::datamodel::pid_utils::parse_classification_label(_classification_label_,
+                                                                    _classification_code_);
+        _classification_regex_ = std::regex(_classification_label_);
+      }
+
+      if (is_mode_no_pile_up() && configuration_.has_key("CI_label")) {
+        // Calorimeter blocks tracked in a bitset indexed by the calorimeter index
+        const std::string ci_label = configuration_.fetch_string("CI_label");
+        DT_THROW_IF(! service_manager_.has(ci_label) ||
+                    ! service_manager_.is_a<snemo::datamodel::calorimeter_index_service>(ci_label),
+                    std::logic_error,
+                    "Cut '" << get_name() << "' has no '" << ci_label << "' service !");
+        _calorimeter_index_
+          = &service_manager_.get<snemo::datamodel::calorimeter_index_service>(ci_label).get_index();
+        _calorimeter_seen_.assign(_calorimeter_index_->size(), false);
       }
 
       this->i_cut::_set_initialized(true);
@@ -156,25 +184,41 @@ namespace snemo {
           DT_LOG_DEBUG(get_logging_priority(), "The event does not have associated classification !");
           return cuts::SELECTION_INAPPLICABLE;
         }
-        const std::string & a_classification = td_aux.fetch_string(snemo::datamodel::pid_utils::classification_label_key());
-        DT_LOG_TRACE(get_logging_priority(), "Looking for " << _classification_label_
-                     << " (current classification is '" << a_classification << "')");
-        if (! std::regex_match(a_classification, std::regex(_classification_label_))) {
-          check_classification = false;
+        if (_classification_exact_ && td_aux.has_key(snemo::datamodel::pid_utils::classification_code_key())) {
+          const snemo::datamodel::pid_utils::classification_code_type a_code
+            = td_aux.fetch_integer(snemo::datamodel::pid_utils::classification_code_key());
+          DT_LOG_TRACE(get_logging_priority(), "Looking for " << _classification_label_
+                       << " (current classification is '"
+                       << snemo::datamodel::pid_utils::classification_label(a_code) << "')");
+          if (a_code != _classification_code_) {
+            check_classification = false;
+          }
+        } else {
+          const std::string & a_classification
+            = td_aux.fetch_string(snemo::datamodel::pid_utils::classification_label_key());
+          DT_LOG_TRACE(get_logging_priority(), "Looking for " << _classification_label_
+                       << " (current classification is '" << a_classification << "')");
+          if (! std::regex_match(a_classification, _classification_regex_)) {
+            check_classification = false;
+          }
         }
       }
 
       // Check if event has no pile ups
       bool check_no_pile_up = true;
-      if (is_mode_no_pile_up()) {
+      if (is_mode_no_pile_up()
+          && check_has_pattern && check_has_classification && check_classification) {
         DT_LOG_DEBUG(get_logging_priority(), "Running NO_PILE_UP mode...");
-        std::set<geomtools::geom_id> gids;
-        const snemo::datamodel::base_topology_pattern::particle_track_dict_type a_particle_track_dict =
-          TD.get_pattern_handle().get().get_particle_track_dictionary();
-        for(snemo::datamodel::base_topology_pattern::particle_track_dict_type::const_iterator it = a_particle_track_dict.begin(); it != a_particle_track_dict.end(); ++it) {
-          if (! (std::regex_match(it->first, std::regex("e[0-9]")) ||
-                 std::regex_match(it->first, std::regex("p[0-9]"))))
-            continue;
+        _calorimeter_ids_.clear();
+        typedef snemo::datamodel::base_topology_pattern::particle_track_dict_type dict_type;
+        const dict_type & a_particle_track_dict
+          = TD.get_pattern_handle().get().get_particle_track_dictionary();
+        for (dict_type::const_iterator it = a_particle_track_dict.begin();
+             it != a_particle_track_dict.end() && check_no_pile_up; ++it) {
+          // Only electrons and positrons
+          const snemo::datamodel::pid_utils::particle_type a_type = it->first.get_type();
+          if (a_type != snemo::datamodel::pid_utils::PARTICLE_ELECTRON &&
+              a_type != snemo::datamodel::pid_utils::PARTICLE_POSITRON) continue;
 
           const snemo::datamodel::particle_track & a_particle = it->second.get();
           if (! a_particle.has_associated_calorimeter_hits()) {
@@ -194,12 +238,31 @@ namespace snemo {
 
           for (size_t i = 0; i < the_calorimeters.size(); ++i) {
             const geomtools::geom_id & gid = the_calorimeters.at(i).get().get_geom_id();
-            if (gids.find(gid) != gids.end()) {
+            const size_t a_index = _calorimeter_index_ != 0
+              ? _calorimeter_index_->get_index(gid)
+              : snemo::datamodel::calorimeter_index::INVALID_INDEX;
+            if (a_index != snemo::datamodel::calorimeter_index::INVALID_INDEX) {
+              if (_calorimeter_seen_[a_index]) {
+                check_no_pile_up = false;
+                break;
+              }
+              _calorimeter_seen_[a_index] = true;
+              _calorimeter_indexes_.push_back(a_index);
+              continue;
+            }
+            // Few calorimeters per event: a linear search in a reused buffer is enough
+            if (std::find(_calorimeter_ids_.begin(), _calorimeter_ids_.end(), gid) != _calorimeter_ids_.end()) {
               check_no_pile_up = false;
+              break;
             }
-            gids.insert(gid);
+            _calorimeter_ids_.push_back(gid);
           }
         }
+        // Only the blocks set by this event are cleared
+        for (size_t i = 0; i < _calorimeter_indexes_.size(); ++i) {
+          _calorimeter_seen_[_calorimeter_indexes_[i]] = false;
+        }
+        _calorimeter_indexes_.clear();
       }
 
       cut_returned = cuts::SELECTION_REJECTED;
@@ -33,6 +33,8 @@
 
 // Standard library:
 #include <string>
+#include <regex>
+#include <vector>
 
 // Third party:
 // - Boost:
@@ -41,9 +43,18 @@
 #include <datatools/bit_mask.h>
 // - Bayeux/cuts:
 #include <cuts/i_cut.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
 
 namespace snemo {
 
+  namespace datamodel {
+    class calorimeter_index;
+  }
+
   namespace cut {
 
     /// \brief A topology_data event cut
@@ -103,6 +114,14 @@ namespace snemo {
       uint32_t    _mode_;     //!< Mode of the cut
 
       std::string _classification_label_; //!< Classification label
+      bool _classification_exact_;        //!< Flag for a plain classification label
+      snemo::datamodel::pid_utils::classification_code_type _classification_code_; //!< Code of a plain classification label
+      std::regex _classification_regex_;  //!< Classification label compiled as a regular expression
+
+      std::vector<geomtools::geom_id> _calorimeter_ids_; //!< Calorimeters already seen (working buffer)
+      const snemo::datamodel::calorimeter_index * _calorimeter_index_; //!< Dense index of the calorimeter blocks
+      std::vector<bool> _calorimeter_seen_;              //!< Calorimeters already seen by dense index
+      std::vector<size_t> _calorimeter_indexes_;         //!< Dense indexes to clear after the pile-up check
 
       // Macro to automate the registration of the cut :
       CUT_REGISTRATION_INTERFACE(topology_data_cut)
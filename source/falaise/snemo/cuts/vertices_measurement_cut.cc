@@ -26,7 +26,7 @@ namespace snemo {
     void vertices_measurement_cut::_set_defaults()
     {
       _mode_ = MODE_UNDEFINED;
-      _location_ = "";
+      _location_ = snemo::datamodel::vertex_measurement::LOCATION_NONE;
       datatools::invalidate(_vertices_prob_range_min_);
       datatools::invalidate(_vertices_prob_range_max_);
       datatools::invalidate(_vertices_dist_x_range_min_);
@@ -154,12 +154,12 @@ namespace snemo {
 
           size_t count = 0;
           if (configuration_.has_key("location.value")) {
-            std::string location = configuration_.fetch_string("location.value");
-            //check if the location is one of the 4 or leave it be
-            // DT_THROW_IF(,
-            //             std::range_error,
-            //             "Invalid minimal vertices probability (" << pmin << ") !");
-            _location_ = location;
+            const std::string location = configuration_.fetch_string("location.value");
+            _location_ = snemo::datamodel::vertex_measurement::location_from_label(location);
+            DT_THROW_IF(_location_ == snemo::datamodel::vertex_measurement::LOCATION_NONE &&
+                        location != snemo::datamodel::vertex_measurement::location_label(_location_),
+                        std::logic_error,
+                        "Invalid vertices location '" << location << "' !");
 
             count++;
           }
@@ -338,15 +338,15 @@ namespace snemo {
           DT_LOG_DEBUG(get_logging_priority(), "Missing vertex probability !");
           return cuts::SELECTION_INAPPLICABLE;
         }
-        std::string location;
-        a_vertices_meas.get_vertex().get_auxiliaries().fetch("vertex.type",location);
-
-        if (location != "") {
-          if (location != _location_) {
-            DT_LOG_DEBUG(get_logging_priority(),
-                         "Vertices location (" << location << ") doesn't match the requirement.");
-            check_location = false;
-          }
+        if (a_vertices_meas.get_location_type() == snemo::datamodel::vertex_measurement::LOCATION_NONE &&
+            a_vertices_meas.get_probability() > 0.0) {
+          // Common vertex with an unknown location (version 0 archives
+          // without location): the location is not checked
+          DT_LOG_DEBUG(get_logging_priority(), "Unknown vertices location, location not checked.");
+        } else if (a_vertices_meas.get_location_type() != _location_) {
+          DT_LOG_DEBUG(get_logging_priority(),
+                       "Vertices location (" << a_vertices_meas.get_location() << ") doesn't match the requirement.");
+          check_location = false;
         }
       } // end of is_mode_location
 
@@ -19,6 +19,9 @@
 // - Bayeux/cuts:
 #include <cuts/i_cut.h>
 
+// This project:
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+
 namespace snemo {
 
   namespace cut {
@@ -96,7 +99,7 @@ namespace snemo {
     private:
 
       uint32_t _mode_;             //!< Mode of the cut
-      std::string _location_; //!< Vertex/ices location
+      snemo::datamodel::vertex_measurement::location_type _location_; //!< Vertex/ices location
       double _vertices_prob_range_min_; //!< Minimal vertices probability
       double _vertices_prob_range_max_; //!< Maximal vertices probability
       double _vertices_dist_x_range_min_; //!< Minimal vertices distance in x
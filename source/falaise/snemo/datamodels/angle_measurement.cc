@@ -27,6 +27,13 @@ namespace snemo {
       return;
     }
 
+    void angle_measurement::clear()
+    {
+      base_topology_measurement::clear();
+      datatools::invalidate(_angle_);
+      return;
+    }
+
     bool angle_measurement::has_angle() const
     {
       return datatools::is_valid(_angle_);
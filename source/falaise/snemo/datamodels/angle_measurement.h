@@ -39,6 +39,9 @@ namespace snemo {
       /// Get a mutable reference to angle
       double & grab_angle();
 
+      /// Clear the measurement
+      virtual void clear();
+
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
                              const std::string & title_  = "",
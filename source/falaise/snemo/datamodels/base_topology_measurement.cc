@@ -32,6 +32,12 @@ namespace snemo {
       return _auxiliaries_;
     }
 
+    void base_topology_measurement::clear()
+    {
+      _auxiliaries_.clear();
+      return;
+    }
+
     void base_topology_measurement::tree_dump(std::ostream      & out_,
                                               const std::string & title_,
                                               const std::string & indent_,
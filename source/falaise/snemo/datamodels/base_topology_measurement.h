@@ -16,6 +16,7 @@
 // - Bayeux/datatools:
 #include <bayeux/datatools/i_serializable.h>
 #include <bayeux/datatools/i_tree_dump.h>
+#include <bayeux/datatools/i_clear.h>
 #include <bayeux/datatools/properties.h>
 
 namespace snemo {
@@ -24,7 +25,8 @@ namespace snemo {
 
     /// \brief The base class of reconstructed topology
     class base_topology_measurement : public datatools::i_serializable,
-                                      public datatools::i_tree_dumpable
+                                      public datatools::i_tree_dumpable,
+                                      public datatools::i_clear
     {
     public:
 
@@ -40,6 +42,9 @@ namespace snemo {
       /// Return the mutable container of auxiliaries
       datatools::properties & grab_auxiliaries();
 
+      /// Clear the measurement
+      virtual void clear();
+
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
                              const std::string & title_  = "",
@@ -4,9 +4,6 @@
 // Ourselves:
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
 
-// Standard library:
-#include <regex>
-
 namespace snemo {
 
   namespace datamodel {
@@ -35,41 +32,127 @@ namespace snemo {
       return _tracks_;
     }
 
-    bool base_topology_pattern::has_particle_track(const std::string & key_) const
+    bool base_topology_pattern::has_particle_track(const particle_slot & key_) const
     {
       return _tracks_.find(key_) != _tracks_.end();
     }
 
-    const snemo::datamodel::particle_track & base_topology_pattern::get_particle_track(const std::string & key_) const
+    const snemo::datamodel::particle_track & base_topology_pattern::get_particle_track(const particle_slot & key_) const
     {
       return _tracks_.at(key_).get();
     }
 
     bool base_topology_pattern::has_measurement(const std::string & key_) const
     {
-      // Use key as regular expression and match over it
-      auto it = std::find_if(_meas_.begin(), _meas_.end(),
-                             [key_](const std::pair<std::string, handle_measurement> & t) -> bool {
-                               return std::regex_match(t.first, std::regex(key_));
-                             });
-      return it != _meas_.end();
+      // Unknown labels are not interned by queries
+      measurement_key a_key;
+      return measurement_key::lookup(key_, a_key) && has_measurement(a_key);
+    }
+
+    bool base_topology_pattern::has_measurement(const char * key_) const
+    {
+      return has_measurement(std::string(key_));
+    }
+
+    bool base_topology_pattern::has_measurement(const measurement_key & key_) const
+    {
+      return _meas_.find(key_) != _meas_.end();
+    }
+
+    bool base_topology_pattern::has_matching_measurement(const measurement_matcher & matcher_) const
+    {
+      for (measurement_dict_type::const_iterator i = _meas_.begin(); i != _meas_.end(); ++i) {
+        if (matcher_.match(i->first)) return true;
+      }
+      return false;
+    }
+
+    const snemo::datamodel::base_topology_measurement & base_topology_pattern::get_measurement(const measurement_key & key_) const
+    {
+      const base_topology_measurement * a_meas = _find_measurement_(key_);
+      DT_THROW_IF(a_meas == 0, std::logic_error,
+                  "Topology pattern does not hold any '" << key_ << "' measurement !");
+      return *a_meas;
+    }
+
+    const base_topology_measurement * base_topology_pattern::_find_measurement_(const measurement_key & key_) const
+    {
+      measurement_dict_type::const_iterator found = _meas_.find(key_);
+      if (found == _meas_.end() || ! found->second.has_data()) return 0;
+      _compute_pending_measurement_(key_);
+      return &found->second.get();
+    }
+
+    void base_topology_pattern::set_pending_measurement(const measurement_key & label_,
+                                                        const measurement_computation_type & computation_)
+    {
+      DT_THROW_IF(_meas_.find(label_) == _meas_.end(), std::logic_error,
+                  "Topology pattern does not hold any '" << label_ << "' measurement !");
+      _pending_[label_] = computation_;
+      _invalidate_summary();
+      return;
+    }
+
+    bool base_topology_pattern::has_pending_measurements() const
+    {
+      return ! _pending_.empty();
     }
 
-    const snemo::datamodel::base_topology_measurement & base_topology_pattern::get_measurement(const std::string & key_) const
+    void base_topology_pattern::compute_pending_measurements() const
     {
-      return _meas_.at(key_).get();
+      while (! _pending_.empty()) {
+        const measurement_key a_key = _pending_.begin()->first;
+        _compute_pending_measurement_(a_key);
+      }
+      return;
+    }
+
+    void base_topology_pattern::_compute_pending_measurement_(const measurement_key & label_) const
+    {
+      if (_pending_.empty()) return;
+      pending_dict_type::iterator found = _pending_.find(label_);
+      if (found == _pending_.end()) return;
+      // Remove the computation before running it so that it is done only once
+      const measurement_computation_type a_computation = found->second;
+      _pending_.erase(found);
+      a_computation();
+      return;
     }
 
     snemo::datamodel::base_topology_pattern::measurement_dict_type & base_topology_pattern::grab_measurement_dictionary()
     {
+      // Measurements may be changed through the returned reference
+      _invalidate_summary();
       return _meas_;
     }
 
     const snemo::datamodel::base_topology_pattern::measurement_dict_type & base_topology_pattern::get_measurement_dictionary() const
     {
+      // Every measurement handed out must have been computed
+      compute_pending_measurements();
       return _meas_;
     }
 
+    void base_topology_pattern::invalidate_summary()
+    {
+      _invalidate_summary();
+      return;
+    }
+
+    void base_topology_pattern::clear()
+    {
+      _tracks_.clear();
+      _meas_.clear();
+      _pending_.clear();
+      _invalidate_summary();
+      return;
+    }
+
+    void base_topology_pattern::_invalidate_summary()
+    {
+      return;
+    }
+
     void base_topology_pattern::tree_dump(std::ostream      & out_,
                                           const std::string & title_,
                                           const std::string & indent_,
@@ -97,7 +180,7 @@ namespace snemo {
         out_ << std::endl;
         for (snemo::datamodel::base_topology_pattern::particle_track_dict_type::const_iterator
                i = _tracks_.begin(); i != _tracks_.end(); ++i) {
-          const std::string & a_name = i->first;
+          const std::string a_name = i->first.to_string();
           const snemo::datamodel::particle_track & a_track = i->second.get();
           out_ << indent << datatools::i_tree_dumpable::skip_tag;
           snemo::datamodel::base_topology_pattern::particle_track_dict_type::const_iterator j = i;
@@ -115,6 +198,7 @@ namespace snemo {
         }
       }
 
+      compute_pending_measurements();
       {
         out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_)
              << "Associated measurements : ";
@@ -126,7 +210,7 @@ namespace snemo {
         out_ << std::endl;
         for (snemo::datamodel::base_topology_pattern::measurement_dict_type::const_iterator
                i = _meas_.begin(); i != _meas_.end(); ++i) {
-          const std::string & a_name = i->first;
+          const std::string a_name = i->first.to_string();
           const snemo::datamodel::base_topology_measurement & a_meas = i->second.get();
           out_ << indent << datatools::i_tree_dumpable::inherit_skip_tag(inherit_);
           snemo::datamodel::base_topology_pattern::measurement_dict_type::const_iterator j = i;
@@ -12,15 +12,20 @@
 // Standard library:
 #include <string>
 #include <map>
+#include <functional>
+#include <typeinfo>
 
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/i_serializable.h>
 #include <bayeux/datatools/i_tree_dump.h>
+#include <bayeux/datatools/i_clear.h>
 
 // This project:
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/base_topology_measurement.h>
+#include <falaise/snemo/datamodels/topology_keys.h>
+#include <falaise/snemo/datamodels/flat_dict.h>
 
 namespace snemo {
 
@@ -28,7 +33,8 @@ namespace snemo {
 
     /// \brief The base class of reconstructed topology
     class base_topology_pattern : public datatools::i_serializable,
-                                  public datatools::i_tree_dumpable
+                                  public datatools::i_tree_dumpable,
+                                  public datatools::i_clear
     {
     public:
 
@@ -36,7 +42,7 @@ namespace snemo {
       virtual std::string get_pattern_id() const = 0;
 
       /// Typedef to particle track dictionary
-      typedef std::map<std::string, snemo::datamodel::particle_track::handle_type> particle_track_dict_type;
+      typedef flat_dict<particle_slot, snemo::datamodel::particle_track::handle_type> particle_track_dict_type;
 
       /// Typedef to base topology pattern handle
       typedef datatools::handle<snemo::datamodel::base_topology_pattern> handle_type;
@@ -45,7 +51,7 @@ namespace snemo {
       typedef datatools::handle<base_topology_measurement> handle_measurement;
 
       /// Typedef to measurement dictionary
-      typedef std::map<std::string, handle_measurement> measurement_dict_type;
+      typedef flat_dict<measurement_key, handle_measurement> measurement_dict_type;
 
       /// Get a mutable reference to particle track dictionary
       particle_track_dict_type & grab_particle_track_dictionary();
@@ -54,43 +60,86 @@ namespace snemo {
       const particle_track_dict_type & get_particle_track_dictionary() const;
 
       /// Check if a particle track exists
-      bool has_particle_track(const std::string &) const;
+      bool has_particle_track(const particle_slot &) const;
 
       /// Get a given particle track
-      const snemo::datamodel::particle_track & get_particle_track(const std::string &) const;
+      const snemo::datamodel::particle_track & get_particle_track(const particle_slot &) const;
 
       /// Check if a measurement is available
       bool has_measurement(const std::string &) const;
 
+      /// Check if a measurement is available
+      bool has_measurement(const char *) const;
+
+      /// Check if a measurement is available
+      bool has_measurement(const measurement_key &) const;
+
+      /// Check if a measurement matching a regular expression is available
+      bool has_matching_measurement(const measurement_matcher &) const;
+
       /// Get a given measurement
-      const snemo::datamodel::base_topology_measurement & get_measurement(const std::string &) const;
+      const snemo::datamodel::base_topology_measurement & get_measurement(const measurement_key &) const;
 
       /// Check measurement data type
       template<class T>
-      bool has_measurement_as(const std::string & label_) const
+      bool has_measurement_as(const measurement_key & label_) const
       {
-        DT_THROW_IF(! has_measurement(label_),
+        const base_topology_measurement * a_meas = _find_measurement_(label_);
+        DT_THROW_IF(a_meas == 0,
                     std::logic_error,
                     "Topology pattern does not hold any '" << label_ << "' measurement !");
-        const std::type_info & ti = typeid(T);
-        const std::type_info & tf = typeid(get_measurement(label_));
-        return ti == tf;
+        return typeid(T) == typeid(*a_meas);
       }
 
       /// Get a non-mutable measurement of a given type
       template<class T>
-      const T & get_measurement_as(const std::string & label_) const
+      const T & get_measurement_as(const measurement_key & label_) const
       {
-        DT_THROW_IF(! has_measurement_as<T>(label_),
+        const base_topology_measurement * a_meas = _find_measurement_(label_);
+        DT_THROW_IF(a_meas == 0,
+                    std::logic_error,
+                    "Topology pattern does not hold any '" << label_ << "' measurement !");
+        DT_THROW_IF(typeid(T) != typeid(*a_meas),
                     std::logic_error,
                     "Invalid request on measurement data type !");
-        return dynamic_cast<const T&>(get_measurement(label_));
+        return static_cast<const T&>(*a_meas);
+      }
+
+      /// Return a measurement of a given type or 0 if missing or of another type
+      template<class T>
+      const T * find_measurement_as(const measurement_key & label_) const
+      {
+        const base_topology_measurement * a_meas = _find_measurement_(label_);
+        if (a_meas == 0 || typeid(T) != typeid(*a_meas)) return 0;
+        return static_cast<const T*>(a_meas);
       }
 
+      /// Typedef to deferred measurement computation
+      typedef std::function<void()> measurement_computation_type;
+
+      /// Defer the computation of an already attached measurement until its first access
+      ///
+      /// The computation may refer to the objects that built the pattern
+      /// (drivers, kinematics...) which must outlive it, or pending measurements
+      /// must be computed beforehand (see compute_pending_measurements).
+      /// Pending computations are not thread-safe: a pattern with pending
+      /// measurements must be accessed from one thread at a time.
+      void set_pending_measurement(const measurement_key & label_,
+                                   const measurement_computation_type & computation_);
+
+      /// Check if some measurements have not been computed yet
+      bool has_pending_measurements() const;
+
+      /// Compute all the measurements not computed yet
+      void compute_pending_measurements() const;
+
       /// Get a mutable reference to measurement dictionary
       measurement_dict_type & grab_measurement_dictionary();
 
-      /// Get a non-mutable reference to measurement dictionary
+      /// Forget the derived quantities once measurements have been filled afterwards
+      void invalidate_summary();
+
+      /// Get a non-mutable reference to measurement dictionary (pending measurements are computed first)
       const measurement_dict_type & get_measurement_dictionary() const;
 
       /// Constructor
@@ -99,16 +148,36 @@ namespace snemo {
       /// Destructor
       virtual ~base_topology_pattern();
 
+      /// Clear the particle tracks and measurements
+      virtual void clear();
+
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
                              const std::string & title_  = "",
                              const std::string & indent_ = "",
                              bool inherit_               = false) const;
 
+    protected:
+
+      /// Forget the derived quantities computed from the measurements
+      virtual void _invalidate_summary();
+
+    private:
+
+      /// Return a given measurement (computed if deferred) or 0 if missing
+      const base_topology_measurement * _find_measurement_(const measurement_key & label_) const;
+
+      /// Compute a given measurement if its computation has been deferred
+      void _compute_pending_measurement_(const measurement_key & label_) const;
+
     private:
 
-      particle_track_dict_type _tracks_; //!< Particle track dictionary
-      measurement_dict_type _meas_;      //!< Measurement dictionary
+      /// Typedef to deferred measurement computations
+      typedef flat_dict<measurement_key, measurement_computation_type> pending_dict_type;
+
+      particle_track_dict_type _tracks_;   //!< Particle track dictionary
+      measurement_dict_type _meas_;        //!< Measurement dictionary
+      mutable pending_dict_type _pending_; //!< Measurements computed at first access (not serialized, single-threaded)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
@@ -12,6 +12,7 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/string.hpp>
+#include <boost/serialization/map.hpp>
 // - Bayeux/datatools:
 #include <datatools/i_serializable.ipp>
 
@@ -23,9 +24,27 @@ namespace snemo {
     template<class Archive>
     void base_topology_pattern::serialize(Archive & ar_, const unsigned int /* version_ */)
     {
+      // Deferred measurements are stored once computed
+      compute_pending_measurements();
       ar_ & DATATOOLS_SERIALIZATION_I_SERIALIZABLE_BASE_OBJECT_NVP;
-      ar_ & boost::serialization::make_nvp("particle_tracks", _tracks_);
-      ar_ & boost::serialization::make_nvp("measurements", _meas_);
+      // Dictionaries are archived with their string labels
+      std::map<std::string, snemo::datamodel::particle_track::handle_type> tracks;
+      std::map<std::string, handle_measurement> meas;
+      if (Archive::is_saving::value) {
+        for (const auto & i : _tracks_) tracks[i.first.to_string()] = i.second;
+        for (const auto & i : _meas_) meas[i.first.to_string()] = i.second;
+      }
+      ar_ & boost::serialization::make_nvp("particle_tracks", tracks);
+      ar_ & boost::serialization::make_nvp("measurements", meas);
+      if (Archive::is_loading::value) {
+        _tracks_.clear();
+        _tracks_.reserve(tracks.size());
+        for (const auto & i : tracks) _tracks_.insert(std::make_pair(particle_slot(i.first), i.second));
+        _meas_.clear();
+        _meas_.reserve(meas.size());
+        for (const auto & i : meas) _meas_.insert(std::make_pair(measurement_key(i.first), i.second));
+        _invalidate_summary();
+      }
       return;
     }
 
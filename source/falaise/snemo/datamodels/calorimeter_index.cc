@@ -0,0 +1,190 @@
+// falaise/snemo/datamodels/calorimeter_index.cc
+
+// Ourselves:
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/i_tree_dump.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    const size_t calorimeter_index::INVALID_INDEX;
+
+    const std::string & calorimeter_index::category_label(const category_type category_)
+    {
+      static const std::string labels[NUMBER_OF_CATEGORIES] = {
+        "main_calorimeter", "x_calorimeter", "gamma_veto"
+      };
+      DT_THROW_IF(category_ >= NUMBER_OF_CATEGORIES, std::range_error,
+                  "Invalid calorimeter category (" << category_ << ") !");
+      return labels[category_];
+    }
+
+    calorimeter_index::calorimeter_index()
+    {
+      // SuperNEMO demonstrator: module, side, column, row (part is ignored)
+      _layouts_[CATEGORY_MAIN_CALORIMETER].type = 1302;
+      const boost::uint32_t main_extents[] = {1, 2, 20, 13, 0};
+      _layouts_[CATEGORY_MAIN_CALORIMETER].extents.assign(main_extents, main_extents + 5);
+      // module, side, wall, column, row
+      _layouts_[CATEGORY_X_CALORIMETER].type = 1232;
+      const boost::uint32_t xcalo_extents[] = {1, 2, 2, 2, 16};
+      _layouts_[CATEGORY_X_CALORIMETER].extents.assign(xcalo_extents, xcalo_extents + 5);
+      // module, side, wall, column
+      _layouts_[CATEGORY_GAMMA_VETO].type = 1252;
+      const boost::uint32_t gveto_extents[] = {1, 2, 2, 16};
+      _layouts_[CATEGORY_GAMMA_VETO].extents.assign(gveto_extents, gveto_extents + 4);
+      _update_offsets();
+      return;
+    }
+
+    calorimeter_index::~calorimeter_index()
+    {
+      return;
+    }
+
+    void calorimeter_index::set_layout(const category_type category_,
+                                       const boost::uint32_t geom_type_,
+                                       const std::vector<boost::uint32_t> & extents_)
+    {
+      DT_THROW_IF(category_ >= NUMBER_OF_CATEGORIES, std::range_error,
+                  "Invalid calorimeter category (" << category_ << ") !");
+      DT_THROW_IF(extents_.empty(), std::logic_error,
+                  "Missing address extents for '" << category_label(category_) << "' !");
+      _layouts_[category_].type = geom_type_;
+      _layouts_[category_].extents = extents_;
+      _update_offsets();
+      return;
+    }
+
+    void calorimeter_index::initialize(const datatools::properties & config_)
+    {
+      for (size_t i = 0; i < NUMBER_OF_CATEGORIES; ++i) {
+        const category_type a_category = static_cast<category_type>(i);
+        const std::string & a_prefix = category_label(a_category);
+        boost::uint32_t a_type = _layouts_[i].type;
+        std::vector<boost::uint32_t> some_extents = _layouts_[i].extents;
+        if (config_.has_key(a_prefix + ".type")) {
+          a_type = config_.fetch_integer(a_prefix + ".type");
+        }
+        if (config_.has_key(a_prefix + ".extents")) {
+          std::vector<int> values;
+          config_.fetch(a_prefix + ".extents", values);
+          some_extents.clear();
+          for (size_t j = 0; j < values.size(); ++j) {
+            DT_THROW_IF(values[j] < 0, std::range_error,
+                        "Invalid negative extent for '" << a_prefix << "' !");
+            some_extents.push_back(values[j]);
+          }
+        }
+        DT_THROW_IF(some_extents.empty(), std::logic_error,
+                    "Missing address extents for '" << a_prefix << "' !");
+        _layouts_[i].type = a_type;
+        _layouts_[i].extents = some_extents;
+      }
+      _update_offsets();
+      return;
+    }
+
+    size_t calorimeter_index::size() const
+    {
+      return _size_;
+    }
+
+    size_t calorimeter_index::get_number_of_blocks(const category_type category_) const
+    {
+      DT_THROW_IF(category_ >= NUMBER_OF_CATEGORIES, std::range_error,
+                  "Invalid calorimeter category (" << category_ << ") !");
+      return _layouts_[category_].size;
+    }
+
+    size_t calorimeter_index::get_index(const geomtools::geom_id & gid_) const
+    {
+      const boost::uint32_t a_type = gid_.get_type();
+      for (size_t i = 0; i < NUMBER_OF_CATEGORIES; ++i) {
+        const layout_type & a_layout = _layouts_[i];
+        if (a_layout.type != a_type) continue;
+        if (gid_.get_depth() < a_layout.extents.size()) return INVALID_INDEX;
+        size_t a_index = 0;
+        for (size_t j = 0; j < a_layout.extents.size(); ++j) {
+          const boost::uint32_t an_extent = a_layout.extents[j];
+          if (an_extent == 0) continue;
+          // Invalid and 'any' addresses are larger than any extent
+          const boost::uint32_t an_address = gid_.get(j);
+          if (an_address >= an_extent) return INVALID_INDEX;
+          a_index = a_index * an_extent + an_address;
+        }
+        return a_layout.offset + a_index;
+      }
+      return INVALID_INDEX;
+    }
+
+    bool calorimeter_index::has_index(const geomtools::geom_id & gid_) const
+    {
+      return get_index(gid_) != INVALID_INDEX;
+    }
+
+    calorimeter_index::category_type calorimeter_index::get_category(const size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _size_, std::range_error, "Invalid calorimeter index (" << index_ << ") !");
+      size_t i = 0;
+      while (index_ >= _layouts_[i].offset + _layouts_[i].size) ++i;
+      return static_cast<category_type>(i);
+    }
+
+    void calorimeter_index::tree_dump(std::ostream & out_,
+                                      const std::string & title_,
+                                      const std::string & indent_) const
+    {
+      if (! title_.empty()) out_ << indent_ << title_ << std::endl;
+      for (size_t i = 0; i < NUMBER_OF_CATEGORIES; ++i) {
+        const layout_type & a_layout = _layouts_[i];
+        out_ << indent_ << datatools::i_tree_dumpable::tag
+             << "Category '" << category_label(static_cast<category_type>(i)) << "' : type = "
+             << a_layout.type << ", offset = " << a_layout.offset
+             << ", blocks = " << a_layout.size << std::endl;
+      }
+      out_ << indent_ << datatools::i_tree_dumpable::last_tag
+           << "Number of blocks : " << _size_ << std::endl;
+      return;
+    }
+
+    void calorimeter_index::_update_offsets()
+    {
+      _size_ = 0;
+      for (size_t i = 0; i < NUMBER_OF_CATEGORIES; ++i) {
+        layout_type & a_layout = _layouts_[i];
+        a_layout.offset = _size_;
+        a_layout.size = 1;
+        for (size_t j = 0; j < a_layout.extents.size(); ++j) {
+          if (a_layout.extents[j] > 0) a_layout.size *= a_layout.extents[j];
+        }
+        for (size_t j = 0; j < i; ++j) {
+          DT_THROW_IF(_layouts_[j].type == a_layout.type, std::logic_error,
+                      "Categories '" << category_label(static_cast<category_type>(j))
+                      << "' and '" << category_label(static_cast<category_type>(i))
+                      << "' share the geometry type " << a_layout.type << " !");
+        }
+        _size_ += a_layout.size;
+      }
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,119 @@
+/// \file falaise/snemo/datamodels/calorimeter_index.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Dense index of the calorimeter blocks
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODELS_CALORIMETER_INDEX_H
+#define FALAISE_SNEMO_DATAMODELS_CALORIMETER_INDEX_H 1
+
+// Standard library:
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief Dense index of the main calorimeter, X-calorimeter and gamma veto blocks
+    ///
+    /// Each category is described by its geometry type and by the number of
+    /// values of each address of its geom_ids (0 for addresses not identifying
+    /// the block such as the part). Blocks are numbered contiguously, category
+    /// after category, so that per-event code can work with integer indexes,
+    /// bitsets and direct-index arrays. The index of a geom_id is computed
+    /// from its addresses without any lookup.
+    class calorimeter_index
+    {
+    public:
+
+      /// Calorimeter categories
+      enum category_type {
+        CATEGORY_MAIN_CALORIMETER = 0,
+        CATEGORY_X_CALORIMETER    = 1,
+        CATEGORY_GAMMA_VETO       = 2,
+        NUMBER_OF_CATEGORIES      = 3
+      };
+
+      /// Index of geom_ids not associated to a calorimeter block
+      static const size_t INVALID_INDEX = static_cast<size_t>(-1);
+
+      /// Return the configuration prefix of a category
+      static const std::string & category_label(const category_type category_);
+
+      /// Default constructor (SuperNEMO demonstrator layout)
+      calorimeter_index();
+
+      /// Destructor
+      ~calorimeter_index();
+
+      /// Set the layout of a category
+      void set_layout(const category_type category_,
+                      const boost::uint32_t geom_type_,
+                      const std::vector<boost::uint32_t> & extents_);
+
+      /// Configure the layouts from properties
+      void initialize(const datatools::properties & config_);
+
+      /// Return the total number of calorimeter blocks
+      size_t size() const;
+
+      /// Return the number of blocks of a category
+      size_t get_number_of_blocks(const category_type category_) const;
+
+      /// Return the dense index of a geom_id (INVALID_INDEX if not a calorimeter block)
+      size_t get_index(const geomtools::geom_id & gid_) const;
+
+      /// Check if a geom_id is a calorimeter block
+      bool has_index(const geomtools::geom_id & gid_) const;
+
+      /// Return the category of a dense index
+      category_type get_category(const size_t index_) const;
+
+      /// Smart print
+      void tree_dump(std::ostream & out_ = std::clog,
+                     const std::string & title_ = "",
+                     const std::string & indent_ = "") const;
+
+    protected:
+
+      /// Compute the offsets of the categories
+      void _update_offsets();
+
+    private:
+
+      /// \brief Layout of a calorimeter category
+      struct layout_type {
+        boost::uint32_t type;                  //!< Geometry type of the blocks
+        std::vector<boost::uint32_t> extents; //!< Number of values of each address (0 : not used)
+        size_t offset;                        //!< Index of the first block
+        size_t size;                          //!< Number of blocks
+      };
+
+      layout_type _layouts_[NUMBER_OF_CATEGORIES]; //!< Layouts of the categories
+      size_t _size_;                               //!< Total number of blocks
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODELS_CALORIMETER_INDEX_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,169 @@
+// falaise/snemo/datamodels/calorimeter_index_service.cc
+
+// Ourselves:
+#include <falaise/snemo/datamodels/calorimeter_index_service.h>
+
+// Standard library:
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    // Registration instantiation macro :
+    DATATOOLS_SERVICE_REGISTRATION_IMPLEMENT(calorimeter_index_service,
+                                             "snemo::datamodel::calorimeter_index_service")
+
+    calorimeter_index_service::calorimeter_index_service()
+      : datatools::base_service("calorimeter_index",
+                                "Dense index of the calorimeter blocks")
+    {
+      _initialized_ = false;
+      return;
+    }
+
+    calorimeter_index_service::~calorimeter_index_service()
+    {
+      if (is_initialized()) this->calorimeter_index_service::reset();
+      return;
+    }
+
+    bool calorimeter_index_service::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    int calorimeter_index_service::initialize(const datatools::properties & config_,
+                                              datatools::service_dict_type & /* service_dict_ */)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Service '" << get_name() << "' is already initialized !");
+      datatools::base_service::common_initialize(config_);
+      _index_.initialize(config_);
+      _initialized_ = true;
+      return EXIT_SUCCESS;
+    }
+
+    int calorimeter_index_service::reset()
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Service '" << get_name() << "' is not initialized !");
+      _initialized_ = false;
+      _index_ = calorimeter_index();
+      return EXIT_SUCCESS;
+    }
+
+    const calorimeter_index & calorimeter_index_service::get_index() const
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Service '" << get_name() << "' is not initialized !");
+      return _index_;
+    }
+
+    void calorimeter_index_service::tree_dump(std::ostream & out_,
+                                              const std::string & title_,
+                                              const std::string & indent_,
+                                              bool inherit_) const
+    {
+      this->datatools::base_service::tree_dump(out_, title_, indent_, true);
+      out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+           << "Calorimeter index : " << std::endl;
+      std::ostringstream indent_oss;
+      indent_oss << indent_ << datatools::i_tree_dumpable::inherit_skip_tag(inherit_);
+      _index_.tree_dump(out_, "", indent_oss.str());
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/* OCD support */
+#include <datatools/object_configuration_description.h>
+DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::datamodel::calorimeter_index_service, ocd_)
+{
+  ocd_.set_class_name("snemo::datamodel::calorimeter_index_service");
+  ocd_.set_class_description("A service providing the dense index of the calorimeter blocks");
+  ocd_.set_class_library("Falaise_ParticleIdentification");
+  ocd_.set_class_documentation("This service numbers the main calorimeter, X-calorimeter and gamma   \n"
+                               "veto blocks contiguously so that modules and cuts can use integer    \n"
+                               "indexes, bitsets and direct-index arrays instead of comparing or     \n"
+                               "hashing geom_ids. The index of a block is computed from the addresses \n"
+                               "of its geom_id. The default layout is the one of the SuperNEMO       \n"
+                               "demonstrator.                                                        \n");
+
+  const std::string labels[] = {"main_calorimeter", "x_calorimeter", "gamma_veto"};
+  const std::string types[]  = {"1302", "1232", "1252"};
+  const std::string extents[] = {"integer[5] = 1 2 20 13 0",
+                                 "integer[5] = 1 2 2 2 16",
+                                 "integer[4] = 1 2 2 16"};
+  for (size_t i = 0; i < 3; ++i) {
+    {
+      // Description of the '<category>.type' configuration property :
+      datatools::configuration_property_description & cpd
+        = ocd_.add_property_info();
+      cpd.set_name_pattern(labels[i] + ".type")
+        .set_terse_description("The geometry type of the '" + labels[i] + "' blocks")
+        .set_traits(datatools::TYPE_INTEGER)
+        .set_mandatory(false)
+        .set_default_value_integer(std::atoi(types[i].c_str()))
+        .add_example("Default value::                                  \n"
+                     "                                                 \n"
+                     "  " + labels[i] + ".type : integer = " + types[i] + "\n"
+                     "                                                 \n"
+                     );
+    }
+    {
+      // Description of the '<category>.extents' configuration property :
+      datatools::configuration_property_description & cpd
+        = ocd_.add_property_info();
+      cpd.set_name_pattern(labels[i] + ".extents")
+        .set_terse_description("The number of values of each address of the '" + labels[i] + "' blocks")
+        .set_traits(datatools::TYPE_INTEGER,
+                    datatools::configuration_property_description::ARRAY)
+        .set_mandatory(false)
+        .set_long_description("One value per address of the geom_id, 0 meaning that the \n"
+                              "address does not identify the block (part number).       \n")
+        .add_example("Default value::                                  \n"
+                     "                                                 \n"
+                     "  " + labels[i] + ".extents : " + extents[i] + "\n"
+                     "                                                 \n"
+                     );
+    }
+  }
+
+  // Additionnal configuration hints :
+  ocd_.set_configuration_hints("Here is a full configuration example in the            \n"
+                               "``datatools::properties`` ASCII format::               \n"
+                               "                                                       \n"
+                               "  main_calorimeter.type    : integer = 1302            \n"
+                               "  main_calorimeter.extents : integer[5] = 1 2 20 13 0  \n"
+                               "  x_calorimeter.type       : integer = 1232            \n"
+                               "  x_calorimeter.extents    : integer[5] = 1 2 2 2 16   \n"
+                               "  gamma_veto.type          : integer = 1252            \n"
+                               "  gamma_veto.extents       : integer[4] = 1 2 2 16     \n"
+                               "                                                       \n"
+                               );
+
+  ocd_.set_validation_support(true);
+  ocd_.lock();
+  return;
+}
+
+DOCD_CLASS_IMPLEMENT_LOAD_END() // Closing macro for implementation
+DOCD_CLASS_SYSTEM_REGISTRATION(snemo::datamodel::calorimeter_index_service,
+                               "snemo::datamodel::calorimeter_index_service")
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
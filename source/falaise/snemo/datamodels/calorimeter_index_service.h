@@ -0,0 +1,78 @@
+/// \file falaise/snemo/datamodels/calorimeter_index_service.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Service providing the dense index of the calorimeter blocks
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODELS_CALORIMETER_INDEX_SERVICE_H
+#define FALAISE_SNEMO_DATAMODELS_CALORIMETER_INDEX_SERVICE_H 1
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/base_service.h>
+
+// This project:
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief Service building the calorimeter index once for all the modules
+    class calorimeter_index_service : public datatools::base_service
+    {
+    public:
+
+      /// Constructor
+      calorimeter_index_service();
+
+      /// Destructor
+      virtual ~calorimeter_index_service();
+
+      /// Check initialization flag
+      virtual bool is_initialized() const;
+
+      /// Initialization
+      virtual int initialize(const datatools::properties & config_,
+                             datatools::service_dict_type & service_dict_);
+
+      /// Reset
+      virtual int reset();
+
+      /// Return the calorimeter index
+      const calorimeter_index & get_index() const;
+
+      /// Smart print
+      virtual void tree_dump(std::ostream & out_ = std::clog,
+                             const std::string & title_ = "",
+                             const std::string & indent_ = "",
+                             bool inherit_ = false) const;
+
+    private:
+
+      bool _initialized_;        //!< Initialization flag
+      calorimeter_index _index_; //!< The calorimeter index
+
+      // Registration of the service :
+      DATATOOLS_SERVICE_REGISTRATION_INTERFACE(calorimeter_index_service)
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#include <datatools/ocd_macros.h>
+
+// Declare the OCD interface of the service
+DOCD_CLASS_DECLARATION(snemo::datamodel::calorimeter_index_service)
+
+#endif // FALAISE_SNEMO_DATAMODELS_CALORIMETER_INDEX_SERVICE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -27,6 +27,13 @@ namespace snemo {
       return;
     }
 
+    void energy_measurement::clear()
+    {
+      base_topology_measurement::clear();
+      datatools::invalidate(_energy_);
+      return;
+    }
+
     bool energy_measurement::has_energy() const
     {
       return datatools::is_valid(_energy_);
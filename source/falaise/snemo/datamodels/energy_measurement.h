@@ -38,6 +38,9 @@ namespace snemo {
       /// Get a mutable reference to energy
       double & grab_energy();
 
+      /// Clear the measurement
+      virtual void clear();
+
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
                              const std::string & title_  = "",
@@ -0,0 +1,233 @@
+/** \file falaise/snemo/datamodels/event_time_measurement.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/event_time_measurement.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    // Serial tag for datatools::i_serializable interface :
+    DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(event_time_measurement,
+                                                      "snemo::datamodel::event_time_measurement")
+
+    // static
+    const std::string & event_time_measurement::measurement_label()
+    {
+      static const std::string _label("event_time");
+      return _label;
+    }
+
+    event_time_measurement::event_time_measurement()
+    {
+      datatools::invalidate(_t0_);
+      datatools::invalidate(_sigma_t0_);
+      datatools::invalidate(_internal_chi2_);
+      datatools::invalidate(_internal_probability_);
+      datatools::invalidate(_external_t0_);
+      datatools::invalidate(_external_chi2_);
+      datatools::invalidate(_external_probability_);
+      return;
+    }
+
+    event_time_measurement::~event_time_measurement()
+    {
+      return;
+    }
+
+    const event_time_measurement::label_collection_type & event_time_measurement::get_particle_labels() const
+    {
+      return _particle_labels_;
+    }
+
+    event_time_measurement::label_collection_type & event_time_measurement::grab_particle_labels()
+    {
+      return _particle_labels_;
+    }
+
+    unsigned int event_time_measurement::get_ndof() const
+    {
+      return _particle_labels_.empty() ? 0 : _particle_labels_.size() - 1;
+    }
+
+    bool event_time_measurement::has_internal_fit() const
+    {
+      return datatools::is_valid(_internal_chi2_);
+    }
+
+    void event_time_measurement::set_internal_fit(const double t0_, const double sigma_t0_,
+                                                  const double chi2_, const double probability_)
+    {
+      _t0_ = t0_;
+      _sigma_t0_ = sigma_t0_;
+      _internal_chi2_ = chi2_;
+      _internal_probability_ = probability_;
+      return;
+    }
+
+    double event_time_measurement::get_t0() const
+    {
+      return _t0_;
+    }
+
+    double event_time_measurement::get_sigma_t0() const
+    {
+      return _sigma_t0_;
+    }
+
+    double event_time_measurement::get_internal_chi2() const
+    {
+      return _internal_chi2_;
+    }
+
+    double event_time_measurement::get_internal_probability() const
+    {
+      return _internal_probability_;
+    }
+
+    const event_time_measurement::pull_collection_type & event_time_measurement::get_internal_pulls() const
+    {
+      return _internal_pulls_;
+    }
+
+    event_time_measurement::pull_collection_type & event_time_measurement::grab_internal_pulls()
+    {
+      return _internal_pulls_;
+    }
+
+    bool event_time_measurement::has_external_fit() const
+    {
+      return datatools::is_valid(_external_chi2_);
+    }
+
+    void event_time_measurement::set_external_fit(const double t0_, const double chi2_,
+                                                  const double probability_)
+    {
+      _external_t0_ = t0_;
+      _external_chi2_ = chi2_;
+      _external_probability_ = probability_;
+      return;
+    }
+
+    double event_time_measurement::get_external_t0() const
+    {
+      return _external_t0_;
+    }
+
+    double event_time_measurement::get_external_chi2() const
+    {
+      return _external_chi2_;
+    }
+
+    double event_time_measurement::get_external_probability() const
+    {
+      return _external_probability_;
+    }
+
+    const event_time_measurement::pull_collection_type & event_time_measurement::get_external_pulls() const
+    {
+      return _external_pulls_;
+    }
+
+    event_time_measurement::pull_collection_type & event_time_measurement::grab_external_pulls()
+    {
+      return _external_pulls_;
+    }
+
+    void event_time_measurement::set_incoming_particle(const std::string & label_)
+    {
+      _incoming_particle_ = label_;
+      return;
+    }
+
+    const std::string & event_time_measurement::get_incoming_particle() const
+    {
+      return _incoming_particle_;
+    }
+
+    void event_time_measurement::clear()
+    {
+      base_topology_measurement::clear();
+      _particle_labels_.clear();
+      datatools::invalidate(_t0_);
+      datatools::invalidate(_sigma_t0_);
+      datatools::invalidate(_internal_chi2_);
+      datatools::invalidate(_internal_probability_);
+      _internal_pulls_.clear();
+      datatools::invalidate(_external_t0_);
+      datatools::invalidate(_external_chi2_);
+      datatools::invalidate(_external_probability_);
+      _external_pulls_.clear();
+      _incoming_particle_.clear();
+      return;
+    }
+
+    void event_time_measurement::tree_dump(std::ostream      & out_,
+                                           const std::string & title_,
+                                           const std::string & indent_,
+                                           bool inherit_) const
+    {
+      std::string indent;
+      if (! indent_.empty ()) indent = indent_;
+      base_topology_measurement::tree_dump(out_, title_, indent_, true);
+
+      out_ << indent << datatools::i_tree_dumpable::tag
+           << "Particles: " << _particle_labels_.size() << std::endl;
+
+      out_ << indent << datatools::i_tree_dumpable::tag
+           << "Internal fit: ";
+      if (has_internal_fit()) {
+        out_ << "t0 = " << _t0_/CLHEP::ns << " +/- " << _sigma_t0_/CLHEP::ns << " ns, "
+             << "chi2 = " << _internal_chi2_ << "/" << get_ndof() << ", "
+             << "P = " << _internal_probability_/CLHEP::perCent << "%" << std::endl;
+      } else {
+        out_ << "<no value>" << std::endl;
+      }
+      for (size_t i = 0; i < _internal_pulls_.size(); i++) {
+        out_ << indent << datatools::i_tree_dumpable::skip_tag;
+        if (i + 1 == _internal_pulls_.size()) {
+          out_ << datatools::i_tree_dumpable::last_tag;
+        } else {
+          out_ << datatools::i_tree_dumpable::tag;
+        }
+        out_ << "Pull '" << _particle_labels_.at(i) << "' = " << _internal_pulls_.at(i) << std::endl;
+      }
+
+      out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_)
+           << "External fit: ";
+      if (has_external_fit()) {
+        out_ << "incoming '" << _incoming_particle_ << "', "
+             << "t0 = " << _external_t0_/CLHEP::ns << " ns, "
+             << "chi2 = " << _external_chi2_ << "/" << get_ndof() << ", "
+             << "P = " << _external_probability_/CLHEP::perCent << "%" << std::endl;
+      } else {
+        out_ << "<no value>" << std::endl;
+      }
+      for (size_t i = 0; i < _external_pulls_.size(); i++) {
+        out_ << indent << datatools::i_tree_dumpable::inherit_skip_tag(inherit_);
+        if (i + 1 == _external_pulls_.size()) {
+          out_ << datatools::i_tree_dumpable::last_tag;
+        } else {
+          out_ << datatools::i_tree_dumpable::tag;
+        }
+        out_ << "Pull '" << _particle_labels_.at(i) << "' = " << _external_pulls_.at(i) << std::endl;
+      }
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
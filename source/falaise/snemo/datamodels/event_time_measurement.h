@@ -0,0 +1,154 @@
+/// \file falaise/snemo/datamodels/event_time_measurement.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: The event time measurement
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_EVENT_TIME_MEASUREMENT_H
+#define FALAISE_SNEMO_DATAMODEL_EVENT_TIME_MEASUREMENT_H 1
+
+// Standard library:
+#include <string>
+#include <vector>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief The event time measurement
+    ///
+    /// Result of the fit of a common time over all the particles of an event,
+    /// given their measured calorimeter times and their theoretical times of
+    /// flight:
+    ///  - internal hypothesis : all the particles are emitted at the same
+    ///    time t0 from the event vertex;
+    ///  - external hypothesis : the first particle to hit a calorimeter
+    ///    travels backward to the event vertex, which it crosses at the time
+    ///    t0, where the other particles are emitted.
+    /// Pulls are stored per particle, in the order of the particle labels.
+    class event_time_measurement : public base_topology_measurement {
+    public:
+
+      /// Typedef for particle labels
+      typedef std::vector<std::string> label_collection_type;
+
+      /// Typedef for pulls
+      typedef std::vector<double> pull_collection_type;
+
+      /// Label of the measurement within topology patterns
+      static const std::string & measurement_label();
+
+      /// Constructor
+      event_time_measurement();
+
+      /// Destructor
+      ~event_time_measurement();
+
+      /// Return the labels of the fitted particles
+      const label_collection_type & get_particle_labels() const;
+
+      /// Return the mutable labels of the fitted particles
+      label_collection_type & grab_particle_labels();
+
+      /// Return the number of degrees of freedom
+      unsigned int get_ndof() const;
+
+      /// Check if the internal fit is available
+      bool has_internal_fit() const;
+
+      /// Set the internal fit results
+      void set_internal_fit(const double t0_, const double sigma_t0_,
+                            const double chi2_, const double probability_);
+
+      /// Return the fitted emission time
+      double get_t0() const;
+
+      /// Return the uncertainty on the fitted emission time
+      double get_sigma_t0() const;
+
+      /// Return the internal chi2
+      double get_internal_chi2() const;
+
+      /// Return the internal probability
+      double get_internal_probability() const;
+
+      /// Return the internal pulls
+      const pull_collection_type & get_internal_pulls() const;
+
+      /// Return the mutable internal pulls
+      pull_collection_type & grab_internal_pulls();
+
+      /// Check if the external fit is available
+      bool has_external_fit() const;
+
+      /// Set the external fit results
+      void set_external_fit(const double t0_, const double chi2_, const double probability_);
+
+      /// Return the fitted crossing time of the external hypothesis
+      double get_external_t0() const;
+
+      /// Return the external chi2
+      double get_external_chi2() const;
+
+      /// Return the external probability
+      double get_external_probability() const;
+
+      /// Return the external pulls
+      const pull_collection_type & get_external_pulls() const;
+
+      /// Return the mutable external pulls
+      pull_collection_type & grab_external_pulls();
+
+      /// Set the label of the incoming particle of the external hypothesis
+      void set_incoming_particle(const std::string & label_);
+
+      /// Return the label of the incoming particle of the external hypothesis
+      const std::string & get_incoming_particle() const;
+
+      /// Clear the measurement
+      virtual void clear();
+
+      /// Smart print
+      virtual void tree_dump(std::ostream      & out_    = std::clog,
+                             const std::string & title_  = "",
+                             const std::string & indent_ = "",
+                             bool inherit_               = false) const;
+
+    private:
+
+      label_collection_type _particle_labels_; //!< Labels of the fitted particles
+      double _t0_;                             //!< Fitted emission time
+      double _sigma_t0_;                       //!< Uncertainty on the emission time
+      double _internal_chi2_;                  //!< Internal chi2
+      double _internal_probability_;           //!< Internal probability
+      pull_collection_type _internal_pulls_;   //!< Internal pulls
+      double _external_t0_;                    //!< Fitted crossing time
+      double _external_chi2_;                  //!< External chi2
+      double _external_probability_;           //!< External probability
+      pull_collection_type _external_pulls_;   //!< External pulls
+      std::string _incoming_particle_;         //!< Incoming particle of the external hypothesis
+
+      DATATOOLS_SERIALIZATION_DECLARATION()
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#include <boost/serialization/export.hpp>
+BOOST_CLASS_EXPORT_KEY2(snemo::datamodel::event_time_measurement,
+                        "snemo::datamodel::event_time_measurement")
+
+#endif // FALAISE_SNEMO_DATAMODEL_EVENT_TIME_MEASUREMENT_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,49 @@
+// -*- mode: c++ ; -*-
+/// \file falaise/snemo/datamodels/event_time_measurement.ipp
+
+#ifndef FALAISE_SNEMO_DATAMODEL_EVENT_TIME_MEASUREMENT_IPP
+#define FALAISE_SNEMO_DATAMODEL_EVENT_TIME_MEASUREMENT_IPP 1
+
+// Ourselves:
+#include <falaise/snemo/datamodels/event_time_measurement.h>
+
+// Third party:
+// - Boost:
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+// - Bayeux/datatools:
+#include <datatools/i_serializable.ipp>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_measurement.ipp>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// Serialization method
+    template<class Archive>
+    void event_time_measurement::serialize(Archive & ar_, const unsigned int /* version_ */)
+    {
+      ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_topology_measurement);
+      ar_ & boost::serialization::make_nvp("particle_labels", _particle_labels_);
+      ar_ & boost::serialization::make_nvp("t0", _t0_);
+      ar_ & boost::serialization::make_nvp("sigma_t0", _sigma_t0_);
+      ar_ & boost::serialization::make_nvp("internal_chi2", _internal_chi2_);
+      ar_ & boost::serialization::make_nvp("internal_probability", _internal_probability_);
+      ar_ & boost::serialization::make_nvp("internal_pulls", _internal_pulls_);
+      ar_ & boost::serialization::make_nvp("external_t0", _external_t0_);
+      ar_ & boost::serialization::make_nvp("external_chi2", _external_chi2_);
+      ar_ & boost::serialization::make_nvp("external_probability", _external_probability_);
+      ar_ & boost::serialization::make_nvp("external_pulls", _external_pulls_);
+      ar_ & boost::serialization::make_nvp("incoming_particle", _incoming_particle_);
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_EVENT_TIME_MEASUREMENT_IPP
@@ -0,0 +1,171 @@
+/// \file falaise/snemo/datamodels/flat_dict.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: A dictionary stored as a sorted contiguous array
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_FLAT_DICT_H
+#define FALAISE_SNEMO_DATAMODEL_FLAT_DICT_H 1
+
+// Standard library:
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief Dictionary stored as a vector of (key, value) pairs sorted by key
+    ///
+    /// Topology patterns hold a handful of entries: a sorted contiguous
+    /// array is faster to walk than a node based map and the subset of the
+    /// std::map interface provided here is enough for the patterns and the
+    /// builders. Iterators are invalidated by insertion and removal.
+    template<class Key, class T>
+    class flat_dict
+    {
+    public:
+
+      typedef Key key_type;
+      typedef T mapped_type;
+      typedef std::pair<Key, T> value_type;
+      typedef typename std::vector<value_type>::iterator iterator;
+      typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+      iterator begin() { return _items_.begin(); }
+      iterator end() { return _items_.end(); }
+      const_iterator begin() const { return _items_.begin(); }
+      const_iterator end() const { return _items_.end(); }
+
+      /// Return the number of entries
+      size_t size() const { return _items_.size(); }
+
+      /// Check if the dictionary has no entry
+      bool empty() const { return _items_.empty(); }
+
+      /// Remove all the entries
+      void clear() { _items_.clear(); }
+
+      /// Reserve memory for a given number of entries
+      void reserve(const size_t n_) { _items_.reserve(n_); }
+
+      /// Find the entry with a given key
+      iterator find(const Key & key_)
+      {
+        iterator it = _lower_bound_(key_);
+        if (it != _items_.end() && it->first == key_) return it;
+        return _items_.end();
+      }
+
+      /// Find the entry with a given key
+      const_iterator find(const Key & key_) const
+      {
+        const_iterator it = _lower_bound_(key_);
+        if (it != _items_.end() && it->first == key_) return it;
+        return _items_.end();
+      }
+
+      /// Return the number of entries with a given key (0 or 1)
+      size_t count(const Key & key_) const
+      {
+        return find(key_) != _items_.end() ? 1 : 0;
+      }
+
+      /// Return the value associated to a given key
+      T & at(const Key & key_)
+      {
+        iterator it = find(key_);
+        if (it == _items_.end()) throw std::out_of_range("flat_dict::at");
+        return it->second;
+      }
+
+      /// Return the value associated to a given key
+      const T & at(const Key & key_) const
+      {
+        const_iterator it = find(key_);
+        if (it == _items_.end()) throw std::out_of_range("flat_dict::at");
+        return it->second;
+      }
+
+      /// Return the value associated to a given key, inserting a default one if missing
+      T & operator[](const Key & key_)
+      {
+        iterator it = _lower_bound_(key_);
+        if (it == _items_.end() || ! (it->first == key_)) {
+          it = _items_.insert(it, value_type(key_, T()));
+        }
+        return it->second;
+      }
+
+      /// Insert an entry if its key is not already present
+      std::pair<iterator, bool> insert(const value_type & value_)
+      {
+        iterator it = _lower_bound_(value_.first);
+        if (it != _items_.end() && it->first == value_.first) {
+          return std::make_pair(it, false);
+        }
+        it = _items_.insert(it, value_);
+        return std::make_pair(it, true);
+      }
+
+      /// Insert an entry converted from a pair if its key is not already present
+      template<class P>
+      std::pair<iterator, bool> insert(const P & value_)
+      {
+        return insert(value_type(value_));
+      }
+
+      /// Remove the entry with a given key
+      size_t erase(const Key & key_)
+      {
+        iterator it = find(key_);
+        if (it == _items_.end()) return 0;
+        _items_.erase(it);
+        return 1;
+      }
+
+      /// Remove the entry at a given position
+      iterator erase(iterator it_)
+      {
+        return _items_.erase(it_);
+      }
+
+    private:
+
+      /// Compare an entry with a key
+      static bool _less_key_(const value_type & value_, const Key & key_)
+      {
+        return value_.first < key_;
+      }
+
+      iterator _lower_bound_(const Key & key_)
+      {
+        return std::lower_bound(_items_.begin(), _items_.end(), key_, &flat_dict::_less_key_);
+      }
+
+      const_iterator _lower_bound_(const Key & key_) const
+      {
+        return std::lower_bound(_items_.begin(), _items_.end(), key_, &flat_dict::_less_key_);
+      }
+
+    private:
+
+      std::vector<value_type> _items_; //!< Entries sorted by key
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_FLAT_DICT_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
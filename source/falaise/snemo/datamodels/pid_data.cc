@@ -0,0 +1,148 @@
+// pid_data.cc
+
+// Ourselves:
+#include <falaise/snemo/datamodels/pid_data.h>
+
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    pid_data::pid_data()
+    {
+      clear();
+      return;
+    }
+
+    pid_data::~pid_data()
+    {
+      return;
+    }
+
+    void pid_data::reset(const size_t nparticles_)
+    {
+      clear();
+      _types_.assign(nparticles_, pid_utils::PARTICLE_UNDEFINED);
+      return;
+    }
+
+    size_t pid_data::get_number_of_particles() const
+    {
+      return _types_.size();
+    }
+
+    void pid_data::set_particle_type(const size_t index_, const pid_utils::particle_type type_)
+    {
+      DT_THROW_IF(index_ >= _types_.size(), std::range_error,
+                  "Invalid particle index (" << index_ << ") !");
+      _types_[index_] = type_;
+      return;
+    }
+
+    pid_utils::particle_type pid_data::get_particle_type(const size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _types_.size(), std::range_error,
+                  "Invalid particle index (" << index_ << ") !");
+      return static_cast<pid_utils::particle_type>(_types_[index_]);
+    }
+
+    bool pid_data::particle_is(const size_t index_, const pid_utils::particle_type type_) const
+    {
+      return get_particle_type(index_) == type_;
+    }
+
+    void pid_data::increment_particle_count(const pid_utils::particle_type type_)
+    {
+      _counts_[type_]++;
+      return;
+    }
+
+    void pid_data::set_particle_count(const pid_utils::particle_type type_, const size_t count_)
+    {
+      _counts_[type_] = count_;
+      return;
+    }
+
+    size_t pid_data::get_particle_count(const pid_utils::particle_type type_) const
+    {
+      return _counts_[type_];
+    }
+
+    pid_utils::classification_code_type pid_data::get_classification_code() const
+    {
+      return pid_utils::make_classification_code(_counts_[pid_utils::PARTICLE_ELECTRON],
+                                                 _counts_[pid_utils::PARTICLE_POSITRON],
+                                                 _counts_[pid_utils::PARTICLE_GAMMA],
+                                                 _counts_[pid_utils::PARTICLE_ALPHA],
+                                                 _counts_[pid_utils::PARTICLE_UNDEFINED]);
+    }
+
+    std::string pid_data::get_classification_label() const
+    {
+      return pid_utils::make_classification_label(_counts_[pid_utils::PARTICLE_ELECTRON],
+                                                  _counts_[pid_utils::PARTICLE_POSITRON],
+                                                  _counts_[pid_utils::PARTICLE_GAMMA],
+                                                  _counts_[pid_utils::PARTICLE_ALPHA],
+                                                  _counts_[pid_utils::PARTICLE_UNDEFINED]);
+    }
+
+    void pid_data::clear()
+    {
+      _types_.clear();
+      for (size_t i = 0; i < pid_utils::NUMBER_OF_PARTICLE_TYPES; ++i) {
+        _counts_[i] = 0;
+      }
+      return;
+    }
+
+    void pid_data::tree_dump(std::ostream      & out_,
+                             const std::string & title_,
+                             const std::string & indent_,
+                             bool inherit_) const
+    {
+      std::string indent;
+      if (! indent_.empty()) {
+        indent = indent_;
+      }
+      if (! title_.empty()) {
+        out_ << indent << title_ << std::endl;
+      }
+
+      out_ << indent << datatools::i_tree_dumpable::tag
+           << "Particle types : ";
+      if (_types_.empty()) {
+        out_ << "<none>";
+      }
+      for (size_t i = 0; i < _types_.size(); ++i) {
+        out_ << pid_utils::classification_symbol(get_particle_type(i));
+      }
+      out_ << std::endl;
+
+      out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_)
+           << "Classification : '"
+           << get_classification_label() << "'"
+           << std::endl;
+
+      return;
+    }
+
+    // serial tag for datatools::serialization::i_serializable interface :
+    DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(pid_data, "snemo::datamodel::pid_data")
+
+  } // end of namespace model
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,113 @@
+/// \file falaise/snemo/datamodels/pid_data.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: SuperNEMO particle identification data model
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODELS_PID_DATA_H
+#define FALAISE_SNEMO_DATAMODELS_PID_DATA_H 1
+
+// Standard library:
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/i_serializable.h>
+#include <bayeux/datatools/i_tree_dump.h>
+#include <bayeux/datatools/i_clear.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief SuperNEMO particle identification data model
+    ///
+    /// Holds the particle type of every particle of the particle track data
+    /// bank (in the same order) and the number of particles of each type.
+    /// It is filled once by the particle identification driver and read by
+    /// the topology builders, the measurement drivers and the PID cuts.
+    class pid_data : public datatools::i_serializable,
+                     public datatools::i_tree_dumpable,
+                     public datatools::i_clear
+    {
+    public:
+
+      /// Default constructor
+      pid_data();
+
+      /// Destructor
+      virtual ~pid_data();
+
+      /// Reset the bank for a given number of particles (all undefined, no count)
+      void reset(const size_t nparticles_);
+
+      /// Return the number of particles
+      size_t get_number_of_particles() const;
+
+      /// Set the type of a given particle
+      void set_particle_type(const size_t index_, const pid_utils::particle_type type_);
+
+      /// Return the type of a given particle
+      pid_utils::particle_type get_particle_type(const size_t index_) const;
+
+      /// Check the type of a given particle
+      bool particle_is(const size_t index_, const pid_utils::particle_type type_) const;
+
+      /// Increment the number of particles of a given type
+      void increment_particle_count(const pid_utils::particle_type type_);
+
+      /// Set the number of particles of a given type
+      void set_particle_count(const pid_utils::particle_type type_, const size_t count_);
+
+      /// Return the number of particles of a given type
+      size_t get_particle_count(const pid_utils::particle_type type_) const;
+
+      /// Return the classification code built from the particle counts
+      pid_utils::classification_code_type get_classification_code() const;
+
+      /// Return the classification label built from the particle counts
+      std::string get_classification_label() const;
+
+      /// Clear the object
+      virtual void clear();
+
+      /// Smart print
+      virtual void tree_dump(std::ostream      & out_    = std::clog,
+                             const std::string & title_  = "",
+                             const std::string & indent_ = "",
+                             bool inherit_               = false) const;
+
+    private :
+
+      std::vector<boost::uint8_t> _types_;                          //!< Particle types
+      boost::uint32_t _counts_[pid_utils::NUMBER_OF_PARTICLE_TYPES]; //!< Particle counts per type
+
+      DATATOOLS_SERIALIZATION_DECLARATION()
+
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#include <boost/serialization/export.hpp>
+BOOST_CLASS_EXPORT_KEY2(snemo::datamodel::pid_data, "snemo::datamodel::pid_data")
+
+#endif // FALAISE_SNEMO_DATAMODELS_PID_DATA_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
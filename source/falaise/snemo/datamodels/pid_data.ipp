@@ -0,0 +1,35 @@
+// -*- mode: c++ ; -*-
+/// \file falaise/snemo/datamodels/pid_data.ipp
+
+#ifndef FALAISE_SNEMO_DATAMODEL_PID_DATA_IPP
+#define FALAISE_SNEMO_DATAMODEL_PID_DATA_IPP 1
+
+// Ourselves:
+#include <falaise/snemo/datamodels/pid_data.h>
+
+// Third party:
+// - Boost:
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+// - Bayeux/datatools:
+#include <datatools/i_serializable.ipp>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    template<class Archive>
+    void pid_data::serialize(Archive & ar_, const unsigned int /*version_*/)
+    {
+      ar_ & DATATOOLS_SERIALIZATION_I_SERIALIZABLE_BASE_OBJECT_NVP;
+      ar_ & boost::serialization::make_nvp("types", _types_);
+      ar_ & boost::serialization::make_nvp("counts", _counts_);
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_PID_DATA_IPP
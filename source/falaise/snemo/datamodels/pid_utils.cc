@@ -4,10 +4,24 @@
 // Ourselves:
 #include <falaise/snemo/datamodels/pid_utils.h>
 
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_data.h>
+
 namespace snemo {
 
   namespace datamodel {
 
+    const unsigned int pid_utils::CLASSIFICATION_COUNT_BITS;
+    const size_t pid_utils::CLASSIFICATION_COUNT_MAX;
+    const size_t pid_utils::CLASSIFICATION_COUNT_OVERFLOW;
+
     const std::string & pid_utils::pid_prefix_key()
     {
       static const std::string s("pid_utils");
@@ -28,6 +42,13 @@ namespace snemo {
       return s;
     }
 
+    const std::string & pid_utils::classification_code_key()
+    {
+      static const std::string s(snemo::datamodel::pid_utils::pid_prefix_key() +
+                                 ".classification_code");
+      return s;
+    }
+
     const std::string & pid_utils::electron_label()
     {
       static const std::string s("electron");
@@ -58,6 +79,164 @@ namespace snemo {
       return s;
     }
 
+    const std::string & pid_utils::classification_symbol(const particle_type type_)
+    {
+      static const std::string symbols[NUMBER_OF_PARTICLE_TYPES] = {"e", "p", "g", "a", "X"};
+      DT_THROW_IF(type_ >= NUMBER_OF_PARTICLE_TYPES, std::logic_error,
+                  "Invalid particle type '" << type_ << "' !");
+      return symbols[type_];
+    }
+
+    pid_utils::classification_code_type pid_utils::make_classification_code(const size_t n_electrons_,
+                                                                            const size_t n_positrons_,
+                                                                            const size_t n_gammas_,
+                                                                            const size_t n_alphas_,
+                                                                            const size_t n_undefined_)
+    {
+      const size_t counts[NUMBER_OF_PARTICLE_TYPES] = {n_electrons_, n_positrons_, n_gammas_, n_alphas_, n_undefined_};
+      classification_code_type code = 0;
+      for (size_t i = 0; i < NUMBER_OF_PARTICLE_TYPES; ++i) {
+        const classification_code_type n
+          = (counts[i] > CLASSIFICATION_COUNT_MAX ? CLASSIFICATION_COUNT_OVERFLOW : counts[i]);
+        code |= n << (i * CLASSIFICATION_COUNT_BITS);
+      }
+      return code;
+    }
+
+    size_t pid_utils::get_particle_count(const classification_code_type code_, const particle_type type_)
+    {
+      return (code_ >> (type_ * CLASSIFICATION_COUNT_BITS)) & CLASSIFICATION_COUNT_OVERFLOW;
+    }
+
+    bool pid_utils::is_overflow_classification_code(const classification_code_type code_)
+    {
+      for (size_t i = 0; i < NUMBER_OF_PARTICLE_TYPES; ++i) {
+        if (get_particle_count(code_, static_cast<particle_type>(i)) == CLASSIFICATION_COUNT_OVERFLOW) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    std::string pid_utils::make_classification_label(const size_t n_electrons_,
+                                                     const size_t n_positrons_,
+                                                     const size_t n_gammas_,
+                                                     const size_t n_alphas_,
+                                                     const size_t n_undefined_)
+    {
+      const size_t counts[NUMBER_OF_PARTICLE_TYPES] = {n_electrons_, n_positrons_, n_gammas_, n_alphas_, n_undefined_};
+      std::string label;
+      for (size_t i = 0; i < NUMBER_OF_PARTICLE_TYPES; ++i) {
+        if (counts[i] == 0) continue;
+        label += std::to_string(counts[i]);
+        label += classification_symbol(static_cast<particle_type>(i));
+      }
+      return label;
+    }
+
+    std::string pid_utils::classification_label(const classification_code_type code_)
+    {
+      DT_THROW_IF(is_overflow_classification_code(code_), std::range_error,
+                  "Classification code " << code_ << " has overflowed, the label must be built from the particle counts !");
+      return make_classification_label(get_particle_count(code_, PARTICLE_ELECTRON),
+                                       get_particle_count(code_, PARTICLE_POSITRON),
+                                       get_particle_count(code_, PARTICLE_GAMMA),
+                                       get_particle_count(code_, PARTICLE_ALPHA),
+                                       get_particle_count(code_, PARTICLE_UNDEFINED));
+    }
+
+    bool pid_utils::parse_classification_label(const std::string & label_, classification_code_type & code_)
+    {
+      size_t counts[NUMBER_OF_PARTICLE_TYPES] = {0, 0, 0, 0, 0};
+      size_t n = 0;
+      for (size_t i = 0; i < label_.size(); ++i) {
+        const char c = label_[i];
+        if (c >= '0' && c <= '9') {
+          n = 10 * n + (c - '0');
+          if (n > CLASSIFICATION_COUNT_MAX) return false;
+          continue;
+        }
+        size_t type = 0;
+        for (; type < NUMBER_OF_PARTICLE_TYPES; ++type) {
+          if (classification_symbol(static_cast<particle_type>(type))[0] == c) break;
+        }
+        if (type == NUMBER_OF_PARTICLE_TYPES || n == 0) return false;
+        counts[type] = n;
+        n = 0;
+      }
+      if (n != 0) return false;
+      const classification_code_type a_code
+        = make_classification_code(counts[PARTICLE_ELECTRON], counts[PARTICLE_POSITRON],
+                                   counts[PARTICLE_GAMMA], counts[PARTICLE_ALPHA],
+                                   counts[PARTICLE_UNDEFINED]);
+      // Only canonical labels i.e. types in order without repetition
+      if (classification_label(a_code) != label_) return false;
+      code_ = a_code;
+      return true;
+    }
+
+    void pid_utils::fetch_particle_counts(const snemo::datamodel::particle_track_data & ptd_,
+                                          size_t counts_[NUMBER_OF_PARTICLE_TYPES])
+    {
+      const datatools::properties & aux = ptd_.get_auxiliaries();
+      const std::string * labels[NUMBER_OF_PARTICLE_TYPES] = {
+        &electron_label(), &positron_label(), &gamma_label(), &alpha_label(), &undefined_label()
+      };
+      for (size_t i = 0; i < NUMBER_OF_PARTICLE_TYPES; ++i) {
+        counts_[i] = aux.has_key(*labels[i]) ? aux.fetch_integer(*labels[i]) : 0;
+      }
+      return;
+    }
+
+    pid_utils::classification_code_type pid_utils::fetch_classification_code(const snemo::datamodel::particle_track_data & ptd_)
+    {
+      size_t counts[NUMBER_OF_PARTICLE_TYPES];
+      fetch_particle_counts(ptd_, counts);
+      return make_classification_code(counts[PARTICLE_ELECTRON], counts[PARTICLE_POSITRON],
+                                      counts[PARTICLE_GAMMA], counts[PARTICLE_ALPHA],
+                                      counts[PARTICLE_UNDEFINED]);
+    }
+
+    pid_utils::particle_type pid_utils::particle_type_from_label(const std::string & label_)
+    {
+      if (label_ == electron_label()) return PARTICLE_ELECTRON;
+      if (label_ == positron_label()) return PARTICLE_POSITRON;
+      if (label_ == gamma_label())    return PARTICLE_GAMMA;
+      if (label_ == alpha_label())    return PARTICLE_ALPHA;
+      return PARTICLE_UNDEFINED;
+    }
+
+    pid_utils::particle_type pid_utils::fetch_particle_type(const particle_track & pt_)
+    {
+      const datatools::properties & aux = pt_.get_auxiliaries();
+      if (! aux.has_key(pid_label_key())) {
+        DT_LOG_WARNING(datatools::logger::PRIO_ALWAYS,
+                       "Missing '" << pid_label_key() << "' property !");
+        return PARTICLE_UNDEFINED;
+      }
+      return particle_type_from_label(aux.fetch_string(pid_label_key()));
+    }
+
+    void pid_utils::fetch_pid_data(const snemo::datamodel::particle_track_data & ptd_,
+                                   snemo::datamodel::pid_data & pid_)
+    {
+      const size_t nparticles = ptd_.has_particles() ? ptd_.get_particles().size() : 0;
+      pid_.reset(nparticles);
+      for (size_t i = 0; i < nparticles; ++i) {
+        const particle_track & a_particle = ptd_.get_particles()[i].get();
+        const datatools::properties & aux = a_particle.get_auxiliaries();
+        if (! aux.has_key(pid_label_key())) continue;
+        pid_.set_particle_type(i, particle_type_from_label(aux.fetch_string(pid_label_key())));
+      }
+      // Counts are taken as is since they may not fit in a classification code
+      size_t counts[NUMBER_OF_PARTICLE_TYPES];
+      fetch_particle_counts(ptd_, counts);
+      for (size_t i = 0; i < NUMBER_OF_PARTICLE_TYPES; ++i) {
+        pid_.set_particle_count(static_cast<particle_type>(i), counts[i]);
+      }
+      return;
+    }
+
     bool pid_utils::particle_is(const particle_track & pt_, const std::string & label_)
     {
       const datatools::properties & aux = pt_.get_auxiliaries();
@@ -11,6 +11,10 @@
 // Standard library:
 #include <string>
 
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+
 // - Falaise:
 #include <falaise/snemo/datamodels/particle_track_data.h>
 
@@ -18,8 +22,33 @@ namespace snemo {
 
   namespace datamodel {
 
+    class pid_data;
+
     struct pid_utils {
 
+      /// Particle types entering the event classification
+      enum particle_type {
+        PARTICLE_ELECTRON  = 0,
+        PARTICLE_POSITRON  = 1,
+        PARTICLE_GAMMA     = 2,
+        PARTICLE_ALPHA     = 3,
+        PARTICLE_UNDEFINED = 4,
+        NUMBER_OF_PARTICLE_TYPES = 5
+      };
+
+      /// Typedef for the compact classification code i.e. particle counts
+      /// packed into an integer
+      typedef uint32_t classification_code_type;
+
+      /// Number of bits used to store each particle count in a classification code
+      static const unsigned int CLASSIFICATION_COUNT_BITS = 6;
+
+      /// Maximal particle count stored in a classification code
+      static const size_t CLASSIFICATION_COUNT_MAX = (1 << CLASSIFICATION_COUNT_BITS) - 2;
+
+      /// Count field of a particle type whose count exceeds CLASSIFICATION_COUNT_MAX
+      static const size_t CLASSIFICATION_COUNT_OVERFLOW = (1 << CLASSIFICATION_COUNT_BITS) - 1;
+
       /// The default prefix value for all pid_utils property keys
       static const std::string & pid_prefix_key();
 
@@ -29,6 +58,9 @@ namespace snemo {
       /// The name of a string property representing the classification label
       static const std::string & classification_label_key();
 
+      /// The name of an integer property representing the classification code
+      static const std::string & classification_code_key();
+
       /// The label of electron particle
       static const std::string & electron_label();
 
@@ -44,6 +76,55 @@ namespace snemo {
       /// The label of undefined particle
       static const std::string & undefined_label();
 
+      /// The short label of a particle type used in classification label ("e", "p", "g"...)
+      static const std::string & classification_symbol(const particle_type);
+
+      /// Build a classification code from particle counts (counts above
+      /// CLASSIFICATION_COUNT_MAX are flagged with CLASSIFICATION_COUNT_OVERFLOW)
+      static classification_code_type make_classification_code(const size_t n_electrons_,
+                                                               const size_t n_positrons_,
+                                                               const size_t n_gammas_,
+                                                               const size_t n_alphas_,
+                                                               const size_t n_undefined_);
+
+      /// Return the number of particles of a given type from a classification code
+      static size_t get_particle_count(const classification_code_type code_, const particle_type type_);
+
+      /// Check if a classification code has lost some particle count
+      static bool is_overflow_classification_code(const classification_code_type code_);
+
+      /// Build the classification label ("2e3g"...) from particle counts
+      static std::string make_classification_label(const size_t n_electrons_,
+                                                   const size_t n_positrons_,
+                                                   const size_t n_gammas_,
+                                                   const size_t n_alphas_,
+                                                   const size_t n_undefined_);
+
+      /// Build the classification label ("2e3g"...) from a classification code
+      /// (throw if the code has overflowed, use the particle counts instead)
+      static std::string classification_label(const classification_code_type code_);
+
+      /// Parse a classification label ("2e3g"...) built by 'classification_label', return false otherwise
+      static bool parse_classification_label(const std::string & label_, classification_code_type & code_);
+
+      /// Fetch the particle counters stored in particle track data auxiliaries
+      static void fetch_particle_counts(const snemo::datamodel::particle_track_data & ptd_,
+                                        size_t counts_[NUMBER_OF_PARTICLE_TYPES]);
+
+      /// Build the classification code from particle counters stored in particle track data auxiliaries
+      static classification_code_type fetch_classification_code(const snemo::datamodel::particle_track_data & ptd_);
+
+      /// Return the particle type associated to a PID label (undefined if unknown)
+      static particle_type particle_type_from_label(const std::string & label_);
+
+      /// Return the particle type from the PID label stored in particle auxiliaries
+      static particle_type fetch_particle_type(const snemo::datamodel::particle_track & pt_);
+
+      /// Build the PID bank from the PID labels and particle counters stored in
+      /// particle track data auxiliaries
+      static void fetch_pid_data(const snemo::datamodel::particle_track_data & ptd_,
+                                 snemo::datamodel::pid_data & pid_);
+
       /// Check a particle pid label
       static bool particle_is(const snemo::datamodel::particle_track &, const std::string &);
 
@@ -0,0 +1,109 @@
+/** \file falaise/snemo/datamodels/probability_array.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/probability_array.h>
+
+// Standard library:
+#include <cmath>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    probability_array::probability_array()
+      : _size_(0)
+    {
+      datatools::invalidate(_min_);
+      datatools::invalidate(_max_);
+      return;
+    }
+
+    probability_array::probability_array(const probability_array & other_)
+      : _size_(0)
+    {
+      datatools::invalidate(_min_);
+      datatools::invalidate(_max_);
+      assign(other_.begin(), other_.end());
+      return;
+    }
+
+    probability_array::~probability_array()
+    {
+      return;
+    }
+
+    probability_array & probability_array::operator=(const probability_array & other_)
+    {
+      if (this != &other_) {
+        assign(other_.begin(), other_.end());
+      }
+      return *this;
+    }
+
+    double probability_array::at(const size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _size_, std::out_of_range,
+                  "Invalid probability index (" << index_ << " >= " << _size_ << ") !");
+      return data()[index_];
+    }
+
+    double probability_array::front() const
+    {
+      DT_THROW_IF(empty(), std::logic_error, "No probability !");
+      return data()[0];
+    }
+
+    double probability_array::back() const
+    {
+      DT_THROW_IF(empty(), std::logic_error, "No probability !");
+      return data()[_size_ - 1];
+    }
+
+    void probability_array::push_back(const double value_)
+    {
+      if (_size_ < INLINE_CAPACITY) {
+        _inline_[_size_] = value_;
+      } else {
+        if (_size_ == INLINE_CAPACITY) {
+          // Move the inline values to the heap storage
+          _heap_.assign(_inline_, _inline_ + INLINE_CAPACITY);
+        }
+        _heap_.push_back(value_);
+      }
+      // NaN values are stored but never enter the summaries
+      if (! std::isnan(value_)) {
+        if (! datatools::is_valid(_min_) || value_ < _min_) _min_ = value_;
+        if (! datatools::is_valid(_max_) || value_ > _max_) _max_ = value_;
+      }
+      _size_++;
+      return;
+    }
+
+    void probability_array::clear()
+    {
+      // Heap capacity is kept for reuse
+      _heap_.clear();
+      _size_ = 0;
+      datatools::invalidate(_min_);
+      datatools::invalidate(_max_);
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,145 @@
+/// \file falaise/snemo/datamodels/probability_array.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Small collection of probabilities with min/max summaries
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_PROBABILITY_ARRAY_H
+#define FALAISE_SNEMO_DATAMODEL_PROBABILITY_ARRAY_H 1
+
+// Standard library:
+#include <cstddef>
+#include <vector>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief Small collection of probabilities with min/max summaries
+    ///
+    /// Up to INLINE_CAPACITY values are stored inline, which covers the
+    /// usual one value per TOF measurement without any heap allocation.
+    /// The minimal and maximal values are updated on insertion so range
+    /// checks do not have to scan the collection. NaN values are ignored by
+    /// the summaries, as they would be by a scan comparing every value.
+    /// Values are read-only once inserted.
+    class probability_array
+    {
+    public:
+
+      /// Number of values stored without heap allocation
+      static const size_t INLINE_CAPACITY = 4;
+
+      /// Typedef for the value type
+      typedef double value_type;
+
+      /// Typedef for the iterator
+      typedef const double * const_iterator;
+
+      /// Default constructor
+      probability_array();
+
+      /// Copy constructor
+      probability_array(const probability_array & other_);
+
+      /// Destructor
+      ~probability_array();
+
+      /// Assignment operator
+      probability_array & operator=(const probability_array & other_);
+
+      /// Return the number of values
+      size_t size() const
+      {
+        return _size_;
+      }
+
+      /// Check if there is no value
+      bool empty() const
+      {
+        return _size_ == 0;
+      }
+
+      /// Return the values
+      const double * data() const
+      {
+        return _size_ <= INLINE_CAPACITY ? _inline_ : &_heap_.front();
+      }
+
+      /// Return an iterator on the first value
+      const_iterator begin() const
+      {
+        return data();
+      }
+
+      /// Return an iterator past the last value
+      const_iterator end() const
+      {
+        return data() + _size_;
+      }
+
+      /// Return the value at a given index (unchecked)
+      double operator[](const size_t index_) const
+      {
+        return data()[index_];
+      }
+
+      /// Return the value at a given index
+      double at(const size_t index_) const;
+
+      /// Return the first value
+      double front() const;
+
+      /// Return the last value
+      double back() const;
+
+      /// Return the minimal value (invalid if empty or only NaN values)
+      double get_min() const
+      {
+        return _min_;
+      }
+
+      /// Return the maximal value (invalid if empty or only NaN values)
+      double get_max() const
+      {
+        return _max_;
+      }
+
+      /// Append a value
+      void push_back(const double value_);
+
+      /// Replace the values by a range of values
+      template<typename Iterator>
+      void assign(Iterator first_, Iterator last_)
+      {
+        clear();
+        for (; first_ != last_; ++first_) push_back(*first_);
+        return;
+      }
+
+      /// Remove all the values
+      void clear();
+
+    private:
+
+      double _inline_[INLINE_CAPACITY]; //!< Inline values
+      std::vector<double> _heap_;       //!< All the values beyond the inline capacity
+      size_t _size_;                    //!< Number of values
+      double _min_;                     //!< Minimal value
+      double _max_;                     //!< Maximal value
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_PROBABILITY_ARRAY_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -26,6 +26,9 @@ BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::vertex_measurement)
 #include <falaise/snemo/datamodels/tof_measurement.ipp>
 DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::tof_measurement)
 BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::tof_measurement)
+#include <falaise/snemo/datamodels/event_time_measurement.ipp>
+DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::event_time_measurement)
+BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::event_time_measurement)
 
 
 /**************************************
@@ -61,6 +64,10 @@ BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_2p_pattern)
 DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::topology_2eNg_pattern)
 BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_2eNg_pattern)
 
+#include <falaise/snemo/datamodels/topology_NeMg_pattern.ipp>
+DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::topology_NeMg_pattern)
+BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_NeMg_pattern)
+
 /***********************************
  * snemo::datamodel::topology_data *
  ***********************************/
@@ -69,4 +76,12 @@ BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_2eNg_pattern)
 DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::topology_data)
 BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_data)
 
+/******************************
+ * snemo::datamodel::pid_data *
+ ******************************/
+
+#include <falaise/snemo/datamodels/pid_data.ipp>
+DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::pid_data)
+BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::pid_data)
+
 #endif // FALAISE_SNEMO_DATAMODELS_THE_SERIALIZABLE_BIS_H
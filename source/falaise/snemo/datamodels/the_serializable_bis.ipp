@@ -12,8 +12,10 @@
 #include <falaise/snemo/datamodels/topology_2p_pattern.ipp>
 #include <falaise/snemo/datamodels/topology_1eNg_pattern.ipp>
 #include <falaise/snemo/datamodels/topology_2eNg_pattern.ipp>
+#include <falaise/snemo/datamodels/topology_NeMg_pattern.ipp>
 #include <falaise/snemo/datamodels/topology_1e1a_pattern.ipp>
 
 #include <falaise/snemo/datamodels/topology_data.ipp>
+#include <falaise/snemo/datamodels/pid_data.ipp>
 
 #endif // FALAISE_SNEMO_DATAMODEL_THE_SERIALIZABLE_BIS_IPP
@@ -18,6 +18,7 @@ namespace snemo {
 
     tof_measurement::tof_measurement()
     {
+      _single_precision_storage_ = false;
       return;
     }
 
@@ -56,6 +57,25 @@ namespace snemo {
       return _external_probabilities_;
     }
 
+    bool tof_measurement::is_single_precision_storage() const
+    {
+      return _single_precision_storage_;
+    }
+
+    void tof_measurement::set_single_precision_storage(const bool single_precision_)
+    {
+      _single_precision_storage_ = single_precision_;
+      return;
+    }
+
+    void tof_measurement::clear()
+    {
+      base_topology_measurement::clear();
+      _internal_probabilities_.clear();
+      _external_probabilities_.clear();
+      return;
+    }
+
     void tof_measurement::tree_dump(std::ostream      & out_,
                                     const std::string & title_,
                                     const std::string & indent_,
@@ -65,10 +85,15 @@ namespace snemo {
       if (! indent_.empty ()) indent = indent_;
       base_topology_measurement::tree_dump(out_, title_, indent_, true);
 
+      out_ << indent << datatools::i_tree_dumpable::tag
+           << "Single precision storage: " << _single_precision_storage_ << std::endl;
+
       out_ << indent << datatools::i_tree_dumpable::tag
            << "Internal probabilities: ";
       if (has_internal_probabilities()) {
-        out_ << _internal_probabilities_.size() << std::endl;
+        out_ << _internal_probabilities_.size()
+             << " (min = " << _internal_probabilities_.get_min()/CLHEP::perCent << "%, "
+             << "max = " << _internal_probabilities_.get_max()/CLHEP::perCent << "%)" << std::endl;
       } else {
         out_ << "<no value>" << std::endl;
       }
@@ -86,7 +111,9 @@ namespace snemo {
       out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_)
            << "External probabilities: ";
       if (has_external_probabilities()) {
-        out_ << _external_probabilities_.size() << std::endl;
+        out_ << _external_probabilities_.size()
+             << " (min = " << _external_probabilities_.get_min()/CLHEP::perCent << "%, "
+             << "max = " << _external_probabilities_.get_max()/CLHEP::perCent << "%)" << std::endl;
       } else {
         out_ << "<no value>" << std::endl;
       }
@@ -1,7 +1,7 @@
 /// \file falaise/snemo/datamodels/tof_measurement.h
 /* Author(s) :    Steven Calvez <calvez@lal.in2p3.fr>
  * Creation date: 2014-01-27
- * Last modified: 2015-10-20
+ * Last modified: 2026-10-18
  *
  * Description: The Time-Of-Flight measurement
  */
@@ -11,6 +11,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/base_topology_measurement.h>
+#include <falaise/snemo/datamodels/probability_array.h>
 
 namespace snemo {
 
@@ -22,7 +23,7 @@ namespace snemo {
     public:
 
       /// Typedef for probability type
-      typedef std::vector<double> probability_type;
+      typedef probability_array probability_type;
 
       /// Constructor
       tof_measurement();
@@ -48,16 +49,33 @@ namespace snemo {
       /// Get a mutable reference to external probabilities
       probability_type & grab_external_probabilities();
 
+      /// Check if probabilities are persisted in single precision
+      bool is_single_precision_storage() const;
+
+      /// Set the single precision persistence of probabilities
+      void set_single_precision_storage(const bool single_precision_);
+
+      /// Clear the measurement
+      virtual void clear();
+
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
                              const std::string & title_  = "",
                              const std::string & indent_ = "",
                              bool inherit_               = false) const;
 
+    private:
+
+      /// Serialize probabilities as a collection of Value
+      template<typename Value, class Archive>
+      static void _serialize_probabilities_(Archive & ar_, const char * name_,
+                                            probability_type & probabilities_);
+
     private:
 
       probability_type _internal_probabilities_;//!< TOF internal probabilities
       probability_type _external_probabilities_;//!< TOF external probabilities
+      bool _single_precision_storage_;          //!< Persist probabilities as float
 
       DATATOOLS_SERIALIZATION_DECLARATION()
     };
@@ -69,6 +87,10 @@ namespace snemo {
 BOOST_CLASS_EXPORT_KEY2(snemo::datamodel::tof_measurement,
                         "snemo::datamodel::tof_measurement")
 
+// Class version 1: probabilities may be stored in single precision
+#include <boost/serialization/version.hpp>
+BOOST_CLASS_VERSION(snemo::datamodel::tof_measurement, 1)
+
 #endif // FALAISE_SNEMO_DATAMODEL_TOF_MEASUREMENT_H
 
 /*
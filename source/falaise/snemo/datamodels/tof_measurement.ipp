@@ -12,6 +12,7 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
 // - Bayeux/datatools:
 #include <datatools/i_serializable.ipp>
 
@@ -22,13 +23,38 @@ namespace snemo {
 
   namespace datamodel {
 
+    template<typename Value, class Archive>
+    void tof_measurement::_serialize_probabilities_(Archive & ar_, const char * name_,
+                                                    probability_type & probabilities_)
+    {
+      std::vector<Value> values;
+      if (Archive::is_saving::value) {
+        values.assign(probabilities_.begin(), probabilities_.end());
+      }
+      ar_ & boost::serialization::make_nvp(name_, values);
+      if (Archive::is_loading::value) {
+        probabilities_.assign(values.begin(), values.end());
+      }
+      return;
+    }
+
     /// Serialization method
     template<class Archive>
-    void tof_measurement::serialize(Archive & ar_, const unsigned int /* version_ */)
+    void tof_measurement::serialize(Archive & ar_, const unsigned int version_)
     {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_topology_measurement);
-      ar_ & boost::serialization::make_nvp("internal_probabilities", _internal_probabilities_);
-      ar_ & boost::serialization::make_nvp("external_probabilities", _external_probabilities_);
+      if (version_ >= 1) {
+        ar_ & boost::serialization::make_nvp("single_precision_storage", _single_precision_storage_);
+      } else if (Archive::is_loading::value) {
+        _single_precision_storage_ = false;
+      }
+      if (_single_precision_storage_) {
+        _serialize_probabilities_<float>(ar_, "internal_probabilities", _internal_probabilities_);
+        _serialize_probabilities_<float>(ar_, "external_probabilities", _external_probabilities_);
+      } else {
+        _serialize_probabilities_<double>(ar_, "internal_probabilities", _internal_probabilities_);
+        _serialize_probabilities_<double>(ar_, "external_probabilities", _external_probabilities_);
+      }
       return;
     }
 
@@ -30,7 +30,7 @@ namespace snemo {
     }
 
     topology_1e1p_pattern::topology_1e1p_pattern()
-      : topology_1e_pattern()
+      : topology_1e_pattern(), _pair_summary_("e1", "p1")
     {
       return;
     }
@@ -40,6 +40,26 @@ namespace snemo {
       return;
     }
 
+    const topology_pair_summary & topology_1e1p_pattern::get_electron_positron_summary() const
+    {
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_ALL);
+    }
+
+    const topology_pair_summary & topology_1e1p_pattern::_fetch_pair_summary_(const uint32_t groups_) const
+    {
+      if (! _pair_summary_.is_computed(groups_)) {
+        _pair_summary_.compute(*this, groups_);
+      }
+      return _pair_summary_;
+    }
+
+    void topology_1e1p_pattern::_invalidate_summary()
+    {
+      topology_1e_pattern::_invalidate_summary();
+      _pair_summary_.reset();
+      return;
+    }
+
     bool topology_1e1p_pattern::has_positron_track() const
     {
       return has_particle_track("p1");
@@ -74,130 +94,125 @@ namespace snemo {
 
     bool topology_1e1p_pattern::has_electron_positron_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_ANGLE).has_angle();
     }
 
     double topology_1e1p_pattern::get_electron_positron_angle() const
     {
       DT_THROW_IF(! has_electron_positron_angle(), std::logic_error, "No electron-positron angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_p1").get_angle();
+      return _pair_summary_.get_angle();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_internal_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_TOF).has_tof();
     }
 
     double topology_1e1p_pattern::get_electron_positron_internal_probability() const
     {
       DT_THROW_IF(! has_electron_positron_internal_probability(), std::logic_error, "No electron-positron TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1").get_internal_probabilities().front();
+      return _pair_summary_.get_internal_probability();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_external_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_TOF).has_tof();
     }
 
     double topology_1e1p_pattern::get_electron_positron_external_probability() const
     {
       DT_THROW_IF(! has_electron_positron_external_probability(), std::logic_error, "No electron-positron TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1").get_external_probabilities().front();
+      return _pair_summary_.get_external_probability();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertices_probability() const
     {
       DT_THROW_IF(! has_electron_positron_vertices_probability(), std::logic_error, "No common electron-positron vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1").get_probability();
+      return _pair_summary_.get_vertices_probability();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_vertices_distance() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertices_distance_x() const
     {
       DT_THROW_IF(! has_electron_positron_vertices_distance(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1").get_vertices_distance_x();
+      return _pair_summary_.get_vertices_distance_x();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertices_distance_y() const
     {
       DT_THROW_IF(! has_electron_positron_vertices_distance(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1").get_vertices_distance_y();
+      return _pair_summary_.get_vertices_distance_y();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertices_distance_z() const
     {
       DT_THROW_IF(! has_electron_positron_vertices_distance(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1").get_vertices_distance_z();
+      return _pair_summary_.get_vertices_distance_z();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_vertex_location() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     std::string topology_1e1p_pattern::get_electron_positron_vertex_location() const
     {
       DT_THROW_IF(! has_electron_positron_vertex_location(), std::logic_error, "No common electron_positron vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_e1_p1")).get_location();
+      return _pair_summary_.get_vertex_location();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_vertex_position() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertex_position_x() const
     {
       DT_THROW_IF(! has_electron_positron_vertex_position(), std::logic_error, "No common electron_positron vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_e1_p1")).get_vertex_position_x();
+      return _pair_summary_.get_vertex_position_x();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertex_position_y() const
     {
       DT_THROW_IF(! has_electron_positron_vertex_position(), std::logic_error, "No common electron_positron vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_e1_p1")).get_vertex_position_y();
+      return _pair_summary_.get_vertex_position_y();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertex_position_z() const
     {
       DT_THROW_IF(! has_electron_positron_vertex_position(), std::logic_error, "No common electron_positron vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_e1_p1")).get_vertex_position_z();
+      return _pair_summary_.get_vertex_position_z();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_minimal_energy() const
     {
-      return has_measurement("energy_e1") && has_measurement("energy_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_ENERGY).has_energy();
     }
 
     double topology_1e1p_pattern::get_electron_positron_minimal_energy() const
     {
       DT_THROW_IF(! has_electron_positron_minimal_energy(), std::logic_error, "No electron/positron minimal energy measurement stored !");
-      //bien dégueulasse
-      return std::min(dynamic_cast<const snemo::datamodel::energy_measurement&> (get_measurement("energy_e1")).get_energy(),
-                      dynamic_cast<const snemo::datamodel::energy_measurement&> (get_measurement("energy_p1")).get_energy());
+      return _pair_summary_.get_minimal_energy();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_maximal_energy() const
     {
-      return
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_e1") &&
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_p1");
+      return _fetch_pair_summary_(topology_pair_summary::GROUP_ENERGY).has_energy();
     }
 
     double topology_1e1p_pattern::get_electron_positron_maximal_energy() const
     {
       DT_THROW_IF(! has_electron_positron_maximal_energy(), std::logic_error, "No electron/positron maximal energy measurement stored !");
-      return std::max(get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy());
+      return _pair_summary_.get_maximal_energy();
     }
 
     double topology_1e1p_pattern::get_positron_track_length() const
@@ -1,7 +1,7 @@
 /// \file falaise/snemo/datamodels/topology_1e1p_pattern.h
 /* Author(s) :    François Mauger <mauger@lpccaen.in2p3.fr>
  * Creation date: 2012-03-19
- * Last modified: 2014-01-27
+ * Last modified: 2026-10-18
  *
  * Description: The 1e1p class of trajectory patterns
  */
@@ -14,6 +14,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/topology_1e_pattern.h>
+#include <falaise/snemo/datamodels/topology_pair_summary.h>
 
 namespace snemo {
 
@@ -36,6 +37,9 @@ namespace snemo {
       /// Destructor
       virtual ~topology_1e1p_pattern();
 
+      /// Return the derived quantities of the electron-positron pair, all computed
+      const topology_pair_summary & get_electron_positron_summary() const;
+
       /// Check positron track availability
       bool has_positron_track() const;
 
@@ -123,8 +127,20 @@ namespace snemo {
       /// Get electron track length
       double get_positron_track_length() const;
 
+    protected:
+
+      /// Forget the derived quantities computed from the measurements
+      virtual void _invalidate_summary();
+
     private:
 
+      /// Return the derived quantities of the electron-positron pair with some groups computed
+      const topology_pair_summary & _fetch_pair_summary_(const uint32_t groups_) const;
+
+    private:
+
+      mutable topology_pair_summary _pair_summary_; //!< Electron-positron pair quantities (not serialized)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
@@ -37,6 +37,13 @@ namespace snemo {
       return;
     }
 
+    void topology_1eNg_pattern::clear()
+    {
+      topology_1e_pattern::clear();
+      _number_of_gammas_ = 0;
+      return;
+    }
+
     bool topology_1eNg_pattern::has_number_of_gammas() const
     {
       return _number_of_gammas_ != 0;
@@ -55,7 +62,8 @@ namespace snemo {
 
     bool topology_1eNg_pattern::has_gammas_energies() const
     {
-      return has_measurement("energy_g[0-9]+");
+      static const measurement_matcher _matcher("energy_g[0-9]+");
+      return has_matching_measurement(_matcher);
     }
 
     void topology_1eNg_pattern::fetch_gammas_energies(topology_1eNg_pattern::energy_collection_type & energies_) const
@@ -63,12 +71,11 @@ namespace snemo {
       DT_THROW_IF(! has_gammas_energies(), std::logic_error,
                   "No gammas energy measurement stored !");
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        std::ostringstream oss;
-        oss << "energy_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' energy measurement !");
+        const measurement_key a_key(measurement_key::KIND_ENERGY, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(a_key),
+                    std::logic_error, "Missing '" << a_key << "' energy measurement !");
         const snemo::datamodel::energy_measurement & a_energy_meas
-          = get_measurement_as<snemo::datamodel::energy_measurement>(oss.str());
+          = get_measurement_as<snemo::datamodel::energy_measurement>(a_key);
         energies_.push_back(a_energy_meas.get_energy());
       }
       return;
@@ -76,7 +83,8 @@ namespace snemo {
 
     bool topology_1eNg_pattern::has_electron_gammas_tof_probabilities() const
     {
-      return has_measurement("tof_e1_g[0-9]+");
+      static const measurement_matcher _matcher("tof_e1_g[0-9]+");
+      return has_matching_measurement(_matcher);
     }
 
     void topology_1eNg_pattern::fetch_electron_gammas_internal_probabilities(topology_1eNg_pattern::tof_collection_type & eg_pint_) const
@@ -84,12 +92,11 @@ namespace snemo {
       DT_THROW_IF(! has_electron_gammas_tof_probabilities(), std::logic_error,
                   "No electron-gammas TOF measurement stored !");
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        std::ostringstream oss;
-        oss << "tof_e1_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+        const measurement_key a_key(measurement_key::KIND_TOF, particle_slot(pid_utils::PARTICLE_ELECTRON, 1), particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+        DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                    std::logic_error, "Missing '" << a_key << "' TOF measurement !");
         const snemo::datamodel::tof_measurement & a_tof_meas
-          = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+          = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
         eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
       }
       return;
@@ -99,12 +106,11 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_gammas_tof_probabilities(), std::logic_error, "No electron-gammas TOF measurement stored !");
       for(size_t ig = 1; ig <= get_number_of_gammas(); ++ig) {
-        std::ostringstream oss;
-        oss << "tof_e1_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+        const measurement_key a_key(measurement_key::KIND_TOF, particle_slot(pid_utils::PARTICLE_ELECTRON, 1), particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+        DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                    std::logic_error, "Missing '" << a_key << "' TOF measurement !");
         const snemo::datamodel::tof_measurement & a_tof_meas
-          = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+          = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
         eg_pext_.push_back(a_tof_meas.get_external_probabilities());
       }
       return;
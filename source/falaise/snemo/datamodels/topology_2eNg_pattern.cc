@@ -36,6 +36,13 @@ namespace snemo {
       return;
     }
 
+    void topology_2eNg_pattern::clear()
+    {
+      topology_2e_pattern::clear();
+      _number_of_gammas_ = 0;
+      return;
+    }
+
     bool topology_2eNg_pattern::has_number_of_gammas() const
     {
       return _number_of_gammas_ != 0;
@@ -54,7 +61,8 @@ namespace snemo {
 
     bool topology_2eNg_pattern::has_gammas_energies() const
     {
-      return has_measurement("energy_g[0-9]+");
+      static const measurement_matcher _matcher("energy_g[0-9]+");
+      return has_matching_measurement(_matcher);
     }
 
     void topology_2eNg_pattern::fetch_gammas_energies(topology_2eNg_pattern::energy_collection_type & g_energies_) const
@@ -62,12 +70,11 @@ namespace snemo {
       DT_THROW_IF(! has_gammas_energies(), std::logic_error,
                   "No gamma energy measurement stored !");
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        std::ostringstream oss;
-        oss << "energy_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' energy measurement !");
+        const measurement_key a_key(measurement_key::KIND_ENERGY, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(a_key),
+                    std::logic_error, "Missing '" << a_key << "' energy measurement !");
         const snemo::datamodel::energy_measurement & a_energy_meas
-          = get_measurement_as<snemo::datamodel::energy_measurement>(oss.str());
+          = get_measurement_as<snemo::datamodel::energy_measurement>(a_key);
         g_energies_.push_back(a_energy_meas.get_energy());
       }
       return;
@@ -75,7 +82,8 @@ namespace snemo {
 
     bool topology_2eNg_pattern::has_electrons_gammas_tof_probabilities() const
     {
-      return has_measurement("tof_e[0-9]+_g[0-9]+");
+      static const measurement_matcher _matcher("tof_e[0-9]+_g[0-9]+");
+      return has_matching_measurement(_matcher);
     }
 
     void topology_2eNg_pattern::fetch_electrons_gammas_internal_probabilities(topology_2eNg_pattern::tof_collection_type & eg_pint_) const
@@ -84,12 +92,11 @@ namespace snemo {
                   "No electrons-gammas TOF measurement stored !");
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
         for (size_t ie = 1; ie <= 2; ie++) {
-          std::ostringstream oss;
-          oss << "tof_e" << ie << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+          const measurement_key a_key(measurement_key::KIND_TOF, particle_slot(pid_utils::PARTICLE_ELECTRON, ie), particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' TOF measurement !");
           const snemo::datamodel::tof_measurement & a_tof_meas
-            = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+            = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
           eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
         }
       }
@@ -102,12 +109,11 @@ namespace snemo {
                   "No electrons-gammas TOF measurement stored !");
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
         for (size_t ie = 1; ie <= 2; ie++) {
-          std::ostringstream oss;
-          oss << "tof_e" << ie << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+          const measurement_key a_key(measurement_key::KIND_TOF, particle_slot(pid_utils::PARTICLE_ELECTRON, ie), particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' TOF measurement !");
           const snemo::datamodel::tof_measurement & a_tof_meas
-            = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+            = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
           eg_pext_.push_back(a_tof_meas.get_external_probabilities());
         }
       }
@@ -116,24 +122,25 @@ namespace snemo {
 
     bool topology_2eNg_pattern::has_electron_min_gammas_tof_probabilities() const
     {
+      static const measurement_matcher _e1_matcher("tof_e1_g[0-9]+");
+      static const measurement_matcher _e2_matcher("tof_e2_g[0-9]+");
       if(get_minimal_energy_electron_name() == "e1")
-        return has_measurement("tof_e1_g[0-9]+");
+        return has_matching_measurement(_e1_matcher);
       else
-        return has_measurement("tof_e2_g[0-9]+");
+        return has_matching_measurement(_e2_matcher);
     }
 
     void topology_2eNg_pattern::fetch_electron_min_gammas_internal_probabilities(topology_2eNg_pattern::tof_collection_type & eg_pint_) const
     {
       DT_THROW_IF(! has_electron_min_gammas_tof_probabilities(), std::logic_error,
                   "No electron_min-gammas TOF measurement stored !");
-      std::string e_min = get_minimal_energy_electron_name();
+      const particle_slot e_min(get_minimal_energy_electron_name());
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_min << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+          const measurement_key a_key(measurement_key::KIND_TOF, e_min, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' TOF measurement !");
           const snemo::datamodel::tof_measurement & a_tof_meas
-            = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+            = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
           eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
       }
       return;
@@ -143,14 +150,13 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_min_gammas_tof_probabilities(), std::logic_error,
                   "No electron_min-gammas TOF measurement stored !");
-      std::string e_min = get_minimal_energy_electron_name();
+      const particle_slot e_min(get_minimal_energy_electron_name());
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_min << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+          const measurement_key a_key(measurement_key::KIND_TOF, e_min, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' TOF measurement !");
           const snemo::datamodel::tof_measurement & a_tof_meas
-            = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+            = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
           eg_pext_.push_back(a_tof_meas.get_external_probabilities());
       }
       return;
@@ -158,24 +164,25 @@ namespace snemo {
 
     bool topology_2eNg_pattern::has_electron_max_gammas_tof_probabilities() const
     {
+      static const measurement_matcher _e1_matcher("tof_e1_g[0-9]+");
+      static const measurement_matcher _e2_matcher("tof_e2_g[0-9]+");
       if(get_maximal_energy_electron_name() == "e1")
-        return has_measurement("tof_e1_g[0-9]+");
+        return has_matching_measurement(_e1_matcher);
       else
-        return has_measurement("tof_e2_g[0-9]+");
+        return has_matching_measurement(_e2_matcher);
     }
 
     void topology_2eNg_pattern::fetch_electron_max_gammas_internal_probabilities(topology_2eNg_pattern::tof_collection_type & eg_pint_) const
     {
       DT_THROW_IF(! has_electron_max_gammas_tof_probabilities(), std::logic_error,
                   "No electron_max-gammas TOF measurement stored !");
-      std::string e_max = get_maximal_energy_electron_name();
+      const particle_slot e_max(get_maximal_energy_electron_name());
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_max << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+          const measurement_key a_key(measurement_key::KIND_TOF, e_max, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' TOF measurement !");
           const snemo::datamodel::tof_measurement & a_tof_meas
-            = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+            = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
           eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
       }
       return;
@@ -185,14 +192,13 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_max_gammas_tof_probabilities(), std::logic_error,
                   "No electron_max-gammas TOF measurement stored !");
-      std::string e_max = get_maximal_energy_electron_name();
+      const particle_slot e_max(get_maximal_energy_electron_name());
       for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_max << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
+          const measurement_key a_key(measurement_key::KIND_TOF, e_max, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' TOF measurement !");
           const snemo::datamodel::tof_measurement & a_tof_meas
-            = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
+            = get_measurement_as<snemo::datamodel::tof_measurement>(a_key);
           eg_pext_.push_back(a_tof_meas.get_external_probabilities());
       }
       return;
@@ -41,6 +41,9 @@ namespace snemo {
       /// Destructor
       virtual ~topology_2eNg_pattern();
 
+      /// Clear the pattern
+      virtual void clear();
+
       /// Check number of gammas validity
       bool has_number_of_gammas() const;
 
@@ -30,7 +30,7 @@ namespace snemo {
     }
 
     topology_2e_pattern::topology_2e_pattern()
-      : base_topology_pattern()
+      : base_topology_pattern(), _electrons_summary_("e1", "e2")
     {
       return;
     }
@@ -40,11 +40,29 @@ namespace snemo {
       return;
     }
 
+    const topology_pair_summary & topology_2e_pattern::get_electrons_summary() const
+    {
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_ALL);
+    }
+
+    const topology_pair_summary & topology_2e_pattern::_fetch_electrons_summary_(const uint32_t groups_) const
+    {
+      if (! _electrons_summary_.is_computed(groups_)) {
+        _electrons_summary_.compute(*this, groups_);
+      }
+      return _electrons_summary_;
+    }
+
+    void topology_2e_pattern::_invalidate_summary()
+    {
+      base_topology_pattern::_invalidate_summary();
+      _electrons_summary_.reset();
+      return;
+    }
+
     bool topology_2e_pattern::has_electrons_energy() const
     {
-      return
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_e1") &&
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_ENERGY).has_energy();
     }
 
     bool topology_2e_pattern::has_electron_minimal_energy() const
@@ -55,8 +73,7 @@ namespace snemo {
     double topology_2e_pattern::get_electron_minimal_energy() const
     {
       DT_THROW_IF(! has_electron_minimal_energy(), std::logic_error, "No electron minimal energy measurement stored !");
-      return std::min(get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy());
+      return _electrons_summary_.get_minimal_energy();
     }
 
     bool topology_2e_pattern::has_electron_maximal_energy() const
@@ -67,139 +84,132 @@ namespace snemo {
     double topology_2e_pattern::get_electron_maximal_energy() const
     {
       DT_THROW_IF(! has_electron_maximal_energy(), std::logic_error, "No electron maximal energy measurement stored !");
-      return std::max(get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy());
+      return _electrons_summary_.get_maximal_energy();
     }
 
     double topology_2e_pattern::get_electrons_energy_sum() const
     {
       DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
-      return get_electron_minimal_energy() + get_electron_maximal_energy();
+      return _electrons_summary_.get_energy_sum();
     }
 
     double topology_2e_pattern::get_electrons_energy_difference() const
     {
       DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
-      return get_electron_maximal_energy() - get_electron_minimal_energy();
+      return _electrons_summary_.get_energy_difference();
     }
 
     std::string topology_2e_pattern::get_minimal_energy_electron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy())
-        return "e1";
-      else
-        return "e2";
+      DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
+      return _electrons_summary_.get_minimal_energy_slot().to_string();
     }
 
     std::string topology_2e_pattern::get_maximal_energy_electron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy())
-        return "e2";
-      else
-        return "e1";
+      DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
+      return _electrons_summary_.get_maximal_energy_slot().to_string();
     }
 
     bool topology_2e_pattern::has_electrons_internal_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_TOF).has_tof();
     }
 
     double topology_2e_pattern::get_electrons_internal_probability() const
     {
       DT_THROW_IF(! has_electrons_internal_probability(), std::logic_error, "No electrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2").get_internal_probabilities().front();
+      return _electrons_summary_.get_internal_probability();
     }
 
     bool topology_2e_pattern::has_electrons_external_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_TOF).has_tof();
     }
 
     double topology_2e_pattern::get_electrons_external_probability() const
     {
       DT_THROW_IF(! has_electrons_external_probability(), std::logic_error, "No electrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2").get_external_probabilities().front();
+      return _electrons_summary_.get_external_probability();
     }
 
     bool topology_2e_pattern::has_electrons_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_ANGLE).has_angle();
     }
 
     double topology_2e_pattern::get_electrons_angle() const
     {
-      DT_THROW_IF(! has_electrons_external_probability(), std::logic_error, "No electrons angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_e2").get_angle();
+      DT_THROW_IF(! has_electrons_angle(), std::logic_error, "No electrons angle measurement stored !");
+      return _electrons_summary_.get_angle();
     }
 
     bool topology_2e_pattern::has_electrons_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_2e_pattern::get_electrons_vertices_probability() const
     {
       DT_THROW_IF(! has_electrons_vertices_probability(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_probability();
+      return _electrons_summary_.get_vertices_probability();
     }
 
     bool topology_2e_pattern::has_electrons_vertices_distance() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_2e_pattern::get_electrons_vertices_distance_x() const
     {
       DT_THROW_IF(! has_electrons_vertices_distance(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_vertices_distance_x();
+      return _electrons_summary_.get_vertices_distance_x();
     }
 
     double topology_2e_pattern::get_electrons_vertices_distance_y() const
     {
       DT_THROW_IF(! has_electrons_vertices_distance(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_vertices_distance_y();
+      return _electrons_summary_.get_vertices_distance_y();
     }
 
     double topology_2e_pattern::get_electrons_vertices_distance_z() const
     {
       DT_THROW_IF(! has_electrons_vertices_distance(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_vertices_distance_z();
+      return _electrons_summary_.get_vertices_distance_z();
     }
 
     bool topology_2e_pattern::has_electrons_vertex_location() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     std::string topology_2e_pattern::get_electrons_vertex_location() const
     {
       DT_THROW_IF(! has_electrons_vertex_location(), std::logic_error, "No common electrons vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_e1_e2")).get_location();
+      return _electrons_summary_.get_vertex_location();
     }
 
     bool topology_2e_pattern::has_electrons_vertex_position() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2");
+      return _fetch_electrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_2e_pattern::get_electrons_vertex_position_x() const
     {
       DT_THROW_IF(! has_electrons_vertex_position(), std::logic_error, "No electrons vertex measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_vertex_position_x();
+      return _electrons_summary_.get_vertex_position_x();
     }
 
     double topology_2e_pattern::get_electrons_vertex_position_y() const
     {
       DT_THROW_IF(! has_electrons_vertex_position(), std::logic_error, "No electrons vertex measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_vertex_position_y();
+      return _electrons_summary_.get_vertex_position_y();
     }
 
     double topology_2e_pattern::get_electrons_vertex_position_z() const
     {
       DT_THROW_IF(! has_electrons_vertex_position(), std::logic_error, "No electrons vertex measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_vertex_position_z();
+      return _electrons_summary_.get_vertex_position_z();
     }
 
   } // end of namespace datamodel
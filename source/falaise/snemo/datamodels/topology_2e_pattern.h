@@ -1,7 +1,7 @@
 /// \file falaise/snemo/datamodels/topology_2e_pattern.h
 /* Author(s) :    Steven Calvez <calvez@lal.in2p3.fr>
  * Creation date: 2015-05-19
- * Last modified: 2015-10-16
+ * Last modified: 2026-10-18
  *
  * Description: The 2 electrons topology pattern class
  */
@@ -11,6 +11,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/topology_pair_summary.h>
 
 namespace snemo {
 
@@ -33,6 +34,9 @@ namespace snemo {
       /// Destructor
       virtual ~topology_2e_pattern();
 
+      /// Return the derived quantities of the electron pair, all computed
+      const topology_pair_summary & get_electrons_summary() const;
+
       /// Check electron minimal energy validity
       bool has_electron_minimal_energy() const;
 
@@ -114,8 +118,20 @@ namespace snemo {
       /// Return electrons vertex position in Z
       double get_electrons_vertex_position_z() const;
 
+    protected:
+
+      /// Forget the derived quantities computed from the measurements
+      virtual void _invalidate_summary();
+
     private:
 
+      /// Return the derived quantities of the electron pair with some groups computed
+      const topology_pair_summary & _fetch_electrons_summary_(const uint32_t groups_) const;
+
+    private:
+
+      mutable topology_pair_summary _electrons_summary_; //!< Electron pair quantities (not serialized)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
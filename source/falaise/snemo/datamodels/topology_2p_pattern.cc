@@ -30,7 +30,7 @@ namespace snemo {
     }
 
     topology_2p_pattern::topology_2p_pattern()
-      : base_topology_pattern()
+      : base_topology_pattern(), _positrons_summary_("p1", "p2")
     {
       return;
     }
@@ -40,11 +40,29 @@ namespace snemo {
       return;
     }
 
+    const topology_pair_summary & topology_2p_pattern::get_positrons_summary() const
+    {
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_ALL);
+    }
+
+    const topology_pair_summary & topology_2p_pattern::_fetch_positrons_summary_(const uint32_t groups_) const
+    {
+      if (! _positrons_summary_.is_computed(groups_)) {
+        _positrons_summary_.compute(*this, groups_);
+      }
+      return _positrons_summary_;
+    }
+
+    void topology_2p_pattern::_invalidate_summary()
+    {
+      base_topology_pattern::_invalidate_summary();
+      _positrons_summary_.reset();
+      return;
+    }
+
     bool topology_2p_pattern::has_positrons_energy() const
     {
-      return
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_p1") &&
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_ENERGY).has_energy();
     }
 
     bool topology_2p_pattern::has_positron_minimal_energy() const
@@ -55,8 +73,7 @@ namespace snemo {
     double topology_2p_pattern::get_positron_minimal_energy() const
     {
       DT_THROW_IF(! has_positron_minimal_energy(), std::logic_error, "No positron minimal energy measurement stored !");
-      return std::min(get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy());
+      return _positrons_summary_.get_minimal_energy();
     }
 
     bool topology_2p_pattern::has_positron_maximal_energy() const
@@ -67,141 +84,132 @@ namespace snemo {
     double topology_2p_pattern::get_positron_maximal_energy() const
     {
       DT_THROW_IF(! has_positron_maximal_energy(), std::logic_error, "No positron maximal energy measurement stored !");
-      return std::max(get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy());
+      return _positrons_summary_.get_maximal_energy();
     }
 
     double topology_2p_pattern::get_positrons_energy_sum() const
     {
-      //Only one energy check
-      DT_THROW_IF(! has_positron_maximal_energy(), std::logic_error, "No positron energy measurement stored !");
-      return get_positron_minimal_energy() + get_positron_maximal_energy();
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _positrons_summary_.get_energy_sum();
     }
 
     double topology_2p_pattern::get_positrons_energy_difference() const
     {
-      //Only one energy check
-      DT_THROW_IF(! has_positron_maximal_energy(), std::logic_error, "No positron energy measurement stored !");
-      return get_positron_maximal_energy() - get_positron_minimal_energy();
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _positrons_summary_.get_energy_difference();
     }
 
     std::string topology_2p_pattern::get_minimal_energy_positron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy())
-        return "p1";
-      else
-        return "p2";
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _positrons_summary_.get_minimal_energy_slot().to_string();
     }
 
     std::string topology_2p_pattern::get_maximal_energy_positron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy())
-        return "p2";
-      else
-        return "p1";
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _positrons_summary_.get_maximal_energy_slot().to_string();
     }
 
     bool topology_2p_pattern::has_positrons_internal_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_TOF).has_tof();
     }
 
     double topology_2p_pattern::get_positrons_internal_probability() const
     {
       DT_THROW_IF(! has_positrons_internal_probability(), std::logic_error, "No positrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2").get_internal_probabilities().front();
+      return _positrons_summary_.get_internal_probability();
     }
 
     bool topology_2p_pattern::has_positrons_external_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_TOF).has_tof();
     }
 
     double topology_2p_pattern::get_positrons_external_probability() const
     {
       DT_THROW_IF(! has_positrons_external_probability(), std::logic_error, "No positrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2").get_external_probabilities().front();
+      return _positrons_summary_.get_external_probability();
     }
 
     bool topology_2p_pattern::has_positrons_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_ANGLE).has_angle();
     }
 
     double topology_2p_pattern::get_positrons_angle() const
     {
       DT_THROW_IF(! has_positrons_angle(), std::logic_error, "No positrons angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_p1_p2").get_angle();
+      return _positrons_summary_.get_angle();
     }
 
     bool topology_2p_pattern::has_positrons_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_2p_pattern::get_positrons_vertices_probability() const
     {
       DT_THROW_IF(! has_positrons_vertices_probability(), std::logic_error, "No common positrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2").get_probability();
+      return _positrons_summary_.get_vertices_probability();
     }
 
     bool topology_2p_pattern::has_positrons_vertices_distance() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_2p_pattern::get_positrons_vertices_distance_x() const
     {
       DT_THROW_IF(! has_positrons_vertices_distance(), std::logic_error, "No common positrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2").get_vertices_distance_x();
+      return _positrons_summary_.get_vertices_distance_x();
     }
 
     double topology_2p_pattern::get_positrons_vertices_distance_y() const
     {
       DT_THROW_IF(! has_positrons_vertices_distance(), std::logic_error, "No common positrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2").get_vertices_distance_y();
+      return _positrons_summary_.get_vertices_distance_y();
     }
 
     double topology_2p_pattern::get_positrons_vertices_distance_z() const
     {
       DT_THROW_IF(! has_positrons_vertices_distance(), std::logic_error, "No common positrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2").get_vertices_distance_z();
+      return _positrons_summary_.get_vertices_distance_z();
     }
 
     bool topology_2p_pattern::has_positrons_vertex_location() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     std::string topology_2p_pattern::get_positrons_vertex_location() const
     {
       DT_THROW_IF(! has_positrons_vertex_location(), std::logic_error, "No common positrons vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_p1_p2")).get_location();
+      return _positrons_summary_.get_vertex_location();
     }
 
     bool topology_2p_pattern::has_positrons_vertex_position() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2");
+      return _fetch_positrons_summary_(topology_pair_summary::GROUP_VERTEX).has_vertex();
     }
 
     double topology_2p_pattern::get_positrons_vertex_position_x() const
     {
       DT_THROW_IF(! has_positrons_vertex_position(), std::logic_error, "No common positrons vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_p1_p2")).get_vertex_position_x();
+      return _positrons_summary_.get_vertex_position_x();
     }
 
     double topology_2p_pattern::get_positrons_vertex_position_y() const
     {
       DT_THROW_IF(! has_positrons_vertex_position(), std::logic_error, "No common positrons vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_p1_p2")).get_vertex_position_y();
+      return _positrons_summary_.get_vertex_position_y();
     }
 
     double topology_2p_pattern::get_positrons_vertex_position_z() const
     {
       DT_THROW_IF(! has_positrons_vertex_position(), std::logic_error, "No common positrons vertices measurement stored !");
-      return dynamic_cast<const snemo::datamodel::vertex_measurement&> (get_measurement("vertex_p1_p2")).get_vertex_position_z();
+      return _positrons_summary_.get_vertex_position_z();
     }
 
   } // end of namespace datamodel
@@ -0,0 +1,167 @@
+/** \file falaise/snemo/datamodels/topology_NeMg_pattern.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/topology_NeMg_pattern.h>
+
+// This project:
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    // Serial tag for datatools::i_serializable interface :
+    DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(topology_NeMg_pattern,
+                                                      "snemo::datamodel::topology_NeMg_pattern")
+
+    // static
+    const std::string & topology_NeMg_pattern::pattern_id()
+    {
+      static const std::string _id("NeMg");
+      return _id;
+    }
+
+    std::string topology_NeMg_pattern::get_pattern_id() const
+    {
+      return topology_NeMg_pattern::pattern_id();
+    }
+
+    topology_NeMg_pattern::topology_NeMg_pattern()
+      : base_topology_pattern()
+    {
+      _number_of_electrons_ = 0;
+      _number_of_gammas_ = 0;
+      return;
+    }
+
+    topology_NeMg_pattern::~topology_NeMg_pattern()
+    {
+      return;
+    }
+
+    void topology_NeMg_pattern::clear()
+    {
+      base_topology_pattern::clear();
+      _number_of_electrons_ = 0;
+      _number_of_gammas_ = 0;
+      return;
+    }
+
+    void topology_NeMg_pattern::set_number_of_electrons(const size_t nelectrons_)
+    {
+      _number_of_electrons_ = nelectrons_;
+      return;
+    }
+
+    size_t topology_NeMg_pattern::get_number_of_electrons() const
+    {
+      return _number_of_electrons_;
+    }
+
+    void topology_NeMg_pattern::set_number_of_gammas(const size_t ngammas_)
+    {
+      _number_of_gammas_ = ngammas_;
+      return;
+    }
+
+    size_t topology_NeMg_pattern::get_number_of_gammas() const
+    {
+      return _number_of_gammas_;
+    }
+
+    bool topology_NeMg_pattern::has_electrons_energies() const
+    {
+      static const measurement_matcher _matcher("energy_e[0-9]+");
+      return has_matching_measurement(_matcher);
+    }
+
+    void topology_NeMg_pattern::fetch_electrons_energies(topology_NeMg_pattern::energy_collection_type & e_energies_) const
+    {
+      DT_THROW_IF(! has_electrons_energies(), std::logic_error,
+                  "No electron energy measurement stored !");
+      for (size_t ie = 1; ie <= get_number_of_electrons(); ie++) {
+        const measurement_key a_key(measurement_key::KIND_ENERGY, particle_slot(pid_utils::PARTICLE_ELECTRON, ie));
+        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(a_key),
+                    std::logic_error, "Missing '" << a_key << "' energy measurement !");
+        e_energies_.push_back(get_measurement_as<snemo::datamodel::energy_measurement>(a_key).get_energy());
+      }
+      return;
+    }
+
+    double topology_NeMg_pattern::get_electrons_energy_sum() const
+    {
+      energy_collection_type energies;
+      fetch_electrons_energies(energies);
+      double sum = 0.0;
+      for (size_t i = 0; i < energies.size(); i++) {
+        sum += energies[i];
+      }
+      return sum;
+    }
+
+    bool topology_NeMg_pattern::has_gammas_energies() const
+    {
+      static const measurement_matcher _matcher("energy_g[0-9]+");
+      return has_matching_measurement(_matcher);
+    }
+
+    void topology_NeMg_pattern::fetch_gammas_energies(topology_NeMg_pattern::energy_collection_type & g_energies_) const
+    {
+      DT_THROW_IF(! has_gammas_energies(), std::logic_error,
+                  "No gamma energy measurement stored !");
+      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
+        const measurement_key a_key(measurement_key::KIND_ENERGY, particle_slot(pid_utils::PARTICLE_GAMMA, ig));
+        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(a_key),
+                    std::logic_error, "Missing '" << a_key << "' energy measurement !");
+        g_energies_.push_back(get_measurement_as<snemo::datamodel::energy_measurement>(a_key).get_energy());
+      }
+      return;
+    }
+
+    bool topology_NeMg_pattern::has_electrons_vertices_probabilities() const
+    {
+      static const measurement_matcher _matcher("vertex_e[0-9]+_e[0-9]+");
+      return has_matching_measurement(_matcher);
+    }
+
+    void topology_NeMg_pattern::fetch_electrons_vertices_probabilities(topology_NeMg_pattern::probability_collection_type & probabilities_) const
+    {
+      DT_THROW_IF(! has_electrons_vertices_probabilities(), std::logic_error,
+                  "No electrons common vertex measurement stored !");
+      for (size_t ie1 = 1; ie1 <= get_number_of_electrons(); ie1++) {
+        for (size_t ie2 = ie1 + 1; ie2 <= get_number_of_electrons(); ie2++) {
+          const measurement_key a_key(measurement_key::KIND_VERTEX,
+                                      particle_slot(pid_utils::PARTICLE_ELECTRON, ie1),
+                                      particle_slot(pid_utils::PARTICLE_ELECTRON, ie2));
+          DT_THROW_IF(! has_measurement_as<snemo::datamodel::vertex_measurement>(a_key),
+                      std::logic_error, "Missing '" << a_key << "' vertex measurement !");
+          probabilities_.push_back(get_measurement_as<snemo::datamodel::vertex_measurement>(a_key).get_probability());
+        }
+      }
+      return;
+    }
+
+    size_t topology_NeMg_pattern::get_number_of_common_vertices(const double probability_threshold_) const
+    {
+      probability_collection_type probabilities;
+      fetch_electrons_vertices_probabilities(probabilities);
+      size_t n = 0;
+      for (size_t i = 0; i < probabilities.size(); i++) {
+        if (probabilities[i] >= probability_threshold_) n++;
+      }
+      return n;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,112 @@
+/// \file falaise/snemo/datamodels/topology_NeMg_pattern.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: The N electrons - M gammas topology pattern class
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_NEMG_PATTERN_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_NEMG_PATTERN_H 1
+
+// Standard library:
+#include <vector>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief The N electrons - M gammas class of reconstructed topology
+    ///
+    /// Used for events with more than two electrons (and any number of
+    /// gammas). Electron pair measurements are stored for every pair
+    /// e<i>/e<j> with i < j, electron-gamma measurements for every e<i>/g<k>.
+    class topology_NeMg_pattern : public base_topology_pattern
+    {
+    public:
+
+      /// Typedef for energy collection
+      typedef std::vector<double> energy_collection_type;
+
+      /// Typedef for electron pair probability collection
+      typedef std::vector<double> probability_collection_type;
+
+      /// Static function to return pattern identifier of the pattern
+      static const std::string & pattern_id();
+
+      /// Return pattern identifier of the pattern
+      virtual std::string get_pattern_id() const;
+
+      /// Constructor
+      topology_NeMg_pattern();
+
+      /// Destructor
+      virtual ~topology_NeMg_pattern();
+
+      /// Clear the pattern
+      virtual void clear();
+
+      /// Set number of electrons
+      void set_number_of_electrons(const size_t nelectrons_);
+
+      /// Return the number of electrons
+      size_t get_number_of_electrons() const;
+
+      /// Set number of gammas
+      void set_number_of_gammas(const size_t ngammas_);
+
+      /// Return the number of gammas
+      size_t get_number_of_gammas() const;
+
+      /// Check electrons energies existence
+      bool has_electrons_energies() const;
+
+      /// Fetch the electrons energies
+      void fetch_electrons_energies(energy_collection_type & e_energies_) const;
+
+      /// Get electrons energy sum
+      double get_electrons_energy_sum() const;
+
+      /// Check gammas energies existence
+      bool has_gammas_energies() const;
+
+      /// Fetch the gammas energies
+      void fetch_gammas_energies(energy_collection_type & g_energies_) const;
+
+      /// Check electron pairs common vertex probabilities existence
+      bool has_electrons_vertices_probabilities() const;
+
+      /// Fetch the common vertex probabilities of the electron pairs (e1/e2, e1/e3... e2/e3...)
+      void fetch_electrons_vertices_probabilities(probability_collection_type & probabilities_) const;
+
+      /// Return the number of electron pairs with a common vertex probability above a threshold
+      size_t get_number_of_common_vertices(const double probability_threshold_) const;
+
+    private:
+
+      size_t _number_of_electrons_; //!< Number of electrons in the topology
+      size_t _number_of_gammas_;    //!< Number of gammas in the topology
+
+      DATATOOLS_SERIALIZATION_DECLARATION()
+
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#include <boost/serialization/export.hpp>
+BOOST_CLASS_EXPORT_KEY2(snemo::datamodel::topology_NeMg_pattern,
+                        "snemo::datamodel::topology_NeMg_pattern")
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_NEMG_PATTERN_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,380 @@
+/** \file falaise/snemo/datamodels/topology_keys.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/topology_keys.h>
+
+// Standard library:
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    namespace {
+
+      /// Labels not following the topology naming scheme
+      ///
+      /// Labels are kept for the lifetime of the process: their number is
+      /// bounded by measurement_key::INTERNED_LABELS_MAX.
+      struct label_registry
+      {
+        boost::uint32_t intern(const char * first_, const char * last_)
+        {
+          const std::string a_label(first_, last_);
+          std::lock_guard<std::mutex> lock(mutex);
+          std::map<std::string, boost::uint32_t>::const_iterator found = indexes.find(a_label);
+          if (found != indexes.end()) return found->second;
+          DT_THROW_IF(labels.size() >= measurement_key::INTERNED_LABELS_MAX, std::length_error,
+                      "Too many labels outside the topology naming scheme, cannot intern '"
+                      << a_label << "' !");
+          const boost::uint32_t index = labels.size();
+          labels.push_back(a_label);
+          indexes[a_label] = index;
+          return index;
+        }
+
+        bool find(const char * first_, const char * last_, boost::uint32_t & index_)
+        {
+          const std::string a_label(first_, last_);
+          std::lock_guard<std::mutex> lock(mutex);
+          std::map<std::string, boost::uint32_t>::const_iterator found = indexes.find(a_label);
+          if (found == indexes.end()) return false;
+          index_ = found->second;
+          return true;
+        }
+
+        size_t size()
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          return labels.size();
+        }
+
+        std::string label(const boost::uint32_t index_)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          return labels.at(index_);
+        }
+
+        std::mutex mutex;
+        std::vector<std::string> labels;
+        std::map<std::string, boost::uint32_t> indexes;
+      };
+
+      label_registry & the_label_registry()
+      {
+        static label_registry _registry;
+        return _registry;
+      }
+
+      const particle_slot::code_type SLOT_INTERNED_FLAG = 0x80000000;
+      const unsigned int SLOT_TYPE_SHIFT = 16;
+      const unsigned int KEY_KIND_SHIFT = 56;
+      const unsigned int KEY_FIRST_SHIFT = 24;
+      const measurement_key::code_type KEY_SLOT_MASK = 0xFFFFFF;
+      const measurement_key::code_type KEY_INDEX_MASK = 0xFFFFFFFF;
+      const size_t MATCHER_CACHE_MAX = 4096;
+
+    }
+
+    const unsigned int particle_slot::RANK_MAX;
+    const size_t measurement_key::INTERNED_LABELS_MAX;
+
+    particle_slot::particle_slot()
+      : _code_(0)
+    {
+      return;
+    }
+
+    particle_slot::particle_slot(const pid_utils::particle_type type_, const unsigned int rank_)
+    {
+      DT_THROW_IF(type_ >= pid_utils::NUMBER_OF_PARTICLE_TYPES, std::logic_error,
+                  "Invalid particle type (" << type_ << ") !");
+      DT_THROW_IF(rank_ < 1 || rank_ > RANK_MAX, std::logic_error,
+                  "Invalid particle rank (" << rank_ << ") !");
+      _code_ = ((type_ + 1) << SLOT_TYPE_SHIFT) | rank_;
+      return;
+    }
+
+    particle_slot::particle_slot(const std::string & label_)
+    {
+      _set_(label_.data(), label_.data() + label_.size());
+      return;
+    }
+
+    particle_slot::particle_slot(const char * label_)
+    {
+      _set_(label_, label_ + std::strlen(label_));
+      return;
+    }
+
+    void particle_slot::_set_(const char * first_, const char * last_)
+    {
+      if (parse(first_, last_, *this)) return;
+      _code_ = SLOT_INTERNED_FLAG | the_label_registry().intern(first_, last_);
+      return;
+    }
+
+    // static
+    bool particle_slot::parse(const char * first_, const char * last_, particle_slot & slot_)
+    {
+      if (last_ - first_ < 2) return false;
+      size_t type = 0;
+      for (; type < pid_utils::NUMBER_OF_PARTICLE_TYPES; ++type) {
+        if (pid_utils::classification_symbol(static_cast<pid_utils::particle_type>(type))[0] == *first_) break;
+      }
+      if (type == pid_utils::NUMBER_OF_PARTICLE_TYPES) return false;
+      // Rank without leading zero
+      if (first_[1] == '0') return false;
+      unsigned int rank = 0;
+      for (const char * c = first_ + 1; c != last_; ++c) {
+        if (*c < '0' || *c > '9') return false;
+        rank = 10 * rank + (*c - '0');
+        if (rank > RANK_MAX) return false;
+      }
+      slot_ = particle_slot(static_cast<pid_utils::particle_type>(type), rank);
+      return true;
+    }
+
+    bool particle_slot::is_valid() const
+    {
+      return _code_ != 0;
+    }
+
+    bool particle_slot::is_interned() const
+    {
+      return (_code_ & SLOT_INTERNED_FLAG) != 0;
+    }
+
+    pid_utils::particle_type particle_slot::get_type() const
+    {
+      if (! is_valid() || is_interned()) return pid_utils::PARTICLE_UNDEFINED;
+      return static_cast<pid_utils::particle_type>((_code_ >> SLOT_TYPE_SHIFT) - 1);
+    }
+
+    unsigned int particle_slot::get_rank() const
+    {
+      if (is_interned()) return 0;
+      return _code_ & RANK_MAX;
+    }
+
+    particle_slot::code_type particle_slot::get_code() const
+    {
+      return _code_;
+    }
+
+    std::string particle_slot::to_string() const
+    {
+      if (! is_valid()) return std::string();
+      if (is_interned()) return the_label_registry().label(_code_ & ~SLOT_INTERNED_FLAG);
+      std::ostringstream oss;
+      oss << pid_utils::classification_symbol(get_type()) << get_rank();
+      return oss.str();
+    }
+
+    // static
+    const std::string & measurement_key::kind_label(const kind_type kind_)
+    {
+      static const std::string _labels[] = {"", "tof", "angle", "vertex", "energy"};
+      static const std::string _none;
+      if (kind_ > KIND_ENERGY) return _none;
+      return _labels[kind_];
+    }
+
+    measurement_key::measurement_key()
+      : _code_(0)
+    {
+      return;
+    }
+
+    measurement_key::measurement_key(const kind_type kind_,
+                                     const particle_slot & first_,
+                                     const particle_slot & second_)
+    {
+      DT_THROW_IF(kind_ == KIND_INVALID || kind_ == KIND_LABEL, std::logic_error,
+                  "Invalid measurement kind (" << kind_ << ") !");
+      DT_THROW_IF(! first_.is_valid(), std::logic_error, "Invalid particle slot !");
+      if (first_.is_interned() || second_.is_interned()) {
+        // Arbitrary particle labels: intern the whole measurement label
+        std::string a_label = kind_label(kind_) + "_" + first_.to_string();
+        if (second_.is_valid()) a_label += "_" + second_.to_string();
+        _set_(a_label.data(), a_label.data() + a_label.size());
+        return;
+      }
+      _code_ = (static_cast<code_type>(kind_) << KEY_KIND_SHIFT)
+        | (static_cast<code_type>(first_.get_code()) << KEY_FIRST_SHIFT)
+        | static_cast<code_type>(second_.get_code());
+      return;
+    }
+
+    measurement_key::measurement_key(const std::string & label_)
+    {
+      _set_(label_.data(), label_.data() + label_.size());
+      return;
+    }
+
+    measurement_key::measurement_key(const char * label_)
+    {
+      _set_(label_, label_ + std::strlen(label_));
+      return;
+    }
+
+    // static
+    bool measurement_key::lookup(const std::string & label_, measurement_key & key_)
+    {
+      const char * first = label_.data();
+      const char * last = first + label_.size();
+      if (_parse_(first, last, key_)) return true;
+      boost::uint32_t index = 0;
+      if (! the_label_registry().find(first, last, index)) return false;
+      key_._code_ = (static_cast<code_type>(KIND_LABEL) << KEY_KIND_SHIFT) | index;
+      return true;
+    }
+
+    // static
+    size_t measurement_key::get_number_of_interned_labels()
+    {
+      return the_label_registry().size();
+    }
+
+    void measurement_key::_set_(const char * first_, const char * last_)
+    {
+      if (_parse_(first_, last_, *this)) return;
+      _code_ = (static_cast<code_type>(KIND_LABEL) << KEY_KIND_SHIFT)
+        | the_label_registry().intern(first_, last_);
+      return;
+    }
+
+    // static
+    bool measurement_key::_parse_(const char * first_, const char * last_, measurement_key & key_)
+    {
+      // Parse "<kind>_<slot>[_<slot>]"
+      const char * sep1 = std::find(first_, last_, '_');
+      if (sep1 != last_) {
+        const std::string a_prefix(first_, sep1);
+        int kind = KIND_INVALID;
+        for (int k = KIND_TOF; k <= KIND_ENERGY; ++k) {
+          if (a_prefix == kind_label(static_cast<kind_type>(k))) {
+            kind = k;
+            break;
+          }
+        }
+        const char * sep2 = std::find(sep1 + 1, last_, '_');
+        particle_slot first_slot;
+        particle_slot second_slot;
+        if (kind != KIND_INVALID
+            && particle_slot::parse(sep1 + 1, sep2, first_slot)
+            && (sep2 == last_ || particle_slot::parse(sep2 + 1, last_, second_slot))) {
+          key_ = measurement_key(static_cast<kind_type>(kind), first_slot, second_slot);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool measurement_key::is_valid() const
+    {
+      return _code_ != 0;
+    }
+
+    bool measurement_key::is_interned() const
+    {
+      return get_kind() == KIND_LABEL;
+    }
+
+    measurement_key::kind_type measurement_key::get_kind() const
+    {
+      return static_cast<kind_type>(_code_ >> KEY_KIND_SHIFT);
+    }
+
+    particle_slot measurement_key::get_first() const
+    {
+      particle_slot a_slot;
+      if (! is_valid() || is_interned()) return a_slot;
+      const particle_slot::code_type code = (_code_ >> KEY_FIRST_SHIFT) & KEY_SLOT_MASK;
+      return particle_slot(static_cast<pid_utils::particle_type>((code >> SLOT_TYPE_SHIFT) - 1),
+                           code & particle_slot::RANK_MAX);
+    }
+
+    particle_slot measurement_key::get_second() const
+    {
+      particle_slot a_slot;
+      if (! is_valid() || is_interned()) return a_slot;
+      const particle_slot::code_type code = _code_ & KEY_SLOT_MASK;
+      if (code == 0) return a_slot;
+      return particle_slot(static_cast<pid_utils::particle_type>((code >> SLOT_TYPE_SHIFT) - 1),
+                           code & particle_slot::RANK_MAX);
+    }
+
+    measurement_key::code_type measurement_key::get_code() const
+    {
+      return _code_;
+    }
+
+    std::string measurement_key::to_string() const
+    {
+      if (! is_valid()) return std::string();
+      if (is_interned()) return the_label_registry().label(_code_ & KEY_INDEX_MASK);
+      std::string a_label = kind_label(get_kind()) + "_" + get_first().to_string();
+      const particle_slot second = get_second();
+      if (second.is_valid()) a_label += "_" + second.to_string();
+      return a_label;
+    }
+
+    measurement_matcher::measurement_matcher(const std::string & pattern_)
+      : _pattern_(pattern_),
+        _regex_(pattern_)
+    {
+      return;
+    }
+
+    const std::string & measurement_matcher::get_pattern() const
+    {
+      return _pattern_;
+    }
+
+    bool measurement_matcher::match(const measurement_key & key_) const
+    {
+      std::lock_guard<std::mutex> lock(_cache_mutex_);
+      std::map<measurement_key, bool>::const_iterator found = _cache_.find(key_);
+      if (found != _cache_.end()) return found->second;
+      const bool matched = std::regex_match(key_.to_string(), _regex_);
+      // Keys built from particle ranks are not bounded: keep the cache small
+      if (_cache_.size() >= MATCHER_CACHE_MAX) _cache_.clear();
+      _cache_[key_] = matched;
+      return matched;
+    }
+
+    std::ostream & operator<<(std::ostream & out_, const particle_slot & slot_)
+    {
+      out_ << slot_.to_string();
+      return out_;
+    }
+
+    std::ostream & operator<<(std::ostream & out_, const measurement_key & key_)
+    {
+      out_ << key_.to_string();
+      return out_;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,222 @@
+/// \file falaise/snemo/datamodels/topology_keys.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Keys of the particle tracks and measurements of topology patterns
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_KEYS_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_KEYS_H 1
+
+// Standard library:
+#include <string>
+#include <iostream>
+#include <regex>
+#include <mutex>
+#include <map>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief Slot of a particle track within a topology pattern
+    ///
+    /// A slot is made of the particle type and of its rank within this type
+    /// i.e. "e1", "g3"... Labels not following this scheme are interned so
+    /// that slots are always compared as integers.
+    class particle_slot
+    {
+    public:
+
+      /// Typedef for the integer code
+      typedef boost::uint32_t code_type;
+
+      /// Maximal rank of a particle within its type
+      static const unsigned int RANK_MAX = 0xFFFF;
+
+      /// Default constructor (invalid slot)
+      particle_slot();
+
+      /// Constructor from particle type and rank (starting from 1)
+      particle_slot(const pid_utils::particle_type type_, const unsigned int rank_);
+
+      /// Constructor from a label
+      particle_slot(const std::string & label_);
+
+      /// Constructor from a label
+      particle_slot(const char * label_);
+
+      /// Check validity
+      bool is_valid() const;
+
+      /// Check if the slot has been built from an arbitrary label
+      bool is_interned() const;
+
+      /// Return the particle type (PARTICLE_UNDEFINED for interned slots)
+      pid_utils::particle_type get_type() const;
+
+      /// Return the rank of the particle within its type (0 for interned slots)
+      unsigned int get_rank() const;
+
+      /// Return the integer code
+      code_type get_code() const;
+
+      /// Return the label
+      std::string to_string() const;
+
+      /// Parse a "<symbol><rank>" label, return false if the label does not follow this scheme
+      static bool parse(const char * first_, const char * last_, particle_slot & slot_);
+
+      bool operator<(const particle_slot & other_) const { return _code_ < other_._code_; }
+      bool operator==(const particle_slot & other_) const { return _code_ == other_._code_; }
+      bool operator!=(const particle_slot & other_) const { return _code_ != other_._code_; }
+
+    private:
+
+      /// Set the slot from a label
+      void _set_(const char * first_, const char * last_);
+
+    private:
+
+      code_type _code_; //!< Particle type and rank, or interned label index
+    };
+
+    /// \brief Key of a measurement within a topology pattern
+    ///
+    /// A key is made of the measurement kind and of up to two particle slots
+    /// i.e. "tof_e1_g3", "energy_g2"... Labels not following this scheme
+    /// are interned so that keys are always compared as integers. Interned
+    /// labels, shared with particle slots, are never released: they are
+    /// meant for a finite set of labels (fixed by the configuration) and
+    /// their number is bounded by INTERNED_LABELS_MAX.
+    class measurement_key
+    {
+    public:
+
+      /// Typedef for the integer code
+      typedef boost::uint64_t code_type;
+
+      /// Maximal number of interned labels (particle slots and measurement keys)
+      static const size_t INTERNED_LABELS_MAX = 0x10000;
+
+      /// Measurement kinds
+      enum kind_type {
+        KIND_INVALID = 0,
+        KIND_TOF     = 1,
+        KIND_ANGLE   = 2,
+        KIND_VERTEX  = 3,
+        KIND_ENERGY  = 4,
+        KIND_LABEL   = 15 //!< Interned label
+      };
+
+      /// Return the label prefix of a measurement kind ("tof", "angle"...)
+      static const std::string & kind_label(const kind_type kind_);
+
+      /// Default constructor (invalid key)
+      measurement_key();
+
+      /// Constructor from measurement kind and particle slots
+      measurement_key(const kind_type kind_,
+                      const particle_slot & first_,
+                      const particle_slot & second_ = particle_slot());
+
+      /// Constructor from a label
+      measurement_key(const std::string & label_);
+
+      /// Constructor from a label
+      measurement_key(const char * label_);
+
+      /// Find the key of a label without interning it, return false if no such key exists
+      static bool lookup(const std::string & label_, measurement_key & key_);
+
+      /// Return the number of interned labels
+      static size_t get_number_of_interned_labels();
+
+      /// Check validity
+      bool is_valid() const;
+
+      /// Check if the key has been built from an arbitrary label
+      bool is_interned() const;
+
+      /// Return the measurement kind
+      kind_type get_kind() const;
+
+      /// Return the first particle slot
+      particle_slot get_first() const;
+
+      /// Return the second particle slot (invalid for single particle measurement)
+      particle_slot get_second() const;
+
+      /// Return the integer code
+      code_type get_code() const;
+
+      /// Return the label
+      std::string to_string() const;
+
+      bool operator<(const measurement_key & other_) const { return _code_ < other_._code_; }
+      bool operator==(const measurement_key & other_) const { return _code_ == other_._code_; }
+      bool operator!=(const measurement_key & other_) const { return _code_ != other_._code_; }
+
+    private:
+
+      /// Set the key from a label
+      void _set_(const char * first_, const char * last_);
+
+      /// Build the key of a label following the naming scheme
+      static bool _parse_(const char * first_, const char * last_, measurement_key & key_);
+
+    private:
+
+      code_type _code_; //!< Measurement kind and particle slots, or interned label index
+    };
+
+    /// \brief Pre-compiled matcher of measurement labels
+    ///
+    /// The regular expression is compiled once at construction and match
+    /// results are cached per key, so that a matcher kept by its caller
+    /// (i.e. as a static object) is cheap to apply to every event.
+    class measurement_matcher
+    {
+    public:
+
+      /// Constructor from a regular expression over measurement labels
+      explicit measurement_matcher(const std::string & pattern_);
+
+      /// Return the regular expression
+      const std::string & get_pattern() const;
+
+      /// Check if a measurement key matches the regular expression
+      bool match(const measurement_key & key_) const;
+
+    private:
+
+      std::string _pattern_;                    //!< Regular expression
+      std::regex _regex_;                       //!< Compiled regular expression
+      mutable std::mutex _cache_mutex_;         //!< Mutex protecting the cache
+      mutable std::map<measurement_key, bool> _cache_; //!< Match results per key
+    };
+
+    std::ostream & operator<<(std::ostream & out_, const particle_slot & slot_);
+
+    std::ostream & operator<<(std::ostream & out_, const measurement_key & key_);
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_KEYS_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
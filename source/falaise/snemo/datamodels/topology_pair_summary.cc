@@ -0,0 +1,128 @@
+/** \file falaise/snemo/datamodels/topology_pair_summary.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/topology_pair_summary.h>
+
+// Standard library:
+#include <algorithm>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    topology_pair_summary::topology_pair_summary(const particle_slot & first_,
+                                                 const particle_slot & second_)
+      : _first_(first_), _second_(second_)
+    {
+      reset();
+      return;
+    }
+
+    void topology_pair_summary::reset()
+    {
+      _computed_ = GROUP_NONE;
+      _available_ = GROUP_NONE;
+      datatools::invalidate(_minimal_energy_);
+      datatools::invalidate(_maximal_energy_);
+      _first_is_minimal_ = false;
+      datatools::invalidate(_internal_probability_);
+      datatools::invalidate(_external_probability_);
+      datatools::invalidate(_angle_);
+      datatools::invalidate(_vertices_probability_);
+      datatools::invalidate(_vertices_distance_x_);
+      datatools::invalidate(_vertices_distance_y_);
+      datatools::invalidate(_vertices_distance_z_);
+      _vertex_location_.clear();
+      datatools::invalidate(_vertex_position_x_);
+      datatools::invalidate(_vertex_position_y_);
+      datatools::invalidate(_vertex_position_z_);
+      return;
+    }
+
+    void topology_pair_summary::compute(const base_topology_pattern & pattern_, const uint32_t groups_)
+    {
+      const uint32_t todo = groups_ & ~_computed_;
+
+      if (todo & GROUP_ENERGY) {
+        const energy_measurement * e1
+          = pattern_.find_measurement_as<energy_measurement>(measurement_key(measurement_key::KIND_ENERGY, _first_));
+        const energy_measurement * e2
+          = pattern_.find_measurement_as<energy_measurement>(measurement_key(measurement_key::KIND_ENERGY, _second_));
+        if (e1 != 0 && e2 != 0) {
+          _first_is_minimal_ = e1->get_energy() < e2->get_energy();
+          _minimal_energy_ = std::min(e1->get_energy(), e2->get_energy());
+          _maximal_energy_ = std::max(e1->get_energy(), e2->get_energy());
+          _available_ |= GROUP_ENERGY;
+        }
+        _computed_ |= GROUP_ENERGY;
+      }
+
+      if (todo & GROUP_TOF) {
+        const tof_measurement * a_tof
+          = pattern_.find_measurement_as<tof_measurement>(measurement_key(measurement_key::KIND_TOF, _first_, _second_));
+        if (a_tof != 0) {
+          // Only the first probability of each kind is kept
+          if (a_tof->has_internal_probabilities()) {
+            _internal_probability_ = a_tof->get_internal_probabilities().front();
+          }
+          if (a_tof->has_external_probabilities()) {
+            _external_probability_ = a_tof->get_external_probabilities().front();
+          }
+          _available_ |= GROUP_TOF;
+        }
+        _computed_ |= GROUP_TOF;
+      }
+
+      if (todo & GROUP_ANGLE) {
+        const angle_measurement * an_angle
+          = pattern_.find_measurement_as<angle_measurement>(measurement_key(measurement_key::KIND_ANGLE, _first_, _second_));
+        if (an_angle != 0) {
+          _angle_ = an_angle->get_angle();
+          _available_ |= GROUP_ANGLE;
+        }
+        _computed_ |= GROUP_ANGLE;
+      }
+
+      if (todo & GROUP_VERTEX) {
+        const vertex_measurement * a_vertex
+          = pattern_.find_measurement_as<vertex_measurement>(measurement_key(measurement_key::KIND_VERTEX, _first_, _second_));
+        if (a_vertex != 0) {
+          _vertices_probability_ = a_vertex->get_probability();
+          _vertices_distance_x_ = a_vertex->get_vertices_distance_x();
+          _vertices_distance_y_ = a_vertex->get_vertices_distance_y();
+          _vertices_distance_z_ = a_vertex->get_vertices_distance_z();
+          _vertex_location_ = a_vertex->get_location();
+          _vertex_position_x_ = a_vertex->get_vertex_position_x();
+          _vertex_position_y_ = a_vertex->get_vertex_position_y();
+          _vertex_position_z_ = a_vertex->get_vertex_position_z();
+          _available_ |= GROUP_VERTEX;
+        }
+        _computed_ |= GROUP_VERTEX;
+      }
+
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
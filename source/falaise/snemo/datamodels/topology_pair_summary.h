@@ -0,0 +1,237 @@
+/// \file falaise/snemo/datamodels/topology_pair_summary.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Derived quantities of a pair of particles of a topology pattern
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_PAIR_SUMMARY_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_PAIR_SUMMARY_H 1
+
+// Standard library:
+#include <string>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+// - Bayeux/datatools:
+#include <datatools/bit_mask.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_keys.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    class base_topology_pattern;
+
+    /// \brief Derived quantities of a pair of particles of a topology pattern
+    ///
+    /// The scalar quantities of the energy, TOF, angle and vertex measurements
+    /// of a particle pair are fetched once per group and kept here, so that
+    /// pattern getters do not have to look up and type-check the measurements
+    /// on every call. Groups are computed independently so that a deferred
+    /// measurement is only computed when one of its quantities is requested.
+    class topology_pair_summary
+    {
+    public:
+
+      /// Groups of quantities
+      enum group_type {
+        GROUP_NONE   = 0,
+        GROUP_ENERGY = datatools::bit_mask::bit00, //!< Energies of both particles
+        GROUP_TOF    = datatools::bit_mask::bit01, //!< TOF probabilities of the pair
+        GROUP_ANGLE  = datatools::bit_mask::bit02, //!< Angle between both particles
+        GROUP_VERTEX = datatools::bit_mask::bit03, //!< Common vertex of the pair
+        GROUP_ALL    = GROUP_ENERGY | GROUP_TOF | GROUP_ANGLE | GROUP_VERTEX
+      };
+
+      /// Constructor
+      topology_pair_summary(const particle_slot & first_, const particle_slot & second_);
+
+      /// Return the first particle slot
+      const particle_slot & get_first() const
+      {
+        return _first_;
+      }
+
+      /// Return the second particle slot
+      const particle_slot & get_second() const
+      {
+        return _second_;
+      }
+
+      /// Check if some groups have been computed
+      bool is_computed(const uint32_t groups_) const
+      {
+        return (_computed_ & groups_) == groups_;
+      }
+
+      /// Compute the groups not computed yet from the measurements of a pattern
+      void compute(const base_topology_pattern & pattern_, const uint32_t groups_);
+
+      /// Forget all the computed quantities
+      void reset();
+
+      /// Check if both energies are available
+      bool has_energy() const
+      {
+        return _available_ & GROUP_ENERGY;
+      }
+
+      /// Return the minimal energy
+      double get_minimal_energy() const
+      {
+        return _minimal_energy_;
+      }
+
+      /// Return the maximal energy
+      double get_maximal_energy() const
+      {
+        return _maximal_energy_;
+      }
+
+      /// Return the energy sum
+      double get_energy_sum() const
+      {
+        return _minimal_energy_ + _maximal_energy_;
+      }
+
+      /// Return the energy difference
+      double get_energy_difference() const
+      {
+        return _maximal_energy_ - _minimal_energy_;
+      }
+
+      /// Return the slot of the minimal energy particle
+      const particle_slot & get_minimal_energy_slot() const
+      {
+        return _first_is_minimal_ ? _first_ : _second_;
+      }
+
+      /// Return the slot of the maximal energy particle
+      const particle_slot & get_maximal_energy_slot() const
+      {
+        return _first_is_minimal_ ? _second_ : _first_;
+      }
+
+      /// Check if the TOF probabilities are available
+      bool has_tof() const
+      {
+        return _available_ & GROUP_TOF;
+      }
+
+      /// Return the first TOF internal probability
+      double get_internal_probability() const
+      {
+        return _internal_probability_;
+      }
+
+      /// Return the first TOF external probability
+      double get_external_probability() const
+      {
+        return _external_probability_;
+      }
+
+      /// Check if the angle is available
+      bool has_angle() const
+      {
+        return _available_ & GROUP_ANGLE;
+      }
+
+      /// Return the angle between both particles
+      double get_angle() const
+      {
+        return _angle_;
+      }
+
+      /// Check if the common vertex is available
+      bool has_vertex() const
+      {
+        return _available_ & GROUP_VERTEX;
+      }
+
+      /// Return the common vertex probability
+      double get_vertices_probability() const
+      {
+        return _vertices_probability_;
+      }
+
+      /// Return the vertices distance in X
+      double get_vertices_distance_x() const
+      {
+        return _vertices_distance_x_;
+      }
+
+      /// Return the vertices distance in Y
+      double get_vertices_distance_y() const
+      {
+        return _vertices_distance_y_;
+      }
+
+      /// Return the vertices distance in Z
+      double get_vertices_distance_z() const
+      {
+        return _vertices_distance_z_;
+      }
+
+      /// Return the common vertex location label
+      const std::string & get_vertex_location() const
+      {
+        return _vertex_location_;
+      }
+
+      /// Return the common vertex position in X
+      double get_vertex_position_x() const
+      {
+        return _vertex_position_x_;
+      }
+
+      /// Return the common vertex position in Y
+      double get_vertex_position_y() const
+      {
+        return _vertex_position_y_;
+      }
+
+      /// Return the common vertex position in Z
+      double get_vertex_position_z() const
+      {
+        return _vertex_position_z_;
+      }
+
+    private:
+
+      particle_slot _first_;         //!< First particle slot
+      particle_slot _second_;        //!< Second particle slot
+      uint32_t _computed_;           //!< Computed groups
+      uint32_t _available_;          //!< Groups with available measurements
+      double _minimal_energy_;       //!< Minimal energy
+      double _maximal_energy_;       //!< Maximal energy
+      bool _first_is_minimal_;       //!< First particle has strictly the minimal energy
+      double _internal_probability_; //!< TOF internal probability
+      double _external_probability_; //!< TOF external probability
+      double _angle_;                //!< Angle between both particles
+      double _vertices_probability_; //!< Common vertex probability
+      double _vertices_distance_x_;  //!< Vertices distance in X
+      double _vertices_distance_y_;  //!< Vertices distance in Y
+      double _vertices_distance_z_;  //!< Vertices distance in Z
+      std::string _vertex_location_; //!< Common vertex location label
+      double _vertex_position_x_;    //!< Common vertex position in X
+      double _vertex_position_y_;    //!< Common vertex position in Y
+      double _vertex_position_z_;    //!< Common vertex position in Z
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_PAIR_SUMMARY_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -13,10 +13,38 @@ namespace snemo {
     DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(vertex_measurement,
                                                       "snemo::datamodel::vertex_measurement")
 
+    // static
+    const std::string & vertex_measurement::location_label(const location_type location_)
+    {
+      typedef snemo::datamodel::particle_track pt;
+      switch (location_) {
+      case LOCATION_SOURCE_FOIL: return pt::vertex_on_source_foil_label();
+      case LOCATION_WIRE: return pt::vertex_on_wire_label();
+      case LOCATION_MAIN_CALORIMETER: return pt::vertex_on_main_calorimeter_label();
+      case LOCATION_X_CALORIMETER: return pt::vertex_on_x_calorimeter_label();
+      case LOCATION_GAMMA_VETO: return pt::vertex_on_gamma_veto_label();
+      default: break;
+      }
+      return pt::vertex_none_label();
+    }
+
+    // static
+    vertex_measurement::location_type vertex_measurement::location_from_label(const std::string & label_)
+    {
+      typedef snemo::datamodel::particle_track pt;
+      if (label_ == pt::vertex_on_source_foil_label()) return LOCATION_SOURCE_FOIL;
+      if (label_ == pt::vertex_on_wire_label()) return LOCATION_WIRE;
+      if (label_ == pt::vertex_on_main_calorimeter_label()) return LOCATION_MAIN_CALORIMETER;
+      if (label_ == pt::vertex_on_x_calorimeter_label()) return LOCATION_X_CALORIMETER;
+      if (label_ == pt::vertex_on_gamma_veto_label()) return LOCATION_GAMMA_VETO;
+      return LOCATION_NONE;
+    }
+
     vertex_measurement::vertex_measurement()
     {
       _vertex_.invalidate();
       datatools::invalidate(_probability_);
+      _location_ = LOCATION_NONE;
       return;
     }
 
@@ -25,6 +53,15 @@ namespace snemo {
       return;
     }
 
+    void vertex_measurement::clear()
+    {
+      base_topology_measurement::clear();
+      _vertex_.invalidate();
+      datatools::invalidate(_probability_);
+      _location_ = LOCATION_NONE;
+      return;
+    }
+
     bool vertex_measurement::has_vertex() const
     {
       // Only test if placement is valid (blur_spot validation implies a valid
@@ -107,17 +144,26 @@ namespace snemo {
 
     bool vertex_measurement::has_location() const
     {
-      std::string location;
-      _vertex_.get_auxiliaries().fetch("vertex.type",location);
+      return _location_ != LOCATION_NONE;
+    }
+
+    void vertex_measurement::set_location(const location_type location_)
+    {
+      _location_ = location_;
+      // Keep the legacy label for the clients of the vertex auxiliaries
+      _vertex_.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(),
+                                         location_label(location_));
+      return;
+    }
 
-      return location != snemo::datamodel::particle_track::vertex_none_label();
+    vertex_measurement::location_type vertex_measurement::get_location_type() const
+    {
+      return static_cast<location_type>(_location_);
     }
 
     std::string vertex_measurement::get_location() const
     {
-      std::string location;
-      _vertex_.get_auxiliaries().fetch("vertex.type",location);
-      return location;
+      return location_label(get_location_type());
     }
 
     void vertex_measurement::tree_dump(std::ostream      & out_,
@@ -137,6 +183,9 @@ namespace snemo {
         out_ << _probability_/CLHEP::perCent << "%" << std::endl;
       }
 
+      out_ << indent << datatools::i_tree_dumpable::tag
+           << "Location: " << get_location() << std::endl;
+
       out_ << indent << datatools::i_tree_dumpable::tag
            << "Distance: "<< std::endl;
       if (! has_vertices_distance()) {
@@ -9,10 +9,15 @@
 #ifndef FALAISE_SNEMO_DATAMODEL_VERTEX_MEASUREMENT_H
 #define FALAISE_SNEMO_DATAMODEL_VERTEX_MEASUREMENT_H 1
 
+// Standard library:
+#include <string>
+
 // This project
 #include <falaise/snemo/datamodels/base_topology_measurement.h>
 
 // Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
 // - Bayeux/geomtools:
 #include <bayeux/geomtools/blur_spot.h>
 
@@ -25,6 +30,22 @@ namespace snemo {
 
     public:
 
+      /// Vertex locations
+      enum location_type {
+        LOCATION_NONE              = 0,
+        LOCATION_SOURCE_FOIL       = 1,
+        LOCATION_WIRE              = 2,
+        LOCATION_MAIN_CALORIMETER  = 3,
+        LOCATION_X_CALORIMETER     = 4,
+        LOCATION_GAMMA_VETO        = 5
+      };
+
+      /// Return the legacy vertex auxiliary label of a location
+      static const std::string & location_label(const location_type location_);
+
+      /// Return the location of a legacy vertex auxiliary label (LOCATION_NONE if unknown)
+      static location_type location_from_label(const std::string & label_);
+
       /// Constructor
       vertex_measurement();
 
@@ -76,9 +97,18 @@ namespace snemo {
       /// Check location validity
       bool has_location() const;
 
+      /// Set vertex location (also stored as the legacy 'vertex.type' auxiliary of the vertex)
+      void set_location(const location_type location_);
+
       /// Return vertex location
+      location_type get_location_type() const;
+
+      /// Return vertex location as its legacy label
       std::string get_location() const;
 
+      /// Clear the measurement
+      virtual void clear();
+
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
                              const std::string & title_  = "",
@@ -89,6 +119,7 @@ namespace snemo {
 
       double _probability_;          //!< Chi2 probability of the vertex
       geomtools::blur_spot _vertex_; //!< 3D position and associated errors
+      uint8_t _location_;            //!< Vertex location (see location_type)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
     };
@@ -101,6 +132,11 @@ namespace snemo {
 BOOST_CLASS_EXPORT_KEY2(snemo::datamodel::vertex_measurement,
                         "snemo::datamodel::vertex_measurement")
 
+// Class version 1: the location is stored as a location_type code instead
+// of the "vertex.type" auxiliary property of the vertex
+#include <boost/serialization/version.hpp>
+BOOST_CLASS_VERSION(snemo::datamodel::vertex_measurement, 1)
+
 #endif // FALAISE_SNEMO_DATAMODEL_VERTEX_MEASUREMENT_H
 
 /*
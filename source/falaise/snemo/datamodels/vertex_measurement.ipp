@@ -17,6 +17,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/base_topology_measurement.ipp>
+#include <falaise/snemo/datamodels/particle_track.h>
 
 namespace snemo {
 
@@ -24,11 +25,21 @@ namespace snemo {
 
     /// Serialization method
     template<class Archive>
-    void vertex_measurement::serialize(Archive & ar_, const unsigned int /* version_ */)
+    void vertex_measurement::serialize(Archive & ar_, const unsigned int version_)
     {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_topology_measurement);
       ar_ & boost::serialization::make_nvp("probability", _probability_);
       ar_ & boost::serialization::make_nvp("vertex", _vertex_);
+      if (version_ >= 1) {
+        ar_ & boost::serialization::make_nvp("location", _location_);
+      } else if (Archive::is_loading::value) {
+        // Version 0 stored the location as an auxiliary property of the vertex
+        const datatools::properties & aux = _vertex_.get_auxiliaries();
+        _location_ = LOCATION_NONE;
+        if (aux.has_key(snemo::datamodel::particle_track::vertex_type_key())) {
+          _location_ = location_from_label(aux.fetch_string(snemo::datamodel::particle_track::vertex_type_key()));
+        }
+      }
       return;
     }
 
@@ -11,6 +11,7 @@
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
 
 namespace snemo {
 
@@ -94,8 +95,7 @@ namespace snemo {
     void angle_driver::process(const snemo::datamodel::particle_track & pt_,
                                snemo::datamodel::angle_measurement & angle_)
     {
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
-      this->_process_algo(pt_, angle_.grab_angle());
+      process(pt_, snemo::datamodel::pid_utils::fetch_particle_type(pt_), angle_);
       return;
     }
 
@@ -103,12 +103,52 @@ namespace snemo {
                                const snemo::datamodel::particle_track & pt2_,
                                snemo::datamodel::angle_measurement & angle_)
     {
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
-      this->_process_algo(pt1_, pt2_, angle_.grab_angle());
+      process(pt1_, snemo::datamodel::pid_utils::fetch_particle_type(pt1_),
+              pt2_, snemo::datamodel::pid_utils::fetch_particle_type(pt2_), angle_);
       return;
     }
 
-    void angle_driver::_process_algo(const snemo::datamodel::particle_track & pt_,
+    void angle_driver::process(const snemo::datamodel::particle_track & pt_,
+                               const snemo::datamodel::pid_utils::particle_type type_,
+                               snemo::datamodel::angle_measurement & angle_)
+    {
+      kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(type_, 1), pt_);
+      process(kc.get(0), angle_);
+      return;
+    }
+
+    void angle_driver::process(const snemo::datamodel::particle_track & pt1_,
+                               const snemo::datamodel::pid_utils::particle_type type1_,
+                               const snemo::datamodel::particle_track & pt2_,
+                               const snemo::datamodel::pid_utils::particle_type type2_,
+                               snemo::datamodel::angle_measurement & angle_)
+    {
+      kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(type1_, 1), pt1_);
+      kc.add(snemo::datamodel::particle_slot(type2_, 2), pt2_);
+      process(kc.get(0), kc.get(1), angle_);
+      return;
+    }
+
+    void angle_driver::process(const particle_kinematics & k_,
+                               snemo::datamodel::angle_measurement & angle_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(k_, angle_.grab_angle());
+      return;
+    }
+
+    void angle_driver::process(const particle_kinematics & k1_,
+                               const particle_kinematics & k2_,
+                               snemo::datamodel::angle_measurement & angle_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(k1_, k2_, angle_.grab_angle());
+      return;
+    }
+
+    void angle_driver::_process_algo(const particle_kinematics & k_,
                                      double & angle_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
@@ -116,14 +156,13 @@ namespace snemo {
       // Invalidate angle meas.
       datatools::invalidate(angle_);
 
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt_)) {
+      if (k_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
         DT_LOG_WARNING(get_logging_priority(),
                        "No angle can be deduced from a single gamma !");
         return;
       }
-      geomtools::vector_3d particle_dir;
-      geomtools::invalidate(particle_dir);
-      _get_direction(pt_, particle_dir);
+      _check_direction(k_);
+      const geomtools::vector_3d & particle_dir = k_.direction;
 
       if (geomtools::is_valid(particle_dir)) {
         geomtools::vector_3d Ox(1,0,0);
@@ -134,8 +173,8 @@ namespace snemo {
       return;
     }
 
-    void angle_driver::_process_algo(const snemo::datamodel::particle_track & pt1_,
-                                     const snemo::datamodel::particle_track & pt2_,
+    void angle_driver::_process_algo(const particle_kinematics & k1_,
+                                     const particle_kinematics & k2_,
                                      double & angle_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
@@ -143,18 +182,16 @@ namespace snemo {
       // Invalidate angle meas.
       datatools::invalidate(angle_);
 
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) &&
-          snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
+      if (k1_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA &&
+          k2_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
         DT_LOG_WARNING(get_logging_priority(), "The two particles are gammas ! No angle can be measured !");
         return;
       }
 
-      geomtools::vector_3d particle_dir1;
-      geomtools::invalidate(particle_dir1);
-      _get_direction(pt1_, particle_dir1);
-      geomtools::vector_3d particle_dir2;
-      geomtools::invalidate(particle_dir2);
-      _get_direction(pt2_, particle_dir2);
+      _check_direction(k1_);
+      _check_direction(k2_);
+      const geomtools::vector_3d & particle_dir1 = k1_.direction;
+      const geomtools::vector_3d & particle_dir2 = k2_.direction;
 
       if (geomtools::is_valid(particle_dir1) && geomtools::is_valid(particle_dir2)) {
         angle_ = std::acos(particle_dir1 * particle_dir2) / M_PI * 180 * CLHEP::degree;
@@ -163,57 +200,17 @@ namespace snemo {
       return;
     }
 
-    void angle_driver::_get_direction(const snemo::datamodel::particle_track & pt_,
-                                      geomtools::vector_3d & direction_)
+    void angle_driver::_check_direction(const particle_kinematics & k_) const
     {
-      // Invalidate direction
-      geomtools::invalidate(direction_);
-
-      // Get foil vertices from particle tracks
-      const snemo::datamodel::particle_track::vertex_collection_type & the_vertices = pt_.get_vertices();
-      geomtools::vector_3d foil_vertex;
-      geomtools::invalidate(foil_vertex);
-      for (snemo::datamodel::particle_track::vertex_collection_type::const_iterator
-             i_vtx = the_vertices.begin(); i_vtx != the_vertices.end(); ++i_vtx) {
-        if (! snemo::datamodel::particle_track::vertex_is_on_source_foil(i_vtx->get()))
-          continue;
-
-        foil_vertex = i_vtx->get().get_position();
-        break;
-      }
-      // For now only consider the angle computation for particles with a vertex on the foil.
-      // Would/Should work for charged particles
-      // Could be done for charged particle/gamma angle  but it would require to add an orgin vertex to every gamma (by default source ?)
-      if (! geomtools::is_valid(foil_vertex)) {
-        // DT_LOG_WARNING(get_logging_priority(), "Particle has no vertices on the source foil !");
-        return;
-      }
-
-      // Check particle type
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt_)) {
+      // The direction (computed once per particle) is only available for
+      // particles with a vertex on the foil: gammas use their first
+      // calorimeter vertex, charged particles their trajectory.
+      if (! geomtools::is_valid(k_.foil_vertex)) return;
+      if (k_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
         DT_LOG_TRACE(get_logging_priority(), "Particle track is a gamma !");
-        // Get the first vertex on calorimeter (should be the first associated calorimeter)
-        for (snemo::datamodel::particle_track::vertex_collection_type::const_iterator
-               i_vtx = the_vertices.begin(); i_vtx != the_vertices.end(); ++i_vtx) {
-          if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(i_vtx->get()) ||
-              snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(i_vtx->get())    ||
-              snemo::datamodel::particle_track::vertex_is_on_gamma_veto(i_vtx->get())) {
-            const geomtools::vector_3d & calo_vertex = i_vtx->get().get_position();
-            direction_ = calo_vertex - foil_vertex;
-            break;
-          }
-        }
-      } else if (pt_.has_trajectory()) {
-        const snemo::datamodel::tracker_trajectory & a_trajectory = pt_.get_trajectory();
-        const snemo::datamodel::base_trajectory_pattern & a_track_pattern = a_trajectory.get_pattern();
-        direction_ = a_track_pattern.get_shape().get_direction_on_curve(foil_vertex);
-      } else {
+      } else if (! k_.track->has_trajectory()) {
         DT_LOG_WARNING(get_logging_priority(), "Particle track has no tracker trajectory associated !");
-        return;
       }
-
-      // Return a normalized direction
-      direction_ /= direction_.mag();
       return;
     }
 
@@ -40,6 +40,9 @@
 // - Bayeux/geomtools:
 #include <bayeux/geomtools/clhep.h>
 
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+
 namespace snemo {
 
   namespace datamodel {
@@ -49,6 +52,8 @@ namespace snemo {
 
   namespace reconstruction {
 
+    struct particle_kinematics;
+
     /// Driver for the angle measurement algorithms
     class angle_driver
     {
@@ -84,6 +89,27 @@ namespace snemo {
                    const snemo::datamodel::particle_track & pt2_,
                    snemo::datamodel::angle_measurement & angle_);
 
+      /// Main process for single particle angle measurement with particle type already identified
+      void process(const snemo::datamodel::particle_track & pt_,
+                   const snemo::datamodel::pid_utils::particle_type type_,
+                   snemo::datamodel::angle_measurement & angle_);
+
+      /// Main process for angle between two particle tracks with particle types already identified
+      void process(const snemo::datamodel::particle_track & pt1_,
+                   const snemo::datamodel::pid_utils::particle_type type1_,
+                   const snemo::datamodel::particle_track & pt2_,
+                   const snemo::datamodel::pid_utils::particle_type type2_,
+                   snemo::datamodel::angle_measurement & angle_);
+
+      /// Main process for single particle angle measurement from the cached particle kinematics
+      void process(const particle_kinematics & k_,
+                   snemo::datamodel::angle_measurement & angle_);
+
+      /// Main process for angle between two particles from the cached particle kinematics
+      void process(const particle_kinematics & k1_,
+                   const particle_kinematics & k2_,
+                   snemo::datamodel::angle_measurement & angle_);
+
       /// Reset the driver
       void reset();
 
@@ -99,17 +125,16 @@ namespace snemo {
       void _set_defaults();
 
       /// Special method to process single particle track
-      void _process_algo(const snemo::datamodel::particle_track & pt_,
+      void _process_algo(const particle_kinematics & k_,
                          double & angle_);
 
       /// Special method to process two particle tracks
-      void _process_algo(const snemo::datamodel::particle_track & pt1_,
-                         const snemo::datamodel::particle_track & pt2_,
+      void _process_algo(const particle_kinematics & k1_,
+                         const particle_kinematics & k2_,
                          double & angle_);
 
-      /// Get direction of a particle track
-      void _get_direction(const snemo::datamodel::particle_track & pt_,
-                          geomtools::vector_3d & direction_);
+      /// Report particles without direction
+      void _check_direction(const particle_kinematics & k_) const;
 
     private:
       bool                        _initialized_;      //!< Initialization status
@@ -3,10 +3,17 @@
 
 // Ourselves:
 #include <falaise/snemo/reconstruction/base_topology_builder.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+
+// Standard library:
+#include <algorithm>
+#include <future>
 
 // - Falaise:
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/pid_data.h>
+#include <falaise/snemo/datamodels/event_time_measurement.h>
 
 namespace snemo {
 
@@ -31,9 +38,78 @@ namespace snemo {
       return *_drivers;
     }
 
+    bool base_topology_builder::has_pool() const
+    {
+      return _pool != 0;
+    }
+
+    void base_topology_builder::set_pool(topology_pool & pool_)
+    {
+      _pool = &pool_;
+      return;
+    }
+
+    void base_topology_builder::reset_pool()
+    {
+      _pool = 0;
+      return;
+    }
+
+    void base_topology_builder::set_parallel_gammas(const size_t threshold_,
+                                                    const std::vector<const measurement_drivers *> & lanes_)
+    {
+      _parallel_gammas_threshold = threshold_;
+      _gamma_lanes = lanes_;
+      return;
+    }
+
+    size_t base_topology_builder::get_parallel_gammas_threshold() const
+    {
+      return _parallel_gammas_threshold;
+    }
+
+    void base_topology_builder::set_lazy_measurements(const bool lazy_)
+    {
+      _lazy_measurements = lazy_;
+      return;
+    }
+
+    bool base_topology_builder::is_lazy_measurements() const
+    {
+      return _lazy_measurements;
+    }
+
+    void base_topology_builder::set_required_measurements(const std::set<snemo::datamodel::measurement_key> * labels_)
+    {
+      _required_measurements = labels_;
+      return;
+    }
+
+    bool base_topology_builder::is_measurement_required(const snemo::datamodel::measurement_key & label_) const
+    {
+      // Particle pair TOF is skipped when only the event time is fitted
+      if (label_.get_kind() == snemo::datamodel::measurement_key::KIND_TOF &&
+          _drivers != 0 && _drivers->TOFD && ! _drivers->TOFD->is_pairwise_mode()) {
+        return false;
+      }
+      if (_required_measurements == 0) return true;
+      return _required_measurements->count(label_) != 0;
+    }
+
+    void base_topology_builder::set_calorimeter_index(const snemo::datamodel::calorimeter_index * index_)
+    {
+      _calorimeter_index = index_;
+      return;
+    }
+
     base_topology_builder::base_topology_builder()
     {
       _drivers = 0;
+      _parallel_gammas_threshold = 0;
+      _pool = 0;
+      _calorimeter_index = 0;
+      _lazy_measurements = false;
+      _required_measurements = 0;
       return;
     }
 
@@ -49,42 +125,122 @@ namespace snemo {
 
     void base_topology_builder::build(const snemo::datamodel::particle_track_data & source_,
                                       snemo::datamodel::base_topology_pattern & pattern_)
+    {
+      snemo::datamodel::pid_data a_pid;
+      snemo::datamodel::pid_utils::fetch_pid_data(source_, a_pid);
+      build(source_, a_pid, pattern_);
+      return;
+    }
+
+    void base_topology_builder::build(const snemo::datamodel::particle_track_data & source_,
+                                      const snemo::datamodel::pid_data & pid_,
+                                      snemo::datamodel::base_topology_pattern & pattern_)
     {
       DT_THROW_IF(! has_measurement_drivers(), std::logic_error, "Missing measurement drivers !");
-      this->_build_particle_tracks_dictionary(source_, pattern_.grab_particle_track_dictionary());
+      this->_build_particle_tracks_dictionary(source_, pid_, pattern_.grab_particle_track_dictionary());
+      _build_kinematics(source_, pid_);
       _build_measurement_dictionary(pattern_);
+      _build_event_time_measurement(pattern_);
+      return;
+    }
+
+    void base_topology_builder::_build_event_time_measurement(snemo::datamodel::base_topology_pattern & pattern_)
+    {
+      const measurement_drivers * drivers = _drivers;
+      if (! drivers->TOFD || ! drivers->TOFD->is_event_time_mode()) return;
+      static const snemo::datamodel::measurement_key event_time_label
+        (snemo::datamodel::event_time_measurement::measurement_label());
+      if (! is_measurement_required(event_time_label)) return;
+
+      // One fit over all the particles of the event
+      snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
+        = pattern_.grab_measurement_dictionary();
+      snemo::datamodel::event_time_measurement * event_time
+        = &_create_measurement<snemo::datamodel::event_time_measurement>(meas[event_time_label]);
+      const kinematics_handle_type kin = _get_kinematics();
+      _compute_measurement(pattern_, event_time_label, [drivers, kin, event_time]() {
+          drivers->TOFD->process(*kin, *event_time);
+        });
+      return;
+    }
+
+    void base_topology_builder::_build_kinematics(const snemo::datamodel::particle_track_data & source_,
+                                                  const snemo::datamodel::pid_data & pid_)
+    {
+      // Reuse the cache unless measurements of previous events still refer to it
+      if (! _kinematics || _kinematics.use_count() != 1) {
+        _kinematics = std::make_shared<kinematics_cache>();
+      }
+      _kinematics->build(source_, pid_, _calorimeter_index);
+      return;
+    }
+
+    base_topology_builder::kinematics_handle_type base_topology_builder::_get_kinematics() const
+    {
+      DT_THROW_IF(! _kinematics, std::logic_error, "Particle kinematics have not been built !");
+      return _kinematics;
+    }
+
+    void base_topology_builder::_run_gamma_tasks(const std::vector<gamma_task_type> & tasks_) const
+    {
+      const size_t nlanes = std::min(tasks_.size(), _gamma_lanes.size() + 1);
+      if (_parallel_gammas_threshold == 0 || tasks_.size() < _parallel_gammas_threshold || nlanes < 2) {
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+          tasks_[i](*_drivers);
+        }
+        return;
+      }
+
+      // Drivers are not reentrant: each lane computes every nlanes-th gamma
+      // with its own drivers, the first lane within the current thread
+      auto run_lane = [&tasks_, nlanes] (const measurement_drivers * drivers_, const size_t lane_)
+        {
+          for (size_t i = lane_; i < tasks_.size(); i += nlanes) {
+            tasks_[i](*drivers_);
+          }
+        };
+      std::vector<std::future<void> > futures;
+      futures.reserve(nlanes - 1);
+      for (size_t lane = 1; lane < nlanes; ++lane) {
+        futures.push_back(std::async(std::launch::async, run_lane, _gamma_lanes[lane - 1], lane));
+      }
+      run_lane(_drivers, 0);
+      // Wait for completion (and propagate exceptions if any)
+      for (size_t i = 0; i < futures.size(); ++i) {
+        futures[i].get();
+      }
+      return;
+    }
+
+    void base_topology_builder::_compute_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                     const snemo::datamodel::measurement_key & label_,
+                                                     const measurement_task_type & task_) const
+    {
+      if (_lazy_measurements) {
+        pattern_.set_pending_measurement(label_, task_);
+      } else {
+        task_();
+      }
+      return;
     }
 
     void base_topology_builder::_build_particle_tracks_dictionary(const snemo::datamodel::particle_track_data & ptd_,
+                                                                  const snemo::datamodel::pid_data & pid_,
                                                                   snemo::datamodel::base_topology_pattern::particle_track_dict_type & tracks_)
     {
-      size_t n_electrons = 0;
-      size_t n_positrons = 0;
-      size_t n_alphas    = 0;
-      size_t n_gammas    = 0;
+      typedef snemo::datamodel::pid_utils pu;
+      size_t n_particles[pu::NUMBER_OF_PARTICLE_TYPES] = {0, 0, 0, 0, 0};
       const snemo::datamodel::particle_track_data::particle_collection_type & the_particles
         = ptd_.get_particles();
-      for (snemo::datamodel::particle_track_data::particle_collection_type::const_iterator
-             i_particle = the_particles.begin();
-           i_particle != the_particles.end(); ++i_particle) {
-        const snemo::datamodel::particle_track & a_particle = i_particle->get();
-        std::ostringstream key;
-        if (snemo::datamodel::pid_utils::particle_is_electron(a_particle)) {
-          key << "e" << ++n_electrons;
-        }
-        else if (snemo::datamodel::pid_utils::particle_is_positron(a_particle)) {
-          key << "p" << ++n_positrons;
-        }
-        else if (snemo::datamodel::pid_utils::particle_is_alpha(a_particle)) {
-          key << "a" << ++n_alphas;
-        }
-        else if (snemo::datamodel::pid_utils::particle_is_gamma(a_particle)) {
-          key << "g" << ++n_gammas;
-        }
-        else {
+      DT_THROW_IF(pid_.get_number_of_particles() != the_particles.size(), std::logic_error,
+                  "PID bank does not match the particle track data !");
+      for (size_t i_particle = 0; i_particle < the_particles.size(); ++i_particle) {
+        const pu::particle_type a_type = pid_.get_particle_type(i_particle);
+        if (a_type == pu::PARTICLE_UNDEFINED) {
           continue; // no undefined particles for now
         }
-        tracks_[key.str()] = *i_particle;
+        const snemo::datamodel::particle_slot key(a_type, ++n_particles[a_type]);
+        tracks_[key] = the_particles[i_particle];
       }
       return;
     }
@@ -9,6 +9,13 @@
 #ifndef FALAISE_SNEMO_DATAMODEL_BASE_TOPOLOGY_BUILDER_H
 #define FALAISE_SNEMO_DATAMODEL_BASE_TOPOLOGY_BUILDER_H 1
 
+// Standard library:
+#include <vector>
+#include <set>
+#include <string>
+#include <functional>
+#include <memory>
+
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/factory_macros.h>
@@ -16,6 +23,8 @@
 
 // This project:
 #include <falaise/snemo/reconstruction/topology_driver.h>
+#include <falaise/snemo/reconstruction/topology_pool.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
 
 namespace snemo {
@@ -23,6 +32,7 @@ namespace snemo {
   // Forward declaration
   namespace datamodel {
     class particle_track_data;
+    class pid_data;
   }
 
   namespace reconstruction {
@@ -41,18 +51,55 @@ namespace snemo {
       /// Get a non-mutable reference to measurement drivers
       const measurement_drivers & get_measurement_drivers() const;
 
+      /// Check if an object pool is available
+      bool has_pool() const;
+
+      /// Set the pool of recyclable patterns and measurements
+      void set_pool(topology_pool &);
+
+      /// Reset the pool of recyclable patterns and measurements
+      void reset_pool();
+
+      /// Compute per-gamma measurements concurrently from a number of gammas
+      /// (0 to disable), each concurrent lane using its own measurement drivers
+      void set_parallel_gammas(const size_t threshold_,
+                               const std::vector<const measurement_drivers *> & lanes_);
+
+      /// Return the number of gammas from which per-gamma measurements are computed concurrently
+      size_t get_parallel_gammas_threshold() const;
+
+      /// Set the lazy measurement mode (measurements computed at first access)
+      void set_lazy_measurements(const bool lazy_);
+
+      /// Check the lazy measurement mode
+      bool is_lazy_measurements() const;
+
+      /// Restrict the computed measurements to a set of labels (all measurements if null)
+      void set_required_measurements(const std::set<snemo::datamodel::measurement_key> * labels_);
+
+      /// Check if a measurement has to be computed
+      bool is_measurement_required(const snemo::datamodel::measurement_key & label_) const;
+
+      /// Match calorimeter blocks through their dense index (null to compare geom_ids)
+      void set_calorimeter_index(const snemo::datamodel::calorimeter_index * index_);
+
       /// Pure virtual method to create a topology pattern related to topology builder
       virtual snemo::datamodel::base_topology_pattern::handle_type create_pattern();
 
-      /// Main function to build topology pattern
+      /// Main function to build topology pattern (PID fetched from particle track auxiliaries)
+      virtual void build(const snemo::datamodel::particle_track_data & source_,
+                         snemo::datamodel::base_topology_pattern & pattern_);
+
+      /// Main function to build topology pattern given the PID bank
       virtual void build(const snemo::datamodel::particle_track_data & source_,
+                         const snemo::datamodel::pid_data & pid_,
                          snemo::datamodel::base_topology_pattern & pattern_);
 
       /// Constructor
       base_topology_builder();
 
       /// Destructor
-      ~base_topology_builder();
+      virtual ~base_topology_builder();
 
     protected:
 
@@ -60,13 +107,67 @@ namespace snemo {
       virtual snemo::datamodel::base_topology_pattern::handle_type _create_pattern() = 0;
 
       virtual void _build_particle_tracks_dictionary(const snemo::datamodel::particle_track_data & source_,
+                                                     const snemo::datamodel::pid_data & pid_,
                                                      snemo::datamodel::base_topology_pattern::particle_track_dict_type & tracks_);
 
       virtual void _build_measurement_dictionary(snemo::datamodel::base_topology_pattern & pattern_) = 0;
 
+      /// Attach the event time measurement fitted over all the particles (TOF event time mode)
+      void _build_event_time_measurement(snemo::datamodel::base_topology_pattern & pattern_);
+
+      /// Return a pattern of type T, recycled from the pool if any
+      template<class T>
+      snemo::datamodel::base_topology_pattern::handle_type _make_pattern()
+      {
+        if (has_pool()) return _pool->create_pattern<T>();
+        snemo::datamodel::base_topology_pattern::handle_type h(new T);
+        return h;
+      }
+
+      /// Attach to the measurement handle a measurement of type T, recycled from the pool if any
+      template<class T>
+      T & _create_measurement(snemo::datamodel::base_topology_pattern::handle_measurement & handle_)
+      {
+        if (has_pool()) return _pool->create_measurement<T>(handle_);
+        T * ptr = new T;
+        handle_.reset(ptr);
+        return *ptr;
+      }
+
+      /// Typedef for the shared handle to the particle kinematics of the event
+      typedef std::shared_ptr<const kinematics_cache> kinematics_handle_type;
+
+      /// Fill the event view and compute the kinematics of every particle once
+      void _build_kinematics(const snemo::datamodel::particle_track_data & source_,
+                             const snemo::datamodel::pid_data & pid_);
+
+      /// Return the particle kinematics of the event being built
+      kinematics_handle_type _get_kinematics() const;
+
+      /// Typedef for a block of measurements to be computed
+      typedef std::function<void()> measurement_task_type;
+
+      /// Typedef for the measurements of a gamma, computed with the given drivers
+      typedef std::function<void(const measurement_drivers &)> gamma_task_type;
+
+      /// Run per-gamma measurement tasks, concurrently if the number of gammas reaches the threshold
+      void _run_gamma_tasks(const std::vector<gamma_task_type> & tasks_) const;
+
+      /// Compute a measurement right away or, in lazy mode, at its first access
+      void _compute_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                const snemo::datamodel::measurement_key & label_,
+                                const measurement_task_type & task_) const;
+
     protected:
 
       const measurement_drivers * _drivers;//!< Measurement drivers
+      size_t _parallel_gammas_threshold;   //!< Number of gammas from which per-gamma measurements run concurrently
+      std::vector<const measurement_drivers *> _gamma_lanes; //!< Measurement drivers of the concurrent per-gamma lanes
+      bool _lazy_measurements;             //!< Measurements computed at first access
+      const std::set<snemo::datamodel::measurement_key> * _required_measurements; //!< Keys of the measurements to compute
+      topology_pool * _pool;               //!< Pool of recyclable patterns and measurements
+      const snemo::datamodel::calorimeter_index * _calorimeter_index; //!< Dense index of the calorimeter blocks
+      std::shared_ptr<kinematics_cache> _kinematics; //!< Particle kinematics of the event being built
 
       // Factory stuff :
       DATATOOLS_FACTORY_SYSTEM_REGISTER_INTERFACE(base_topology_builder)
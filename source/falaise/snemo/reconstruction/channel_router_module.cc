@@ -0,0 +1,428 @@
+/// \file falaise/snemo/reconstruction/channel_router_module.cc
+
+// Ourselves:
+#include <snemo/reconstruction/channel_router_module.h>
+
+// Standard library:
+#include <algorithm>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/service_manager.h>
+// - Bayeux/cuts:
+#include <cuts/cut_service.h>
+#include <cuts/cut_manager.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/processing/services.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    // Registration instantiation macro :
+    DPP_MODULE_REGISTRATION_IMPLEMENT(channel_router_module,
+                                      "snemo::reconstruction::channel_router_module")
+
+    const size_t channel_router_module::MAX_NUMBER_OF_CHANNELS;
+
+    void channel_router_module::_set_defaults()
+    {
+      _TD_label_ = "TD";//snemo::datamodel::data_info::default_topology_data_label();
+      _CR_label_ = "CR";
+      _first_match_only_ = false;
+      _cut_graph_.clear();
+      _channels_.clear();
+      _unclassified_.clear();
+      _all_channels_.clear();
+      _dispatch_.clear();
+      _default_module_.reset();
+      return;
+    }
+
+    // Initialization :
+    void channel_router_module::initialize(const datatools::properties  & setup_,
+                                           datatools::service_manager   & service_manager_,
+                                           dpp::module_handle_dict_type & module_dict_)
+    {
+      DT_THROW_IF (is_initialized(),
+                   std::logic_error,
+                   "Module '" << get_name() << "' is already initialized ! ");
+
+      dpp::base_module::_common_initialize(setup_);
+
+      if (setup_.has_key("TD_label")) {
+        _TD_label_ = setup_.fetch_string("TD_label");
+      }
+
+      if (setup_.has_key("CR_label")) {
+        _CR_label_ = setup_.fetch_string("CR_label");
+      }
+
+      if (setup_.has_key("first_match_only")) {
+        _first_match_only_ = setup_.fetch_boolean("first_match_only");
+      }
+
+      // Cut manager :
+      std::string cut_label = snemo::processing::service_info::default_cut_service_label();
+      if (setup_.has_key("Cut_label")) {
+        cut_label = setup_.fetch_string("Cut_label");
+      }
+      DT_THROW_IF(cut_label.empty(), std::logic_error,
+                  "Module '" << get_name() << "' has no valid '" << "Cut_label" << "' property !");
+      DT_THROW_IF(! service_manager_.has(cut_label) ||
+                  ! service_manager_.is_a<cuts::cut_service>(cut_label),
+                  std::logic_error,
+                  "Module '" << get_name() << "' has no '" << cut_label << "' service !");
+      cuts::cut_service & Cut
+        = service_manager_.grab<cuts::cut_service>(cut_label);
+      _cut_graph_.set_cut_manager(Cut.grab_cut_manager());
+
+      // Channels :
+      DT_THROW_IF(! setup_.has_key("channels"), std::logic_error,
+                  "Module '" << get_name() << "' has no 'channels' list !");
+      std::vector<std::string> channel_names;
+      setup_.fetch("channels", channel_names);
+      DT_THROW_IF(channel_names.size() > MAX_NUMBER_OF_CHANNELS, std::logic_error,
+                  "Module '" << get_name() << "' has too many channels (" << channel_names.size() << ") !");
+      for (size_t i = 0; i < channel_names.size(); ++i) {
+        channel_type a_channel;
+        a_channel.name = channel_names[i];
+        const std::string cut_key = a_channel.name + ".cut";
+        DT_THROW_IF(! setup_.has_key(cut_key), std::logic_error,
+                    "Missing '" << cut_key << "' property !");
+        a_channel.node = _cut_graph_.add_cut(setup_.fetch_string(cut_key));
+
+        const std::string module_key = a_channel.name + ".module";
+        if (setup_.has_key(module_key)) {
+          const std::string module_name = setup_.fetch_string(module_key);
+          dpp::module_handle_dict_type::iterator found = module_dict_.find(module_name);
+          DT_THROW_IF(found == module_dict_.end(), std::logic_error,
+                      "Module '" << get_name() << "' : no module named '" << module_name << "' !");
+          a_channel.module = found->second.grab_initialized_module_handle();
+        }
+
+        // Look for a classification the event must have to enter the channel
+        a_channel.has_classification = false;
+        a_channel.classification = 0;
+        std::vector<size_t> leaves;
+        _cut_graph_.fetch_required_leaves(a_channel.node, leaves);
+        for (size_t ileaf = 0; ileaf < leaves.size(); ++ileaf) {
+          const snemo::cut::cut_graph::node_type & a_leaf = _cut_graph_.get_node(leaves[ileaf]);
+          if (a_leaf.cut_id != "snemo::cut::topology_data_cut") continue;
+          const datatools::properties & a_config = *a_leaf.config;
+          if (! a_config.has_flag("mode.classification")) continue;
+          if (! a_config.has_key("classification.label")) continue;
+          if (a_config.has_key("TD_label") && a_config.fetch_string("TD_label") != _TD_label_) continue;
+          // Regular expressions are not indexed: the channel is tried for every event
+          if (! snemo::datamodel::pid_utils::parse_classification_label(a_config.fetch_string("classification.label"),
+                                                                       a_channel.classification)) continue;
+          a_channel.has_classification = true;
+          break;
+        }
+        DT_LOG_DEBUG(get_logging_priority(), "Channel '" << a_channel.name << "' : "
+                     << (a_channel.has_classification ?
+                         snemo::datamodel::pid_utils::classification_label(a_channel.classification) :
+                         std::string("any classification")));
+        _channels_.push_back(a_channel);
+      }
+
+      // Dispatch table, channels being kept in configuration order
+      for (size_t i = 0; i < _channels_.size(); ++i) {
+        _all_channels_.push_back(i);
+        if (_channels_[i].has_classification) {
+          _dispatch_[_channels_[i].classification].push_back(i);
+        } else {
+          _unclassified_.push_back(i);
+        }
+      }
+      for (std::map<snemo::datamodel::pid_utils::classification_code_type,
+             std::vector<size_t> >::iterator i = _dispatch_.begin(); i != _dispatch_.end(); ++i) {
+        std::vector<size_t> & candidates = i->second;
+        candidates.insert(candidates.end(), _unclassified_.begin(), _unclassified_.end());
+        std::sort(candidates.begin(), candidates.end());
+      }
+      DT_LOG_DEBUG(get_logging_priority(), "Number of shared cut nodes : "
+                   << _cut_graph_.get_number_of_nodes());
+
+      if (setup_.has_key("default_module")) {
+        const std::string module_name = setup_.fetch_string("default_module");
+        dpp::module_handle_dict_type::iterator found = module_dict_.find(module_name);
+        DT_THROW_IF(found == module_dict_.end(), std::logic_error,
+                    "Module '" << get_name() << "' : no module named '" << module_name << "' !");
+        _default_module_ = found->second.grab_initialized_module_handle();
+      }
+
+      _set_initialized(true);
+      return;
+    }
+
+    void channel_router_module::reset()
+    {
+      DT_THROW_IF (! is_initialized(), std::logic_error,
+                   "Module '" << get_name() << "' is not initialized !");
+      _set_initialized(false);
+      _set_defaults();
+      return;
+    }
+
+    // Constructor :
+    channel_router_module::channel_router_module(datatools::logger::priority logging_priority_)
+      : dpp::base_module(logging_priority_)
+    {
+      _set_defaults();
+      return;
+    }
+
+    // Destructor :
+    channel_router_module::~channel_router_module()
+    {
+      if (is_initialized()) channel_router_module::reset();
+      return;
+    }
+
+    size_t channel_router_module::get_number_of_channels() const
+    {
+      return _channels_.size();
+    }
+
+    const std::string & channel_router_module::get_channel_name(const size_t channel_) const
+    {
+      DT_THROW_IF(channel_ >= _channels_.size(), std::range_error,
+                  "Invalid channel index (" << channel_ << ") !");
+      return _channels_[channel_].name;
+    }
+
+    const std::vector<size_t> &
+    channel_router_module::_get_candidates(const datatools::things & data_record_) const
+    {
+      if (_dispatch_.empty() || ! data_record_.has(_TD_label_)) return _unclassified_;
+      const snemo::datamodel::topology_data & TD
+        = data_record_.get<snemo::datamodel::topology_data>(_TD_label_);
+      const datatools::properties & td_aux = TD.get_auxiliaries();
+      const std::string & code_key = snemo::datamodel::pid_utils::classification_code_key();
+      // Classification cuts may still match through the classification label
+      if (! td_aux.has_key(code_key)) return _all_channels_;
+      const snemo::datamodel::pid_utils::classification_code_type a_code = td_aux.fetch_integer(code_key);
+      std::map<snemo::datamodel::pid_utils::classification_code_type,
+               std::vector<size_t> >::const_iterator found = _dispatch_.find(a_code);
+      if (found == _dispatch_.end()) return _unclassified_;
+      return found->second;
+    }
+
+    channel_router_module::mask_type channel_router_module::route(const datatools::things & data_record_)
+    {
+      DT_THROW_IF (! is_initialized(), std::logic_error,
+                   "Module '" << get_name() << "' is not initialized !");
+
+      // Sub-cut results are shared by all the channels for this event
+      _cut_graph_.reset_results();
+
+      mask_type a_mask = 0;
+      const std::vector<size_t> & candidates = _get_candidates(data_record_);
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        const channel_type & a_channel = _channels_[candidates[i]];
+        const int status = _cut_graph_.evaluate(a_channel.node, data_record_);
+        if (status != cuts::SELECTION_ACCEPTED) continue;
+        DT_LOG_DEBUG(get_logging_priority(), "Event belongs to '" << a_channel.name << "' channel");
+        a_mask |= (1 << candidates[i]);
+        if (_first_match_only_) break;
+      }
+      return a_mask;
+    }
+
+    // Processing :
+    dpp::base_module::process_status channel_router_module::process(datatools::things & data_record_)
+    {
+      DT_THROW_IF (! is_initialized(), std::logic_error,
+                   "Module '" << get_name() << "' is not initialized !");
+
+      const mask_type a_mask = route(data_record_);
+
+      // Store the channels
+      datatools::properties * ptr_channels = 0;
+      if (! data_record_.has(_CR_label_)) {
+        ptr_channels = &(data_record_.add<datatools::properties>(_CR_label_));
+      } else {
+        ptr_channels = &(data_record_.grab<datatools::properties>(_CR_label_));
+        ptr_channels->clear();
+      }
+      std::vector<std::string> matched;
+      for (size_t i = 0; i < _channels_.size(); ++i) {
+        if (a_mask & (1 << i)) matched.push_back(_channels_[i].name);
+      }
+      ptr_channels->store_integer("mask", a_mask);
+      ptr_channels->store("channels", matched);
+
+      // Dispatch the event
+      if (a_mask == 0) {
+        if (! _default_module_.has_data()) return dpp::base_module::PROCESS_SUCCESS;
+        return _default_module_.grab().process(data_record_);
+      }
+      for (size_t i = 0; i < _channels_.size(); ++i) {
+        if (! (a_mask & (1 << i))) continue;
+        if (! _channels_[i].module.has_data()) continue;
+        const process_status status = _channels_[i].module.grab().process(data_record_);
+        if (status != dpp::base_module::PROCESS_SUCCESS) return status;
+      }
+
+      return dpp::base_module::PROCESS_SUCCESS;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/* OCD support */
+#include <datatools/object_configuration_description.h>
+DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::channel_router_module, ocd_)
+{
+  ocd_.set_class_name("snemo::reconstruction::channel_router_module");
+  ocd_.set_class_description("A module that tags and dispatches events given their physics channel");
+  ocd_.set_class_library("Falaise_ParticleIdentification");
+  ocd_.set_class_documentation("This module evaluates the channel cuts of the cut service once per event,   \n"
+                               "sub-cuts shared by several channels being evaluated once. Channels requiring \n"
+                               "a classification label are only tried for events with this classification.  \n"
+                               "The matching channels are stored as a bit mask within a ``datatools::properties`` \n"
+                               "bank and the event is processed by the modules associated to the channels.  \n");
+
+  dpp::base_module::common_ocd(ocd_);
+
+  {
+    // Description of the 'TD_label' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("TD_label")
+      .set_terse_description("The label/name of the 'topology data' bank")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(false)
+      .set_long_description("This is the name of the bank holding the event classification. \n")
+      .set_default_value_string("TD")
+      .add_example("Use an alternative name for the 'topology data' bank:: \n"
+                   "                                                       \n"
+                   "  TD_label : string = \"TD2\"                          \n"
+                   "                                                       \n"
+                   );
+  }
+
+  {
+    // Description of the 'CR_label' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("CR_label")
+      .set_terse_description("The label/name of the 'channel routing' bank")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(false)
+      .set_long_description("This is the name of the output ``datatools::properties`` bank \n"
+                            "storing the ``mask`` integer and the ``channels`` names of    \n"
+                            "the channels accepting the event.                             \n")
+      .set_default_value_string("CR")
+      .add_example("Use an alternative name for the 'channel routing' bank:: \n"
+                   "                                                         \n"
+                   "  CR_label : string = \"CR2\"                            \n"
+                   "                                                         \n"
+                   );
+  }
+
+  {
+    // Description of the 'channels' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("channels")
+      .set_terse_description("The names of the channels")
+      .set_traits(datatools::TYPE_STRING,
+                  datatools::configuration_property_description::ARRAY)
+      .set_mandatory(true)
+      .set_long_description("At most 31 channels, the bit of a channel in the mask being \n"
+                            "given by its rank in this list.                              \n")
+      .add_example("Route 2 channels::                                    \n"
+                   "                                                      \n"
+                   "  channels : string[2] = \"channel_2e\" \"channel_1e\" \n"
+                   "                                                      \n"
+                   );
+  }
+
+  {
+    datatools::configuration_property_description & cpd = ocd_.add_configuration_property_info();
+    cpd.set_name_pattern("${channels}.cut")
+      .set_terse_description("The name of the cut selecting the events of a channel")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(true)
+      .add_example("Set the channel cut::                             \n"
+                   "                                                  \n"
+                   "  channel_2e.cut : string = \"2e::channel_cut\"  \n"
+                   "                                                  \n"
+                   );
+  }
+
+  {
+    datatools::configuration_property_description & cpd = ocd_.add_configuration_property_info();
+    cpd.set_name_pattern("${channels}.module")
+      .set_terse_description("The name of the module processing the events of a channel")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(false)
+      .add_example("Set the channel module::                                \n"
+                   "                                                        \n"
+                   "  channel_2e.module : string = \"io_output_2e_channel\" \n"
+                   "                                                        \n"
+                   );
+  }
+
+  {
+    // Description of the 'first_match_only' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("first_match_only")
+      .set_terse_description("Flag to stop at the first channel accepting the event")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("Channels are tried in the order of the ``channels`` list, \n"
+                            "as a chain of ``dpp::if_module`` would do.                 \n")
+      .set_default_value_boolean(false)
+      .add_example("Tag each event with one channel at most:: \n"
+                   "                                          \n"
+                   "  first_match_only : boolean = true       \n"
+                   "                                          \n"
+                   );
+  }
+
+  {
+    // Description of the 'default_module' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("default_module")
+      .set_terse_description("The name of the module processing the events without channel")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(false)
+      .add_example("Store the other events::                         \n"
+                   "                                                 \n"
+                   "  default_module : string = \"io_output_others\" \n"
+                   "                                                 \n"
+                   );
+  }
+
+  // Additionnal configuration hints :
+  ocd_.set_configuration_hints("Here is a full configuration example in the                    \n"
+                               "``datatools::properties`` ASCII format::                       \n"
+                               "                                                               \n"
+                               "  Cut_label         : string = \"cuts\"                         \n"
+                               "  channels          : string[2] = \"channel_2e\" \"channel_1e\"  \n"
+                               "  channel_2e.cut    : string = \"2e::channel_cut\"              \n"
+                               "  channel_2e.module : string = \"io_output_2e_channel\"         \n"
+                               "  channel_1e.cut    : string = \"1e::channel_cut\"              \n"
+                               "  channel_1e.module : string = \"io_output_1e_channel\"         \n"
+                               "  first_match_only  : boolean = true                            \n"
+                               "  default_module    : string = \"io_output_others\"             \n"
+                               "                                                               \n"
+                               );
+
+  ocd_.set_validation_support(true);
+  ocd_.lock();
+  return;
+}
+
+DOCD_CLASS_IMPLEMENT_LOAD_END() // Closing macro for implementation
+DOCD_CLASS_SYSTEM_REGISTRATION(snemo::reconstruction::channel_router_module,
+                               "snemo::reconstruction::channel_router_module")
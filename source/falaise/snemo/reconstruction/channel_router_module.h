@@ -0,0 +1,124 @@
+/// \file falaise/snemo/reconstruction/channel_router_module.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Module tagging and dispatching events to physics channels
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_CHANNEL_ROUTER_MODULE_H
+#define FALAISE_SNEMO_RECONSTRUCTION_CHANNEL_ROUTER_MODULE_H 1
+
+// Standard library:
+#include <map>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/dpp :
+#include <dpp/base_module.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/cuts/cut_graph.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Module routing events to the physics channels they belong to
+    ///
+    /// Each channel is defined by a cut of the cut service, typically a
+    /// ``cuts::multi_and_cut`` combining the topology data checks and a
+    /// classification. The channel cuts are merged into a shared cut graph so
+    /// that a sub-cut used by several channels is evaluated once per event.
+    /// Channels requiring a given classification label are only tried for
+    /// events with this classification. The channels accepting the event are
+    /// stored as a bit mask and the event is passed to the associated modules.
+    class channel_router_module : public dpp::base_module
+    {
+    public:
+
+      /// Typedef for the channel bit mask
+      typedef uint32_t mask_type;
+
+      /// Maximal number of channels
+      static const size_t MAX_NUMBER_OF_CHANNELS = 31;
+
+      /// \brief Channel resolved at initialization
+      struct channel_type {
+        std::string name;                 //!< Name of the channel
+        size_t node;                      //!< Node of the channel cut in the cut graph
+        dpp::module_handle_type module;   //!< Module processing the events of the channel
+        bool has_classification;          //!< Flag for channels requiring a classification
+        snemo::datamodel::pid_utils::classification_code_type classification; //!< Required classification
+      };
+
+      /// Constructor
+      channel_router_module(datatools::logger::priority = datatools::logger::PRIO_FATAL);
+
+      /// Destructor
+      virtual ~channel_router_module();
+
+      /// Initialization
+      virtual void initialize(const datatools::properties  & setup_,
+                              datatools::service_manager   & service_manager_,
+                              dpp::module_handle_dict_type & module_dict_);
+
+      /// Reset
+      virtual void reset();
+
+      /// Data record processing
+      virtual process_status process(datatools::things & data_);
+
+      /// Return the number of channels
+      size_t get_number_of_channels() const;
+
+      /// Return the name of a channel
+      const std::string & get_channel_name(const size_t channel_) const;
+
+      /// Return the bit mask of the channels accepting the event
+      mask_type route(const datatools::things & data_);
+
+    protected:
+
+      /// Give default values to specific class members.
+      void _set_defaults();
+
+      /// Return the channels worth trying given the event classification
+      const std::vector<size_t> & _get_candidates(const datatools::things & data_) const;
+
+    private:
+
+      std::string _TD_label_;                 //!< The label of the topology data bank
+      std::string _CR_label_;                 //!< The label of the channel routing bank
+      bool _first_match_only_;                //!< Flag to stop at the first matching channel
+      snemo::cut::cut_graph _cut_graph_;      //!< Shared graph of the channel cuts
+      std::vector<channel_type> _channels_;   //!< Channels in configuration order
+      std::vector<size_t> _unclassified_;     //!< Channels not requiring a classification
+      std::vector<size_t> _all_channels_;     //!< Every channel, for events without classification code
+      std::map<snemo::datamodel::pid_utils::classification_code_type,
+               std::vector<size_t> > _dispatch_; //!< Channels to try given the classification
+      dpp::module_handle_type _default_module_; //!< Module processing events without channel
+
+      // Macro to automate the registration of the module :
+      DPP_MODULE_REGISTRATION_INTERFACE(channel_router_module)
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#include <datatools/ocd_macros.h>
+
+// Declare the OCD interface of the module
+DOCD_CLASS_DECLARATION(snemo::reconstruction::channel_router_module)
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_CHANNEL_ROUTER_MODULE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,209 @@
+// falaise/snemo/reconstruction/chi2_probability.cc
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Third party:
+// - GSL:
+#include <gsl/gsl_cdf.h>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+
+      const double SQRT_1_2 = 0.70710678118654752440;  // 1/sqrt(2)
+      const double SQRT_2_PI = 0.79788456080286535588; // sqrt(2/pi)
+
+      /// Abramowitz & Stegun 7.1.26, absolute error below 1.5e-7 for x >= 0
+      inline double fast_erfc(const double x_)
+      {
+        const double t = 1.0 / (1.0 + 0.3275911 * x_);
+        const double poly = t * (0.254829592 + t * (-0.284496736 + t * (1.421413741
+                                 + t * (-1.453152027 + t * 1.061405429))));
+        return poly * std::exp(-x_ * x_);
+      }
+
+      /// Survival function for dof = 1 to 3 given an erfc implementation
+      template<double (*Erfc)(double)>
+      inline double closed_form_survival(const double chi2_, const unsigned int dof_)
+      {
+        // NaN is kept by std::max
+        const double x = std::max(chi2_, 0.0);
+        if (dof_ == 2) return std::exp(-0.5 * x);
+        const double u = std::sqrt(x);
+        const double q1 = Erfc(u * SQRT_1_2);
+        if (dof_ == 1) return q1;
+        return q1 + SQRT_2_PI * u * std::exp(-0.5 * x);
+      }
+
+      inline double std_erfc(const double x_)
+      {
+        return std::erfc(x_);
+      }
+
+      /// Survival functions tabulated over u = sqrt(chi2)
+      struct survival_table
+      {
+        static const unsigned int DOF_MAX = 3;
+        static const unsigned int STEPS_PER_UNIT = 128;
+        static const unsigned int U_MAX = 10;
+
+        survival_table()
+        {
+          const size_t n = U_MAX * STEPS_PER_UNIT + 2;
+          for (unsigned int dof = 1; dof <= DOF_MAX; ++dof) {
+            std::vector<double> & a_table = values[dof - 1];
+            a_table.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+              const double u = static_cast<double>(i) / STEPS_PER_UNIT;
+              a_table[i] = closed_form_survival<std_erfc>(u * u, dof);
+            }
+          }
+          return;
+        }
+
+        static const survival_table & instance()
+        {
+          static const survival_table _table;
+          return _table;
+        }
+
+        std::vector<double> values[DOF_MAX];
+      };
+
+    }
+
+    // static
+    const std::string & chi2_probability::method_label(const method_type method_)
+    {
+      static const std::string labels[4] = {"gsl", "exact", "fast", "tabulated"};
+      DT_THROW_IF(method_ > METHOD_TABULATED, std::range_error,
+                  "Invalid chi2 probability method (" << method_ << ") !");
+      return labels[method_];
+    }
+
+    // static
+    chi2_probability::method_type chi2_probability::method_from_label(const std::string & label_)
+    {
+      for (int i = METHOD_GSL; i <= METHOD_TABULATED; ++i) {
+        const method_type a_method = static_cast<method_type>(i);
+        if (label_ == method_label(a_method)) return a_method;
+      }
+      DT_THROW(std::logic_error, "Unknown chi2 probability method '" << label_ << "' !");
+    }
+
+    // static
+    double chi2_probability::gsl_survival(const double chi2_, const unsigned int dof_)
+    {
+      return gsl_cdf_chisq_Q(chi2_, dof_);
+    }
+
+    // static
+    double chi2_probability::exact_survival(const double chi2_, const unsigned int dof_)
+    {
+      if (dof_ < 1 || dof_ > survival_table::DOF_MAX) return gsl_survival(chi2_, dof_);
+      return closed_form_survival<std_erfc>(chi2_, dof_);
+    }
+
+    // static
+    double chi2_probability::fast_survival(const double chi2_, const unsigned int dof_)
+    {
+      if (dof_ < 1 || dof_ > survival_table::DOF_MAX) return gsl_survival(chi2_, dof_);
+      return closed_form_survival<fast_erfc>(chi2_, dof_);
+    }
+
+    // static
+    double chi2_probability::tabulated_survival(const double chi2_, const unsigned int dof_)
+    {
+      if (dof_ < 1 || dof_ > survival_table::DOF_MAX) return gsl_survival(chi2_, dof_);
+      const double x = std::max(chi2_, 0.0);
+      const double position = std::sqrt(x) * survival_table::STEPS_PER_UNIT;
+      // Beyond the table (or NaN)
+      if (! (position < survival_table::U_MAX * survival_table::STEPS_PER_UNIT)) {
+        return exact_survival(chi2_, dof_);
+      }
+      const std::vector<double> & a_table = survival_table::instance().values[dof_ - 1];
+      const size_t i = static_cast<size_t>(position);
+      const double f = position - i;
+      return a_table[i] + (a_table[i + 1] - a_table[i]) * f;
+    }
+
+    chi2_probability::chi2_probability(const method_type method_)
+    {
+      set_method(method_);
+      return;
+    }
+
+    void chi2_probability::set_method(const method_type method_)
+    {
+      DT_THROW_IF(method_ > METHOD_TABULATED, std::range_error,
+                  "Invalid chi2 probability method (" << method_ << ") !");
+      if (method_ == METHOD_TABULATED) {
+        // Build the table now rather than within the event loop
+        survival_table::instance();
+      }
+      _method_ = method_;
+      return;
+    }
+
+    chi2_probability::method_type chi2_probability::get_method() const
+    {
+      return _method_;
+    }
+
+    double chi2_probability::survival(const double chi2_, const unsigned int dof_) const
+    {
+      switch (_method_) {
+      case METHOD_EXACT: return exact_survival(chi2_, dof_);
+      case METHOD_FAST: return fast_survival(chi2_, dof_);
+      case METHOD_TABULATED: return tabulated_survival(chi2_, dof_);
+      default: break;
+      }
+      return gsl_survival(chi2_, dof_);
+    }
+
+    void chi2_probability::survival(const double * chi2_, double * probabilities_, const size_t size_,
+                                    const unsigned int dof_) const
+    {
+      // Method and degrees of freedom are resolved once so that the closed
+      // form loops have no branch and can be vectorized
+      const bool closed_form = (dof_ >= 1 && dof_ <= survival_table::DOF_MAX);
+      if (closed_form && _method_ == METHOD_FAST) {
+        for (size_t i = 0; i < size_; ++i) {
+          probabilities_[i] = closed_form_survival<fast_erfc>(chi2_[i], dof_);
+        }
+        return;
+      }
+      if (closed_form && _method_ == METHOD_EXACT) {
+        for (size_t i = 0; i < size_; ++i) {
+          probabilities_[i] = closed_form_survival<std_erfc>(chi2_[i], dof_);
+        }
+        return;
+      }
+      for (size_t i = 0; i < size_; ++i) {
+        probabilities_[i] = survival(chi2_[i], dof_);
+      }
+      return;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
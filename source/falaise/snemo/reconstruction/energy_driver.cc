@@ -10,6 +10,7 @@
 // This project:
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
 
 namespace snemo {
 
@@ -91,28 +92,29 @@ namespace snemo {
 
     void energy_driver::process(const snemo::datamodel::particle_track & pt_,
                                 snemo::datamodel::energy_measurement & energy_)
+    {
+      kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_UNDEFINED, 1), pt_);
+      process(kc.get(0), energy_);
+      return;
+    }
+
+    void energy_driver::process(const particle_kinematics & k_,
+                                snemo::datamodel::energy_measurement & energy_)
     {
       DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
-      this->_process_algo(pt_, energy_.grab_energy());
+      this->_process_algo(k_, energy_.grab_energy());
       return;
     }
 
-    void energy_driver::_process_algo(const snemo::datamodel::particle_track & pt_,
+    void energy_driver::_process_algo(const particle_kinematics & k_,
                                       double & energy_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
-      // Invalidate result
-      datatools::invalidate(energy_);
-
-      if (pt_.has_associated_calorimeter_hits()) {
-        const snemo::datamodel::calibrated_calorimeter_hit::collection_type &
-          the_calos = pt_.get_associated_calorimeter_hits();
-        for (snemo::datamodel::calibrated_calorimeter_hit::collection_type::const_iterator
-               icalo = the_calos.begin(); icalo != the_calos.end(); ++icalo) {
-          const snemo::datamodel::calibrated_calorimeter_hit & a_calo = icalo->get();
-          icalo == the_calos.begin() ? energy_ = a_calo.get_energy() : energy_ += a_calo.get_energy();
-        }
-      } else {
+
+      // Energy summed over the associated calorimeter hits (invalid if none)
+      energy_ = k_.total_energy;
+      if (! k_.track->has_associated_calorimeter_hits()) {
         DT_LOG_DEBUG(get_logging_priority(), "Particle track is not associated to any calorimeter block !");
       }
 
@@ -47,6 +47,8 @@ namespace snemo {
 
   namespace reconstruction {
 
+    struct particle_kinematics;
+
     /// Driver for the gamma clustering algorithms
     class energy_driver
     {
@@ -71,6 +73,10 @@ namespace snemo {
       void process(const snemo::datamodel::particle_track & pt_,
                    snemo::datamodel::energy_measurement & energy_);
 
+      /// Main process from the particle kinematics cached for the event
+      void process(const particle_kinematics & k_,
+                   snemo::datamodel::energy_measurement & energy_);
+
       /// Check if theclusterizer is initialized
       bool is_initialized() const;
 
@@ -92,7 +98,7 @@ namespace snemo {
       void _set_defaults();
 
       /// Special method to process and generate particle track data
-      void _process_algo(const snemo::datamodel::particle_track & pt_,
+      void _process_algo(const particle_kinematics & k_,
                          double & energy_);
 
     private:
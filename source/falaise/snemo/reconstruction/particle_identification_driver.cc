@@ -3,6 +3,9 @@
 // Ourselves:
 #include <snemo/reconstruction/particle_identification_driver.h>
 
+// Standard library:
+#include <algorithm>
+
 // Third party:
 // - Bayeux/cuts:
 #include <bayeux/cuts/cut_manager.h>
@@ -11,6 +14,7 @@
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/pid_data.h>
 
 namespace snemo {
 
@@ -86,6 +90,72 @@ namespace snemo {
       return _mode_ & MODE_PID_USER;
     }
 
+    void particle_identification_driver::set_export_labels(const bool export_labels_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Driver is already initialized !");
+      _export_labels_ = export_labels_;
+      return;
+    }
+
+    bool particle_identification_driver::is_export_labels() const
+    {
+      return _export_labels_;
+    }
+
+    void particle_identification_driver::set_exclusive_definitions(const bool exclusive_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Driver is already initialized !");
+      _exclusive_definitions_ = exclusive_;
+      return;
+    }
+
+    bool particle_identification_driver::is_exclusive_definitions() const
+    {
+      return _exclusive_definitions_;
+    }
+
+    void particle_identification_driver::set_adaptive_ordering(const bool adaptive_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Driver is already initialized !");
+      _adaptive_ordering_ = adaptive_;
+      return;
+    }
+
+    bool particle_identification_driver::is_adaptive_ordering() const
+    {
+      return _adaptive_ordering_;
+    }
+
+    void particle_identification_driver::set_shared_subcuts(const bool shared_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Driver is already initialized !");
+      _shared_subcuts_ = shared_;
+      return;
+    }
+
+    bool particle_identification_driver::is_shared_subcuts() const
+    {
+      return _shared_subcuts_;
+    }
+
+    size_t particle_identification_driver::get_number_of_cut_nodes() const
+    {
+      return _cut_graph_.get_number_of_nodes();
+    }
+
+    void particle_identification_driver::fetch_definition_order(std::vector<std::string> & cut_names_) const
+    {
+      cut_names_.clear();
+      for (size_t i = 0; i < _ordering_.size(); ++i) {
+        cut_names_.push_back(_definitions_[_ordering_[i]].cut_name);
+      }
+      return;
+    }
+
     // Constructor
     particle_identification_driver::particle_identification_driver()
     {
@@ -127,11 +197,33 @@ namespace snemo {
       }
       DT_THROW_IF(_mode_ == MODE_UNDEFINED, std::logic_error, "Missing at least a 'mode.XXX' property !");
 
+      // Export of PID labels within particle track auxiliaries
+      if (setup_.has_key("export_labels")) {
+        set_export_labels(setup_.fetch_boolean("export_labels"));
+      }
+
+      // Evaluation order of the definitions
+      if (setup_.has_key("exclusive_definitions")) {
+        set_exclusive_definitions(setup_.fetch_boolean("exclusive_definitions"));
+      }
+      if (setup_.has_key("adaptive_ordering")) {
+        set_adaptive_ordering(setup_.fetch_boolean("adaptive_ordering"));
+      }
+      // Without exclusive definitions, every cut is evaluated whatever the order
+      DT_THROW_IF(is_adaptive_ordering() && ! is_exclusive_definitions(), std::logic_error,
+                  "Adaptive ordering requires mutually exclusive definitions !");
+
+      // Evaluation of the sub-cuts shared by the definitions
+      if (setup_.has_key("shared_subcuts")) {
+        set_shared_subcuts(setup_.fetch_boolean("shared_subcuts"));
+      }
+
       // Fetch PID definition
       DT_THROW_IF(! setup_.has_key("definitions"), std::logic_error,
                   "Missing definitions of particles !");
       std::vector<std::string> pid_definitions;
       setup_.fetch("definitions", pid_definitions);
+      property_dict_type pid_properties;
       for (size_t i = 0; i < pid_definitions.size(); ++i) {
         const std::string & key = pid_definitions.at(i);
         if (is_mode_pid_label()) {
@@ -140,7 +232,7 @@ namespace snemo {
             const std::string a_key = snemo::datamodel::pid_utils::pid_label_key();
             const std::string a_value = setup_.fetch_string(str);
             pair_property_type ppt = std::make_pair(a_key, a_value);
-            _pid_properties_.insert(std::make_pair(key, ppt));
+            pid_properties.insert(std::make_pair(key, ppt));
           }
         }
         if (is_mode_pid_user()) {
@@ -151,9 +243,36 @@ namespace snemo {
           const std::string a_key = setup_.fetch_string(str1);
           const std::string a_value = setup_.fetch_string(str2);
           pair_property_type ppt = std::make_pair(a_key, a_value);
-          _pid_properties_.insert(std::make_pair(key, ppt));
+          pid_properties.insert(std::make_pair(key, ppt));
+        }
+      }
+
+      // Resolve cuts and particle types once for all
+      typedef snemo::datamodel::pid_utils pu;
+      cuts::cut_manager & cut_mgr = grab_cut_manager();
+      if (is_shared_subcuts()) _cut_graph_.set_cut_manager(cut_mgr);
+      for (property_dict_type::const_iterator ip = pid_properties.begin();
+           ip != pid_properties.end(); ++ip) {
+        definition_type a_definition;
+        a_definition.cut_name = ip->first;
+        DT_THROW_IF(! cut_mgr.has(a_definition.cut_name), std::logic_error,
+                    "Cut '" << a_definition.cut_name << "' is missing !");
+        a_definition.cut = &cut_mgr.grab(a_definition.cut_name);
+        a_definition.node = 0;
+        if (is_shared_subcuts()) {
+          a_definition.node = _cut_graph_.add_cut(a_definition.cut_name);
         }
+        a_definition.naccepted = 0;
+        a_definition.property = ip->second;
+        const std::string & a_value = a_definition.property.second;
+        a_definition.type = pu::particle_type_from_label(a_value);
+        a_definition.counting = (a_definition.type != pu::PARTICLE_UNDEFINED
+                                 || a_value == pu::undefined_label());
+        a_definition.labelling = (a_definition.property.first == pu::pid_label_key());
+        _ordering_.push_back(_definitions_.size());
+        _definitions_.push_back(a_definition);
       }
+      DT_LOG_DEBUG(get_logging_priority(), "Number of shared cut nodes : " << get_number_of_cut_nodes());
 
       set_initialized(true);
       return;
@@ -168,11 +287,44 @@ namespace snemo {
     }
 
     int particle_identification_driver::process(snemo::datamodel::particle_track_data & ptd_)
+    {
+      snemo::datamodel::pid_data a_pid;
+      int status = 0;
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+
+      status = _process_algo(ptd_, a_pid, &ptd_);
+      if (status != 0) {
+        DT_LOG_ERROR(get_logging_priority(),
+                     "Processing of particle tracks by '" << get_id() << "' algorithm has failed !");
+        return status;
+      }
+
+      return status;
+    }
+
+    int particle_identification_driver::process(snemo::datamodel::particle_track_data & ptd_,
+                                                snemo::datamodel::pid_data & pid_)
     {
       int status = 0;
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
 
-      status = _process_algo(ptd_);
+      status = _process_algo(ptd_, pid_, is_export_labels() ? &ptd_ : 0);
+      if (status != 0) {
+        DT_LOG_ERROR(get_logging_priority(),
+                     "Processing of particle tracks by '" << get_id() << "' algorithm has failed !");
+        return status;
+      }
+
+      return status;
+    }
+
+    int particle_identification_driver::identify(const snemo::datamodel::particle_track_data & ptd_,
+                                                 snemo::datamodel::pid_data & pid_)
+    {
+      int status = 0;
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+
+      status = _process_algo(ptd_, pid_, 0);
       if (status != 0) {
         DT_LOG_ERROR(get_logging_priority(),
                      "Processing of particle tracks by '" << get_id() << "' algorithm has failed !");
@@ -187,35 +339,67 @@ namespace snemo {
       _logging_priority_ = datatools::logger::PRIO_WARNING;
       _mode_ = MODE_UNDEFINED;
       _cut_manager_ = 0;
+      _export_labels_ = true;
+      _exclusive_definitions_ = false;
+      _adaptive_ordering_ = false;
+      _shared_subcuts_ = false;
+      _cut_graph_.clear();
+      _definitions_.clear();
+      _ordering_.clear();
+      return;
+    }
+
+    void particle_identification_driver::_update_ordering()
+    {
+      // Most accepting definitions first, configuration order otherwise
+      const definition_collection_type & defs = _definitions_;
+      std::stable_sort(_ordering_.begin(), _ordering_.end(),
+                       [&defs] (const size_t i_, const size_t j_) {
+                         return defs[i_].naccepted > defs[j_].naccepted;
+                       });
       return;
     }
 
-    int particle_identification_driver::_process_algo(snemo::datamodel::particle_track_data & ptd_)
+    int particle_identification_driver::_process_algo(const snemo::datamodel::particle_track_data & ptd_,
+                                                      snemo::datamodel::pid_data & pid_,
+                                                      snemo::datamodel::particle_track_data * labelled_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
-      // Count number of particles given their label
+      typedef snemo::datamodel::pid_utils pu;
+
+      // Count number of particles given their label (only when exporting labels)
       typedef std::map<std::string, size_t> particle_counter_type;
       particle_counter_type particle_counter;
 
-      snemo::datamodel::particle_track_data::particle_collection_type & particles
-        = ptd_.grab_particles();
-      for (snemo::datamodel::particle_track_data::particle_collection_type::iterator
-             it = particles.begin(); it != particles.end(); ++it) {
-        snemo::datamodel::particle_track & a_particle = it->grab();
+      const size_t nparticles = ptd_.has_particles() ? ptd_.get_particles().size() : 0;
+      pid_.reset(nparticles);
+
+      for (size_t ipart = 0; ipart < nparticles; ++ipart) {
+        const snemo::datamodel::particle_track & a_particle = ptd_.get_particles()[ipart].get();
+        if (is_shared_subcuts()) {
+          _cut_graph_.reset_results();
+        }
 
         bool particle_is_undefined = true;
-        for (property_dict_type::const_iterator ip = _pid_properties_.begin();
-             ip != _pid_properties_.end(); ++ip) {
-          const std::string & cut_name = ip->first;
+        bool particle_is_typed = false;
+        pu::particle_type a_type = pu::PARTICLE_UNDEFINED;
+        for (size_t iorder = 0; iorder < _ordering_.size(); ++iorder) {
+          definition_collection_type::iterator id = _definitions_.begin() + _ordering_[iorder];
+          const std::string & cut_name = id->cut_name;
           DT_LOG_DEBUG(get_logging_priority(), "Applying '" << cut_name << "' selection...");
 
-          cuts::cut_manager & cut_mgr = grab_cut_manager();
-          DT_THROW_IF(! cut_mgr.has(cut_name), std::logic_error, "Cut '" << cut_name << "' is missing !");
-          cuts::i_cut & a_cut = cut_mgr.grab(cut_name);
-          a_cut.set_user_data(a_particle);
-          const int cut_status = a_cut.process();
-          a_cut.reset_user_data();
+          // Cuts hold the user data while processing: concurrent drivers
+          // must be given their own cut manager
+          int cut_status = cuts::SELECTION_INAPPLICABLE;
+          if (is_shared_subcuts()) {
+            cut_status = _cut_graph_.evaluate(id->node, a_particle);
+          } else {
+            cuts::i_cut & a_cut = *id->cut;
+            a_cut.set_user_data(a_particle);
+            cut_status = a_cut.process();
+            a_cut.reset_user_data();
+          }
 
           if (cut_status != cuts::SELECTION_ACCEPTED) {
             DT_LOG_DEBUG(get_logging_priority(),
@@ -223,32 +407,55 @@ namespace snemo {
             continue;
           }
 
-          datatools::properties & aux = a_particle.grab_auxiliaries();
-          const pair_property_type & ppt = ip->second;
-          const std::string & key = ppt.first;
-          std::string value = ppt.second;
-          if (is_mode_pid_label()) {
-            DT_LOG_DEBUG(get_logging_priority(),
-                         "Current particle fulfills '" << cut_name << "' criteria !");
-             // Store particle label within 'particle_track' auxiliairies
-            if (aux.has_key(key)) {
-              const std::string a_label = aux.fetch_string(key);
-              if (a_label != value) {
-                value = a_label + "|" + value;
+          if (id->labelling) {
+            // Particles fulfilling several PID labels are undefined
+            if (is_mode_pid_label() && particle_is_typed && a_type != id->type) {
+              a_type = pu::PARTICLE_UNDEFINED;
+            } else {
+              a_type = id->type;
+            }
+            particle_is_typed = true;
+          }
+          // Typed particles are counted once, given their resolved type
+          if (id->counting && ! id->labelling) pid_.increment_particle_count(id->type);
+          particle_is_undefined = false;
+          id->naccepted++;
+
+          if (labelled_ != 0) {
+            snemo::datamodel::particle_track & a_labelled = labelled_->grab_particles()[ipart].grab();
+            datatools::properties & aux = a_labelled.grab_auxiliaries();
+            const pair_property_type & ppt = id->property;
+            const std::string & key = ppt.first;
+            std::string value = ppt.second;
+            if (is_mode_pid_label()) {
+              DT_LOG_DEBUG(get_logging_priority(),
+                           "Current particle fulfills '" << cut_name << "' criteria !");
+              // Store particle label within 'particle_track' auxiliairies
+              if (aux.has_key(key)) {
+                const std::string a_label = aux.fetch_string(key);
+                if (a_label != value) {
+                  value = a_label + "|" + value;
+                }
               }
             }
+            aux.update(key, value);
+            particle_counter[ppt.second]++;
           }
-          aux.update(key, value);
 
-          particle_is_undefined = false;
-          particle_counter[ppt.second]++;
+          // A particle fulfills at most one of mutually exclusive definitions
+          if (is_exclusive_definitions()) break;
         }
 
+        pid_.set_particle_type(ipart, a_type);
+        if (particle_is_typed) pid_.increment_particle_count(a_type);
+
         if (is_mode_pid_label() && particle_is_undefined) {
-          datatools::properties & aux = a_particle.grab_auxiliaries();
-          aux.update(snemo::datamodel::pid_utils::pid_label_key(),
-                     snemo::datamodel::pid_utils::undefined_label());
-          particle_counter[snemo::datamodel::pid_utils::undefined_label()]++;
+          pid_.increment_particle_count(pu::PARTICLE_UNDEFINED);
+          if (labelled_ != 0) {
+            snemo::datamodel::particle_track & a_labelled = labelled_->grab_particles()[ipart].grab();
+            a_labelled.grab_auxiliaries().update(pu::pid_label_key(), pu::undefined_label());
+            particle_counter[pu::undefined_label()]++;
+          }
         }
       }
 
@@ -256,9 +463,11 @@ namespace snemo {
            i != particle_counter.end(); ++i) {
         DT_LOG_DEBUG(get_logging_priority(), "Number of '" << i->first << "' particles : "
                      << i->second);
-        ptd_.grab_auxiliaries().update_integer(i->first, i->second);
+        labelled_->grab_auxiliaries().update_integer(i->first, i->second);
       }
 
+      if (is_adaptive_ordering()) _update_ordering();
+
       DT_LOG_TRACE(get_logging_priority(), "Exiting.");
       return 0;
     }
@@ -277,6 +486,85 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::particle_identification_d
                                "/todo What does the manager do ?"
                                );
 
+  {
+    // Description of the 'export_labels' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("export_labels")
+      .set_terse_description("Flag to export PID labels within particle track auxiliaries")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("Particle types and counters are always stored in the PID bank. \n"
+                            "The string labels and counters are only written in the particle \n"
+                            "track auxiliaries for compatibility purpose.                   \n")
+      .set_default_value_boolean(true)
+      .add_example("Keep particle tracks untouched::   \n"
+                   "                                   \n"
+                   "  export_labels : boolean = false  \n"
+                   "                                   \n"
+                   );
+  }
+
+  {
+    // Description of the 'exclusive_definitions' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("exclusive_definitions")
+      .set_terse_description("Flag for mutually exclusive PID definitions")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("When the PID definitions cannot be fulfilled together, the \n"
+                            "remaining cuts are skipped once a particle is identified.   \n")
+      .set_default_value_boolean(false)
+      .add_example("Stop at the first matching definition::   \n"
+                   "                                          \n"
+                   "  exclusive_definitions : boolean = true  \n"
+                   "                                          \n"
+                   );
+  }
+
+  {
+    // Description of the 'adaptive_ordering' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("adaptive_ordering")
+      .set_terse_description("Flag to try first the PID definitions accepting more particles")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("The number of particles accepted by each definition is     \n"
+                            "recorded and the definitions are reordered after each event \n"
+                            "so that the most likely one is tried first. It requires the \n"
+                            "``exclusive_definitions`` flag.                             \n")
+      .set_default_value_boolean(false)
+      .add_example("Order definitions by acceptance::         \n"
+                   "                                          \n"
+                   "  exclusive_definitions : boolean = true  \n"
+                   "  adaptive_ordering     : boolean = true  \n"
+                   "                                          \n"
+                   );
+  }
+
+  {
+    // Description of the 'shared_subcuts' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("shared_subcuts")
+      .set_terse_description("Flag to evaluate the sub-cuts shared by the PID definitions once per particle")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("The ``cuts::multi_and_cut``, ``cuts::multi_or_cut`` and         \n"
+                            "``cuts::not_cut`` trees of the definitions are merged into a   \n"
+                            "single graph where sub-cuts with the same name, or the same    \n"
+                            "type and configuration, share one node. The result of each node \n"
+                            "is computed once per particle and reused by all definitions.   \n"
+                            "The statistics of the logical cuts themselves are not updated. \n")
+      .set_default_value_boolean(false)
+      .add_example("Share sub-cuts between definitions::  \n"
+                   "                                      \n"
+                   "  shared_subcuts : boolean = true     \n"
+                   "                                      \n"
+                   );
+  }
 
   ocd_.set_validation_support(true);
   ocd_.lock();
@@ -33,19 +33,26 @@
 
 // Standard library:
 #include <map>
+#include <vector>
 
 // - Bayeux/datatools:
 #include <datatools/logger.h>
 #include <datatools/bit_mask.h>
 
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/cuts/cut_graph.h>
+
 namespace cuts {
   class cut_manager;
+  class i_cut;
 }
 
 namespace snemo {
 
   namespace datamodel {
     class particle_track_data;
+    class pid_data;
   }
 
   namespace reconstruction {
@@ -68,6 +75,21 @@ namespace snemo {
       /// Typedef dictionnary of pair property
       typedef std::map<std::string, pair_property_type> property_dict_type;
 
+      /// \brief PID definition resolved at initialization
+      struct definition_type {
+        std::string cut_name;                           //!< Name of the selection cut
+        cuts::i_cut * cut;                              //!< Selection cut resolved from the cut manager
+        size_t node;                                    //!< Root node in the shared cut graph
+        pair_property_type property;                    //!< Auxiliary key/value exported as label
+        snemo::datamodel::pid_utils::particle_type type; //!< Particle type
+        bool labelling;                                 //!< Flag for definitions setting the particle type
+        bool counting;                                  //!< Flag for definitions counted by type
+        size_t naccepted;                               //!< Number of particles accepted so far
+      };
+
+      /// Typedef for the collection of PID definitions
+      typedef std::vector<definition_type> definition_collection_type;
+
       /// Algorithm id
       static const std::string & get_id();
 
@@ -104,6 +126,36 @@ namespace snemo {
       /// Check mode PID_USER
       bool is_mode_pid_user() const;
 
+      /// Set the flag to export PID labels and counters as particle track auxiliaries
+      void set_export_labels(const bool export_labels_);
+
+      /// Check if PID labels and counters are exported as particle track auxiliaries
+      bool is_export_labels() const;
+
+      /// Set the flag for mutually exclusive definitions (a particle gets the first matching one)
+      void set_exclusive_definitions(const bool exclusive_);
+
+      /// Check if the definitions are mutually exclusive
+      bool is_exclusive_definitions() const;
+
+      /// Set the flag to try first the definitions accepting the more particles
+      void set_adaptive_ordering(const bool adaptive_);
+
+      /// Check if the definitions are ordered given their acceptance
+      bool is_adaptive_ordering() const;
+
+      /// Set the flag to evaluate each sub-cut shared by the definitions once per particle
+      void set_shared_subcuts(const bool shared_);
+
+      /// Check if the sub-cuts shared by the definitions are evaluated once per particle
+      bool is_shared_subcuts() const;
+
+      /// Return the number of nodes of the shared cut graph
+      size_t get_number_of_cut_nodes() const;
+
+      /// Return the definitions in their current evaluation order
+      void fetch_definition_order(std::vector<std::string> & cut_names_) const;
+
       /// Constructor
       particle_identification_driver();
 
@@ -116,16 +168,29 @@ namespace snemo {
       /// Reset the clusterizer
       virtual void reset();
 
-      /// Main tracker trajectory driver
+      /// Identify particles and store PID labels as particle track auxiliaries
       int process(snemo::datamodel::particle_track_data & ptd_);
 
+      /// Identify particles into the PID bank, also exporting labels if requested
+      int process(snemo::datamodel::particle_track_data & ptd_,
+                  snemo::datamodel::pid_data & pid_);
+
+      /// Identify particles into the PID bank only, leaving particle tracks untouched
+      int identify(const snemo::datamodel::particle_track_data & ptd_,
+                   snemo::datamodel::pid_data & pid_);
+
     protected:
 
       /// Set default values to class members
       void _set_defaults();
 
-      /// Main identification method
-      virtual int _process_algo(snemo::datamodel::particle_track_data & ptd_);
+      /// Reorder the definitions given their acceptance
+      void _update_ordering();
+
+      /// Main identification method: labels are written in 'labelled_' if not null
+      virtual int _process_algo(const snemo::datamodel::particle_track_data & ptd_,
+                                snemo::datamodel::pid_data & pid_,
+                                snemo::datamodel::particle_track_data * labelled_);
 
     private:
 
@@ -133,7 +198,13 @@ namespace snemo {
       datatools::logger::priority _logging_priority_; //!< Logging priority
       uint32_t _mode_;                                //!< Working mode
       cuts::cut_manager * _cut_manager_;              //!< The SuperNEMO cut manager
-      property_dict_type _pid_properties_;            //!< PID properties dictionnary
+      bool _export_labels_;                           //!< Flag to export PID labels
+      bool _exclusive_definitions_;                   //!< Flag for mutually exclusive definitions
+      bool _adaptive_ordering_;                       //!< Flag for definitions ordered by acceptance
+      bool _shared_subcuts_;                          //!< Flag for sub-cuts evaluated once per particle
+      snemo::cut::cut_graph _cut_graph_;              //!< Shared cut graph
+      definition_collection_type _definitions_;       //!< PID definitions
+      std::vector<size_t> _ordering_;                 //!< Evaluation order of the definitions
     };
 
   }  // end of namespace reconstruction
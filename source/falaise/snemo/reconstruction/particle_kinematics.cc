@@ -0,0 +1,230 @@
+// falaise/snemo/reconstruction/particle_kinematics.cc
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
+
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/tracker_trajectory.h>
+#include <falaise/snemo/datamodels/base_trajectory_pattern.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    particle_kinematics::particle_kinematics()
+    {
+      clear();
+      return;
+    }
+
+    void particle_kinematics::clear()
+    {
+      view = 0;
+      particle = 0;
+      track = 0;
+      type = snemo::datamodel::pid_utils::PARTICLE_UNDEFINED;
+      datatools::invalidate(energy);
+      datatools::invalidate(total_energy);
+      datatools::invalidate(time);
+      datatools::invalidate(sigma_time);
+      datatools::invalidate(mass);
+      datatools::invalidate(track_length);
+      origin_vertex = 0;
+      origin_location = topology_event_view::VERTEX_NONE;
+      geomtools::invalidate(foil_vertex);
+      geomtools::invalidate(first_calorimeter_vertex);
+      geomtools::invalidate(last_calorimeter_vertex);
+      geomtools::invalidate(direction);
+      calorimeter_vertices.clear();
+      return;
+    }
+
+    void particle_kinematics::compute(const topology_event_view & view_, const size_t particle_)
+    {
+      DT_THROW_IF(particle_ >= view_.get_number_of_particles(), std::range_error,
+                  "Invalid particle (" << particle_ << ") !");
+      clear();
+      view = &view_;
+      particle = particle_;
+      track = view_.get_tracks()[particle_];
+      type = view_.get_particle_types()[particle_];
+      if (type != snemo::datamodel::pid_utils::PARTICLE_UNDEFINED) {
+        mass = tof_driver::tof_tool::get_mass(type);
+      }
+      energy = view_.get_energies()[particle_];
+      total_energy = view_.get_total_energies()[particle_];
+      time = view_.get_times()[particle_];
+      sigma_time = view_.get_sigma_times()[particle_];
+      track_length = view_.get_track_lengths()[particle_];
+
+      // Vertices, walked once
+      const size_t first_hit = view_.get_calorimeter_offsets()[particle_];
+      const size_t last_hit = view_.get_calorimeter_offsets()[particle_ + 1];
+      const size_t first_vertex = view_.get_vertex_offsets()[particle_];
+      const size_t last_vertex = view_.get_vertex_offsets()[particle_ + 1];
+      const std::vector<topology_event_view::vertex_location_type> & the_locations
+        = view_.get_vertex_locations();
+      for (size_t ivtx = first_vertex; ivtx < last_vertex; ++ivtx) {
+        const topology_event_view::vertex_location_type a_location = the_locations[ivtx];
+        if (origin_vertex == 0 && (first_hit == last_hit || ! view_.is_same_block(ivtx, first_hit))) {
+          origin_vertex = view_.get_vertices()[ivtx];
+          origin_location = a_location;
+        }
+        if (! geomtools::is_valid(foil_vertex) && a_location == topology_event_view::VERTEX_ON_SOURCE_FOIL) {
+          foil_vertex = view_.get_vertex_position(ivtx);
+        }
+        if (topology_event_view::is_calorimeter_location(a_location)) {
+          if (! geomtools::is_valid(first_calorimeter_vertex)) {
+            first_calorimeter_vertex = view_.get_vertex_position(ivtx);
+          }
+          last_calorimeter_vertex = view_.get_vertex_position(ivtx);
+          // Match the vertex with the calorimeter hit of the same block
+          particle_kinematics::calorimeter_vertex_type a_calo_vertex;
+          a_calo_vertex.vertex = view_.get_vertices()[ivtx];
+          a_calo_vertex.hit = 0;
+          for (size_t ihit = first_hit; ihit < last_hit; ++ihit) {
+            if (view_.is_same_block(ivtx, ihit)) {
+              a_calo_vertex.hit = view_.get_calorimeter_hits()[ihit];
+              break;
+            }
+          }
+          calorimeter_vertices.push_back(a_calo_vertex);
+        }
+      }
+
+      // Direction at the foil vertex
+      if (geomtools::is_valid(foil_vertex)) {
+        if (type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
+          if (geomtools::is_valid(first_calorimeter_vertex)) {
+            direction = first_calorimeter_vertex - foil_vertex;
+          }
+        } else if (track->has_trajectory()) {
+          direction = track->get_trajectory().get_pattern().get_shape().get_direction_on_curve(foil_vertex);
+        }
+        if (geomtools::is_valid(direction)) {
+          direction /= direction.mag();
+        }
+      }
+      return;
+    }
+
+    kinematics_cache::kinematics_cache()
+    {
+      _size_ = 0;
+      return;
+    }
+
+    kinematics_cache::~kinematics_cache()
+    {
+      return;
+    }
+
+    void kinematics_cache::clear()
+    {
+      _view_.clear();
+      _size_ = 0;
+      return;
+    }
+
+    void kinematics_cache::build(const snemo::datamodel::particle_track_data & ptd_,
+                                 const snemo::datamodel::pid_data & pid_,
+                                 const snemo::datamodel::calorimeter_index * index_)
+    {
+      typedef snemo::datamodel::pid_utils pu;
+      clear();
+      _view_.build(ptd_, pid_, index_);
+      size_t n_particles[pu::NUMBER_OF_PARTICLE_TYPES] = {0, 0, 0, 0, 0};
+      const std::vector<pu::particle_type> & the_types = _view_.get_particle_types();
+      for (size_t i_particle = 0; i_particle < the_types.size(); ++i_particle) {
+        const pu::particle_type a_type = the_types[i_particle];
+        if (a_type == pu::PARTICLE_UNDEFINED) continue;
+        _add_kinematics_(snemo::datamodel::particle_slot(a_type, ++n_particles[a_type]), i_particle);
+      }
+      return;
+    }
+
+    size_t kinematics_cache::add(const snemo::datamodel::particle_slot & slot_,
+                                 const snemo::datamodel::particle_track & track_,
+                                 const snemo::datamodel::calorimeter_index * index_)
+    {
+      DT_THROW_IF(has(slot_), std::logic_error, "Particle '" << slot_ << "' is already stored !");
+      return _add_kinematics_(slot_, _view_.add_particle(track_, slot_.get_type(), index_));
+    }
+
+    const topology_event_view & kinematics_cache::get_view() const
+    {
+      return _view_;
+    }
+
+    size_t kinematics_cache::_add_kinematics_(const snemo::datamodel::particle_slot & slot_,
+                                              const size_t particle_)
+    {
+      if (_size_ == _kinematics_.size()) {
+        _slots_.push_back(slot_);
+        _kinematics_.push_back(particle_kinematics());
+      } else {
+        _slots_[_size_] = slot_;
+      }
+      _kinematics_[_size_].compute(_view_, particle_);
+      return _size_++;
+    }
+
+    size_t kinematics_cache::size() const
+    {
+      return _size_;
+    }
+
+    bool kinematics_cache::has(const snemo::datamodel::particle_slot & slot_) const
+    {
+      for (size_t i = 0; i < _size_; ++i) {
+        if (_slots_[i] == slot_) return true;
+      }
+      return false;
+    }
+
+    size_t kinematics_cache::get_index(const snemo::datamodel::particle_slot & slot_) const
+    {
+      // Few particles per event: a linear search is enough
+      for (size_t i = 0; i < _size_; ++i) {
+        if (_slots_[i] == slot_) return i;
+      }
+      DT_THROW(std::logic_error, "No kinematics for particle '" << slot_ << "' !");
+    }
+
+    const particle_kinematics & kinematics_cache::get(const size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _size_, std::range_error, "Invalid particle index (" << index_ << ") !");
+      return _kinematics_[index_];
+    }
+
+    const particle_kinematics & kinematics_cache::get(const snemo::datamodel::particle_slot & slot_) const
+    {
+      return _kinematics_[get_index(slot_)];
+    }
+
+    const snemo::datamodel::particle_slot & kinematics_cache::get_slot(const size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _size_, std::range_error, "Invalid particle index (" << index_ << ") !");
+      return _slots_[index_];
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,160 @@
+/// \file falaise/snemo/reconstruction/particle_kinematics.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Per-event cache of the particle kinematics used by the measurement drivers
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_PARTICLE_KINEMATICS_H
+#define FALAISE_SNEMO_RECONSTRUCTION_PARTICLE_KINEMATICS_H 1
+
+// Standard library:
+#include <vector>
+
+// Third party:
+// - Bayeux/geomtools:
+#include <geomtools/utils.h>
+#include <geomtools/blur_spot.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_keys.h>
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/calibrated_calorimeter_hit.h>
+#include <falaise/snemo/reconstruction/topology_event_view.h>
+
+namespace snemo {
+
+  namespace datamodel {
+    class calorimeter_index;
+  }
+
+  namespace reconstruction {
+
+    /// \brief Quantities derived once per particle and shared by the measurement drivers
+    ///
+    /// Invalid values (or null pointers) stand for quantities the particle
+    /// does not provide (no calorimeter hit, no trajectory, no foil vertex...).
+    /// Vertices of the particle are read from the event view it was computed
+    /// from, in the range [view->get_vertex_offsets()[particle], view->get_vertex_offsets()[particle+1]).
+    struct particle_kinematics
+    {
+      /// \brief Vertex on a calorimeter block with its calorimeter hit
+      struct calorimeter_vertex_type {
+        const geomtools::blur_spot * vertex;                           //!< Vertex on the calorimeter block
+        const snemo::datamodel::calibrated_calorimeter_hit * hit;      //!< Associated hit (null if not found)
+      };
+
+      /// Typedef for the calorimeter vertices
+      typedef std::vector<calorimeter_vertex_type> calorimeter_vertex_collection_type;
+
+      /// Default constructor
+      particle_kinematics();
+
+      /// Reset all the quantities
+      void clear();
+
+      /// Compute the quantities of a particle of an event view
+      void compute(const topology_event_view & view_, const size_t particle_);
+
+      const topology_event_view * view;                //!< Event view
+      size_t particle;                                 //!< Position of the particle in the event view
+      const snemo::datamodel::particle_track * track;  //!< Particle track
+      snemo::datamodel::pid_utils::particle_type type; //!< Particle type
+      double energy;                 //!< Energy of the first associated calorimeter hit
+      double total_energy;           //!< Energy summed over the associated calorimeter hits
+      double time;                   //!< Time of the first associated calorimeter hit
+      double sigma_time;             //!< Time error of the first associated calorimeter hit
+      double mass;                   //!< Mass given the particle type
+      double track_length;           //!< Length of the tracker trajectory
+      const geomtools::blur_spot * origin_vertex; //!< First vertex not on the first associated calorimeter
+      topology_event_view::vertex_location_type origin_location; //!< Location of the origin vertex
+      geomtools::vector_3d foil_vertex;           //!< First vertex on the source foil
+      geomtools::vector_3d first_calorimeter_vertex; //!< First vertex on a calorimeter block
+      geomtools::vector_3d last_calorimeter_vertex;  //!< Last vertex on a calorimeter block
+      geomtools::vector_3d direction;                //!< Unit direction at the foil vertex
+      calorimeter_vertex_collection_type calorimeter_vertices; //!< Vertices on calorimeter blocks
+    };
+
+    /// \brief Kinematics of the particles of one event
+    ///
+    /// The cache is filled once per event, when the topology pattern is built,
+    /// and only read afterwards so that the measurements of the event (possibly
+    /// computed at first access) share the same quantities.
+    /// It owns the event view the kinematics refer to and thus cannot be copied.
+    class kinematics_cache
+    {
+    public:
+
+      /// Constructor
+      kinematics_cache();
+
+      /// Destructor
+      ~kinematics_cache();
+
+      /// Remove all the particles (allocated storage is kept)
+      void clear();
+
+      /// Fill the event view and compute the kinematics of every identified particle
+      ///
+      /// Particles are given the slots of the topology patterns: by type,
+      /// with ranks starting from 1 in the order of the particle track data.
+      void build(const snemo::datamodel::particle_track_data & ptd_,
+                 const snemo::datamodel::pid_data & pid_,
+                 const snemo::datamodel::calorimeter_index * index_ = 0);
+
+      /// Compute and store the kinematics of a particle
+      size_t add(const snemo::datamodel::particle_slot & slot_,
+                 const snemo::datamodel::particle_track & track_,
+                 const snemo::datamodel::calorimeter_index * index_ = 0);
+
+      /// Return the event view
+      const topology_event_view & get_view() const;
+
+      /// Return the number of particles
+      size_t size() const;
+
+      /// Check if a particle is stored
+      bool has(const snemo::datamodel::particle_slot & slot_) const;
+
+      /// Return the position of a particle
+      size_t get_index(const snemo::datamodel::particle_slot & slot_) const;
+
+      /// Return the kinematics of a particle given its position
+      const particle_kinematics & get(const size_t index_) const;
+
+      /// Return the kinematics of a particle
+      const particle_kinematics & get(const snemo::datamodel::particle_slot & slot_) const;
+
+      /// Return the slot of a particle given its position
+      const snemo::datamodel::particle_slot & get_slot(const size_t index_) const;
+
+    private:
+
+      /// Compute and store the kinematics of a particle of the event view
+      size_t _add_kinematics_(const snemo::datamodel::particle_slot & slot_, const size_t particle_);
+
+      kinematics_cache(const kinematics_cache &) = delete;
+      kinematics_cache & operator=(const kinematics_cache &) = delete;
+
+    private:
+
+      topology_event_view _view_;                           //!< Event view
+      size_t _size_;                                        //!< Number of particles in use
+      std::vector<snemo::datamodel::particle_slot> _slots_; //!< Particle slots
+      std::vector<particle_kinematics> _kinematics_;        //!< Particle kinematics
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_PARTICLE_KINEMATICS_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,133 @@
+/** \file falaise/snemo/reconstruction/tof_batch.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/tof_batch.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/tof_kernel.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    tof_batch::tof_batch()
+    {
+      return;
+    }
+
+    tof_batch::~tof_batch()
+    {
+      return;
+    }
+
+    size_t tof_batch::size() const
+    {
+      return _proba_int_.size();
+    }
+
+    bool tof_batch::empty() const
+    {
+      return _proba_int_.empty();
+    }
+
+    void tof_batch::add(const double energy1_, const double mass1_, const double track_length1_,
+                        const double time1_, const double sigma_time1_,
+                        const double energy2_, const double mass2_, const double track_length2_,
+                        const double time2_, const double sigma_time2_,
+                        const double sigma_length_,
+                        probability_type & proba_int_, probability_type & proba_ext_)
+    {
+      _energy1_.push_back(energy1_);
+      _mass1_.push_back(mass1_);
+      _track_length1_.push_back(track_length1_);
+      _time1_.push_back(time1_);
+      _sigma_time1_.push_back(sigma_time1_);
+      _energy2_.push_back(energy2_);
+      _mass2_.push_back(mass2_);
+      _track_length2_.push_back(track_length2_);
+      _time2_.push_back(time2_);
+      _sigma_time2_.push_back(sigma_time2_);
+      _sigma_length_.push_back(sigma_length_);
+      _proba_int_.push_back(&proba_int_);
+      _proba_ext_.push_back(&proba_ext_);
+      return;
+    }
+
+    void tof_batch::set_chi2_probability(const chi2_probability & method_)
+    {
+      _chi2_probability_ = method_;
+      return;
+    }
+
+    void tof_batch::compute()
+    {
+      const size_t n = size();
+      _chi2_int_.resize(n);
+      _chi2_ext_.resize(n);
+      _q_int_.resize(n);
+      _q_ext_.resize(n);
+
+      // Chi2 and probabilities of the whole batch
+      tof_kernel::particle_arrays p1;
+      p1.energy       = _energy1_.data();
+      p1.mass         = _mass1_.data();
+      p1.track_length = _track_length1_.data();
+      p1.time         = _time1_.data();
+      p1.sigma_time   = _sigma_time1_.data();
+      tof_kernel::particle_arrays p2;
+      p2.energy       = _energy2_.data();
+      p2.mass         = _mass2_.data();
+      p2.track_length = _track_length2_.data();
+      p2.time         = _time2_.data();
+      p2.sigma_time   = _sigma_time2_.data();
+      tof_kernel::compute(p1, p2, _sigma_length_.data(), n, _chi2_probability_,
+                          _chi2_int_.data(), _chi2_ext_.data(), _q_int_.data(), _q_ext_.data());
+
+      // Scatter probabilities back to their measurements
+      for (size_t i = 0; i < n; ++i) {
+        _proba_int_[i]->push_back(_q_int_[i]*100.*CLHEP::perCent);
+        _proba_ext_[i]->push_back(_q_ext_[i]*100.*CLHEP::perCent);
+      }
+
+      clear();
+      return;
+    }
+
+    void tof_batch::clear()
+    {
+      _energy1_.clear();
+      _mass1_.clear();
+      _track_length1_.clear();
+      _time1_.clear();
+      _sigma_time1_.clear();
+      _energy2_.clear();
+      _mass2_.clear();
+      _track_length2_.clear();
+      _time2_.clear();
+      _sigma_time2_.clear();
+      _sigma_length_.clear();
+      _chi2_int_.clear();
+      _chi2_ext_.clear();
+      _q_int_.clear();
+      _q_ext_.clear();
+      _proba_int_.clear();
+      _proba_ext_.clear();
+      return;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
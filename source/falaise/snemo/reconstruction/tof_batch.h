@@ -0,0 +1,108 @@
+/// \file falaise/snemo/reconstruction/tof_batch.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Batch of deferred Time-Of-Flight computations
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_TOF_BATCH_H
+#define FALAISE_SNEMO_RECONSTRUCTION_TOF_BATCH_H 1
+
+// Standard library:
+#include <vector>
+
+// This project:
+#include <falaise/snemo/datamodels/probability_array.h>
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Batch of deferred Time-Of-Flight computations
+    ///
+    /// The kinematics of each particle pair (energies, masses, track lengths,
+    /// measured times and their uncertainties) are gathered into contiguous
+    /// arrays. The theoretical times, the internal/external chi2 and the
+    /// related probabilities are then computed over the whole batch by the
+    /// TOF kernel (see tof_kernel) and appended to the probability collections
+    /// of each TOF measurement, in the order the pairs were added.
+    ///
+    /// A batch is not thread-safe: it is owned by a single driver and
+    /// filled from one thread at a time.
+    class tof_batch
+    {
+    public:
+
+      /// Typedef for probability collection
+      typedef snemo::datamodel::probability_array probability_type;
+
+      /// Constructor
+      tof_batch();
+
+      /// Destructor
+      ~tof_batch();
+
+      /// Return the number of pending entries
+      size_t size() const;
+
+      /// Check if the batch has no pending entry
+      bool empty() const;
+
+      /// Add a particle pair hypothesis
+      void add(const double energy1_, const double mass1_, const double track_length1_,
+               const double time1_, const double sigma_time1_,
+               const double energy2_, const double mass2_, const double track_length2_,
+               const double time2_, const double sigma_time2_,
+               const double sigma_length_,
+               probability_type & proba_int_, probability_type & proba_ext_);
+
+      /// Set the method computing the probabilities
+      void set_chi2_probability(const chi2_probability & method_);
+
+      /// Compute all the pending entries and store the probabilities
+      void compute();
+
+      /// Remove all the pending entries
+      void clear();
+
+    private:
+
+      // Gathered kinematics:
+      std::vector<double> _energy1_;
+      std::vector<double> _mass1_;
+      std::vector<double> _track_length1_;
+      std::vector<double> _time1_;
+      std::vector<double> _sigma_time1_;
+      std::vector<double> _energy2_;
+      std::vector<double> _mass2_;
+      std::vector<double> _track_length2_;
+      std::vector<double> _time2_;
+      std::vector<double> _sigma_time2_;
+      std::vector<double> _sigma_length_;
+
+      // Results:
+      std::vector<double> _chi2_int_;
+      std::vector<double> _chi2_ext_;
+      std::vector<double> _q_int_;
+      std::vector<double> _q_ext_;
+      chi2_probability _chi2_probability_; //!< Probability method
+
+      // Destinations:
+      std::vector<probability_type *> _proba_int_;
+      std::vector<probability_type *> _proba_ext_;
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_TOF_BATCH_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -2,14 +2,14 @@
 
 // Ourselves:
 #include <falaise/snemo/reconstruction/tof_driver.h>
+#include <falaise/snemo/reconstruction/tof_kernel.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
 
 // Standard library:
 #include <stdexcept>
 #include <sstream>
 
 // Third party:
-//- GSL:
-#include <gsl/gsl_cdf.h>
 
 // This project:
 #include <falaise/snemo/datamodels/data_model.h>
@@ -20,14 +20,36 @@
 
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/event_time_measurement.h>
 
 namespace snemo {
 
   namespace reconstruction {
 
-    datatools::logger::priority tof_driver::tof_tool::logging = datatools::logger::PRIO_WARNING;
+    namespace {
+
+      /// Weighted mean of the times of flight corrected times, return the chi2
+      double fit_common_time(const std::vector<double> & times_, const std::vector<double> & weights_,
+                             double & t0_, double & sum_weights_)
+      {
+        double sum_wt = 0.0;
+        sum_weights_ = 0.0;
+        for (size_t i = 0; i < times_.size(); ++i) {
+          sum_wt += weights_[i] * times_[i];
+          sum_weights_ += weights_[i];
+        }
+        t0_ = sum_wt / sum_weights_;
+        double chi2 = 0.0;
+        for (size_t i = 0; i < times_.size(); ++i) {
+          chi2 += weights_[i] * (times_[i] - t0_) * (times_[i] - t0_);
+        }
+        return chi2;
+      }
+
+    }
 
-    double tof_driver::tof_tool::get_energy(const snemo::datamodel::particle_track & particle_)
+    double tof_driver::tof_tool::get_energy(const snemo::datamodel::particle_track & particle_,
+                                            const datatools::logger::priority logging_)
     {
       double energy = datatools::invalid_real();
       if (particle_.has_associated_calorimeter_hits()) {
@@ -38,7 +60,7 @@ namespace snemo {
         // only take care of teh first one)
         energy = the_calorimeters.front().get().get_energy();
       } else {
-        DT_LOG_WARNING(logging, "Particle track is not associated to any calorimeter block !");
+        DT_LOG_WARNING(logging_, "Particle track is not associated to any calorimeter block !");
       }
       return energy;
     }
@@ -54,7 +76,8 @@ namespace snemo {
     }
 
     void tof_driver::tof_tool::get_time(const snemo::datamodel::particle_track & particle_,
-                                        double & t_, double & sigma_t_)
+                                        double & t_, double & sigma_t_,
+                                        const datatools::logger::priority logging_)
     {
       datatools::invalidate(t_);
       datatools::invalidate(sigma_t_);
@@ -66,20 +89,25 @@ namespace snemo {
         t_ = a_calo_hit.get_time();
         sigma_t_ = a_calo_hit.get_sigma_time();
       } else {
-        DT_LOG_WARNING(logging, "Particle track is not associated to any calorimeter block !");
+        DT_LOG_WARNING(logging_, "Particle track is not associated to any calorimeter block !");
       }
       return;
     }
 
     double tof_driver::tof_tool::get_mass(const snemo::datamodel::particle_track & particle_)
+    {
+      return get_mass(snemo::datamodel::pid_utils::fetch_particle_type(particle_));
+    }
+
+    double tof_driver::tof_tool::get_mass(const snemo::datamodel::pid_utils::particle_type type_)
     {
       double mass = datatools::invalid_real();
-      if (snemo::datamodel::pid_utils::particle_is_electron(particle_) ||
-          snemo::datamodel::pid_utils::particle_is_positron(particle_)) {
+      if (type_ == snemo::datamodel::pid_utils::PARTICLE_ELECTRON ||
+          type_ == snemo::datamodel::pid_utils::PARTICLE_POSITRON) {
         mass = CLHEP::electron_mass_c2;
-      } else if (snemo::datamodel::pid_utils::particle_is_gamma(particle_)) {
+      } else if (type_ == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
         mass = 0.0 * CLHEP::eV;
-      } else if (snemo::datamodel::pid_utils::particle_is_alpha(particle_)) {
+      } else if (type_ == snemo::datamodel::pid_utils::PARTICLE_ALPHA) {
         mass = 3.727417 * CLHEP::GeV;
       } else {
         DT_THROW_IF(true, std::logic_error,
@@ -88,7 +116,8 @@ namespace snemo {
       return mass;
     }
 
-    double tof_driver::tof_tool::get_charged_particle_track_length(const snemo::datamodel::particle_track & particle_)
+    double tof_driver::tof_tool::get_charged_particle_track_length(const snemo::datamodel::particle_track & particle_,
+                                                                   const datatools::logger::priority logging_)
     {
       double length = datatools::invalid_real();
       if (particle_.has_trajectory()) {
@@ -96,18 +125,19 @@ namespace snemo {
         const snemo::datamodel::base_trajectory_pattern & a_track_pattern = a_trajectory.get_pattern();
         length = a_track_pattern.get_shape().get_length();
       } else {
-        DT_LOG_WARNING(logging, "Particle has no attached trajectory !");
+        DT_LOG_WARNING(logging_, "Particle has no attached trajectory !");
       }
       return length;
     }
 
     double tof_driver::tof_tool::get_gamma_track_length(const snemo::datamodel::particle_track & ptg_,
                                                         const snemo::datamodel::particle_track & pte_,
-                                                        const bool external_hyp_)
+                                                        const bool external_hyp_,
+                                                        const datatools::logger::priority logging_)
     {
       double length = datatools::invalid_real();
       if (! pte_.has_vertices()) {
-        DT_LOG_WARNING(logging, "Electron has no vertices associated !");
+        DT_LOG_WARNING(logging_, "Electron has no vertices associated !");
         return length;
       }
       const snemo::datamodel::particle_track::vertex_collection_type & the_vertices = pte_.get_vertices();
@@ -123,12 +153,12 @@ namespace snemo {
         break;
       }
       if (! geomtools::is_valid(electron_foil_vertex)) {
-        DT_LOG_WARNING(logging, "Electron has no vertices on the calorimeter !");
+        DT_LOG_WARNING(logging_, "Electron has no vertices on the calorimeter !");
         return length;
       }
 
       if (! ptg_.has_vertices()) {
-        DT_LOG_WARNING(logging, "Gamma has no vertices associated !");
+        DT_LOG_WARNING(logging_, "Gamma has no vertices associated !");
         return length;
       }
       const snemo::datamodel::particle_track::vertex_collection_type & the_gamma_vertices = ptg_.get_vertices();
@@ -145,7 +175,7 @@ namespace snemo {
         }
       }
       if (! geomtools::is_valid(gamma_first_calo_vertex)) {
-        DT_LOG_WARNING(logging, "Gamma has no vertices on the calorimeter !");
+        DT_LOG_WARNING(logging_, "Gamma has no vertices on the calorimeter !");
         return length;
       }
 
@@ -201,6 +231,73 @@ namespace snemo {
     {
       _initialized_ = false;
       _logging_priority_ = datatools::logger::PRIO_WARNING;
+      _batch_ = 0;
+      _gamma_batch_.clear();
+      _calorimeter_index_ = 0;
+      _chi2_probability_.set_method(chi2_probability::METHOD_GSL);
+      _mode_ = MODE_PAIRWISE;
+      _pair_charged_sigma_length_ = 0.1 * CLHEP::ns;
+      _pair_gamma_sigma_length_ = 0.6 * CLHEP::ns;
+      datatools::invalidate(_charged_sigma_length_);
+      datatools::invalidate(_gamma_sigma_length_);
+      return;
+    }
+
+    void tof_driver::set_mode(const mode_type mode_)
+    {
+      DT_THROW_IF((mode_ & MODE_ALL) == 0 || (mode_ & ~MODE_ALL) != 0, std::logic_error,
+                  "Invalid TOF mode (" << mode_ << ") !");
+      _mode_ = mode_;
+      return;
+    }
+
+    tof_driver::mode_type tof_driver::get_mode() const
+    {
+      return _mode_;
+    }
+
+    bool tof_driver::is_pairwise_mode() const
+    {
+      return _mode_ & MODE_PAIRWISE;
+    }
+
+    bool tof_driver::is_event_time_mode() const
+    {
+      return _mode_ & MODE_EVENT_TIME;
+    }
+
+    bool tof_driver::has_batch() const
+    {
+      return _batch_ != 0;
+    }
+
+    void tof_driver::set_batch(tof_batch & batch_)
+    {
+      _batch_ = &batch_;
+      _batch_->set_chi2_probability(_chi2_probability_);
+      return;
+    }
+
+    void tof_driver::reset_batch()
+    {
+      _batch_ = 0;
+      return;
+    }
+
+    bool tof_driver::has_calorimeter_index() const
+    {
+      return _calorimeter_index_ != 0;
+    }
+
+    void tof_driver::set_calorimeter_index(const snemo::datamodel::calorimeter_index & index_)
+    {
+      _calorimeter_index_ = &index_;
+      return;
+    }
+
+    void tof_driver::reset_calorimeter_index()
+    {
+      _calorimeter_index_ = 0;
       return;
     }
 
@@ -215,8 +312,54 @@ namespace snemo {
                   "Invalid logging priority level !");
       set_logging_priority(lp);
 
-      // Set logging priority for tof_tool
-      tof_tool::logging = lp;
+      // Chi-square probabilities
+      if (setup_.has_key("chi2_probability.method")) {
+        _chi2_probability_.set_method(chi2_probability::method_from_label(setup_.fetch_string("chi2_probability.method")));
+      }
+      _gamma_batch_.set_chi2_probability(_chi2_probability_);
+
+      // TOF mode
+      if (setup_.has_key("mode")) {
+        const std::string a_mode = setup_.fetch_string("mode");
+        if (a_mode == "pairwise") {
+          set_mode(MODE_PAIRWISE);
+        } else if (a_mode == "event_time") {
+          set_mode(MODE_EVENT_TIME);
+        } else if (a_mode == "all") {
+          set_mode(MODE_ALL);
+        } else {
+          DT_THROW_IF(true, std::logic_error, "Unknown '" << a_mode << "' TOF mode !");
+        }
+      }
+      if (setup_.has_key("pairwise.charged_sigma_length")) {
+        _pair_charged_sigma_length_ = setup_.fetch_real_with_explicit_dimension("pairwise.charged_sigma_length", "time");
+        DT_THROW_IF(_pair_charged_sigma_length_ < 0.0, std::range_error,
+                    "Invalid track length uncertainty of charged pairs (" << _pair_charged_sigma_length_ << ") !");
+      }
+      if (setup_.has_key("pairwise.gamma_sigma_length")) {
+        _pair_gamma_sigma_length_ = setup_.fetch_real_with_explicit_dimension("pairwise.gamma_sigma_length", "time");
+        DT_THROW_IF(_pair_gamma_sigma_length_ < 0.0, std::range_error,
+                    "Invalid track length uncertainty of charged/gamma pairs (" << _pair_gamma_sigma_length_ << ") !");
+      }
+      if (setup_.has_key("event_time.charged_sigma_length")) {
+        _charged_sigma_length_ = setup_.fetch_real_with_explicit_dimension("event_time.charged_sigma_length", "time");
+        DT_THROW_IF(_charged_sigma_length_ < 0.0, std::range_error,
+                    "Invalid track length uncertainty of charged particles (" << _charged_sigma_length_ << ") !");
+      }
+      if (setup_.has_key("event_time.gamma_sigma_length")) {
+        _gamma_sigma_length_ = setup_.fetch_real_with_explicit_dimension("event_time.gamma_sigma_length", "time");
+        DT_THROW_IF(_gamma_sigma_length_ < 0.0, std::range_error,
+                    "Invalid track length uncertainty of gammas (" << _gamma_sigma_length_ << ") !");
+      }
+      // The pairwise uncertainties are shared between the two particles so
+      // that the event time fit of a pair gives back its pairwise chi2
+      if (! datatools::is_valid(_charged_sigma_length_)) {
+        _charged_sigma_length_ = _pair_charged_sigma_length_ / std::sqrt(2.);
+      }
+      if (! datatools::is_valid(_gamma_sigma_length_)) {
+        const double gamma_variance = std::pow(_pair_gamma_sigma_length_, 2) - std::pow(_charged_sigma_length_, 2);
+        _gamma_sigma_length_ = gamma_variance > 0.0 ? std::sqrt(gamma_variance) : 0.0;
+      }
 
       _set_initialized(true);
       return;
@@ -237,35 +380,166 @@ namespace snemo {
     {
       DT_THROW_IF(! is_initialized(), std::logic_error,
                   "Driver '" << get_id() << "' is not initialized !");
-      this->_process_algo(pt1_, pt2_, tof_.grab_internal_probabilities(), tof_.grab_external_probabilities());
+      process(pt1_, snemo::datamodel::pid_utils::fetch_particle_type(pt1_),
+              pt2_, snemo::datamodel::pid_utils::fetch_particle_type(pt2_), tof_);
       return;
     }
 
-    void tof_driver::_process_algo(const snemo::datamodel::particle_track & pt1_,
-                                   const snemo::datamodel::particle_track & pt2_,
-                                   std::vector<double> & proba_int_, std::vector<double> & proba_ext_)
+    void tof_driver::process(const snemo::datamodel::particle_track & pt1_,
+                             const snemo::datamodel::pid_utils::particle_type type1_,
+                             const snemo::datamodel::particle_track & pt2_,
+                             const snemo::datamodel::pid_utils::particle_type type2_,
+                             snemo::datamodel::tof_measurement & tof_)
     {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Driver '" << get_id() << "' is not initialized !");
+      kinematics_cache pair_kinematics;
+      pair_kinematics.add(snemo::datamodel::particle_slot(type1_, 1), pt1_, _calorimeter_index_);
+      pair_kinematics.add(snemo::datamodel::particle_slot(type2_, 2), pt2_, _calorimeter_index_);
+      process(pair_kinematics.get(0), pair_kinematics.get(1), tof_);
+      return;
+    }
+
+    void tof_driver::process(const particle_kinematics & k1_,
+                             const particle_kinematics & k2_,
+                             snemo::datamodel::tof_measurement & tof_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(k1_, k2_,
+                          tof_.grab_internal_probabilities(), tof_.grab_external_probabilities());
+      return;
+    }
+
+    void tof_driver::process(const kinematics_cache & kinematics_,
+                             snemo::datamodel::event_time_measurement & event_time_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Driver '" << get_id() << "' is not initialized !");
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
-      if (! pt1_.has_associated_calorimeter_hits() ||
-          ! pt2_.has_associated_calorimeter_hits()) {
+      // Gammas fly from the origin vertex of the first charged particle
+      const geomtools::blur_spot * a_vertex = 0;
+      for (size_t i = 0; i < kinematics_.size() && a_vertex == 0; ++i) {
+        const particle_kinematics & k = kinematics_.get(i);
+        if (k.type != snemo::datamodel::pid_utils::PARTICLE_GAMMA) a_vertex = k.origin_vertex;
+      }
+      if (a_vertex == 0) {
+        DT_LOG_NOTICE(get_logging_priority(), "No charged particle vertex, event time not fitted !");
+        return;
+      }
+
+      // Gather the particles with a measured time in one pass
+      event_time_.clear();
+      snemo::datamodel::event_time_measurement::label_collection_type & the_labels
+        = event_time_.grab_particle_labels();
+      std::vector<double> E, m, tl, t, sigma;
+      for (size_t i = 0; i < kinematics_.size(); ++i) {
+        const particle_kinematics & k = kinematics_.get(i);
+        double sigma_length;
+        if (k.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
+          // First calorimeter vertex with its calorimeter hit
+          if (k.calorimeter_vertices.empty() || k.calorimeter_vertices.front().hit == 0) continue;
+          const particle_kinematics::calorimeter_vertex_type & a_calo = k.calorimeter_vertices.front();
+          E.push_back(1); // dummy, non-zero value
+          m.push_back(k.mass);
+          tl.push_back((a_vertex->get_position() - a_calo.vertex->get_position()).mag());
+          t.push_back(a_calo.hit->get_time());
+          sigma.push_back(a_calo.hit->get_sigma_time());
+          sigma_length = _gamma_sigma_length_;
+        } else {
+          if (! datatools::is_valid(k.time) || ! datatools::is_valid(k.track_length) ||
+              ! datatools::is_valid(k.mass)) continue;
+          E.push_back(k.energy);
+          m.push_back(k.mass);
+          tl.push_back(k.track_length);
+          t.push_back(k.time);
+          sigma.push_back(k.sigma_time);
+          sigma_length = _charged_sigma_length_;
+        }
+        sigma.back() = std::sqrt(std::pow(sigma.back(), 2) + std::pow(sigma_length, 2));
+        the_labels.push_back(kinematics_.get_slot(i).to_string());
+      }
+      const size_t n = the_labels.size();
+      if (n < 2) {
+        DT_LOG_NOTICE(get_logging_priority(), "Less than 2 timed particles, event time not fitted !");
+        return;
+      }
+
+      std::vector<double> t_th(n);
+      tof_kernel::compute_theoretical_times(E.data(), m.data(), tl.data(), t_th.data(), n);
+      std::vector<double> w(n);
+      size_t i_first = 0;
+      for (size_t i = 0; i < n; ++i) {
+        w[i] = 1.0 / (sigma[i] * sigma[i]);
+        if (t[i] < t[i_first]) i_first = i;
+      }
+
+      // Internal hypothesis: every particle is emitted at t0
+      std::vector<double> t_emission(n);
+      for (size_t i = 0; i < n; ++i) {
+        t_emission[i] = t[i] - t_th[i];
+      }
+      double t0, sum_w;
+      const double chi2_int = fit_common_time(t_emission, w, t0, sum_w);
+      event_time_.set_internal_fit(t0, 1.0 / std::sqrt(sum_w), chi2_int,
+                                   _chi2_probability_.survival(chi2_int, n - 1)*100.*CLHEP::perCent);
+      snemo::datamodel::event_time_measurement::pull_collection_type & pulls_int
+        = event_time_.grab_internal_pulls();
+      for (size_t i = 0; i < n; ++i) {
+        pulls_int.push_back((t_emission[i] - t0) / sigma[i]);
+      }
+
+      // External hypothesis: the first particle to hit a calorimeter comes
+      // from outside and crosses the vertex at t0
+      t_emission[i_first] = t[i_first] + t_th[i_first];
+      double t0_ext;
+      const double chi2_ext = fit_common_time(t_emission, w, t0_ext, sum_w);
+      event_time_.set_external_fit(t0_ext, chi2_ext,
+                                   _chi2_probability_.survival(chi2_ext, n - 1)*100.*CLHEP::perCent);
+      event_time_.set_incoming_particle(the_labels[i_first]);
+      snemo::datamodel::event_time_measurement::pull_collection_type & pulls_ext
+        = event_time_.grab_external_pulls();
+      for (size_t i = 0; i < n; ++i) {
+        pulls_ext.push_back((t_emission[i] - t0_ext) / sigma[i]);
+      }
+
+      DT_LOG_DEBUG(get_logging_priority(), "t0 = " << t0/CLHEP::ns << " ns, "
+                   << "P_int " << event_time_.get_internal_probability()/CLHEP::perCent << " %, "
+                   << "P_ext " << event_time_.get_external_probability()/CLHEP::perCent << " %");
+      DT_LOG_TRACE(get_logging_priority(), "Exiting...");
+      return;
+    }
+
+    void tof_driver::_process_algo(const particle_kinematics & k1_,
+                                   const particle_kinematics & k2_,
+                                   snemo::datamodel::probability_array & proba_int_,
+                                   snemo::datamodel::probability_array & proba_ext_)
+    {
+      DT_LOG_TRACE(get_logging_priority(), "Entering...");
+
+      if (! k1_.track->has_associated_calorimeter_hits() ||
+          ! k2_.track->has_associated_calorimeter_hits()) {
         DT_LOG_WARNING(get_logging_priority(), "No associated calorimeter !");
         return;
       }
 
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) &&
-          snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
+      const bool is_gamma1 = (k1_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA);
+      const bool is_gamma2 = (k2_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA);
+      if (is_gamma1 && is_gamma2) {
         DT_LOG_NOTICE(get_logging_priority(), "TOF calculation not done for 2 gammas !");
         return;
       }
+      DT_THROW_IF(! datatools::is_valid(k1_.mass) || ! datatools::is_valid(k2_.mass), std::logic_error,
+                  "Particle type inappropriate for TOF calculations !");
 
       // Either specialize the methods or consider the case here
-      if (! snemo::datamodel::pid_utils::particle_is_gamma(pt1_) &&
-          ! snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
-        _process_charged_particles(pt1_, pt2_, proba_int_, proba_ext_);
-      } else if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ||
-                 snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
-        _process_charged_gamma_particles(pt1_, pt2_, proba_int_, proba_ext_);
+      if (! is_gamma1 && ! is_gamma2) {
+        _process_charged_particles(k1_, k2_, proba_int_, proba_ext_);
+      } else if (is_gamma1 || is_gamma2) {
+        // Deferred to the shared batch if any
+        tof_batch & a_batch = has_batch() ? *_batch_ : _gamma_batch_;
+        _process_charged_gamma_particles(k1_, k2_, a_batch, proba_int_, proba_ext_);
       } else {
         DT_LOG_WARNING(get_logging_priority(), "Topology not supported !");
         return;
@@ -275,146 +549,123 @@ namespace snemo {
       return;
     }
 
-    void tof_driver::_process_charged_particles(const snemo::datamodel::particle_track & pt1_,
-                                                const snemo::datamodel::particle_track & pt2_,
-                                                std::vector<double> & proba_int_,
-                                                std::vector<double> & proba_ext_)
+    void tof_driver::_process_charged_particles(const particle_kinematics & k1_,
+                                                const particle_kinematics & k2_,
+                                                snemo::datamodel::probability_array & proba_int_,
+                                                snemo::datamodel::probability_array & proba_ext_)
     {
       // Compute theoretical times given energy, mass and track length
-      const double E1 = tof_tool::get_energy(pt1_);
-      const double E2 = tof_tool::get_energy(pt2_);
-      const double tl1 = tof_tool::get_charged_particle_track_length(pt1_);
-      const double tl2 = tof_tool::get_charged_particle_track_length(pt2_);
-      const double m1 = tof_tool::get_mass(pt1_);
-      const double m2 = tof_tool::get_mass(pt2_);
+      const double E1 = k1_.energy;
+      const double E2 = k2_.energy;
+      const double tl1 = k1_.track_length;
+      const double tl2 = k2_.track_length;
+      if (! datatools::is_valid(tl1) || ! datatools::is_valid(tl2)) {
+        DT_LOG_WARNING(get_logging_priority(), "Particle has no attached trajectory !");
+      }
+      const double m1 = k1_.mass;
+      const double m2 = k2_.mass;
       const double t1_th = tof_tool::get_theoretical_time(E1, m1, tl1);
       const double t2_th = tof_tool::get_theoretical_time(E2, m2, tl2);
       DT_LOG_DEBUG(get_logging_priority(), "t1 th : " << t1_th/CLHEP::ns << " ns");
       DT_LOG_DEBUG(get_logging_priority(), "t2 th : " << t2_th/CLHEP::ns << " ns");
 
-      double t1, t2;
-      double sigma_t1, sigma_t2;
-      tof_tool::get_time(pt1_, t1, sigma_t1);
-      tof_tool::get_time(pt2_, t2, sigma_t2);
+      const double t1 = k1_.time;
+      const double t2 = k2_.time;
+      const double sigma_t1 = k1_.sigma_time;
+      const double sigma_t2 = k2_.sigma_time;
       DT_LOG_DEBUG(get_logging_priority(), "t1 meas. : " << t1/CLHEP::ns << " ns");
       DT_LOG_DEBUG(get_logging_priority(), "t2 meas. : " << t2/CLHEP::ns << " ns");
 
-      const double sigma_l = 0.1 * CLHEP::ns; //kind of arbitrary value to keep the internal probability distribution flat,
-                                              // until the uncertainty on the track length is obtained from the reconstruction algorithm.
+      // Kind of arbitrary value to keep the internal probability distribution flat,
+      // until the uncertainty on the track length is obtained from the reconstruction algorithm.
+      const double sigma_l = _pair_charged_sigma_length_;
+      if (has_batch()) {
+        _batch_->add(E1, m1, tl1, t1, sigma_t1, E2, m2, tl2, t2, sigma_t2, sigma_l, proba_int_, proba_ext_);
+        return;
+      }
       const double sigma_exp
         = std::pow(sigma_t1, 2) + std::pow(sigma_t2, 2) + std::pow(sigma_l, 2);
 
       const double chi2_int = std::pow(t1 - t2 - (t1_th - t2_th), 2)/sigma_exp;
       const double chi2_ext = std::pow(std::abs(t1 - t2) - (t1_th + t2_th), 2)/sigma_exp;
 
-      proba_int_.push_back(gsl_cdf_chisq_Q(chi2_int, 1)*100.*CLHEP::perCent);
-      proba_ext_.push_back(gsl_cdf_chisq_Q(chi2_ext, 1)*100.*CLHEP::perCent);
+      proba_int_.push_back(_chi2_probability_.survival(chi2_int, 1)*100.*CLHEP::perCent);
+      proba_ext_.push_back(_chi2_probability_.survival(chi2_ext, 1)*100.*CLHEP::perCent);
 
       DT_LOG_DEBUG(get_logging_priority(), "P_int " << proba_int_.front()/CLHEP::perCent << " %");
       DT_LOG_DEBUG(get_logging_priority(), "P_ext " << proba_ext_.front()/CLHEP::perCent << " %");
       return;
     }
 
-    void tof_driver::_process_charged_gamma_particles(const snemo::datamodel::particle_track & pt1_,
-                                                      const snemo::datamodel::particle_track & pt2_,
-                                                      std::vector<double> & proba_int_,
-                                                      std::vector<double> & proba_ext_)
+    void tof_driver::_process_charged_gamma_particles(const particle_kinematics & k1_,
+                                                      const particle_kinematics & k2_,
+                                                      tof_batch & batch_,
+                                                      snemo::datamodel::probability_array & proba_int_,
+                                                      snemo::datamodel::probability_array & proba_ext_)
     {
-      const snemo::datamodel::particle_track & a_gamma
-        = (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ? pt1_ : pt2_);
-      const snemo::datamodel::particle_track & a_charged
-        = (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ? pt2_ : pt1_);
+      const bool first_is_gamma = (k1_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA);
+      const particle_kinematics & a_gamma = (first_is_gamma ? k1_ : k2_);
+      const particle_kinematics & a_charged = (first_is_gamma ? k2_ : k1_);
 
       // Compute theoretical times given energy, mass and track length
-      const double E1 = tof_tool::get_energy(a_charged);
+      const double E1 = a_charged.energy;
       const double E2 = 1; // dummy, non-zero value
-      const double m1 = tof_tool::get_mass(a_charged);
-      const double m2 = tof_tool::get_mass(a_gamma);
+      const double m1 = a_charged.mass;
+      const double m2 = a_gamma.mass;
 
-      const double tl1 = tof_tool::get_charged_particle_track_length(a_charged);
-      const double t1_th = tof_tool::get_theoretical_time(E1, m1, tl1);
-      double t1, sigma_t1;
-      tof_tool::get_time(a_charged, t1, sigma_t1);
+      const double tl1 = a_charged.track_length;
+      if (! datatools::is_valid(tl1)) {
+        DT_LOG_WARNING(get_logging_priority(), "Particle has no attached trajectory !");
+      }
+      const double t1 = a_charged.time;
+      const double sigma_t1 = a_charged.sigma_time;
       DT_LOG_DEBUG(get_logging_priority(), "t1 meas. : " << t1/CLHEP::ns << " ns");
 
-      snemo::datamodel::particle_track::vertex_collection_type the_gamma_calos_vertices;
-      a_gamma.fetch_vertices(the_gamma_calos_vertices,
-                             snemo::datamodel::particle_track::VERTEX_ON_MAIN_CALORIMETER |
-                             snemo::datamodel::particle_track::VERTEX_ON_X_CALORIMETER    |
-                             snemo::datamodel::particle_track::VERTEX_ON_GAMMA_VETO);
-
-      for (snemo::datamodel::particle_track::vertex_collection_type::iterator
-             ivtx = the_gamma_calos_vertices.begin();
-           ivtx != the_gamma_calos_vertices.end(); ++ivtx) {
+      // Calorimeter vertices are gathered and evaluated by the TOF kernel,
+      // right away unless the batch is shared
+      const bool deferred = (&batch_ == _batch_);
+      if (! deferred) batch_.clear();
+      for (particle_kinematics::calorimeter_vertex_collection_type::const_iterator
+             ivtx = a_gamma.calorimeter_vertices.begin();
+           ivtx != a_gamma.calorimeter_vertices.end(); ++ivtx) {
         double tl2, t2, sigma_t2;
-        this->_get_vertex_to_calo_info_(a_charged, a_gamma, ivtx->get(),
-                                        tl2, t2, sigma_t2);
-
-        const double t2_th = tof_tool::get_theoretical_time(E2, m2, tl2);
-        const double sigma_l = 0.6 * CLHEP::ns;
-        const double sigma_exp = std::pow(sigma_t1, 2) + std::pow(sigma_t2, 2)
-                                 + std::pow(sigma_l, 2);
-        const double chi2_int = std::pow(t1 - t2 - (t1_th - t2_th), 2)/sigma_exp;
-        const double chi2_ext = std::pow(std::abs(t1 - t2) - (t1_th + t2_th), 2)/sigma_exp;
+        this->_get_vertex_to_calo_info_(a_charged, *ivtx, tl2, t2, sigma_t2);
 
-        proba_int_.push_back(gsl_cdf_chisq_Q(chi2_int, 1)*100.*CLHEP::perCent);
-        proba_ext_.push_back(gsl_cdf_chisq_Q(chi2_ext, 1)*100.*CLHEP::perCent);
+        const double sigma_l = _pair_gamma_sigma_length_;
+        batch_.add(E1, m1, tl1, t1, sigma_t1, E2, m2, tl2, t2, sigma_t2, sigma_l, proba_int_, proba_ext_);
+      }
+      if (deferred) return;
+      batch_.compute();
 
-        DT_LOG_DEBUG(get_logging_priority(), "P_int " << proba_int_.back());
-        DT_LOG_DEBUG(get_logging_priority(), "P_ext " << proba_ext_.back());
+      for (size_t i = 0; i < proba_int_.size(); ++i) {
+        DT_LOG_DEBUG(get_logging_priority(), "P_int " << proba_int_[i]);
+        DT_LOG_DEBUG(get_logging_priority(), "P_ext " << proba_ext_[i]);
       }
       return;
     }
 
-    void tof_driver::_get_vertex_to_calo_info_(const snemo::datamodel::particle_track & ptc_,
-                                               const snemo::datamodel::particle_track & ptg_,
-                                               const geomtools::blur_spot & vertex_,
+    void tof_driver::_get_vertex_to_calo_info_(const particle_kinematics & charged_,
+                                               const particle_kinematics::calorimeter_vertex_type & vertex_,
                                                double & track_length_, double & time_, double & sigma_time_)
     {
       datatools::invalidate(track_length_);
       datatools::invalidate(time_);
       datatools::invalidate(sigma_time_);
 
-      if (! ptc_.has_vertices()) {
-        DT_LOG_WARNING(get_logging_priority(), "Electron has no vertices associated !");
-        return;
-      }
-      const snemo::datamodel::particle_track::vertex_collection_type & the_vertices = ptc_.get_vertices();
-      geomtools::vector_3d electron_origin_vertex;
-      geomtools::invalidate(electron_origin_vertex);
-      for (snemo::datamodel::particle_track::vertex_collection_type::const_iterator
-             ivtx = the_vertices.begin(); ivtx < the_vertices.end(); ++ivtx) {
-        const geomtools::blur_spot & a_vertex = ivtx->get();
-
-        if(a_vertex.get_geom_id() == ptc_.get_associated_calorimeter_hits().front().get().get_geom_id())
-          continue;
-
-        electron_origin_vertex = a_vertex.get_position();
-        break;
-      }
-      if (! geomtools::is_valid(electron_origin_vertex)) {
+      // Origin and calorimeter hit matching are resolved once per particle
+      if (charged_.origin_vertex == 0) {
         DT_LOG_WARNING(get_logging_priority(), "Electron has no vertices on the calorimeter !");
         return;
       }
-
-      const snemo::datamodel::calibrated_calorimeter_hit::collection_type &
-        the_gamma_calorimeters = ptg_.get_associated_calorimeter_hits();
-      geomtools::base_hit::has_geom_id_predicate hit_pred(vertex_.get_geom_id());
-      datatools::mother_to_daughter_predicate<geomtools::base_hit,
-                                              snemo::datamodel::calibrated_calorimeter_hit> pred_M2D(hit_pred);
-      datatools::handle_predicate<snemo::datamodel::calibrated_calorimeter_hit> pred_via_handle(pred_M2D);
-      snemo::datamodel::calibrated_calorimeter_hit::collection_type::const_iterator
-        found = std::find_if(the_gamma_calorimeters.begin(),the_gamma_calorimeters.end(), pred_via_handle);
-      if (found == the_gamma_calorimeters.end()) {
-        DT_LOG_WARNING(get_logging_priority(), "Calibrated calorimeter hit with id " << vertex_.get_geom_id()
+      if (vertex_.hit == 0) {
+        DT_LOG_WARNING(get_logging_priority(), "Calibrated calorimeter hit with id " << vertex_.vertex->get_geom_id()
                        << " can not be found ! Might be a gamma from annihilation.");
         return;
       }
-      const snemo::datamodel::calibrated_calorimeter_hit & a_calo_hit = found->get();
 
-      track_length_ = (electron_origin_vertex - vertex_.get_position()).mag();
-      time_ = a_calo_hit.get_time();
-      sigma_time_ = a_calo_hit.get_sigma_time();
+      track_length_ = (charged_.origin_vertex->get_position() - vertex_.vertex->get_position()).mag();
+      time_ = vertex_.hit->get_time();
+      sigma_time_ = vertex_.hit->get_sigma_time();
       return;
     }
 
@@ -423,6 +674,137 @@ namespace snemo {
     {
       // Prefix "TOFD" stands for "Time-Of-Flight Driver" :
       datatools::logger::declare_ocd_logging_configuration(ocd_, "fatal", "TOFD.");
+
+      {
+        // Description of the 'chi2_probability.method' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TOFD.chi2_probability.method")
+          .set_terse_description("The method computing the chi-square probabilities")
+          .set_traits(datatools::TYPE_STRING)
+          .set_mandatory(false)
+          .set_long_description("Internal and external TOF probabilities are the chi-square \n"
+                                "survival function of the TOF chi2 (one degree of freedom).  \n"
+                                "Possible values are : 'gsl' (reference), 'exact' (closed   \n"
+                                "form), 'fast' (approximation, absolute error < 1.5e-7) and \n"
+                                "'tabulated' (interpolation, absolute error < 1e-5).         \n")
+          .set_default_value_string("gsl")
+          .add_example("Use the closed form::                               \n"
+                       "                                                    \n"
+                       "  TOFD.chi2_probability.method : string = \"exact\"  \n"
+                       "                                                    \n"
+                       );
+      }
+
+      {
+        // Description of the 'mode' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TOFD.mode")
+          .set_terse_description("The TOF mode")
+          .set_traits(datatools::TYPE_STRING)
+          .set_mandatory(false)
+          .set_long_description("Possible values are :                                      \n"
+                                " * ``pairwise`` internal/external probabilities of every   \n"
+                                "   particle pair (``tof_e1_e2``, ``tof_e1_g1``...)          \n"
+                                " * ``event_time`` fit of a common emission time over all    \n"
+                                "   the particles of the event (``event_time`` measurement)  \n"
+                                " * ``all`` both of them                                     \n")
+          .set_default_value_string("pairwise")
+          .add_example("Fit the event time only::                  \n"
+                       "                                           \n"
+                       "  TOFD.mode : string = \"event_time\"      \n"
+                       "                                           \n"
+                       );
+      }
+
+      {
+        // Description of the 'pairwise.charged_sigma_length' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TOFD.pairwise.charged_sigma_length")
+          .set_terse_description("Time uncertainty on the track lengths of a pair of charged particles")
+          .set_traits(datatools::TYPE_REAL)
+          .set_mandatory(false)
+          .set_explicit_unit(true)
+          .set_unit_label("time")
+          .set_unit_symbol("ns")
+          .set_long_description("Pairwise mode only: uncertainty of the pair as a whole, added  \n"
+                                "once to the uncertainties of the measured times.              \n")
+          .set_default_value_real(0.1 * CLHEP::ns, "ns")
+          .add_example("Set the uncertainty::                                        \n"
+                       "                                                             \n"
+                       "  TOFD.pairwise.charged_sigma_length : real as time = 0.1 ns \n"
+                       "                                                             \n"
+                       );
+      }
+
+      {
+        // Description of the 'pairwise.gamma_sigma_length' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TOFD.pairwise.gamma_sigma_length")
+          .set_terse_description("Time uncertainty on the track lengths of a charged particle/gamma pair")
+          .set_traits(datatools::TYPE_REAL)
+          .set_mandatory(false)
+          .set_explicit_unit(true)
+          .set_unit_label("time")
+          .set_unit_symbol("ns")
+          .set_long_description("Pairwise mode only: uncertainty of the pair as a whole, added  \n"
+                                "once to the uncertainties of the measured times.              \n")
+          .set_default_value_real(0.6 * CLHEP::ns, "ns")
+          .add_example("Set the uncertainty::                                      \n"
+                       "                                                           \n"
+                       "  TOFD.pairwise.gamma_sigma_length : real as time = 0.6 ns \n"
+                       "                                                           \n"
+                       );
+      }
+
+      {
+        // Description of the 'event_time.charged_sigma_length' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TOFD.event_time.charged_sigma_length")
+          .set_terse_description("Time uncertainty on the track length of charged particles")
+          .set_traits(datatools::TYPE_REAL)
+          .set_mandatory(false)
+          .set_explicit_unit(true)
+          .set_unit_label("time")
+          .set_unit_symbol("ns")
+          .set_long_description("Event time mode only: uncertainty of each charged particle.     \n"
+                                "It defaults to 'pairwise.charged_sigma_length' divided by      \n"
+                                "sqrt(2) so that the fit of two charged particles gives back    \n"
+                                "their pairwise chi2.                                           \n")
+          .add_example("Set the uncertainty::                                          \n"
+                       "                                                               \n"
+                       "  TOFD.event_time.charged_sigma_length : real as time = 0.1 ns \n"
+                       "                                                               \n"
+                       );
+      }
+
+      {
+        // Description of the 'event_time.gamma_sigma_length' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TOFD.event_time.gamma_sigma_length")
+          .set_terse_description("Time uncertainty on the track length of gammas")
+          .set_traits(datatools::TYPE_REAL)
+          .set_mandatory(false)
+          .set_explicit_unit(true)
+          .set_unit_label("time")
+          .set_unit_symbol("ns")
+          .set_long_description("Event time mode only: uncertainty of each gamma. It defaults   \n"
+                                "to sqrt(gamma_pair^2 - charged^2) where 'gamma_pair' is        \n"
+                                "'pairwise.gamma_sigma_length' and 'charged' is                 \n"
+                                "'event_time.charged_sigma_length', so that the fit of a        \n"
+                                "charged particle and a gamma gives back their pairwise chi2.   \n")
+          .add_example("Set the uncertainty::                                        \n"
+                       "                                                             \n"
+                       "  TOFD.event_time.gamma_sigma_length : real as time = 0.6 ns \n"
+                       "                                                             \n"
+                       );
+      }
+      return;
     }
 
   } // end of namespace reconstruction
@@ -41,6 +41,13 @@
 // - Bayeux/datatools:
 #include <bayeux/datatools/logger.h>
 
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/probability_array.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+#include <falaise/snemo/reconstruction/tof_batch.h>
+
 // Forward declaration
 namespace geomtools {
   class blur_spot;
@@ -51,6 +58,8 @@ namespace snemo {
   namespace datamodel {
     class particle_track;
     class tof_measurement;
+    class event_time_measurement;
+    class calorimeter_index;
   }
 
   namespace reconstruction {
@@ -64,11 +73,15 @@ namespace snemo {
       struct tof_tool {
 
         /// Gives the energy of particle
-        static double get_energy(const snemo::datamodel::particle_track & particle_);
+        static double get_energy(const snemo::datamodel::particle_track & particle_,
+                                 const datatools::logger::priority logging_ = datatools::logger::PRIO_WARNING);
 
         /// Gives the mass of the particle
         static double get_mass(const snemo::datamodel::particle_track & particle_);
 
+        /// Gives the mass of a particle type
+        static double get_mass(const snemo::datamodel::pid_utils::particle_type type_);
+
         /// Returns the beta
         static double beta(double energy_, double mass_);
 
@@ -77,17 +90,25 @@ namespace snemo {
 
         /// Gives the times for two charged particles (single deposit)
         static void get_time(const snemo::datamodel::particle_track & particle_,
-                             double & t_, double & sigma_t);
+                             double & t_, double & sigma_t,
+                             const datatools::logger::priority logging_ = datatools::logger::PRIO_WARNING);
 
         /// Gives the track length of an electron
-        static double get_charged_particle_track_length(const snemo::datamodel::particle_track & particle_);
+        static double get_charged_particle_track_length(const snemo::datamodel::particle_track & particle_,
+                                                        const datatools::logger::priority logging_ = datatools::logger::PRIO_WARNING);
 
         /// Gives the track length of a gamma from the electron vertex
         static double get_gamma_track_length(const snemo::datamodel::particle_track & gamma_,
                                              const snemo::datamodel::particle_track & electron_,
-                                             const bool external_hyp_ = false);
+                                             const bool external_hyp_ = false,
+                                             const datatools::logger::priority logging_ = datatools::logger::PRIO_WARNING);
+      };
 
-        static datatools::logger::priority logging; //!< Internal logging priority
+      /// TOF modes
+      enum mode_type {
+        MODE_PAIRWISE   = 1, //!< Internal/external probabilities of particle pairs
+        MODE_EVENT_TIME = 2, //!< Fit of a common time over all the particles of the event
+        MODE_ALL        = MODE_PAIRWISE | MODE_EVENT_TIME
       };
 
       /// Dedicated driver id
@@ -111,11 +132,57 @@ namespace snemo {
       /// Initialize the driver through configuration properties
       void initialize(const datatools::properties & setup_);
 
+      /// Set the TOF mode
+      void set_mode(const mode_type mode_);
+
+      /// Return the TOF mode
+      mode_type get_mode() const;
+
+      /// Check if the TOF of particle pairs is computed
+      bool is_pairwise_mode() const;
+
+      /// Check if the event time is fitted
+      bool is_event_time_mode() const;
+
+      /// Check if TOF computations are deferred to a batch
+      bool has_batch() const;
+
+      /// Defer TOF computations to a batch
+      void set_batch(tof_batch & batch_);
+
+      /// Compute TOF probabilities immediately
+      void reset_batch();
+
+      /// Check if calorimeter blocks are matched through their dense index
+      bool has_calorimeter_index() const;
+
+      /// Match calorimeter blocks through their dense index
+      void set_calorimeter_index(const snemo::datamodel::calorimeter_index & index_);
+
+      /// Match calorimeter blocks through their geom_id
+      void reset_calorimeter_index();
+
       /// Main process
       void process(const snemo::datamodel::particle_track & pt1_,
                    const snemo::datamodel::particle_track & pt2_,
                    snemo::datamodel::tof_measurement & tof_);
 
+      /// Main process with particle types already identified
+      void process(const snemo::datamodel::particle_track & pt1_,
+                   const snemo::datamodel::pid_utils::particle_type type1_,
+                   const snemo::datamodel::particle_track & pt2_,
+                   const snemo::datamodel::pid_utils::particle_type type2_,
+                   snemo::datamodel::tof_measurement & tof_);
+
+      /// Main process from the particle kinematics cached for the event
+      void process(const particle_kinematics & k1_,
+                   const particle_kinematics & k2_,
+                   snemo::datamodel::tof_measurement & tof_);
+
+      /// Fit the event time over all the particles of the event
+      void process(const kinematics_cache & kinematics_,
+                   snemo::datamodel::event_time_measurement & event_time_);
+
       /// Reset the driver
       void reset();
 
@@ -131,31 +198,43 @@ namespace snemo {
       void _set_defaults ();
 
       /// Main method to process particles and to retrieve internal/external TOF probabilities
-      void _process_algo(const snemo::datamodel::particle_track & pt1_,
-                         const snemo::datamodel::particle_track & pt2_,
-                         std::vector<double> & proba_int_, std::vector<double> & proba_ext_);
+      void _process_algo(const particle_kinematics & k1_,
+                         const particle_kinematics & k2_,
+                         snemo::datamodel::probability_array & proba_int_,
+                         snemo::datamodel::probability_array & proba_ext_);
 
       /// Special method to process charged particles
-      void _process_charged_particles(const snemo::datamodel::particle_track & pt1_,
-                                      const snemo::datamodel::particle_track & pt2_,
-                                      std::vector<double> & proba_int_, std::vector<double> & proba_ext_);
-
-      /// Special method to process gamma particles
-      void _process_charged_gamma_particles(const snemo::datamodel::particle_track & pt1_,
-                                            const snemo::datamodel::particle_track & pt2_,
-                                            std::vector<double> & proba_int_, std::vector<double> & proba_ext_);
+      void _process_charged_particles(const particle_kinematics & k1_,
+                                      const particle_kinematics & k2_,
+                                      snemo::datamodel::probability_array & proba_int_,
+                                      snemo::datamodel::probability_array & proba_ext_);
+
+      /// Special method to process gamma particles, calorimeter vertices being evaluated within a batch
+      void _process_charged_gamma_particles(const particle_kinematics & k1_,
+                                            const particle_kinematics & k2_,
+                                            tof_batch & batch_,
+                                            snemo::datamodel::probability_array & proba_int_,
+                                            snemo::datamodel::probability_array & proba_ext_);
     private:
 
       /// Special internal method to extract gamma information (track length,
-      /// time) given a charged particle track
-      void _get_vertex_to_calo_info_(const snemo::datamodel::particle_track & ptc_,
-                                     const snemo::datamodel::particle_track & ptg_,
-                                     const geomtools::blur_spot & vertex_,
+      /// time) given a charged particle and a gamma calorimeter vertex
+      void _get_vertex_to_calo_info_(const particle_kinematics & charged_,
+                                     const particle_kinematics::calorimeter_vertex_type & vertex_,
                                      double & track_length_, double & time_, double & sigma_time_);
 
     private:
       bool _initialized_;                             //!< Initialization status
       datatools::logger::priority _logging_priority_; //!< Logging priority
+      tof_batch * _batch_;                            //!< Batch of deferred computations
+      tof_batch _gamma_batch_;                        //!< Batch evaluating the calorimeter vertices of a gamma right away
+      const snemo::datamodel::calorimeter_index * _calorimeter_index_;  //!< Dense index of the calorimeter blocks
+      chi2_probability _chi2_probability_;            //!< Chi-square probability method
+      mode_type _mode_;                               //!< TOF mode
+      double _pair_charged_sigma_length_;             //!< Pairwise TOF: track length time uncertainty of a charged pair
+      double _pair_gamma_sigma_length_;               //!< Pairwise TOF: track length time uncertainty of a charged/gamma pair
+      double _charged_sigma_length_;                  //!< Event time fit: track length time uncertainty of charged particles
+      double _gamma_sigma_length_;                    //!< Event time fit: track length time uncertainty of gammas
     };
 
   }  // end of namespace reconstruction
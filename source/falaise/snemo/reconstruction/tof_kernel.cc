@@ -0,0 +1,272 @@
+/// \file falaise/snemo/reconstruction/tof_kernel.cc
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/tof_kernel.h>
+
+// Standard library:
+#include <cmath>
+
+// The vector kernels are compiled for their own instruction set whatever
+// the target of the build and selected at run time
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FALAISE_TOF_KERNEL_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+
+      /// Scalar theoretical time, same operations as tof_driver::tof_tool
+      inline double scalar_theoretical_time(const double E_, const double m_, const double tl_)
+      {
+        const double beta = std::sqrt(E_ * (E_ + 2.*m_)) / (E_ + m_);
+        return tl_ / (beta * CLHEP::c_light);
+      }
+
+      /// Scalar loop over the entries [first_, last_)
+      void scalar_chi2(const tof_kernel::particle_arrays & p1_,
+                       const tof_kernel::particle_arrays & p2_,
+                       const double * sl_, const size_t first_, const size_t last_,
+                       double * chi2_int_, double * chi2_ext_)
+      {
+        for (size_t i = first_; i < last_; ++i) {
+          const double t1_th = scalar_theoretical_time(p1_.energy[i], p1_.mass[i], p1_.track_length[i]);
+          const double t2_th = scalar_theoretical_time(p2_.energy[i], p2_.mass[i], p2_.track_length[i]);
+          const double sigma_exp = p1_.sigma_time[i] * p1_.sigma_time[i]
+            + p2_.sigma_time[i] * p2_.sigma_time[i] + sl_[i] * sl_[i];
+          const double dt = p1_.time[i] - p2_.time[i];
+          const double delta_int = dt - (t1_th - t2_th);
+          const double delta_ext = std::abs(dt) - (t1_th + t2_th);
+          chi2_int_[i] = delta_int * delta_int / sigma_exp;
+          chi2_ext_[i] = delta_ext * delta_ext / sigma_exp;
+        }
+        return;
+      }
+
+      /// Vector loops, returning the number of entries they processed
+      typedef size_t (*theoretical_times_function)(const double *, const double *, const double *,
+                                                   double *, const size_t);
+      typedef size_t (*chi2_function)(const tof_kernel::particle_arrays &,
+                                      const tof_kernel::particle_arrays &,
+                                      const double *, const size_t, double *, double *);
+
+      /// \brief Vector loops of an instruction set
+      struct kernel_implementation
+      {
+        const char * label;                           //!< Label of the instruction set
+        theoretical_times_function theoretical_times; //!< Theoretical time loop
+        chi2_function chi2;                           //!< Chi2 loop
+      };
+
+      size_t no_vector_theoretical_times(const double *, const double *, const double *,
+                                      double *, const size_t)
+      {
+        return 0;
+      }
+
+      size_t no_vector_chi2(const tof_kernel::particle_arrays &, const tof_kernel::particle_arrays &,
+                                const double *, const size_t, double *, double *)
+      {
+        return 0;
+      }
+
+#if defined(FALAISE_TOF_KERNEL_X86_DISPATCH)
+
+      const size_t AVX512_WIDTH = 8;
+
+      __attribute__((target("avx512f")))
+      inline __m512d avx512_theoretical_time(const __m512d E_, const __m512d m_, const __m512d tl_)
+      {
+        const __m512d two = _mm512_set1_pd(2.0);
+        const __m512d c = _mm512_set1_pd(CLHEP::c_light);
+        const __m512d p = _mm512_mul_pd(E_, _mm512_add_pd(E_, _mm512_mul_pd(two, m_)));
+        const __m512d beta = _mm512_div_pd(_mm512_sqrt_pd(p), _mm512_add_pd(E_, m_));
+        return _mm512_div_pd(tl_, _mm512_mul_pd(beta, c));
+      }
+
+      __attribute__((target("avx512f")))
+      size_t avx512_theoretical_times(const double * E_, const double * m_, const double * tl_,
+                                      double * t_, const size_t size_)
+      {
+        size_t i = 0;
+        for (; i + AVX512_WIDTH <= size_; i += AVX512_WIDTH) {
+          _mm512_storeu_pd(t_ + i, avx512_theoretical_time(_mm512_loadu_pd(E_ + i),
+                                                           _mm512_loadu_pd(m_ + i),
+                                                           _mm512_loadu_pd(tl_ + i)));
+        }
+        return i;
+      }
+
+      __attribute__((target("avx512f")))
+      size_t avx512_chi2(const tof_kernel::particle_arrays & p1_,
+                         const tof_kernel::particle_arrays & p2_,
+                         const double * sl_, const size_t size_,
+                         double * chi2_int_, double * chi2_ext_)
+      {
+        size_t i = 0;
+        for (; i + AVX512_WIDTH <= size_; i += AVX512_WIDTH) {
+          const __m512d t1_th = avx512_theoretical_time(_mm512_loadu_pd(p1_.energy + i),
+                                                        _mm512_loadu_pd(p1_.mass + i),
+                                                        _mm512_loadu_pd(p1_.track_length + i));
+          const __m512d t2_th = avx512_theoretical_time(_mm512_loadu_pd(p2_.energy + i),
+                                                        _mm512_loadu_pd(p2_.mass + i),
+                                                        _mm512_loadu_pd(p2_.track_length + i));
+          const __m512d st1 = _mm512_loadu_pd(p1_.sigma_time + i);
+          const __m512d st2 = _mm512_loadu_pd(p2_.sigma_time + i);
+          const __m512d sl = _mm512_loadu_pd(sl_ + i);
+          const __m512d sigma_exp = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(st1, st1),
+                                                                _mm512_mul_pd(st2, st2)),
+                                                  _mm512_mul_pd(sl, sl));
+          const __m512d dt = _mm512_sub_pd(_mm512_loadu_pd(p1_.time + i), _mm512_loadu_pd(p2_.time + i));
+          const __m512d delta_int = _mm512_sub_pd(dt, _mm512_sub_pd(t1_th, t2_th));
+          const __m512d delta_ext = _mm512_sub_pd(_mm512_abs_pd(dt), _mm512_add_pd(t1_th, t2_th));
+          _mm512_storeu_pd(chi2_int_ + i, _mm512_div_pd(_mm512_mul_pd(delta_int, delta_int), sigma_exp));
+          _mm512_storeu_pd(chi2_ext_ + i, _mm512_div_pd(_mm512_mul_pd(delta_ext, delta_ext), sigma_exp));
+        }
+        return i;
+      }
+
+      const size_t AVX2_WIDTH = 4;
+
+      __attribute__((target("avx2")))
+      inline __m256d avx2_theoretical_time(const __m256d E_, const __m256d m_, const __m256d tl_)
+      {
+        const __m256d two = _mm256_set1_pd(2.0);
+        const __m256d c = _mm256_set1_pd(CLHEP::c_light);
+        const __m256d p = _mm256_mul_pd(E_, _mm256_add_pd(E_, _mm256_mul_pd(two, m_)));
+        const __m256d beta = _mm256_div_pd(_mm256_sqrt_pd(p), _mm256_add_pd(E_, m_));
+        return _mm256_div_pd(tl_, _mm256_mul_pd(beta, c));
+      }
+
+      __attribute__((target("avx2")))
+      size_t avx2_theoretical_times(const double * E_, const double * m_, const double * tl_,
+                                    double * t_, const size_t size_)
+      {
+        size_t i = 0;
+        for (; i + AVX2_WIDTH <= size_; i += AVX2_WIDTH) {
+          _mm256_storeu_pd(t_ + i, avx2_theoretical_time(_mm256_loadu_pd(E_ + i),
+                                                           _mm256_loadu_pd(m_ + i),
+                                                           _mm256_loadu_pd(tl_ + i)));
+        }
+        return i;
+      }
+
+      __attribute__((target("avx2")))
+      size_t avx2_chi2(const tof_kernel::particle_arrays & p1_,
+                       const tof_kernel::particle_arrays & p2_,
+                       const double * sl_, const size_t size_,
+                       double * chi2_int_, double * chi2_ext_)
+      {
+        // Clearing the sign bit gives the absolute value
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        size_t i = 0;
+        for (; i + AVX2_WIDTH <= size_; i += AVX2_WIDTH) {
+          const __m256d t1_th = avx2_theoretical_time(_mm256_loadu_pd(p1_.energy + i),
+                                                        _mm256_loadu_pd(p1_.mass + i),
+                                                        _mm256_loadu_pd(p1_.track_length + i));
+          const __m256d t2_th = avx2_theoretical_time(_mm256_loadu_pd(p2_.energy + i),
+                                                        _mm256_loadu_pd(p2_.mass + i),
+                                                        _mm256_loadu_pd(p2_.track_length + i));
+          const __m256d st1 = _mm256_loadu_pd(p1_.sigma_time + i);
+          const __m256d st2 = _mm256_loadu_pd(p2_.sigma_time + i);
+          const __m256d sl = _mm256_loadu_pd(sl_ + i);
+          const __m256d sigma_exp = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(st1, st1),
+                                                                _mm256_mul_pd(st2, st2)),
+                                                  _mm256_mul_pd(sl, sl));
+          const __m256d dt = _mm256_sub_pd(_mm256_loadu_pd(p1_.time + i), _mm256_loadu_pd(p2_.time + i));
+          const __m256d delta_int = _mm256_sub_pd(dt, _mm256_sub_pd(t1_th, t2_th));
+          const __m256d delta_ext = _mm256_sub_pd(_mm256_andnot_pd(sign_mask, dt), _mm256_add_pd(t1_th, t2_th));
+          _mm256_storeu_pd(chi2_int_ + i, _mm256_div_pd(_mm256_mul_pd(delta_int, delta_int), sigma_exp));
+          _mm256_storeu_pd(chi2_ext_ + i, _mm256_div_pd(_mm256_mul_pd(delta_ext, delta_ext), sigma_exp));
+        }
+        return i;
+      }
+
+#endif
+
+      /// Select the vector loops supported by the processor
+      const kernel_implementation & select_implementation()
+      {
+        static const kernel_implementation scalar = {"scalar", no_vector_theoretical_times, no_vector_chi2};
+#if defined(FALAISE_TOF_KERNEL_X86_DISPATCH)
+        static const kernel_implementation avx512 = {"avx512", avx512_theoretical_times, avx512_chi2};
+        static const kernel_implementation avx2 = {"avx2", avx2_theoretical_times, avx2_chi2};
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return avx512;
+        if (__builtin_cpu_supports("avx2")) return avx2;
+#endif
+        return scalar;
+      }
+
+      /// Return the vector loops in use, selected once
+      const kernel_implementation & get_implementation()
+      {
+        static const kernel_implementation & _implementation = select_implementation();
+        return _implementation;
+      }
+
+    }
+
+    // static
+    const std::string & tof_kernel::get_instruction_set()
+    {
+      static const std::string _label(get_implementation().label);
+      return _label;
+    }
+
+    // static
+    void tof_kernel::compute_theoretical_times(const double * energy_, const double * mass_,
+                                               const double * track_length_,
+                                               double * time_, const size_t size_)
+    {
+      for (size_t i = get_implementation().theoretical_times(energy_, mass_, track_length_, time_, size_);
+           i < size_; ++i) {
+        time_[i] = scalar_theoretical_time(energy_[i], mass_[i], track_length_[i]);
+      }
+      return;
+    }
+
+    // static
+    void tof_kernel::compute_chi2(const particle_arrays & p1_, const particle_arrays & p2_,
+                                  const double * sigma_length_, const size_t size_,
+                                  double * chi2_int_, double * chi2_ext_)
+    {
+      const size_t done = get_implementation().chi2(p1_, p2_, sigma_length_, size_, chi2_int_, chi2_ext_);
+      scalar_chi2(p1_, p2_, sigma_length_, done, size_, chi2_int_, chi2_ext_);
+      return;
+    }
+
+    // static
+    void tof_kernel::compute(const particle_arrays & p1_, const particle_arrays & p2_,
+                             const double * sigma_length_, const size_t size_,
+                             const chi2_probability & method_,
+                             double * chi2_int_, double * chi2_ext_,
+                             double * proba_int_, double * proba_ext_)
+    {
+      compute_chi2(p1_, p2_, sigma_length_, size_, chi2_int_, chi2_ext_);
+      method_.survival(chi2_int_, proba_int_, size_, 1);
+      method_.survival(chi2_ext_, proba_ext_, size_, 1);
+      return;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,77 @@
+/// \file falaise/snemo/reconstruction/tof_kernel.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Array kernels for the Time-Of-Flight arithmetic
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_TOF_KERNEL_H
+#define FALAISE_SNEMO_RECONSTRUCTION_TOF_KERNEL_H 1
+
+// Standard library:
+#include <string>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    class chi2_probability;
+
+    /// \brief Array kernels for the Time-Of-Flight arithmetic
+    ///
+    /// The kernels evaluate the relativistic theoretical times and the
+    /// internal/external TOF chi2 of many particle pair hypotheses at once.
+    /// Inputs are structure-of-arrays: entry \c i of every array belongs to
+    /// the same hypothesis. On x86 processors, the instruction set is chosen
+    /// at run time, once: AVX-512 (8 doubles) if the processor supports it,
+    /// AVX2 (4 doubles) otherwise if available, a plain scalar loop in any
+    /// other case. Remaining entries are always processed by the scalar loop,
+    /// which gives the same results as the scalar helpers of the TOF driver.
+    class tof_kernel
+    {
+    public:
+
+      /// Kinematics of one particle of the pairs
+      struct particle_arrays
+      {
+        const double * energy;       //!< Kinetic energies
+        const double * mass;         //!< Masses
+        const double * track_length; //!< Track lengths
+        const double * time;         //!< Measured times
+        const double * sigma_time;   //!< Measured time uncertainties
+      };
+
+      /// Return the label of the instruction set in use ("avx512", "avx2" or "scalar")
+      static const std::string & get_instruction_set();
+
+      /// Compute the theoretical times L / (beta c)
+      static void compute_theoretical_times(const double * energy_, const double * mass_,
+                                            const double * track_length_,
+                                            double * time_, const size_t size_);
+
+      /// Compute the internal and external chi2 of the pairs
+      static void compute_chi2(const particle_arrays & p1_, const particle_arrays & p2_,
+                               const double * sigma_length_, const size_t size_,
+                               double * chi2_int_, double * chi2_ext_);
+
+      /// Compute the chi2 and the internal and external probabilities of the pairs
+      static void compute(const particle_arrays & p1_, const particle_arrays & p2_,
+                          const double * sigma_length_, const size_t size_,
+                          const chi2_probability & method_,
+                          double * chi2_int_, double * chi2_ext_,
+                          double * proba_int_, double * proba_ext_);
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_TOF_KERNEL_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -24,18 +24,16 @@ namespace snemo {
 
     snemo::datamodel::base_topology_pattern::handle_type topology_1eNg_builder::_create_pattern()
     {
-      snemo::datamodel::base_topology_pattern::handle_type h(new snemo::datamodel::topology_1eNg_pattern);
-      return h;
+      return _make_pattern<snemo::datamodel::topology_1eNg_pattern>();
     }
 
     void topology_1eNg_builder::_build_measurement_dictionary(snemo::datamodel::base_topology_pattern & pattern_)
     {
       snemo::reconstruction::topology_1e_builder::_build_measurement_dictionary(pattern_);
 
-      const std::string e1_label = "e1";
+      const snemo::datamodel::particle_slot e1_label(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 1);
       DT_THROW_IF(! pattern_.has_particle_track(e1_label), std::logic_error,
                   "No particle with label '" << e1_label << "' has been stored !");
-      const snemo::datamodel::particle_track & e1 = pattern_.get_particle_track(e1_label);
 
       // const snemo::datamodel::particle_track_data::particle_collection_type & the_particles
       //   = ptd_.get_particles();
@@ -44,42 +42,79 @@ namespace snemo {
 
       dynamic_cast<snemo::datamodel::topology_1eNg_pattern &>(pattern_).set_number_of_gammas(ngammas);
 
+      snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
+        = pattern_.grab_measurement_dictionary();
+      const snemo::reconstruction::measurement_drivers * drivers
+        = &base_topology_builder::get_measurement_drivers();
+      const kinematics_handle_type kin = _get_kinematics();
+      const size_t ie1 = kin->get_index(e1_label);
+
+      // Per-gamma measurements are attached to the pattern first, in gamma
+      // order, and then computed gamma after gamma (concurrently for high
+      // gamma multiplicities) unless they are computed at first access
+      std::vector<gamma_task_type> gamma_tasks;
+      gamma_tasks.reserve(ngammas);
       for (int i_gamma = 1; i_gamma <= ngammas;++i_gamma) {
-        std::ostringstream oss;
-        oss << "g" << i_gamma;
-
-        const std::string g_label = oss.str();
+        const snemo::datamodel::particle_slot g_label(snemo::datamodel::pid_utils::PARTICLE_GAMMA, i_gamma);
         DT_THROW_IF(! pattern_.has_particle_track(g_label), std::logic_error,
                     "No particle with label '" << g_label << "' has been stored !");
-        const snemo::datamodel::particle_track & gamma = pattern_.get_particle_track(g_label);
-        snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
-          = pattern_.grab_measurement_dictionary();
-        const snemo::reconstruction::measurement_drivers & drivers
-          = base_topology_builder::get_measurement_drivers();
-        {
-          snemo::datamodel::tof_measurement * ptr_tof = new snemo::datamodel::tof_measurement;
-          meas["tof_e1_" + g_label].reset(ptr_tof);
-          if (drivers.TOFD) drivers.TOFD->process(e1, gamma, *ptr_tof);
-        }
+        const size_t igamma = kin->get_index(g_label);
 
+        // Electron vertex measurement, rebuilt for every gamma
         {
-          snemo::datamodel::vertex_measurement * ptr_vertex_measurement = new snemo::datamodel::vertex_measurement;
-          meas["vertex_e1"].reset(ptr_vertex_measurement);
-          if (drivers.VD) drivers.VD->process(e1, *ptr_vertex_measurement);
+          const snemo::datamodel::measurement_key vertex_e1_label(snemo::datamodel::measurement_key::KIND_VERTEX, e1_label);
+          if (is_measurement_required(vertex_e1_label)) {
+            snemo::datamodel::vertex_measurement * a_vertex
+              = &_create_measurement<snemo::datamodel::vertex_measurement>(meas[vertex_e1_label]);
+            _compute_measurement(pattern_, vertex_e1_label, [drivers, kin, ie1, a_vertex]() {
+                if (drivers->VD) drivers->VD->process(kin->get(ie1), *a_vertex);
+              });
+          }
         }
 
-        {
-          snemo::datamodel::angle_measurement * ptr_angle = new snemo::datamodel::angle_measurement;
-          meas["angle_e1_" + g_label].reset(ptr_angle);
-          if (drivers.AMD) drivers.AMD->process(e1, gamma, *ptr_angle);
+        const snemo::datamodel::measurement_key tof_e1_label(snemo::datamodel::measurement_key::KIND_TOF, e1_label, g_label);
+        const snemo::datamodel::measurement_key angle_e1_label(snemo::datamodel::measurement_key::KIND_ANGLE, e1_label, g_label);
+        const snemo::datamodel::measurement_key energy_label(snemo::datamodel::measurement_key::KIND_ENERGY, g_label);
+        snemo::datamodel::tof_measurement * tof_e1_g = 0;
+        if (is_measurement_required(tof_e1_label)) {
+          tof_e1_g = &_create_measurement<snemo::datamodel::tof_measurement>(meas[tof_e1_label]);
+        }
+        snemo::datamodel::angle_measurement * angle_e1_g = 0;
+        if (is_measurement_required(angle_e1_label)) {
+          angle_e1_g = &_create_measurement<snemo::datamodel::angle_measurement>(meas[angle_e1_label]);
+        }
+        snemo::datamodel::energy_measurement * energy_g = 0;
+        if (is_measurement_required(energy_label)) {
+          energy_g = &_create_measurement<snemo::datamodel::energy_measurement>(meas[energy_label]);
         }
 
-        {
-          snemo::datamodel::energy_measurement * ptr_energy = new snemo::datamodel::energy_measurement;
-          meas["energy_" + g_label].reset(ptr_energy);
-          if (drivers.EMD) drivers.EMD->process(gamma, *ptr_energy);
+        if (is_lazy_measurements()) {
+          if (tof_e1_g) {
+            _compute_measurement(pattern_, tof_e1_label, [drivers, kin, ie1, igamma, tof_e1_g]() {
+                if (drivers->TOFD) drivers->TOFD->process(kin->get(ie1), kin->get(igamma), *tof_e1_g);
+              });
+          }
+          if (angle_e1_g) {
+            _compute_measurement(pattern_, angle_e1_label, [drivers, kin, ie1, igamma, angle_e1_g]() {
+                if (drivers->AMD) drivers->AMD->process(kin->get(ie1), kin->get(igamma), *angle_e1_g);
+              });
+          }
+          if (energy_g) {
+            _compute_measurement(pattern_, energy_label, [drivers, kin, igamma, energy_g]() {
+                if (drivers->EMD) drivers->EMD->process(kin->get(igamma), *energy_g);
+              });
+          }
+          continue;
         }
+
+        gamma_tasks.push_back([kin, ie1, igamma, tof_e1_g, angle_e1_g, energy_g]
+                              (const measurement_drivers & drivers_) {
+            if (drivers_.TOFD && tof_e1_g) drivers_.TOFD->process(kin->get(ie1), kin->get(igamma), *tof_e1_g);
+            if (drivers_.AMD && angle_e1_g) drivers_.AMD->process(kin->get(ie1), kin->get(igamma), *angle_e1_g);
+            if (drivers_.EMD && energy_g) drivers_.EMD->process(kin->get(igamma), *energy_g);
+          });
       }
+      _run_gamma_tasks(gamma_tasks);
       return;
     }
 
@@ -21,38 +21,53 @@ namespace snemo {
 
     snemo::datamodel::base_topology_pattern::handle_type topology_1e_builder::_create_pattern()
     {
-      snemo::datamodel::base_topology_pattern::handle_type h(new snemo::datamodel::topology_1e_pattern);
-      return h;
+      return _make_pattern<snemo::datamodel::topology_1e_pattern>();
     }
 
     void topology_1e_builder::_build_measurement_dictionary(snemo::datamodel::base_topology_pattern & pattern_)
     {
-      const std::string e1_label = "e1";
+      const snemo::datamodel::particle_slot e1_label(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 1);
       DT_THROW_IF(! pattern_.has_particle_track(e1_label), std::logic_error,
                   "No particle with label '" << e1_label << "' has been stored !");
-      const snemo::datamodel::particle_track & e1 = pattern_.get_particle_track(e1_label);
 
       snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
         = pattern_.grab_measurement_dictionary();
-      const snemo::reconstruction::measurement_drivers & drivers
-        = base_topology_builder::get_measurement_drivers();
+      const snemo::reconstruction::measurement_drivers * drivers
+        = &base_topology_builder::get_measurement_drivers();
+      const kinematics_handle_type kin = _get_kinematics();
+      const size_t ie1 = kin->get_index(e1_label);
 
       {
-        snemo::datamodel::vertex_measurement * ptr_vertex_measurement = new snemo::datamodel::vertex_measurement;
-        meas["vertex_e1"].reset(ptr_vertex_measurement);
-        if (drivers.VD) drivers.VD->process(e1, *ptr_vertex_measurement);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_VERTEX, e1_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::vertex_measurement * a_vertex
+            = &_create_measurement<snemo::datamodel::vertex_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ie1, a_vertex]() {
+              if (drivers->VD) drivers->VD->process(kin->get(ie1), *a_vertex);
+            });
+        }
       }
 
       {
-        snemo::datamodel::angle_measurement * ptr_angle = new snemo::datamodel::angle_measurement;
-        meas["angle_" + e1_label].reset(ptr_angle);
-        if (drivers.AMD) drivers.AMD->process(e1, *ptr_angle);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_ANGLE, e1_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::angle_measurement * an_angle
+            = &_create_measurement<snemo::datamodel::angle_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ie1, an_angle]() {
+              if (drivers->AMD) drivers->AMD->process(kin->get(ie1), *an_angle);
+            });
+        }
       }
 
       {
-        snemo::datamodel::energy_measurement * ptr_energy = new snemo::datamodel::energy_measurement;
-        meas["energy_" + e1_label].reset(ptr_energy);
-        if (drivers.EMD) drivers.EMD->process(e1, *ptr_energy);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_ENERGY, e1_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::energy_measurement * an_energy
+            = &_create_measurement<snemo::datamodel::energy_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ie1, an_energy]() {
+              if (drivers->EMD) drivers->EMD->process(kin->get(ie1), *an_energy);
+            });
+        }
       }
 
       return;
@@ -24,54 +24,79 @@ namespace snemo {
 
     snemo::datamodel::base_topology_pattern::handle_type topology_2p_builder::_create_pattern()
     {
-      snemo::datamodel::base_topology_pattern::handle_type h(new snemo::datamodel::topology_2p_pattern);
-      return h;
+      return _make_pattern<snemo::datamodel::topology_2p_pattern>();
     }
 
     void topology_2p_builder::_build_measurement_dictionary(snemo::datamodel::base_topology_pattern & pattern_)
     {
-      const std::string p1_label = "p1";
+      const snemo::datamodel::particle_slot p1_label(snemo::datamodel::pid_utils::PARTICLE_POSITRON, 1);
       DT_THROW_IF(! pattern_.has_particle_track(p1_label), std::logic_error,
                   "No particle with label '" << p1_label << "' has been stored !");
-      const snemo::datamodel::particle_track & p1 = pattern_.get_particle_track(p1_label);
 
-      const std::string p2_label = "p2";
+      const snemo::datamodel::particle_slot p2_label(snemo::datamodel::pid_utils::PARTICLE_POSITRON, 2);
       DT_THROW_IF(! pattern_.has_particle_track(p2_label), std::logic_error,
                   "No particle with label '" << p2_label << "' has been stored !");
-      const snemo::datamodel::particle_track & p2 = pattern_.get_particle_track(p2_label);
 
       snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
         = pattern_.grab_measurement_dictionary();
-      const snemo::reconstruction::measurement_drivers & drivers
-        = base_topology_builder::get_measurement_drivers();
+      const snemo::reconstruction::measurement_drivers * drivers
+        = &base_topology_builder::get_measurement_drivers();
+      const kinematics_handle_type kin = _get_kinematics();
+      const size_t ip1 = kin->get_index(p1_label);
+      const size_t ip2 = kin->get_index(p2_label);
       {
-        snemo::datamodel::tof_measurement * ptr_tof = new snemo::datamodel::tof_measurement;
-        meas["tof_" + p1_label + "_" + p2_label].reset(ptr_tof);
-        if (drivers.TOFD) drivers.TOFD->process(p1, p2, *ptr_tof);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_TOF, p1_label, p2_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::tof_measurement * a_tof
+            = &_create_measurement<snemo::datamodel::tof_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ip1, ip2, a_tof]() {
+              if (drivers->TOFD) drivers->TOFD->process(kin->get(ip1), kin->get(ip2), *a_tof);
+            });
+        }
       }
 
       {
-        snemo::datamodel::vertex_measurement * ptr_vertex_measurement = new snemo::datamodel::vertex_measurement;
-        meas["vertex_" + p1_label + "_" + p2_label].reset(ptr_vertex_measurement);
-        if (drivers.VD) drivers.VD->process(p1, p2, *ptr_vertex_measurement);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_VERTEX, p1_label, p2_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::vertex_measurement * a_vertex
+            = &_create_measurement<snemo::datamodel::vertex_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ip1, ip2, a_vertex]() {
+              if (drivers->VD) drivers->VD->process(kin->get(ip1), kin->get(ip2), *a_vertex);
+            });
+        }
       }
 
       {
-        snemo::datamodel::angle_measurement * ptr_angle = new snemo::datamodel::angle_measurement;
-        meas["angle_" + p1_label + "_" + p2_label].reset(ptr_angle);
-        if (drivers.AMD) drivers.AMD->process(p1, p2, *ptr_angle);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_ANGLE, p1_label, p2_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::angle_measurement * an_angle
+            = &_create_measurement<snemo::datamodel::angle_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ip1, ip2, an_angle]() {
+              if (drivers->AMD) drivers->AMD->process(kin->get(ip1), kin->get(ip2), *an_angle);
+            });
+        }
       }
 
       {
-        snemo::datamodel::energy_measurement * ptr_energy = new snemo::datamodel::energy_measurement;
-        meas["energy_" + p1_label].reset(ptr_energy);
-        if (drivers.EMD) drivers.EMD->process(p1, *ptr_energy);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_ENERGY, p1_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::energy_measurement * an_energy
+            = &_create_measurement<snemo::datamodel::energy_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ip1, an_energy]() {
+              if (drivers->EMD) drivers->EMD->process(kin->get(ip1), *an_energy);
+            });
+        }
       }
 
       {
-        snemo::datamodel::energy_measurement * ptr_energy = new snemo::datamodel::energy_measurement;
-        meas["energy_" + p2_label].reset(ptr_energy);
-        if (drivers.EMD) drivers.EMD->process(p2, *ptr_energy);
+        const snemo::datamodel::measurement_key a_label(snemo::datamodel::measurement_key::KIND_ENERGY, p2_label);
+        if (is_measurement_required(a_label)) {
+          snemo::datamodel::energy_measurement * an_energy
+            = &_create_measurement<snemo::datamodel::energy_measurement>(meas[a_label]);
+          _compute_measurement(pattern_, a_label, [drivers, kin, ip2, an_energy]() {
+              if (drivers->EMD) drivers->EMD->process(kin->get(ip2), *an_energy);
+            });
+        }
       }
 
       return;
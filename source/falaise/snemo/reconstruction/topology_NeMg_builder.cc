@@ -0,0 +1,142 @@
+/** \file falaise/snemo/datamodels/topology_NeMg_builder.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/topology_NeMg_builder.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+#include <falaise/snemo/reconstruction/vertex_driver.h>
+#include <falaise/snemo/reconstruction/angle_driver.h>
+#include <falaise/snemo/reconstruction/energy_driver.h>
+#include <falaise/snemo/datamodels/topology_NeMg_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    // Registration instantiation macro :
+    FL_SNEMO_RECONSTRUCTION_TOPOLOGY_BUILDER_REGISTRATION_IMPLEMENT(topology_NeMg_builder,
+                                                                    "snemo::reconstruction::topology_NeMg_builder")
+
+    snemo::datamodel::base_topology_pattern::handle_type topology_NeMg_builder::_create_pattern()
+    {
+      return _make_pattern<snemo::datamodel::topology_NeMg_pattern>();
+    }
+
+    void topology_NeMg_builder::_build_measurement_dictionary(snemo::datamodel::base_topology_pattern & pattern_)
+    {
+      typedef snemo::datamodel::pid_utils pu;
+      typedef snemo::datamodel::measurement_key mk;
+
+      // Particles are stored with consecutive ranks within their type
+      std::vector<snemo::datamodel::particle_slot> electrons;
+      std::vector<snemo::datamodel::particle_slot> gammas;
+      const snemo::datamodel::base_topology_pattern::particle_track_dict_type & the_tracks
+        = pattern_.get_particle_track_dictionary();
+      for (snemo::datamodel::base_topology_pattern::particle_track_dict_type::const_iterator
+             it = the_tracks.begin(); it != the_tracks.end(); ++it) {
+        const snemo::datamodel::particle_slot & a_slot = it->first;
+        if (a_slot.get_type() == pu::PARTICLE_ELECTRON) electrons.push_back(a_slot);
+        else if (a_slot.get_type() == pu::PARTICLE_GAMMA) gammas.push_back(a_slot);
+      }
+      DT_THROW_IF(electrons.size() < 2, std::logic_error,
+                  "At least two electrons are expected !");
+
+      snemo::datamodel::topology_NeMg_pattern & a_pattern
+        = dynamic_cast<snemo::datamodel::topology_NeMg_pattern &>(pattern_);
+      a_pattern.set_number_of_electrons(electrons.size());
+      a_pattern.set_number_of_gammas(gammas.size());
+
+      snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
+        = pattern_.grab_measurement_dictionary();
+      const snemo::reconstruction::measurement_drivers * drivers
+        = &base_topology_builder::get_measurement_drivers();
+      const kinematics_handle_type kin = _get_kinematics();
+
+      // Vertex compatibility of all the electrons, computed in one pass by
+      // the first vertex measurement actually computed
+      bool vertices_required = false;
+      for (size_t i = 0; i < electrons.size() && ! vertices_required; ++i) {
+        for (size_t j = i + 1; j < electrons.size() && ! vertices_required; ++j) {
+          vertices_required = is_measurement_required(mk(mk::KIND_VERTEX, electrons[i], electrons[j]));
+        }
+      }
+      std::shared_ptr<vertex_matrix> vertices;
+      if (vertices_required && drivers->VD) {
+        // Reuse the matrix unless measurements of previous events still refer to it
+        if (! _vertices_ || _vertices_.use_count() != 1) {
+          _vertices_ = std::make_shared<vertex_matrix>();
+        }
+        _vertices_->clear();
+        vertices = _vertices_;
+      }
+
+      // Single particle measurements
+      std::vector<snemo::datamodel::particle_slot> particles(electrons);
+      particles.insert(particles.end(), gammas.begin(), gammas.end());
+      for (size_t i = 0; i < particles.size(); ++i) {
+        const mk a_label(mk::KIND_ENERGY, particles[i]);
+        if (! is_measurement_required(a_label)) continue;
+        snemo::datamodel::energy_measurement * an_energy
+          = &_create_measurement<snemo::datamodel::energy_measurement>(meas[a_label]);
+        const size_t ip = kin->get_index(particles[i]);
+        _compute_measurement(pattern_, a_label, [drivers, kin, ip, an_energy]() {
+            if (drivers->EMD) drivers->EMD->process(kin->get(ip), *an_energy);
+          });
+      }
+
+      // Electron-electron and electron-gamma measurements
+      for (size_t i = 0; i < electrons.size(); ++i) {
+        const size_t ie = kin->get_index(electrons[i]);
+        for (size_t j = i + 1; j < particles.size(); ++j) {
+          const size_t ip = kin->get_index(particles[j]);
+          const bool is_electron_pair = (j < electrons.size());
+
+          const mk tof_label(mk::KIND_TOF, electrons[i], particles[j]);
+          if (is_measurement_required(tof_label)) {
+            snemo::datamodel::tof_measurement * a_tof
+              = &_create_measurement<snemo::datamodel::tof_measurement>(meas[tof_label]);
+            _compute_measurement(pattern_, tof_label, [drivers, kin, ie, ip, a_tof]() {
+                if (drivers->TOFD) drivers->TOFD->process(kin->get(ie), kin->get(ip), *a_tof);
+              });
+          }
+
+          const mk angle_label(mk::KIND_ANGLE, electrons[i], particles[j]);
+          if (is_measurement_required(angle_label)) {
+            snemo::datamodel::angle_measurement * an_angle
+              = &_create_measurement<snemo::datamodel::angle_measurement>(meas[angle_label]);
+            _compute_measurement(pattern_, angle_label, [drivers, kin, ie, ip, an_angle]() {
+                if (drivers->AMD) drivers->AMD->process(kin->get(ie), kin->get(ip), *an_angle);
+              });
+          }
+
+          if (! is_electron_pair) continue;
+          const mk vertex_label(mk::KIND_VERTEX, electrons[i], particles[j]);
+          if (is_measurement_required(vertex_label)) {
+            snemo::datamodel::vertex_measurement * a_vertex
+              = &_create_measurement<snemo::datamodel::vertex_measurement>(meas[vertex_label]);
+            _compute_measurement(pattern_, vertex_label, [drivers, kin, vertices, ie, ip, a_vertex]() {
+                if (! drivers->VD || ! vertices) return;
+                if (! vertices->is_built()) drivers->VD->process(kin->get_view(), *vertices);
+                drivers->VD->process(*vertices, kin->get(ie), kin->get(ip), *a_vertex);
+              });
+          }
+        }
+      }
+      return;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
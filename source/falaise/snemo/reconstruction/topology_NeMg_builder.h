@@ -0,0 +1,54 @@
+/// \file falaise/snemo/datamodels/topology_NeMg_builder.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: The class to build 'NeMg' topology pattern
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_NEMG_BUILDER_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_NEMG_BUILDER_H 1
+
+// Standard library:
+#include <memory>
+
+// This project:
+#include <falaise/snemo/reconstruction/base_topology_builder.h>
+#include <falaise/snemo/reconstruction/vertex_matrix.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief The class to build 'NeMg' topology pattern
+    ///
+    /// Events with more than two electrons and any number of gammas. The
+    /// common vertices of the electron pairs are taken from the vertex
+    /// compatibility matrix, computed once per event.
+    class topology_NeMg_builder : public base_topology_builder
+    {
+    protected:
+
+      ///
+      virtual snemo::datamodel::base_topology_pattern::handle_type _create_pattern();
+
+      virtual void _build_measurement_dictionary(snemo::datamodel::base_topology_pattern & pattern_);
+
+    private:
+
+      std::shared_ptr<vertex_matrix> _vertices_; //!< Vertex compatibility of the event being built
+
+      /// Macro to automate the registration of the cut
+      FL_SNEMO_RECONSTRUCTION_TOPOLOGY_BUILDER_REGISTRATION_INTERFACE(topology_NeMg_builder)
+    };
+  }
+}
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_NEMG_BUILDER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -3,15 +3,15 @@
 // Ourselves:
 #include <snemo/reconstruction/topology_driver.h>
 
-// Standard library
-#include <regex>
-
 // Third party:
+// - Bayeux/datatools:
+#include <datatools/object_configuration_description.h>
 // - Bayeux/cuts:
 #include <bayeux/cuts/cut_manager.h>
 
 // This project:
 #include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/pid_data.h>
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/datamodels/topology_data.h>
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
@@ -27,6 +27,8 @@ namespace snemo {
 
   namespace reconstruction {
 
+    const size_t topology_driver::DISPATCH_COUNT_MAX;
+
     const std::string & topology_driver::get_id()
     {
       static const std::string _id("TD");
@@ -94,41 +96,89 @@ namespace snemo {
         driver_names.push_back(snemo::reconstruction::angle_driver::get_id());
         driver_names.push_back(snemo::reconstruction::energy_driver::get_id());
       }
+      _initialize_drivers_(setup_, driver_names, _drivers_);
+
+      // Intra-event parallelism :
+      if (setup_.has_key("parallel_gammas.threshold")) {
+        const int threshold = setup_.fetch_integer("parallel_gammas.threshold");
+        DT_THROW_IF(threshold < 0, std::domain_error,
+                    "Invalid number of gammas for parallel measurements (" << threshold << ") !");
+        _parallel_gammas_threshold_ = threshold;
+      }
+      if (_parallel_gammas_threshold_ > 0) {
+        size_t nlanes = 2;
+        if (setup_.has_key("parallel_gammas.lanes")) {
+          const int n = setup_.fetch_integer("parallel_gammas.lanes");
+          DT_THROW_IF(n < 1, std::domain_error,
+                      "Invalid number of lanes for parallel measurements (" << n << ") !");
+          nlanes = n;
+        }
+        // Drivers are not reentrant: every additional lane owns its drivers
+        for (size_t ilane = 1; ilane < nlanes; ++ilane) {
+          boost::shared_ptr<measurement_drivers> a_lane(new measurement_drivers);
+          _initialize_drivers_(setup_, driver_names, *a_lane);
+          _gamma_lanes_.push_back(a_lane);
+        }
+      }
+
+      // Measurements computed at first access :
+      if (setup_.has_key("lazy_measurements")) {
+        _lazy_measurements_ = setup_.fetch_boolean("lazy_measurements");
+      }
+
+      // TOF hypotheses of an event computed at once :
+      if (setup_.has_key("batch_tof")) {
+        _batch_tof_ = setup_.fetch_boolean("batch_tof");
+      }
+      DT_THROW_IF(_batch_tof_ && _lazy_measurements_, std::logic_error,
+                  "Batched TOF computations can not be combined with lazy measurements !");
+
+      // Topology builders :
+      _install_builders_();
+      _build_dispatch_table_();
+
+      set_initialized(true);
+      return;
+    }
+
+    // static
+    void topology_driver::_initialize_drivers_(const datatools::properties & setup_,
+                                               const std::vector<std::string> & driver_names_,
+                                               measurement_drivers & drivers_)
+    {
       for (std::vector<std::string>::const_iterator
-             idriver = driver_names.begin();
-           idriver != driver_names.end(); ++idriver) {
+             idriver = driver_names_.begin();
+           idriver != driver_names_.end(); ++idriver) {
         const std::string & a_driver_name = *idriver;
 
         if (a_driver_name == snemo::reconstruction::tof_driver::get_id()) {
           // Initialize TOF Driver
-          _drivers_.TOFD.reset(new snemo::reconstruction::tof_driver);
+          drivers_.TOFD.reset(new snemo::reconstruction::tof_driver);
           datatools::properties TOFD_config;
           setup_.export_and_rename_starting_with(TOFD_config, std::string(a_driver_name + "."), "");
-          _drivers_.TOFD->initialize(TOFD_config);
+          drivers_.TOFD->initialize(TOFD_config);
         } else if (a_driver_name == snemo::reconstruction::vertex_driver::get_id()) {
           // Initialize Vertex Driver
-          _drivers_.VD.reset(new snemo::reconstruction::vertex_driver);
+          drivers_.VD.reset(new snemo::reconstruction::vertex_driver);
           datatools::properties VD_config;
           setup_.export_and_rename_starting_with(VD_config, std::string(a_driver_name + "."), "");
-          _drivers_.VD->initialize(VD_config);
+          drivers_.VD->initialize(VD_config);
         } else if (a_driver_name == snemo::reconstruction::angle_driver::get_id()) {
           // Initialize Angle Driver
-          _drivers_.AMD.reset(new snemo::reconstruction::angle_driver);
+          drivers_.AMD.reset(new snemo::reconstruction::angle_driver);
           datatools::properties AMD_config;
           setup_.export_and_rename_starting_with(AMD_config, std::string(a_driver_name + "."), "");
-          _drivers_.AMD->initialize(AMD_config);
+          drivers_.AMD->initialize(AMD_config);
         } else if (a_driver_name == snemo::reconstruction::energy_driver::get_id()) {
           // Initialize Energy Driver
-          _drivers_.EMD.reset(new snemo::reconstruction::energy_driver);
+          drivers_.EMD.reset(new snemo::reconstruction::energy_driver);
           datatools::properties EMD_config;
           setup_.export_and_rename_starting_with(EMD_config, std::string(a_driver_name + "."), "");
-          _drivers_.EMD->initialize(EMD_config);
+          drivers_.EMD->initialize(EMD_config);
         } else {
           DT_THROW_IF(true, std::logic_error, "Driver '" << a_driver_name << "' does not exist !");
         }
       }
-
-      set_initialized(true);
       return;
     }
 
@@ -140,13 +190,83 @@ namespace snemo {
       return;
     }
 
+    void topology_driver::set_required_measurements(const std::string & topology_label_,
+                                                    const std::set<std::string> & labels_)
+    {
+      snemo::datamodel::pid_utils::classification_code_type a_code = 0;
+      DT_THROW_IF(! snemo::datamodel::pid_utils::parse_classification_label(topology_label_, a_code),
+                  std::logic_error, "Invalid topology label '" << topology_label_ << "' !");
+      _required_measurements_[topology_label_] = labels_;
+      std::set<snemo::datamodel::measurement_key> & keys = _required_keys_[a_code];
+      keys.clear();
+      for (std::set<std::string>::const_iterator il = labels_.begin(); il != labels_.end(); ++il) {
+        keys.insert(snemo::datamodel::measurement_key(*il));
+      }
+      return;
+    }
+
+    void topology_driver::reset_required_measurements()
+    {
+      _required_measurements_.clear();
+      _required_keys_.clear();
+      return;
+    }
+
+    void topology_driver::set_calorimeter_index(const snemo::datamodel::calorimeter_index & index_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver is not initialized !");
+      if (_drivers_.TOFD) _drivers_.TOFD->set_calorimeter_index(index_);
+      for (size_t ilane = 0; ilane < _gamma_lanes_.size(); ++ilane) {
+        if (_gamma_lanes_[ilane]->TOFD) _gamma_lanes_[ilane]->TOFD->set_calorimeter_index(index_);
+      }
+      for (builder_dict_type::iterator ib = _builders_.begin(); ib != _builders_.end(); ++ib) {
+        ib->second->set_calorimeter_index(&index_);
+      }
+      return;
+    }
+
+    bool topology_driver::has_required_measurements() const
+    {
+      return ! _required_measurements_.empty();
+    }
+
+    bool topology_driver::has_required_measurements(const std::string & topology_label_) const
+    {
+      return _required_measurements_.count(topology_label_) != 0;
+    }
+
+    const std::set<std::string> & topology_driver::get_required_measurements(const std::string & topology_label_) const
+    {
+      required_labels_dict_type::const_iterator found = _required_measurements_.find(topology_label_);
+      DT_THROW_IF(found == _required_measurements_.end(), std::logic_error,
+                  "Measurements of topology '" << topology_label_ << "' are not restricted !");
+      return found->second;
+    }
+
     int topology_driver::process(const snemo::datamodel::particle_track_data & ptd_,
                                  snemo::datamodel::topology_data & td_)
+    {
+      snemo::datamodel::pid_data a_pid;
+      snemo::datamodel::pid_utils::fetch_pid_data(ptd_, a_pid);
+      return process(ptd_, a_pid, td_);
+    }
+
+    int topology_driver::process(const snemo::datamodel::particle_track_data & ptd_,
+                                 const snemo::datamodel::pid_data & pid_,
+                                 snemo::datamodel::topology_data & td_)
     {
       int status = 0;
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+
+      if (_batch_tof_) {
+        // Every TOF hypothesis built for the event goes through one kernel pass
+        const std::vector<const snemo::datamodel::particle_track_data *> ptds(1, &ptd_);
+        const std::vector<const snemo::datamodel::pid_data *> pids(1, &pid_);
+        const std::vector<snemo::datamodel::topology_data *> tds(1, &td_);
+        return process_batch(ptds, pids, tds);
+      }
 
-      status = _process_algo(ptd_, td_);
+      status = _process_algo(ptd_, pid_, td_);
       if (status != 0) {
         DT_LOG_ERROR(get_logging_priority(),
                      "Computing topology quantities with '" << get_id() << "' algorithm has failed !");
@@ -156,9 +276,89 @@ namespace snemo {
       return status;
     }
 
+    int topology_driver::process_batch(const std::vector<const snemo::datamodel::particle_track_data *> & ptds_,
+                                       const std::vector<snemo::datamodel::topology_data *> & tds_)
+    {
+      std::vector<snemo::datamodel::pid_data> the_pids(ptds_.size());
+      std::vector<const snemo::datamodel::pid_data *> pids;
+      pids.reserve(ptds_.size());
+      for (size_t i = 0; i < ptds_.size(); ++i) {
+        snemo::datamodel::pid_utils::fetch_pid_data(*ptds_[i], the_pids[i]);
+        pids.push_back(&the_pids[i]);
+      }
+      return process_batch(ptds_, pids, tds_);
+    }
+
+    int topology_driver::process_batch(const std::vector<const snemo::datamodel::particle_track_data *> & ptds_,
+                                       const std::vector<const snemo::datamodel::pid_data *> & pids_,
+                                       const std::vector<snemo::datamodel::topology_data *> & tds_)
+    {
+      int status = 0;
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      DT_THROW_IF(ptds_.size() != tds_.size() || ptds_.size() != pids_.size(), std::logic_error,
+                  "Number of particle track data (" << ptds_.size() << "), PID data ("
+                  << pids_.size() << ") and topology data (" << tds_.size() << ") mismatch !");
+
+      if (_lazy_measurements_) {
+        // Pending TOF measurements are only computed at first access, long
+        // after the batch would have been flushed: events are processed one
+        // after the other
+        for (size_t i = 0; i < ptds_.size(); ++i) {
+          status = _process_algo(*ptds_[i], *pids_[i], *tds_[i]);
+          if (status != 0) {
+            DT_LOG_ERROR(get_logging_priority(),
+                         "Computing topology quantities with '" << get_id() << "' algorithm has failed !");
+            break;
+          }
+        }
+        return status;
+      }
+
+      // TOF kinematics are gathered event after event and computed at once
+      // when every pattern has been built
+      if (_drivers_.TOFD) _drivers_.TOFD->set_batch(_tof_batch_);
+      try {
+        for (size_t i = 0; i < ptds_.size(); ++i) {
+          status = _process_algo(*ptds_[i], *pids_[i], *tds_[i]);
+          if (status != 0) {
+            DT_LOG_ERROR(get_logging_priority(),
+                         "Computing topology quantities with '" << get_id() << "' algorithm has failed !");
+            break;
+          }
+        }
+      } catch (...) {
+        if (_drivers_.TOFD) _drivers_.TOFD->reset_batch();
+        _tof_batch_.clear();
+        throw;
+      }
+      if (_drivers_.TOFD) _drivers_.TOFD->reset_batch();
+      DT_LOG_DEBUG(get_logging_priority(), "Computing " << _tof_batch_.size() << " TOF hypotheses for "
+                   << ptds_.size() << " events");
+      _tof_batch_.compute();
+
+      // Derived quantities cached before the TOF probabilities were filled
+      // have to be recomputed
+      for (size_t i = 0; i < tds_.size(); ++i) {
+        if (tds_[i]->has_pattern()) {
+          tds_[i]->grab_pattern().invalidate_summary();
+        }
+      }
+      return status;
+    }
+
     void topology_driver::_set_defaults()
     {
       _logging_priority_ = datatools::logger::PRIO_WARNING;
+      _dispatch_table_.clear();
+      _builders_.clear();
+      _pool_.clear();
+      _tof_batch_.clear();
+      _lazy_measurements_ = false;
+      _batch_tof_ = false;
+      _required_measurements_.clear();
+      _required_keys_.clear();
+      _parallel_gammas_threshold_ = 0;
+      _gamma_lanes_.clear();
       _drivers_.TOFD.reset(0);
       _drivers_.VD.reset(0);
       _drivers_.AMD.reset(0);
@@ -167,32 +367,41 @@ namespace snemo {
     }
 
     int topology_driver::_process_algo(const snemo::datamodel::particle_track_data & ptd_,
+                                       const snemo::datamodel::pid_data & pid_,
                                        snemo::datamodel::topology_data & td_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
-      const std::string a_classification = topology_driver::_get_classification_(ptd_);
-      td_.grab_auxiliaries().store(snemo::datamodel::pid_utils::classification_label_key(),
-                                   a_classification);
-      const std::string a_builder_class_id = topology_driver::_get_builder_class_id_(a_classification);
-      if (a_builder_class_id.empty()) {
+      // Reclaim patterns from previous events
+      _pool_.recycle();
+
+      const snemo::datamodel::pid_utils::classification_code_type a_code
+        = topology_driver::_get_classification_(pid_);
+      // Classification label kept for backward compatibility, the code is
+      // only stored if it holds every particle count so that consumers fall
+      // back to the label otherwise
+      datatools::properties & td_aux = td_.grab_auxiliaries();
+      td_aux.store(snemo::datamodel::pid_utils::classification_label_key(),
+                   pid_.get_classification_label());
+      if (! snemo::datamodel::pid_utils::is_overflow_classification_code(a_code)) {
+        td_aux.store_integer(snemo::datamodel::pid_utils::classification_code_key(), a_code);
+      } else if (td_aux.has_key(snemo::datamodel::pid_utils::classification_code_key())) {
+        td_aux.erase(snemo::datamodel::pid_utils::classification_code_key());
+      }
+
+      base_topology_builder * a_builder = _dispatch_table_[_get_dispatch_index_(a_code)];
+      if (a_builder == 0) {
         DT_LOG_DEBUG(get_logging_priority(), "Topology not supported for the measurements ");
         return 0;
       }
+      td_.set_pattern_handle(a_builder->create_pattern());
 
-      const base_topology_builder::factory_register_type & FB
-        = DATATOOLS_FACTORY_GET_SYSTEM_REGISTER(base_topology_builder);
-      DT_THROW_IF(! FB.has(a_builder_class_id), std::logic_error,
-                  "Topology builder class id '" << a_builder_class_id << "' "
-                  << "is not available from the system builder factory register !");
-      const base_topology_builder::factory_register_type::factory_type & the_factory
-        = FB.get(a_builder_class_id);
-      snemo::reconstruction::base_topology_builder * new_builder = the_factory();
-      td_.set_pattern_handle(new_builder->create_pattern());
+      // Topologies without requirement get every measurement
+      required_keys_dict_type::const_iterator found = _required_keys_.find(a_code);
+      a_builder->set_required_measurements(found != _required_keys_.end() ? &found->second : 0);
 
       // Build new topology pattern
-      new_builder->set_measurement_drivers(_drivers_);
-      new_builder->build(ptd_, td_.grab_pattern());
+      a_builder->build(ptd_, pid_, td_.grab_pattern());
 
       if (get_logging_priority() >= datatools::logger::PRIO_TRACE) {
         DT_LOG_TRACE(get_logging_priority(), "New pattern: ");
@@ -203,52 +412,131 @@ namespace snemo {
       return 0;
     }
 
-    std::string topology_driver::_get_classification_(const snemo::datamodel::particle_track_data & ptd_) const
+    void topology_driver::_install_builders_()
     {
-      const datatools::properties & aux = ptd_.get_auxiliaries();
-      std::ostringstream classification;
-
-      std::string key;
-      if (aux.has_key(key = snemo::datamodel::pid_utils::electron_label())) {
-        classification << aux.fetch_integer(key) << "e";
+      std::vector<std::string> builder_class_ids;
+      builder_class_ids.push_back("snemo::reconstruction::topology_1e_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_1e1a_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_1e1p_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_2p_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_1eNg_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_2e_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_2eNg_builder");
+      builder_class_ids.push_back("snemo::reconstruction::topology_NeMg_builder");
+
+      std::vector<const measurement_drivers *> lanes;
+      for (size_t ilane = 0; ilane < _gamma_lanes_.size(); ++ilane) {
+        lanes.push_back(_gamma_lanes_[ilane].get());
       }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::positron_label())) {
-        classification << aux.fetch_integer(key) << "p";
+
+      const base_topology_builder::factory_register_type & FB
+        = DATATOOLS_FACTORY_GET_SYSTEM_REGISTER(base_topology_builder);
+      for (std::vector<std::string>::const_iterator
+             iid = builder_class_ids.begin();
+           iid != builder_class_ids.end(); ++iid) {
+        const std::string & a_builder_class_id = *iid;
+        DT_THROW_IF(! FB.has(a_builder_class_id), std::logic_error,
+                    "Topology builder class id '" << a_builder_class_id << "' "
+                    << "is not available from the system builder factory register !");
+        const base_topology_builder::factory_register_type::factory_type & the_factory
+          = FB.get(a_builder_class_id);
+        boost::shared_ptr<base_topology_builder> a_builder(the_factory());
+        a_builder->set_measurement_drivers(_drivers_);
+        a_builder->set_pool(_pool_);
+        a_builder->set_lazy_measurements(_lazy_measurements_);
+        a_builder->set_parallel_gammas(_parallel_gammas_threshold_, lanes);
+        _builders_[a_builder_class_id] = a_builder;
+        DT_LOG_DEBUG(get_logging_priority(), "Topology builder '" << a_builder_class_id << "' installed");
       }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::gamma_label())) {
-        classification << aux.fetch_integer(key) << "g";
+      return;
+    }
+
+    void topology_driver::_build_dispatch_table_()
+    {
+      const size_t nvalues = DISPATCH_COUNT_MAX + 1;
+      size_t table_size = 1;
+      for (size_t i = 0; i < snemo::datamodel::pid_utils::NUMBER_OF_PARTICLE_TYPES; ++i) {
+        table_size *= nvalues;
       }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::alpha_label())) {
-        classification << aux.fetch_integer(key) << "a";
+      _dispatch_table_.assign(table_size, 0);
+
+      for (size_t index = 0; index < table_size; ++index) {
+        size_t counts[snemo::datamodel::pid_utils::NUMBER_OF_PARTICLE_TYPES];
+        size_t remainder = index;
+        for (size_t i = 0; i < snemo::datamodel::pid_utils::NUMBER_OF_PARTICLE_TYPES; ++i) {
+          counts[i] = remainder % nvalues;
+          remainder /= nvalues;
+        }
+        const snemo::datamodel::pid_utils::classification_code_type a_code
+          = snemo::datamodel::pid_utils::make_classification_code(counts[0], counts[1], counts[2],
+                                                                  counts[3], counts[4]);
+        const std::string a_builder_class_id = _get_builder_class_id_(a_code);
+        if (a_builder_class_id.empty()) continue;
+        builder_dict_type::const_iterator found = _builders_.find(a_builder_class_id);
+        DT_THROW_IF(found == _builders_.end(), std::logic_error,
+                    "Topology builder class id '" << a_builder_class_id << "' "
+                    << "has not been installed !");
+        _dispatch_table_[index] = found->second.get();
       }
-      if (aux.has_key(key = snemo::datamodel::pid_utils::undefined_label())) {
-        classification << aux.fetch_integer(key) << "X";
+      return;
+    }
+
+    // static
+    size_t topology_driver::_get_dispatch_index_(const snemo::datamodel::pid_utils::classification_code_type code_)
+    {
+      const size_t nvalues = DISPATCH_COUNT_MAX + 1;
+      size_t index = 0;
+      for (size_t i = snemo::datamodel::pid_utils::NUMBER_OF_PARTICLE_TYPES; i-- > 0;) {
+        size_t n = snemo::datamodel::pid_utils::get_particle_count(code_,
+                                                                   static_cast<snemo::datamodel::pid_utils::particle_type>(i));
+        if (n > DISPATCH_COUNT_MAX) n = DISPATCH_COUNT_MAX;
+        index = index * nvalues + n;
       }
-      const std::string a_classification = classification.str();
-      DT_LOG_TRACE(get_logging_priority(), "Event classification : " << a_classification);
-      return a_classification;
+      return index;
     }
 
-    std::string topology_driver::_get_builder_class_id_(const std::string & classification_) const
+    snemo::datamodel::pid_utils::classification_code_type
+    topology_driver::_get_classification_(const snemo::datamodel::pid_data & pid_) const
     {
-      // Regex machinery...
+      const snemo::datamodel::pid_utils::classification_code_type a_code
+        = pid_.get_classification_code();
+      DT_LOG_TRACE(get_logging_priority(), "Event classification : "
+                   << pid_.get_classification_label());
+      return a_code;
+    }
+
+    std::string topology_driver::_get_builder_class_id_(const snemo::datamodel::pid_utils::classification_code_type code_) const
+    {
+      typedef snemo::datamodel::pid_utils pu;
+      const size_t ne = pu::get_particle_count(code_, pu::PARTICLE_ELECTRON);
+      const size_t np = pu::get_particle_count(code_, pu::PARTICLE_POSITRON);
+      const size_t ng = pu::get_particle_count(code_, pu::PARTICLE_GAMMA);
+      const size_t na = pu::get_particle_count(code_, pu::PARTICLE_ALPHA);
+      const size_t nx = pu::get_particle_count(code_, pu::PARTICLE_UNDEFINED);
+
       std::string a_class_id;
-      if (classification_ == "1e") {
+      if (nx != 0) {
+        // Events with undefined particles are not supported
+      } else if (ne == 1 && np == 0 && ng == 0 && na == 0) {
         a_class_id = "snemo::reconstruction::topology_1e_builder";
-      } else if (classification_ == "1e1a") {
+      } else if (ne == 1 && np == 0 && ng == 0 && na == 1) {
         a_class_id = "snemo::reconstruction::topology_1e1a_builder";
-      } else if (classification_ == "1e1p") {
+      } else if (ne == 1 && np == 1 && ng == 0 && na == 0) {
         a_class_id = "snemo::reconstruction::topology_1e1p_builder";
-      } else if (classification_ == "2p") {
+      } else if (ne == 0 && np == 2 && ng == 0 && na == 0) {
         a_class_id = "snemo::reconstruction::topology_2p_builder";
-      } else if (std::regex_match(classification_, std::regex("1e[0-9]+g"))) {
+      } else if (ne == 1 && np == 0 && ng >= 1 && na == 0) {
         a_class_id = "snemo::reconstruction::topology_1eNg_builder";
-      } else if (classification_ == "2e") {
+      } else if (ne == 2 && np == 0 && ng == 0 && na == 0) {
         a_class_id = "snemo::reconstruction::topology_2e_builder";
-      } else if (std::regex_match(classification_, std::regex("2e[0-9]+g"))) {
+      } else if (ne == 2 && np == 0 && ng >= 1 && na == 0) {
         a_class_id = "snemo::reconstruction::topology_2eNg_builder";
-      } else {
-        DT_LOG_DEBUG(get_logging_priority(), "Non supported classification '" << classification_ << "' !");
+      } else if (ne >= 3 && np == 0 && na == 0) {
+        a_class_id = "snemo::reconstruction::topology_NeMg_builder";
+      }
+      if (a_class_id.empty()) {
+        DT_LOG_DEBUG(get_logging_priority(), "Non supported classification '"
+                     << pu::classification_label(code_) << "' !");
       }
       DT_LOG_TRACE(get_logging_priority(), "Builder class id : " << a_class_id);
       return a_class_id;
@@ -260,6 +548,92 @@ namespace snemo {
       // Prefix "TD" stands for "Topology Driver" :
       datatools::logger::declare_ocd_logging_configuration(ocd_, "fatal", "TD.");
 
+      {
+        // Description of the 'parallel_gammas.threshold' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("parallel_gammas.threshold")
+          .set_terse_description("The number of gammas from which per-gamma measurements run concurrently")
+          .set_traits(datatools::TYPE_INTEGER)
+          .set_mandatory(false)
+          .set_long_description("For 1eNg and 2eNg topologies, the measurements related to each   \n"
+                                "gamma (TOF, angle, energy) are computed in concurrent lanes when \n"
+                                "the event holds at least this number of gammas. A null value     \n"
+                                "disables the intra-event parallelism. Measurements computed at   \n"
+                                "first access are not concerned.                                  \n")
+          .set_default_value_integer(0)
+          .add_example("Compute per-gamma measurements concurrently from 3 gammas:: \n"
+                       "                                                            \n"
+                       "  parallel_gammas.threshold : integer = 3                   \n"
+                       "                                                            \n"
+                       );
+      }
+
+      {
+        // Description of the 'parallel_gammas.lanes' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("parallel_gammas.lanes")
+          .set_terse_description("The number of concurrent lanes computing per-gamma measurements")
+          .set_traits(datatools::TYPE_INTEGER)
+          .set_mandatory(false)
+          .set_long_description("Measurement drivers are not reentrant: every lane but the first   \n"
+                                "one, which runs within the calling thread, owns its own TOF,     \n"
+                                "vertex, angle and energy drivers configured as the main ones.    \n"
+                                "Gammas are dealt to the lanes in turn.                           \n")
+          .set_default_value_integer(2)
+          .add_example("Compute per-gamma measurements in 4 lanes:: \n"
+                       "                                            \n"
+                       "  parallel_gammas.threshold : integer = 3   \n"
+                       "  parallel_gammas.lanes : integer = 4       \n"
+                       "                                            \n"
+                       );
+      }
+
+      {
+        // Description of the 'lazy_measurements' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("lazy_measurements")
+          .set_terse_description("Flag to compute measurements at their first access")
+          .set_traits(datatools::TYPE_BOOLEAN)
+          .set_mandatory(false)
+          .set_long_description("Measurements are attached to the topology pattern but the related \n"
+                                "drivers are only invoked when the measurement is first requested  \n"
+                                "(by a cut for instance) or when the pattern is stored.            \n"
+                                "Pending measurements refer to the drivers: they must be computed  \n"
+                                "before the driver is reset. Reading the measurement dictionary or \n"
+                                "storing the pattern computes them. With several workers, the      \n"
+                                "topology module computes them before the event leaves the worker. \n")
+          .set_default_value_boolean(false)
+          .add_example("Compute measurements on demand::      \n"
+                       "                                      \n"
+                       "  lazy_measurements : boolean = true  \n"
+                       "                                      \n"
+                       );
+      }
+
+      {
+        // Description of the 'batch_tof' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("batch_tof")
+          .set_terse_description("Flag to compute the TOF hypotheses of an event at once")
+          .set_traits(datatools::TYPE_BOOLEAN)
+          .set_mandatory(false)
+          .set_long_description("The TOF kinematics of every particle pair are gathered while the \n"
+                                "topology pattern is built and the related probabilities are     \n"
+                                "computed in a single pass of the vectorized TOF kernel. Vertex, \n"
+                                "angle and energy measurements are still computed one by one.     \n"
+                                "This flag can not be combined with 'lazy_measurements'.          \n")
+          .set_default_value_boolean(false)
+          .add_example("Batch TOF computations::      \n"
+                       "                              \n"
+                       "  batch_tof : boolean = true  \n"
+                       "                              \n"
+                       );
+      }
+
       // Invoke specific OCD support from the driver class:
       ::snemo::reconstruction::tof_driver::init_ocd(ocd_);
       ::snemo::reconstruction::vertex_driver::init_ocd(ocd_);
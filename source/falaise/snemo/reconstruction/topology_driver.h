@@ -31,18 +31,33 @@
 #ifndef FALAISE_TOPOLOGY_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_DRIVER_H
 #define FALAISE_TOPOLOGY_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_DRIVER_H 1
 
+// Standard library:
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+
 // Third party:
 // - Boost:
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
 // - Bayeux/datatools:
 #include <datatools/logger.h>
 
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_keys.h>
+#include <falaise/snemo/reconstruction/topology_pool.h>
+#include <falaise/snemo/reconstruction/tof_batch.h>
+
 namespace snemo {
 
   namespace datamodel {
     class particle_track_data;
+    class pid_data;
     class topology_data;
+    class calorimeter_index;
   }
 
   namespace reconstruction {
@@ -52,6 +67,7 @@ namespace snemo {
     class vertex_driver;
     class angle_driver;
     class energy_driver;
+    class base_topology_builder;
 
     struct measurement_drivers {
       boost::scoped_ptr<snemo::reconstruction::tof_driver> TOFD;
@@ -65,6 +81,15 @@ namespace snemo {
     {
     public:
 
+      /// Typedef to topology builder dictionary indexed by builder class id
+      typedef std::map<std::string, boost::shared_ptr<base_topology_builder> > builder_dict_type;
+
+      /// Typedef to builder dispatch table indexed by the reduced classification code
+      typedef std::vector<base_topology_builder *> dispatch_table_type;
+
+      /// Particle count per type above which the dispatch table does not distinguish events
+      static const size_t DISPATCH_COUNT_MAX = 3;
+
       /// Algorithm id
       static const std::string & get_id();
 
@@ -92,10 +117,45 @@ namespace snemo {
       /// Reset the clusterizer
       virtual void reset();
 
-      /// Main tracker trajectory driver
+      /// Restrict the measurements computed for a topology ("2e", "1e1g"...) to the given labels
+      void set_required_measurements(const std::string & topology_label_,
+                                     const std::set<std::string> & labels_);
+
+      /// Compute every measurement supported by the topology builders
+      void reset_required_measurements();
+
+      /// Check if the computed measurements are restricted for some topologies
+      bool has_required_measurements() const;
+
+      /// Check if the computed measurements are restricted for a given topology
+      bool has_required_measurements(const std::string & topology_label_) const;
+
+      /// Return the labels of the measurements computed for a given topology
+      const std::set<std::string> & get_required_measurements(const std::string & topology_label_) const;
+
+      /// Match calorimeter blocks through their dense index (after initialization)
+      void set_calorimeter_index(const snemo::datamodel::calorimeter_index & index_);
+
+      /// Main tracker trajectory driver (PID fetched from particle track auxiliaries)
       int process(const snemo::datamodel::particle_track_data & ptd_,
                   snemo::datamodel::topology_data & td_);
 
+      /// Main tracker trajectory driver given the PID bank
+      int process(const snemo::datamodel::particle_track_data & ptd_,
+                  const snemo::datamodel::pid_data & pid_,
+                  snemo::datamodel::topology_data & td_);
+
+      /// Process a batch of events, TOF computations being done for all events at once
+      ///
+      /// With lazy measurements, events are processed one after the other.
+      int process_batch(const std::vector<const snemo::datamodel::particle_track_data *> & ptds_,
+                        const std::vector<snemo::datamodel::topology_data *> & tds_);
+
+      /// Process a batch of events given their PID banks
+      int process_batch(const std::vector<const snemo::datamodel::particle_track_data *> & ptds_,
+                        const std::vector<const snemo::datamodel::pid_data *> & pids_,
+                        const std::vector<snemo::datamodel::topology_data *> & tds_);
+
       /// OCD support:
       static void init_ocd(datatools::object_configuration_description & ocd_);
 
@@ -107,21 +167,54 @@ namespace snemo {
 
       /// Main identification method
       virtual int _process_algo(const snemo::datamodel::particle_track_data & ptd_,
+                                const snemo::datamodel::pid_data & pid_,
                                 snemo::datamodel::topology_data & td_);
 
     private:
 
-      /// Build the event classification
-      std::string _get_classification_(const snemo::datamodel::particle_track_data & ptd_) const;
+      /// Typedef for the labels of the required measurements per topology label
+      typedef std::map<std::string, std::set<std::string> > required_labels_dict_type;
+
+      /// Typedef for the keys of the required measurements per classification code
+      typedef std::map<snemo::datamodel::pid_utils::classification_code_type,
+                       std::set<snemo::datamodel::measurement_key> > required_keys_dict_type;
+
+      /// Initialize a set of measurement drivers
+      static void _initialize_drivers_(const datatools::properties & setup_,
+                                       const std::vector<std::string> & driver_names_,
+                                       measurement_drivers & drivers_);
+
+      /// Instantiate and bind to measurement drivers every supported topology builder
+      void _install_builders_();
+
+      /// Resolve the builder of every reduced classification code
+      void _build_dispatch_table_();
+
+      /// Return the dispatch table index of a classification code
+      static size_t _get_dispatch_index_(const snemo::datamodel::pid_utils::classification_code_type code_);
+
+      /// Build the event classification code
+      snemo::datamodel::pid_utils::classification_code_type
+      _get_classification_(const snemo::datamodel::pid_data & pid_) const;
 
-      /// Build the topology builder class id from the classification field
-      std::string _get_builder_class_id_(const std::string & classification) const;
+      /// Build the topology builder class id from the classification code
+      std::string _get_builder_class_id_(const snemo::datamodel::pid_utils::classification_code_type code_) const;
 
     private:
 
       bool _initialized_;                             //!< Initialize flag
       datatools::logger::priority _logging_priority_; //!< Logging priority
       measurement_drivers _drivers_;                  //!< Measurement drivers such as TOF...
+      builder_dict_type _builders_;                   //!< Topology builders instantiated once at initialization
+      dispatch_table_type _dispatch_table_;           //!< Topology builders indexed by reduced classification code
+      topology_pool _pool_;                           //!< Pool of recyclable patterns and measurements
+      bool _lazy_measurements_;                       //!< Measurements computed at first access
+      bool _batch_tof_;                               //!< TOF hypotheses of an event computed at once
+      required_labels_dict_type _required_measurements_; //!< Labels of the measurements to compute per topology
+      required_keys_dict_type _required_keys_;        //!< Keys of the measurements to compute per classification code
+      tof_batch _tof_batch_;                          //!< TOF computations deferred over a batch of events
+      size_t _parallel_gammas_threshold_;             //!< Number of gammas from which per-gamma measurements run concurrently
+      std::vector<boost::shared_ptr<measurement_drivers> > _gamma_lanes_; //!< Drivers of the additional per-gamma lanes
     };
 
   }  // end of namespace reconstruction
@@ -0,0 +1,296 @@
+// falaise/snemo/reconstruction/topology_event_view.cc
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/topology_event_view.h>
+
+// Standard library:
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/tracker_trajectory.h>
+#include <falaise/snemo/datamodels/base_trajectory_pattern.h>
+#include <falaise/snemo/datamodels/pid_data.h>
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    // static
+    topology_event_view::vertex_location_type
+    topology_event_view::fetch_vertex_location(const geomtools::blur_spot & vertex_)
+    {
+      // The location label is fetched once and compared to every known label
+      const datatools::properties & aux = vertex_.get_auxiliaries();
+      if (! aux.has_key(snemo::datamodel::particle_track::vertex_type_key())) return VERTEX_NONE;
+      return static_cast<vertex_location_type>
+        (snemo::datamodel::vertex_measurement::location_from_label(aux.fetch_string(snemo::datamodel::particle_track::vertex_type_key())));
+    }
+
+    // static
+    const std::string & topology_event_view::vertex_location_label(const vertex_location_type location_)
+    {
+      return snemo::datamodel::vertex_measurement::location_label(to_measurement_location(location_));
+    }
+
+    // static
+    snemo::datamodel::vertex_measurement::location_type
+    topology_event_view::to_measurement_location(const vertex_location_type location_)
+    {
+      return static_cast<snemo::datamodel::vertex_measurement::location_type>(location_);
+    }
+
+    // static
+    bool topology_event_view::is_calorimeter_location(const vertex_location_type location_)
+    {
+      return location_ == VERTEX_ON_MAIN_CALORIMETER
+        || location_ == VERTEX_ON_X_CALORIMETER
+        || location_ == VERTEX_ON_GAMMA_VETO;
+    }
+
+    topology_event_view::topology_event_view()
+    {
+      clear();
+      return;
+    }
+
+    topology_event_view::~topology_event_view()
+    {
+      return;
+    }
+
+    void topology_event_view::clear()
+    {
+      _tracks_.clear();
+      _types_.clear();
+      _energies_.clear();
+      _total_energies_.clear();
+      _times_.clear();
+      _sigma_times_.clear();
+      _track_lengths_.clear();
+      _vertex_offsets_.assign(1, 0);
+      _calorimeter_offsets_.assign(1, 0);
+      _vertices_.clear();
+      _vertex_xs_.clear();
+      _vertex_ys_.clear();
+      _vertex_zs_.clear();
+      _vertex_locations_.clear();
+      _vertex_calorimeter_indexes_.clear();
+      _calorimeter_hits_.clear();
+      _calorimeter_indexes_.clear();
+      return;
+    }
+
+    void topology_event_view::build(const snemo::datamodel::particle_track_data & ptd_,
+                                    const snemo::datamodel::pid_data & pid_,
+                                    const snemo::datamodel::calorimeter_index * index_)
+    {
+      clear();
+      if (! ptd_.has_particles()) return;
+      const snemo::datamodel::particle_track_data::particle_collection_type & the_particles
+        = ptd_.get_particles();
+      DT_THROW_IF(pid_.get_number_of_particles() != the_particles.size(), std::logic_error,
+                  "PID bank does not match the particle track data !");
+      for (size_t i_particle = 0; i_particle < the_particles.size(); ++i_particle) {
+        add_particle(the_particles[i_particle].get(), pid_.get_particle_type(i_particle), index_);
+      }
+      return;
+    }
+
+    size_t topology_event_view::add_particle(const snemo::datamodel::particle_track & track_,
+                                             const snemo::datamodel::pid_utils::particle_type type_,
+                                             const snemo::datamodel::calorimeter_index * index_)
+    {
+      _tracks_.push_back(&track_);
+      _types_.push_back(type_);
+
+      // Calorimeter hits
+      double energy = datatools::invalid_real();
+      double total_energy = datatools::invalid_real();
+      double time = datatools::invalid_real();
+      double sigma_time = datatools::invalid_real();
+      const snemo::datamodel::calibrated_calorimeter_hit::collection_type & the_calos
+        = track_.get_associated_calorimeter_hits();
+      for (size_t i = 0; i < the_calos.size(); ++i) {
+        const snemo::datamodel::calibrated_calorimeter_hit & a_calo = the_calos[i].get();
+        if (i == 0) {
+          energy = a_calo.get_energy();
+          total_energy = energy;
+          time = a_calo.get_time();
+          sigma_time = a_calo.get_sigma_time();
+        } else {
+          total_energy += a_calo.get_energy();
+        }
+        _calorimeter_hits_.push_back(&a_calo);
+        _calorimeter_indexes_.push_back(index_ != 0 ?
+                                        index_->get_index(a_calo.get_geom_id()) :
+                                        snemo::datamodel::calorimeter_index::INVALID_INDEX);
+      }
+      _energies_.push_back(energy);
+      _total_energies_.push_back(total_energy);
+      _times_.push_back(time);
+      _sigma_times_.push_back(sigma_time);
+      _calorimeter_offsets_.push_back(_calorimeter_hits_.size());
+
+      // Tracker trajectory
+      double track_length = datatools::invalid_real();
+      if (track_.has_trajectory()) {
+        track_length = track_.get_trajectory().get_pattern().get_shape().get_length();
+      }
+      _track_lengths_.push_back(track_length);
+
+      // Vertices
+      const snemo::datamodel::particle_track::vertex_collection_type & the_vertices
+        = track_.get_vertices();
+      for (size_t i = 0; i < the_vertices.size(); ++i) {
+        const geomtools::blur_spot & a_vertex = the_vertices[i].get();
+        const geomtools::vector_3d & a_position = a_vertex.get_position();
+        const vertex_location_type a_location = fetch_vertex_location(a_vertex);
+        _vertices_.push_back(&a_vertex);
+        _vertex_xs_.push_back(a_position.x());
+        _vertex_ys_.push_back(a_position.y());
+        _vertex_zs_.push_back(a_position.z());
+        _vertex_locations_.push_back(a_location);
+        _vertex_calorimeter_indexes_.push_back(index_ != 0 && is_calorimeter_location(a_location) ?
+                                               index_->get_index(a_vertex.get_geom_id()) :
+                                               snemo::datamodel::calorimeter_index::INVALID_INDEX);
+      }
+      _vertex_offsets_.push_back(_vertices_.size());
+      return _tracks_.size() - 1;
+    }
+
+    size_t topology_event_view::get_number_of_particles() const
+    {
+      return _tracks_.size();
+    }
+
+    size_t topology_event_view::get_number_of_vertices() const
+    {
+      return _vertices_.size();
+    }
+
+    size_t topology_event_view::get_number_of_calorimeter_hits() const
+    {
+      return _calorimeter_hits_.size();
+    }
+
+    const std::vector<const snemo::datamodel::particle_track *> & topology_event_view::get_tracks() const
+    {
+      return _tracks_;
+    }
+
+    const std::vector<snemo::datamodel::pid_utils::particle_type> & topology_event_view::get_particle_types() const
+    {
+      return _types_;
+    }
+
+    const std::vector<double> & topology_event_view::get_energies() const
+    {
+      return _energies_;
+    }
+
+    const std::vector<double> & topology_event_view::get_total_energies() const
+    {
+      return _total_energies_;
+    }
+
+    const std::vector<double> & topology_event_view::get_times() const
+    {
+      return _times_;
+    }
+
+    const std::vector<double> & topology_event_view::get_sigma_times() const
+    {
+      return _sigma_times_;
+    }
+
+    const std::vector<double> & topology_event_view::get_track_lengths() const
+    {
+      return _track_lengths_;
+    }
+
+    const std::vector<size_t> & topology_event_view::get_vertex_offsets() const
+    {
+      return _vertex_offsets_;
+    }
+
+    const std::vector<size_t> & topology_event_view::get_calorimeter_offsets() const
+    {
+      return _calorimeter_offsets_;
+    }
+
+    const std::vector<const geomtools::blur_spot *> & topology_event_view::get_vertices() const
+    {
+      return _vertices_;
+    }
+
+    const std::vector<double> & topology_event_view::get_vertex_xs() const
+    {
+      return _vertex_xs_;
+    }
+
+    const std::vector<double> & topology_event_view::get_vertex_ys() const
+    {
+      return _vertex_ys_;
+    }
+
+    const std::vector<double> & topology_event_view::get_vertex_zs() const
+    {
+      return _vertex_zs_;
+    }
+
+    geomtools::vector_3d topology_event_view::get_vertex_position(const size_t vertex_) const
+    {
+      DT_THROW_IF(vertex_ >= _vertices_.size(), std::range_error, "Invalid vertex (" << vertex_ << ") !");
+      return geomtools::vector_3d(_vertex_xs_[vertex_], _vertex_ys_[vertex_], _vertex_zs_[vertex_]);
+    }
+
+    const std::vector<topology_event_view::vertex_location_type> & topology_event_view::get_vertex_locations() const
+    {
+      return _vertex_locations_;
+    }
+
+    const std::vector<size_t> & topology_event_view::get_vertex_calorimeter_indexes() const
+    {
+      return _vertex_calorimeter_indexes_;
+    }
+
+    const std::vector<const snemo::datamodel::calibrated_calorimeter_hit *> & topology_event_view::get_calorimeter_hits() const
+    {
+      return _calorimeter_hits_;
+    }
+
+    const std::vector<size_t> & topology_event_view::get_calorimeter_indexes() const
+    {
+      return _calorimeter_indexes_;
+    }
+
+    bool topology_event_view::is_same_block(const size_t vertex_, const size_t hit_) const
+    {
+      const size_t vertex_index = _vertex_calorimeter_indexes_[vertex_];
+      const size_t hit_index = _calorimeter_indexes_[hit_];
+      if (vertex_index != snemo::datamodel::calorimeter_index::INVALID_INDEX ||
+          hit_index != snemo::datamodel::calorimeter_index::INVALID_INDEX) {
+        return vertex_index == hit_index;
+      }
+      // No dense index: compare the geom_ids
+      return _vertices_[vertex_]->get_geom_id() == _calorimeter_hits_[hit_]->get_geom_id();
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
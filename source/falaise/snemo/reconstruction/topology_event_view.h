@@ -0,0 +1,195 @@
+/// \file falaise/snemo/reconstruction/topology_event_view.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Struct-of-arrays view of the particles of an event
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_TOPOLOGY_EVENT_VIEW_H
+#define FALAISE_SNEMO_RECONSTRUCTION_TOPOLOGY_EVENT_VIEW_H 1
+
+// Standard library:
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/geomtools:
+#include <geomtools/utils.h>
+#include <geomtools/blur_spot.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/calibrated_calorimeter_hit.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+    class particle_track_data;
+    class pid_data;
+    class calorimeter_index;
+  }
+
+  namespace reconstruction {
+
+    /// \brief Struct-of-arrays view of the particles of an event
+    ///
+    /// The view is filled once per event from the particle track data: the
+    /// quantities the topology stage reads from particle tracks, calorimeter
+    /// hits and vertices (including the vertex location, otherwise stored as
+    /// a string auxiliary) are copied into contiguous arrays. Vertices and
+    /// calorimeter hits of particle \c i are found in the ranges
+    /// [offsets[i], offsets[i+1]) of the related arrays. Source objects are
+    /// referenced, not copied: the view is only valid while the particle
+    /// track data lives. Clearing the view keeps the allocated storage.
+    class topology_event_view
+    {
+    public:
+
+      /// Vertex locations (same codes as the vertex measurement locations)
+      enum vertex_location_type {
+        VERTEX_NONE                = snemo::datamodel::vertex_measurement::LOCATION_NONE,
+        VERTEX_ON_SOURCE_FOIL      = snemo::datamodel::vertex_measurement::LOCATION_SOURCE_FOIL,
+        VERTEX_ON_WIRE             = snemo::datamodel::vertex_measurement::LOCATION_WIRE,
+        VERTEX_ON_MAIN_CALORIMETER = snemo::datamodel::vertex_measurement::LOCATION_MAIN_CALORIMETER,
+        VERTEX_ON_X_CALORIMETER    = snemo::datamodel::vertex_measurement::LOCATION_X_CALORIMETER,
+        VERTEX_ON_GAMMA_VETO       = snemo::datamodel::vertex_measurement::LOCATION_GAMMA_VETO
+      };
+
+      /// Return the location of a vertex from its auxiliaries
+      static vertex_location_type fetch_vertex_location(const geomtools::blur_spot & vertex_);
+
+      /// Return the auxiliary label of a vertex location
+      static const std::string & vertex_location_label(const vertex_location_type location_);
+
+      /// Return the vertex measurement location of a vertex location
+      static snemo::datamodel::vertex_measurement::location_type to_measurement_location(const vertex_location_type location_);
+
+      /// Check if a vertex location is a calorimeter block
+      static bool is_calorimeter_location(const vertex_location_type location_);
+
+      /// Constructor
+      topology_event_view();
+
+      /// Destructor
+      ~topology_event_view();
+
+      /// Remove all the particles (allocated storage is kept)
+      void clear();
+
+      /// Fill the view with all the particles of an event
+      void build(const snemo::datamodel::particle_track_data & ptd_,
+                 const snemo::datamodel::pid_data & pid_,
+                 const snemo::datamodel::calorimeter_index * index_ = 0);
+
+      /// Append a particle and return its position
+      size_t add_particle(const snemo::datamodel::particle_track & track_,
+                          const snemo::datamodel::pid_utils::particle_type type_,
+                          const snemo::datamodel::calorimeter_index * index_ = 0);
+
+      /// Return the number of particles
+      size_t get_number_of_particles() const;
+
+      /// Return the number of vertices
+      size_t get_number_of_vertices() const;
+
+      /// Return the number of calorimeter hits
+      size_t get_number_of_calorimeter_hits() const;
+
+      /// Return the particle tracks
+      const std::vector<const snemo::datamodel::particle_track *> & get_tracks() const;
+
+      /// Return the particle types
+      const std::vector<snemo::datamodel::pid_utils::particle_type> & get_particle_types() const;
+
+      /// Return the energies of the first calorimeter hit of the particles
+      const std::vector<double> & get_energies() const;
+
+      /// Return the energies summed over the calorimeter hits of the particles
+      const std::vector<double> & get_total_energies() const;
+
+      /// Return the times of the first calorimeter hit of the particles
+      const std::vector<double> & get_times() const;
+
+      /// Return the time errors of the first calorimeter hit of the particles
+      const std::vector<double> & get_sigma_times() const;
+
+      /// Return the tracker trajectory lengths of the particles
+      const std::vector<double> & get_track_lengths() const;
+
+      /// Return the first vertex of each particle (one extra entry for the end)
+      const std::vector<size_t> & get_vertex_offsets() const;
+
+      /// Return the first calorimeter hit of each particle (one extra entry for the end)
+      const std::vector<size_t> & get_calorimeter_offsets() const;
+
+      /// Return the vertices
+      const std::vector<const geomtools::blur_spot *> & get_vertices() const;
+
+      /// Return the X positions of the vertices
+      const std::vector<double> & get_vertex_xs() const;
+
+      /// Return the Y positions of the vertices
+      const std::vector<double> & get_vertex_ys() const;
+
+      /// Return the Z positions of the vertices
+      const std::vector<double> & get_vertex_zs() const;
+
+      /// Return the position of a vertex
+      geomtools::vector_3d get_vertex_position(const size_t vertex_) const;
+
+      /// Return the locations of the vertices
+      const std::vector<vertex_location_type> & get_vertex_locations() const;
+
+      /// Return the calorimeter indexes of the vertices (INVALID_INDEX if none)
+      const std::vector<size_t> & get_vertex_calorimeter_indexes() const;
+
+      /// Return the calorimeter hits
+      const std::vector<const snemo::datamodel::calibrated_calorimeter_hit *> & get_calorimeter_hits() const;
+
+      /// Return the calorimeter indexes of the calorimeter hits (INVALID_INDEX if none)
+      const std::vector<size_t> & get_calorimeter_indexes() const;
+
+      /// Check if a vertex and a calorimeter hit belong to the same calorimeter block
+      bool is_same_block(const size_t vertex_, const size_t hit_) const;
+
+    private:
+
+      // Particles:
+      std::vector<const snemo::datamodel::particle_track *> _tracks_;       //!< Particle tracks
+      std::vector<snemo::datamodel::pid_utils::particle_type> _types_;      //!< Particle types
+      std::vector<double> _energies_;                                       //!< First calorimeter hit energies
+      std::vector<double> _total_energies_;                                 //!< Summed calorimeter hit energies
+      std::vector<double> _times_;                                          //!< First calorimeter hit times
+      std::vector<double> _sigma_times_;                                    //!< First calorimeter hit time errors
+      std::vector<double> _track_lengths_;                                  //!< Tracker trajectory lengths
+      std::vector<size_t> _vertex_offsets_;                                 //!< First vertex of each particle
+      std::vector<size_t> _calorimeter_offsets_;                            //!< First calorimeter hit of each particle
+
+      // Vertices:
+      std::vector<const geomtools::blur_spot *> _vertices_;                 //!< Vertices
+      std::vector<double> _vertex_xs_;                                      //!< Vertex X positions
+      std::vector<double> _vertex_ys_;                                      //!< Vertex Y positions
+      std::vector<double> _vertex_zs_;                                      //!< Vertex Z positions
+      std::vector<vertex_location_type> _vertex_locations_;                 //!< Vertex locations
+      std::vector<size_t> _vertex_calorimeter_indexes_;                     //!< Vertex calorimeter indexes
+
+      // Calorimeter hits:
+      std::vector<const snemo::datamodel::calibrated_calorimeter_hit *> _calorimeter_hits_; //!< Calorimeter hits
+      std::vector<size_t> _calorimeter_indexes_;                            //!< Calorimeter hit indexes
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_TOPOLOGY_EVENT_VIEW_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
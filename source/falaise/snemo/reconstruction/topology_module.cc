@@ -20,8 +20,11 @@
 // This project:
 #include <falaise/snemo/datamodels/data_model.h>
 #include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_data.h>
 #include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/calorimeter_index_service.h>
 #include <falaise/snemo/processing/services.h>
+#include <falaise/snemo/cuts/channel_cut.h>
 
 #include <snemo/reconstruction/particle_identification_driver.h>
 #include <snemo/reconstruction/topology_driver.h>
@@ -37,9 +40,11 @@ namespace snemo {
     void topology_module::_set_defaults()
     {
       _PTD_label_ = snemo::datamodel::data_info::default_particle_track_data_label();
+      _PID_label_ = "PID";
+      _store_PID_ = false;
       _TD_label_ = "TD";//snemo::datamodel::data_info::default_topology_data_label();
-      _pid_driver_.reset(0);
-      _topology_driver_.reset(0);
+      _idle_workers_.clear();
+      _workers_.clear();
       return;
     }
 
@@ -58,6 +63,14 @@ namespace snemo {
         _PTD_label_ = setup_.fetch_string("PTD_label");
       }
 
+      if (setup_.has_key("PID_label")) {
+        _PID_label_ = setup_.fetch_string("PID_label");
+      }
+
+      if (setup_.has_key("store_PID")) {
+        _store_PID_ = setup_.fetch_boolean("store_PID");
+      }
+
       if (setup_.has_key("TD_label")) {
         _TD_label_ = setup_.fetch_string("TD_label");
       }
@@ -76,16 +89,69 @@ namespace snemo {
       cuts::cut_service & Cut
         = service_manager_.grab<cuts::cut_service>(cut_label);
 
-      _pid_driver_.reset(new snemo::reconstruction::particle_identification_driver);
-      _pid_driver_->set_cut_manager(Cut.grab_cut_manager());
+      // Calorimeter index :
+      const snemo::datamodel::calorimeter_index * CI = 0;
+      if (setup_.has_key("CI_label")) {
+        const std::string ci_label = setup_.fetch_string("CI_label");
+        DT_THROW_IF(! service_manager_.has(ci_label) ||
+                    ! service_manager_.is_a<snemo::datamodel::calorimeter_index_service>(ci_label),
+                    std::logic_error,
+                    "Module '" << get_name() << "' has no '" << ci_label << "' service !");
+        CI = &service_manager_.get<snemo::datamodel::calorimeter_index_service>(ci_label).get_index();
+      }
+
+      // Concurrency :
+      size_t nworkers = 1;
+      if (setup_.has_key("concurrency.workers")) {
+        const int n = setup_.fetch_integer("concurrency.workers");
+        DT_THROW_IF(n < 1, std::domain_error,
+                    "Module '" << get_name() << "' has an invalid number of workers (" << n << ") !");
+        nworkers = n;
+      }
+
+      // Measurements demanded by the channel cuts :
+      bool restrict_measurements = true;
+      if (setup_.has_key("measurements.restrict_to_cuts")) {
+        restrict_measurements = setup_.fetch_boolean("measurements.restrict_to_cuts");
+      }
+      measurement_demand_type required_measurements;
+      if (restrict_measurements) {
+        _analyse_measurement_demand(Cut.get_cut_manager(), required_measurements);
+      }
 
       // Drivers :
       datatools::properties PID_config;
       setup_.export_and_rename_starting_with(PID_config, particle_identification_driver::get_id() + ".", "");
-      _pid_driver_->initialize(PID_config);
+      for (size_t iworker = 0; iworker < nworkers; ++iworker) {
+        boost::shared_ptr<worker_drivers> a_worker(new worker_drivers);
+        a_worker->PID.reset(new snemo::reconstruction::particle_identification_driver);
+        if (nworkers > 1) {
+          // Cuts hold the data they are processing: each worker evaluates
+          // its own instances of the PID cuts
+          _clone_cut_manager(Cut.grab_cut_manager(), a_worker->cuts);
+          a_worker->PID->set_cut_manager(*a_worker->cuts);
+        } else {
+          a_worker->PID->set_cut_manager(Cut.grab_cut_manager());
+        }
+        a_worker->PID->initialize(PID_config);
+
+        a_worker->TD.reset(new snemo::reconstruction::topology_driver);
+        a_worker->TD->initialize(setup_);
+        for (measurement_demand_type::const_iterator idemand = required_measurements.begin();
+             idemand != required_measurements.end(); ++idemand) {
+          a_worker->TD->set_required_measurements(idemand->first, idemand->second);
+        }
+        if (CI != 0) {
+          a_worker->TD->set_calorimeter_index(*CI);
+        }
 
-      _topology_driver_.reset(new snemo::reconstruction::topology_driver);
-      _topology_driver_->initialize(setup_);
+        _workers_.push_back(a_worker);
+        _idle_workers_.push_back(iworker);
+      }
+      DT_THROW_IF(! _store_PID_ && ! _workers_.front()->PID->is_export_labels(), std::logic_error,
+                  "Module '" << get_name() << "' would store particle types neither in the '"
+                  << _PID_label_ << "' bank nor within the particle tracks !");
+      DT_LOG_DEBUG(get_logging_priority(), "Number of workers : " << nworkers);
 
       _set_initialized(true);
       return;
@@ -115,6 +181,144 @@ namespace snemo {
       return;
     }
 
+    size_t topology_module::get_number_of_workers() const
+    {
+      return _workers_.size();
+    }
+
+    size_t topology_module::_acquire_worker()
+    {
+      std::unique_lock<std::mutex> lock(_workers_mutex_);
+      while (_idle_workers_.empty()) {
+        _worker_released_.wait(lock);
+      }
+      const size_t a_worker = _idle_workers_.back();
+      _idle_workers_.pop_back();
+      return a_worker;
+    }
+
+    void topology_module::_release_worker(const size_t worker_)
+    {
+      {
+        std::lock_guard<std::mutex> lock(_workers_mutex_);
+        _idle_workers_.push_back(worker_);
+      }
+      _worker_released_.notify_one();
+      return;
+    }
+
+    void topology_module::_clone_cut_manager(cuts::cut_manager & shared_,
+                                             boost::scoped_ptr<cuts::cut_manager> & clone_) const
+    {
+      clone_.reset(new cuts::cut_manager);
+      clone_->set_logging_priority(shared_.get_logging_priority());
+      if (shared_.has_service_manager()) {
+        clone_->set_service_manager(shared_.grab_service_manager());
+      }
+      datatools::properties a_config;
+      clone_->initialize(a_config);
+      // Cuts are only declared here, they are created and initialized by the
+      // cut manager when the PID driver fetches them
+      const cuts::cut_handle_dict_type & the_cuts = shared_.get_cuts();
+      for (cuts::cut_handle_dict_type::const_iterator icut = the_cuts.begin();
+           icut != the_cuts.end(); ++icut) {
+        const cuts::cut_entry_type & a_cut_entry = icut->second;
+        clone_->load_cut(icut->first, a_cut_entry.get_cut_id(), a_cut_entry.get_cut_config());
+      }
+      return;
+    }
+
+    void topology_module::_analyse_measurement_demand(const cuts::cut_manager & cut_manager_,
+                                                      measurement_demand_type & demand_) const
+    {
+      demand_.clear();
+      // Channels are 'multi_and' cuts combining a classification cut with
+      // channel cuts; channel cuts outside such a combination may apply to
+      // any topology
+      std::set<std::string> bound_channel_cuts;
+      // Topologies selected by a channel without channel cut consume any measurement
+      std::set<std::string> unrestricted_topologies;
+      const cuts::cut_handle_dict_type & the_cuts = cut_manager_.get_cuts();
+      for (cuts::cut_handle_dict_type::const_iterator icut = the_cuts.begin();
+           icut != the_cuts.end(); ++icut) {
+        const cuts::cut_entry_type & a_cut_entry = icut->second;
+        if (a_cut_entry.get_cut_id() != "cuts::multi_and_cut") continue;
+        const datatools::properties & a_config = a_cut_entry.get_cut_config();
+        if (! a_config.has_key("cuts")) continue;
+        std::vector<std::string> the_members;
+        a_config.fetch("cuts", the_members);
+        std::set<std::string> the_topologies;
+        std::set<std::string> the_channel_cuts;
+        std::set<std::string> the_labels;
+        for (size_t i = 0; i < the_members.size(); ++i) {
+          cuts::cut_handle_dict_type::const_iterator found = the_cuts.find(the_members[i]);
+          if (found == the_cuts.end()) continue;
+          const cuts::cut_entry_type & a_member = found->second;
+          const datatools::properties & a_member_config = a_member.get_cut_config();
+          if (a_member.get_cut_id() == "snemo::cut::channel_cut") {
+            the_channel_cuts.insert(the_members[i]);
+            snemo::cut::channel_cut::extract_measurement_labels(a_member_config, the_labels);
+          } else if (a_member.get_cut_id() == "snemo::cut::topology_data_cut" &&
+                     a_member_config.has_flag("mode.classification") &&
+                     a_member_config.has_key("classification.label")) {
+            const std::string a_topology = a_member_config.fetch_string("classification.label");
+            snemo::datamodel::pid_utils::classification_code_type a_code = 0;
+            // Regular expressions may select several topologies
+            if (snemo::datamodel::pid_utils::parse_classification_label(a_topology, a_code)) {
+              the_topologies.insert(a_topology);
+            }
+          }
+        }
+        if (the_topologies.empty()) continue;
+        if (the_channel_cuts.empty()) {
+          unrestricted_topologies.insert(the_topologies.begin(), the_topologies.end());
+          continue;
+        }
+        bound_channel_cuts.insert(the_channel_cuts.begin(), the_channel_cuts.end());
+        for (std::set<std::string>::const_iterator itopo = the_topologies.begin();
+             itopo != the_topologies.end(); ++itopo) {
+          demand_[*itopo].insert(the_labels.begin(), the_labels.end());
+        }
+      }
+      // Channel cuts not bound to a classification cut may apply to any topology
+      std::set<std::string> any_topology_labels;
+      for (cuts::cut_handle_dict_type::const_iterator icut = the_cuts.begin();
+           icut != the_cuts.end(); ++icut) {
+        const cuts::cut_entry_type & a_cut_entry = icut->second;
+        if (a_cut_entry.get_cut_id() != "snemo::cut::channel_cut") continue;
+        if (bound_channel_cuts.count(icut->first)) continue;
+        snemo::cut::channel_cut::extract_measurement_labels(a_cut_entry.get_cut_config(), any_topology_labels);
+      }
+      for (measurement_demand_type::iterator idemand = demand_.begin();
+           idemand != demand_.end(); ) {
+        idemand->second.insert(any_topology_labels.begin(), any_topology_labels.end());
+        // Without demand information, every measurement of the topology is computed
+        if (idemand->second.empty() || unrestricted_topologies.count(idemand->first)) {
+          DT_LOG_DEBUG(get_logging_priority(), "No measurement demand for the '" << idemand->first
+                       << "' topology : all its measurements are computed");
+          demand_.erase(idemand++);
+        } else {
+          ++idemand;
+        }
+      }
+
+      if (demand_.empty()) {
+        DT_LOG_DEBUG(get_logging_priority(), "No channel : all the measurements are computed");
+        return;
+      }
+      if (get_logging_priority() >= datatools::logger::PRIO_DEBUG) {
+        for (measurement_demand_type::const_iterator idemand = demand_.begin();
+             idemand != demand_.end(); ++idemand) {
+          DT_LOG_DEBUG(get_logging_priority(), "Measurements consumed by the '" << idemand->first << "' channels :");
+          for (std::set<std::string>::const_iterator ilabel = idemand->second.begin();
+               ilabel != idemand->second.end(); ++ilabel) {
+            DT_LOG_DEBUG(get_logging_priority(), " - '" << *ilabel << "'");
+          }
+        }
+      }
+      return;
+    }
+
     // Processing :
     dpp::base_module::process_status topology_module::process(datatools::things & data_record_)
     {
@@ -128,12 +332,24 @@ namespace snemo {
         // leave the data unchanged.
         return dpp::base_module::PROCESS_ERROR;
       }
-      // Grab the 'particle_track_data' entry from the data model :
-      snemo::datamodel::particle_track_data & the_particle_track_data
-        = data_record_.grab<snemo::datamodel::particle_track_data>(_PTD_label_);
-
-      // Prepare process
-      _prepare_process(the_particle_track_data);
+      // Get the 'particle_track_data' entry from the data model :
+      const snemo::datamodel::particle_track_data & the_particle_track_data
+        = data_record_.get<snemo::datamodel::particle_track_data>(_PTD_label_);
+
+      // Check PID data
+      snemo::datamodel::pid_data a_local_pid_data;
+      snemo::datamodel::pid_data * ptr_pid_data = &a_local_pid_data;
+      if (_store_PID_) {
+        if (! data_record_.has(_PID_label_)) {
+          ptr_pid_data
+            = &(data_record_.add<snemo::datamodel::pid_data>(_PID_label_));
+        } else {
+          ptr_pid_data
+            = &(data_record_.grab<snemo::datamodel::pid_data>(_PID_label_));
+          ptr_pid_data->clear();
+        }
+      }
+      snemo::datamodel::pid_data & the_pid_data = *ptr_pid_data;
 
       // Check topology data
       const bool preserve_former_output = false;
@@ -150,30 +366,73 @@ namespace snemo {
       }
       snemo::datamodel::topology_data & the_topology_data = *ptr_topology_data;
 
-      // Main processing method :
-      _process(the_particle_track_data, the_topology_data);
+      // Events may be processed concurrently, each one by its own worker
+      const size_t a_worker = _acquire_worker();
+      try {
+        // Prepare process
+        if (_workers_[a_worker]->PID->is_export_labels()) {
+          // Compatibility: PID labels are also stored within particle tracks
+          _prepare_process(*_workers_[a_worker],
+                           data_record_.grab<snemo::datamodel::particle_track_data>(_PTD_label_),
+                           the_pid_data);
+        } else {
+          _prepare_process(*_workers_[a_worker], the_particle_track_data, the_pid_data);
+        }
+
+        // Main processing method :
+        _process(*_workers_[a_worker], the_particle_track_data, the_pid_data, the_topology_data);
+      } catch (...) {
+        _release_worker(a_worker);
+        throw;
+      }
+      _release_worker(a_worker);
 
       return dpp::base_module::PROCESS_SUCCESS;
     }
 
-    void topology_module::_prepare_process(snemo::datamodel::particle_track_data & ptd_)
+    void topology_module::_prepare_process(worker_drivers & worker_,
+                                           snemo::datamodel::particle_track_data & ptd_,
+                                           snemo::datamodel::pid_data & pid_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
       // Process the particle identification driver :
-      _pid_driver_.get()->process(ptd_);
+      worker_.PID->process(ptd_, pid_);
 
       DT_LOG_TRACE(get_logging_priority(), "Exiting.");
       return;
     }
 
-    void topology_module::_process(const snemo::datamodel::particle_track_data & ptd_,
+    void topology_module::_prepare_process(worker_drivers & worker_,
+                                           const snemo::datamodel::particle_track_data & ptd_,
+                                           snemo::datamodel::pid_data & pid_)
+    {
+      DT_LOG_TRACE(get_logging_priority(), "Entering...");
+
+      // Process the particle identification driver :
+      worker_.PID->identify(ptd_, pid_);
+
+      DT_LOG_TRACE(get_logging_priority(), "Exiting.");
+      return;
+    }
+
+    void topology_module::_process(worker_drivers & worker_,
+                                   const snemo::datamodel::particle_track_data & ptd_,
+                                   const snemo::datamodel::pid_data & pid_,
                                    snemo::datamodel::topology_data & td_ )
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
       // Process the topology driver i.e. TOF, angle meas... :
-      _topology_driver_.get()->process(ptd_,td_);
+      worker_.TD->process(ptd_, pid_, td_);
+
+      // Deferred measurements are computed when the pattern is read or
+      // stored. They rely on the drivers of this worker which, with several
+      // workers, may process another event concurrently as soon as it is
+      // released: they are then computed before leaving the worker
+      if (_workers_.size() > 1 && td_.has_pattern()) {
+        td_.grab_pattern().compute_pending_measurements();
+      }
 
       DT_LOG_TRACE(get_logging_priority(), "Exiting.");
       return;
@@ -214,6 +473,45 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::topology_module, ocd_)
                    );
   }
 
+  {
+    // Description of the 'PID_label' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("PID_label")
+      .set_terse_description("The label/name of the 'PID data' bank")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(false)
+      .set_long_description("This is the name of the bank where the particle types   \n"
+                            "and counters identified by the PID driver are stored    \n"
+                            "(see ``store_PID``).                                    \n")
+      .set_default_value_string("PID")
+      .add_example("Use an alternative name for the 'PID data' bank:: \n"
+                   "                                                  \n"
+                   "  PID_label : string = \"PID2\"                   \n"
+                   "                                                  \n"
+                   );
+  }
+
+  {
+    // Description of the 'store_PID' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("store_PID")
+      .set_terse_description("Flag to store the 'PID data' bank")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("The particle types and counters identified by the PID driver \n"
+                            "are stored in the 'PID data' bank. Otherwise, they are only  \n"
+                            "exported within the particle tracks, which then requires     \n"
+                            "``PID.export_labels`` not to be disabled.                    \n")
+      .set_default_value_boolean(false)
+      .add_example("Store the 'PID data' bank::  \n"
+                   "                             \n"
+                   "  store_PID : boolean = true \n"
+                   "                             \n"
+                   );
+  }
+
   {
     // Description of the 'TD_label' configuration property :
     datatools::configuration_property_description & cpd
@@ -232,6 +530,66 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::topology_module, ocd_)
                    );
   }
 
+  {
+    // Description of the 'CI_label' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("CI_label")
+      .set_terse_description("The label/name of the calorimeter index service")
+      .set_traits(datatools::TYPE_STRING)
+      .set_mandatory(false)
+      .set_long_description("When set, the TOF driver matches calorimeter blocks through \n"
+                            "their dense index instead of comparing geom_ids.             \n")
+      .add_example("Use the calorimeter index service:: \n"
+                   "                                    \n"
+                   "  CI_label : string = \"CI\"         \n"
+                   "                                    \n"
+                   );
+  }
+
+  {
+    // Description of the 'concurrency.workers' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("concurrency.workers")
+      .set_terse_description("The number of events that can be processed concurrently")
+      .set_traits(datatools::TYPE_INTEGER)
+      .set_mandatory(false)
+      .set_long_description("Each worker holds its own copy of the particle identification \n"
+                            "and topology drivers. With several workers, each one also     \n"
+                            "instantiates its own PID cuts from the cut definitions of the \n"
+                            "cut service, so that PID cuts are evaluated concurrently.     \n")
+      .set_default_value_integer(1)
+      .add_example("Allow 4 events to be processed concurrently:: \n"
+                   "                                              \n"
+                   "  concurrency.workers : integer = 4           \n"
+                   "                                              \n"
+                   );
+  }
+
+  {
+    // Description of the 'measurements.restrict_to_cuts' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("measurements.restrict_to_cuts")
+      .set_terse_description("Flag to compute only the measurements consumed by the channel cuts")
+      .set_traits(datatools::TYPE_BOOLEAN)
+      .set_mandatory(false)
+      .set_long_description("The channels of the cut service ('multi_and' cuts combining a     \n"
+                            "classification cut with channel cuts) are analysed at            \n"
+                            "initialization and, for each topology selected by a channel, only \n"
+                            "the measurements referenced by its channel cuts are computed and  \n"
+                            "stored. Topologies not selected by any channel, or selected by a  \n"
+                            "channel without channel cut, still get every measurement. Jobs    \n"
+                            "storing the topology data for later use should disable it.        \n")
+      .set_default_value_boolean(true)
+      .add_example("Compute every measurement::                            \n"
+                   "                                                       \n"
+                   "  measurements.restrict_to_cuts : boolean = false      \n"
+                   "                                                       \n"
+                   );
+  }
+
   {
     datatools::configuration_property_description & cpd = ocd_.add_configuration_property_info();
     cpd.set_name_pattern("drivers")
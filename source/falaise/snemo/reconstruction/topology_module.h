@@ -33,9 +33,18 @@
 #ifndef FALAISE_TOPOLOGY_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_MODULE_H
 #define FALAISE_TOPOLOGY_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_MODULE_H 1
 
+// Standard library:
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+
 // Third party:
 // - Boost:
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 // - Bayeux/dpp :
 #include <dpp/base_module.h>
 
@@ -43,10 +52,15 @@ namespace geomtools {
   class manager;
 }
 
+namespace cuts {
+  class cut_manager;
+}
+
 namespace snemo {
 
   namespace datamodel {
     class particle_track_data;
+    class pid_data;
     class topology_data;
   }
 
@@ -78,25 +92,65 @@ namespace snemo {
       /// Data record processing
       virtual process_status process(datatools::things & data_);
 
+      /// Return the number of workers able to process events concurrently
+      size_t get_number_of_workers() const;
+
     protected:
 
+      /// \brief Set of drivers owned by a worker
+      struct worker_drivers {
+        boost::scoped_ptr<cuts::cut_manager> cuts;                                    //!< Private PID cuts (concurrent workers only)
+        boost::scoped_ptr<snemo::reconstruction::particle_identification_driver> PID; //!< Handle to the pid driver
+        boost::scoped_ptr<snemo::reconstruction::topology_driver> TD;                 //!< Handle to the topology driver
+      };
+
       /// Give default values to specific class members.
       void _set_defaults();
 
-      /// Prepare data for processing
-      void _prepare_process(snemo::datamodel::particle_track_data & ptd_);
+      /// Acquire an idle worker (wait for one if all are busy)
+      size_t _acquire_worker();
+
+      /// Release a worker
+      void _release_worker(const size_t worker_);
+
+      /// Typedef for measurement labels per topology label
+      typedef std::map<std::string, std::set<std::string> > measurement_demand_type;
+
+      /// Create a private cut manager declaring the same cuts as a shared one
+      void _clone_cut_manager(cuts::cut_manager & shared_,
+                              boost::scoped_ptr<cuts::cut_manager> & clone_) const;
+
+      /// Collect the measurement labels consumed by the channel cuts of each topology
+      void _analyse_measurement_demand(const cuts::cut_manager & cut_manager_,
+                                       measurement_demand_type & demand_) const;
+
+      /// Prepare data for processing, PID labels being exported within particle tracks
+      void _prepare_process(worker_drivers & worker_,
+                            snemo::datamodel::particle_track_data & ptd_,
+                            snemo::datamodel::pid_data & pid_);
+
+      /// Prepare data for processing, particle tracks being left untouched
+      void _prepare_process(worker_drivers & worker_,
+                            const snemo::datamodel::particle_track_data & ptd_,
+                            snemo::datamodel::pid_data & pid_);
 
       /// Special method to process and generate particle track data
-      void _process(const snemo::datamodel::particle_track_data & ptd_,
+      void _process(worker_drivers & worker_,
+                    const snemo::datamodel::particle_track_data & ptd_,
+                    const snemo::datamodel::pid_data & pid_,
                     snemo::datamodel::topology_data & td_);
 
     private:
 
       std::string _PTD_label_; //!< The label of the input data bank
+      std::string _PID_label_; //!< The label of the PID data bank
+      bool _store_PID_;        //!< Flag to store the PID data bank
       std::string _TD_label_;  //!< The label of the output data bank
 
-      boost::scoped_ptr<snemo::reconstruction::particle_identification_driver> _pid_driver_; //!< Handle to the pid driver with dynamic memory auto-deletion
-      boost::scoped_ptr<snemo::reconstruction::topology_driver> _topology_driver_;           //!< Handle to the topology driver with dynamic memory auto-deletion
+      std::vector<boost::shared_ptr<worker_drivers> > _workers_; //!< Per-worker drivers
+      std::vector<size_t> _idle_workers_;                        //!< Indexes of the idle workers
+      std::mutex _workers_mutex_;                                //!< Mutex protecting the idle workers
+      std::condition_variable _worker_released_;                 //!< Signal a worker has been released
 
       // Macro to automate the registration of the module :
       DPP_MODULE_REGISTRATION_INTERFACE(topology_module)
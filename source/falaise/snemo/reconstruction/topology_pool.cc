@@ -0,0 +1,74 @@
+/** \file falaise/snemo/reconstruction/topology_pool.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/topology_pool.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    topology_pool::topology_pool()
+    {
+      return;
+    }
+
+    topology_pool::~topology_pool()
+    {
+      clear();
+      return;
+    }
+
+    void topology_pool::recycle()
+    {
+      std::vector<pattern_handle_type>::iterator last = _used_patterns_.begin();
+      for (std::vector<pattern_handle_type>::iterator
+             ipattern = _used_patterns_.begin();
+           ipattern != _used_patterns_.end(); ++ipattern) {
+        if (! ipattern->unique()) {
+          // Pattern still referenced outside of the pool
+          *last++ = *ipattern;
+          continue;
+        }
+        snemo::datamodel::base_topology_pattern & a_pattern = ipattern->grab();
+        snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
+          = a_pattern.grab_measurement_dictionary();
+        for (snemo::datamodel::base_topology_pattern::measurement_dict_type::iterator
+               imeas = meas.begin(); imeas != meas.end(); ++imeas) {
+          measurement_handle_type & h = imeas->second;
+          if (! h.has_data() || ! h.unique()) continue;
+          snemo::datamodel::base_topology_measurement & a_meas = h.grab();
+          a_meas.clear();
+          _free_measurements_[std::type_index(typeid(a_meas))].push_back(h);
+        }
+        a_pattern.clear();
+        _free_patterns_[std::type_index(typeid(a_pattern))].push_back(*ipattern);
+      }
+      _used_patterns_.erase(last, _used_patterns_.end());
+      return;
+    }
+
+    size_t topology_pool::get_number_of_used_patterns() const
+    {
+      return _used_patterns_.size();
+    }
+
+    void topology_pool::clear()
+    {
+      _used_patterns_.clear();
+      _free_patterns_.clear();
+      _free_measurements_.clear();
+      return;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
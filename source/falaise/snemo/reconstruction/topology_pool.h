@@ -0,0 +1,113 @@
+/// \file falaise/snemo/reconstruction/topology_pool.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: A pool of recyclable topology patterns and measurements
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_TOPOLOGY_POOL_H
+#define FALAISE_SNEMO_RECONSTRUCTION_TOPOLOGY_POOL_H 1
+
+// Standard library:
+#include <map>
+#include <vector>
+#include <typeindex>
+#include <typeinfo>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Pool of topology patterns and measurements
+    ///
+    /// Objects handed out by the pool stay referenced by it. Once a pattern is
+    /// no longer referenced anywhere else (typically when the topology data bank
+    /// has been reset), the pattern and the measurements it holds are cleared
+    /// and kept aside, keyed by their concrete type, to be reused by the next
+    /// events instead of being freed and reallocated.
+    class topology_pool
+    {
+    public:
+
+      /// Typedef to pattern handle
+      typedef snemo::datamodel::base_topology_pattern::handle_type pattern_handle_type;
+
+      /// Typedef to measurement handle
+      typedef snemo::datamodel::base_topology_pattern::handle_measurement measurement_handle_type;
+
+      /// Constructor
+      topology_pool();
+
+      /// Destructor
+      ~topology_pool();
+
+      /// Return a recycled or a newly allocated pattern of type T
+      template<class T>
+      pattern_handle_type create_pattern()
+      {
+        pattern_handle_type h;
+        std::vector<pattern_handle_type> & free_patterns = _free_patterns_[std::type_index(typeid(T))];
+        if (free_patterns.empty()) {
+          h.reset(new T);
+        } else {
+          h = free_patterns.back();
+          free_patterns.pop_back();
+        }
+        _used_patterns_.push_back(h);
+        return h;
+      }
+
+      /// Attach a recycled or a newly allocated measurement of type T to the handle
+      template<class T>
+      T & create_measurement(measurement_handle_type & handle_)
+      {
+        std::vector<measurement_handle_type> & free_measurements
+          = _free_measurements_[std::type_index(typeid(T))];
+        if (free_measurements.empty()) {
+          T * ptr = new T;
+          handle_.reset(ptr);
+          return *ptr;
+        }
+        handle_ = free_measurements.back();
+        free_measurements.pop_back();
+        return static_cast<T &>(handle_.grab());
+      }
+
+      /// Reclaim the patterns and measurements which are not referenced anymore
+      void recycle();
+
+      /// Return the number of patterns currently in use
+      size_t get_number_of_used_patterns() const;
+
+      /// Release all the pooled objects
+      void clear();
+
+    private:
+
+      /// Typedef to free pattern lists per pattern type
+      typedef std::map<std::type_index, std::vector<pattern_handle_type> > pattern_free_list_type;
+
+      /// Typedef to free measurement lists per measurement type
+      typedef std::map<std::type_index, std::vector<measurement_handle_type> > measurement_free_list_type;
+
+      std::vector<pattern_handle_type> _used_patterns_;  //!< Patterns handed out
+      pattern_free_list_type _free_patterns_;            //!< Cleared patterns ready for reuse
+      measurement_free_list_type _free_measurements_;    //!< Cleared measurements ready for reuse
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_TOPOLOGY_POOL_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -8,8 +8,6 @@
 #include <sstream>
 
 // Third party:
-//- GSL:
-#include <gsl/gsl_cdf.h>
 // - Bayeux/geomtools:
 #include <bayeux/geomtools/blur_spot.h>
 
@@ -17,6 +15,8 @@
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
+#include <falaise/snemo/reconstruction/vertex_matrix.h>
 
 namespace snemo {
 
@@ -71,6 +71,7 @@ namespace snemo {
 
       _initialized_ = false;
       _logging_priority_ = datatools::logger::PRIO_WARNING;
+      _chi2_probability_.set_method(chi2_probability::METHOD_GSL);
       return;
     }
 
@@ -85,6 +86,11 @@ namespace snemo {
                   "Invalid logging priority level !");
       set_logging_priority(lp);
 
+      // Chi-square probabilities
+      if (setup_.has_key("chi2_probability.method")) {
+        _chi2_probability_.set_method(chi2_probability::method_from_label(setup_.fetch_string("chi2_probability.method")));
+      }
+
       _set_initialized(true);
       return;
     }
@@ -99,8 +105,7 @@ namespace snemo {
     void vertex_driver::process(const snemo::datamodel::particle_track & pt_,
                                 snemo::datamodel::vertex_measurement & vertex_)
     {
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
-      this->_process_algo(pt_, vertex_);
+      process(pt_, snemo::datamodel::pid_utils::fetch_particle_type(pt_), vertex_);
       return;
     }
 
@@ -108,17 +113,75 @@ namespace snemo {
                                 const snemo::datamodel::particle_track & pt2_,
                                 snemo::datamodel::vertex_measurement & vertex_)
     {
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
-      this->_process_algo(pt1_, pt2_, vertex_);
+      process(pt1_, snemo::datamodel::pid_utils::fetch_particle_type(pt1_),
+              pt2_, snemo::datamodel::pid_utils::fetch_particle_type(pt2_), vertex_);
+      return;
+    }
+
+    void vertex_driver::process(const snemo::datamodel::particle_track & pt_,
+                                const snemo::datamodel::pid_utils::particle_type type_,
+                                snemo::datamodel::vertex_measurement & vertex_)
+    {
+      kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(type_, 1), pt_);
+      process(kc.get(0), vertex_);
+      return;
+    }
+
+    void vertex_driver::process(const snemo::datamodel::particle_track & pt1_,
+                                const snemo::datamodel::pid_utils::particle_type type1_,
+                                const snemo::datamodel::particle_track & pt2_,
+                                const snemo::datamodel::pid_utils::particle_type type2_,
+                                snemo::datamodel::vertex_measurement & vertex_)
+    {
+      kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(type1_, 1), pt1_);
+      kc.add(snemo::datamodel::particle_slot(type2_, 2), pt2_);
+      process(kc.get(0), kc.get(1), vertex_);
+      return;
+    }
+
+    void vertex_driver::process(const particle_kinematics & k_,
+                                snemo::datamodel::vertex_measurement & vertex_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(k_, vertex_);
+      return;
+    }
+
+    void vertex_driver::process(const particle_kinematics & k1_,
+                                const particle_kinematics & k2_,
+                                snemo::datamodel::vertex_measurement & vertex_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(k1_, k2_, vertex_);
       return;
     }
 
-    void vertex_driver::_process_algo(const snemo::datamodel::particle_track & pt_,
+    void vertex_driver::process(const topology_event_view & view_,
+                                vertex_matrix & matrix_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(view_, matrix_);
+      return;
+    }
+
+    void vertex_driver::process(const vertex_matrix & matrix_,
+                                const particle_kinematics & k1_,
+                                const particle_kinematics & k2_,
+                                snemo::datamodel::vertex_measurement & vertex_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_algo(matrix_, k1_, k2_, vertex_);
+      return;
+    }
+
+    void vertex_driver::_process_algo(const particle_kinematics & k_,
                                       snemo::datamodel::vertex_measurement & vertex_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt_)) {
+      if (k_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
         DT_LOG_WARNING(get_logging_priority(),
                        "Vertex measurement cannot be computed if the particle is a gamma!");
         return;
@@ -126,47 +189,29 @@ namespace snemo {
 
       geomtools::blur_spot & a_spot = vertex_.grab_vertex();
 
-      const snemo::datamodel::particle_track::vertex_collection_type & the_vertices
-        = pt_.get_vertices();
-
-      snemo::datamodel::particle_track::vertex_collection_type::const_iterator last_vtx = the_vertices.end();
-      --last_vtx;
-
-      std::string location;
-      for (snemo::datamodel::particle_track::vertex_collection_type::const_iterator
-             ivtx = the_vertices.begin();
-           ivtx != the_vertices.end(); ++ivtx) {
-
-        const geomtools::blur_spot & vtx = ivtx->get();
-
-        //This way, the case where two vertices are on the same calorimeter hit is supported
-        if(vtx.get_geom_id() == pt_.get_associated_calorimeter_hits().front().get().get_geom_id() && ivtx != last_vtx) {
-          continue;
-        }
+      // Take the first vertex different from the calorimeter hit (cached
+      // with the particle kinematics) or, if every vertex is on the
+      // calorimeter hit, the last one
+      const topology_event_view & a_view = *k_.view;
+      const size_t first_vertex = a_view.get_vertex_offsets()[k_.particle];
+      const size_t last_vertex = a_view.get_vertex_offsets()[k_.particle + 1];
+      const geomtools::blur_spot * a_vertex = k_.origin_vertex;
+      topology_event_view::vertex_location_type a_location = k_.origin_location;
+      if (a_vertex == 0 && first_vertex != last_vertex) {
+        a_vertex = a_view.get_vertices()[last_vertex - 1];
+        a_location = a_view.get_vertex_locations()[last_vertex - 1];
+      }
 
-        a_spot.set_position(vtx.get_position());
-
-        if(snemo::datamodel::particle_track::vertex_is_on_source_foil(vtx))
-          location = snemo::datamodel::particle_track::vertex_on_source_foil_label();
-        else if(snemo::datamodel::particle_track::vertex_is_on_wire(vtx))
-          location = snemo::datamodel::particle_track::vertex_on_wire_label();
-        else if(snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vtx))
-          location = snemo::datamodel::particle_track::vertex_on_main_calorimeter_label();
-        else if(snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vtx))
-          location = snemo::datamodel::particle_track::vertex_on_x_calorimeter_label();
-        else if(snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vtx))
-          location = snemo::datamodel::particle_track::vertex_on_gamma_veto_label();
-        else {
-          location = snemo::datamodel::particle_track::vertex_none_label();
+      vertex_.set_location(snemo::datamodel::vertex_measurement::LOCATION_NONE);
+      if (a_vertex != 0) {
+        a_spot.set_position(a_vertex->get_position());
+        vertex_.set_location(topology_event_view::to_measurement_location(a_location));
+        if (a_location == topology_event_view::VERTEX_NONE) {
           DT_LOG_WARNING(get_logging_priority(),
                          "Single particle vertex location is different from any of the available locations !");
         }
-
-        break; // Stop at the first (and supposedly only vertex different from the calorimeter hit)
       }
 
-      a_spot.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(), location);
-
       //Always three dimensions vertices at the moment
       a_spot.set_blur_dimension(3);
       vertex_.set_probability(1);
@@ -179,87 +224,130 @@ namespace snemo {
       return;
     }
 
-    void vertex_driver::_process_algo(const snemo::datamodel::particle_track & pt1_,
-                                      const snemo::datamodel::particle_track & pt2_,
+    void vertex_driver::_process_algo(const particle_kinematics & k1_,
+                                      const particle_kinematics & k2_,
                                       snemo::datamodel::vertex_measurement & vertex_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ||
-          snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
+      if (k1_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA ||
+          k2_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
         DT_LOG_WARNING(get_logging_priority(),
                        "Vertex measurement cannot be computed if one particle is a gamma!");
         return;
       }
 
-      auto have_same_origin = [] (const geomtools::blur_spot & vtx1_,
-                                  const geomtools::blur_spot & vtx2_) -> bool
-        {
-          if (snemo::datamodel::particle_track::vertex_is_on_source_foil(vtx1_) &&
-              snemo::datamodel::particle_track::vertex_is_on_source_foil(vtx2_)) {
-            return true;
-          }
-          if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vtx1_) &&
-              snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vtx2_)) {
-            return true;
-          }
-          if (snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vtx1_) &&
-              snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vtx2_)) {
-            return true;
-          }
-          if (snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vtx1_) &&
-              snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vtx2_)) {
-            return true;
-          }
-          if (snemo::datamodel::particle_track::vertex_is_on_wire(vtx1_) &&
-              snemo::datamodel::particle_track::vertex_is_on_wire(vtx2_)) {
-            return true;
-          }
-          return false;
-        };
-
-      const snemo::datamodel::particle_track::vertex_collection_type & the_vertices_1
-        = pt1_.get_vertices();
-      const snemo::datamodel::particle_track::vertex_collection_type & the_vertices_2
-        = pt2_.get_vertices();
+      // Vertices come from the same origin if they share a known location
+      // and, on calorimeters, the same block (same buckets as the vertex matrix)
+      const topology_event_view & a_view = *k1_.view;
+      DT_THROW_IF(k2_.view != k1_.view, std::logic_error, "Particles belong to different event views !");
+      const std::vector<topology_event_view::vertex_location_type> & the_locations
+        = a_view.get_vertex_locations();
+      const std::vector<size_t> & the_indexes = a_view.get_vertex_calorimeter_indexes();
+      const std::vector<const geomtools::blur_spot *> & the_vertices = a_view.get_vertices();
+      const size_t first_vertex_1 = a_view.get_vertex_offsets()[k1_.particle];
+      const size_t last_vertex_1 = a_view.get_vertex_offsets()[k1_.particle + 1];
+      const size_t first_vertex_2 = a_view.get_vertex_offsets()[k2_.particle];
+      const size_t last_vertex_2 = a_view.get_vertex_offsets()[k2_.particle + 1];
       bool no_common_vertex = true;
-      for (snemo::datamodel::particle_track::vertex_collection_type::const_iterator
-             ivtx1 = the_vertices_1.begin();
-           ivtx1 != the_vertices_1.end(); ++ivtx1) {
-        for (snemo::datamodel::particle_track::vertex_collection_type::const_iterator
-               ivtx2 = the_vertices_2.begin();
-             ivtx2 != the_vertices_2.end(); ++ivtx2) {
-          const geomtools::blur_spot & vtx1 = ivtx1->get();
-          const geomtools::blur_spot & vtx2 = ivtx2->get();
-
-          if (! have_same_origin(vtx1, vtx2)) {
+      for (size_t ivtx1 = first_vertex_1; ivtx1 < last_vertex_1; ++ivtx1) {
+        const topology_event_view::vertex_location_type location1 = the_locations[ivtx1];
+        if (location1 == topology_event_view::VERTEX_NONE) continue;
+        const vertex_matrix::bucket_key_type key1 = vertex_matrix::make_bucket_key(location1, the_indexes[ivtx1]);
+        for (size_t ivtx2 = first_vertex_2; ivtx2 < last_vertex_2; ++ivtx2) {
+          if (vertex_matrix::make_bucket_key(the_locations[ivtx2], the_indexes[ivtx2]) != key1) {
             DT_LOG_TRACE(get_logging_priority(), "Vertices do not come from the same origin !");
             continue;
           }
           no_common_vertex = false;
           // vertex_ is updated only if the probability is better
-          _find_common_vertex(vtx1, vtx2, vertex_);
+          _find_common_vertex(*the_vertices[ivtx1], *the_vertices[ivtx2], location1, vertex_);
         }
       }
 
       if(no_common_vertex) {
-        vertex_.set_probability(0);
-        geomtools::blur_spot & a_spot = vertex_.grab_vertex();
-        a_spot.set_blur_dimension(3);
-        const double epsilon = 1e-13;
-        a_spot.set_errors(epsilon,epsilon,epsilon);
-        a_spot.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(),
-                                         snemo::datamodel::particle_track::vertex_none_label());
+        _set_no_common_vertex(vertex_);
       }
 
       DT_LOG_TRACE(get_logging_priority(), "Exiting...");
       return;
     }
 
-    void vertex_driver::_find_common_vertex(const geomtools::blur_spot & vtx1_,
-                                            const geomtools::blur_spot & vtx2_,
-                                            snemo::datamodel::vertex_measurement & vertex_)
+    void vertex_driver::_process_algo(const topology_event_view & view_,
+                                      vertex_matrix & matrix_)
+    {
+      DT_LOG_TRACE(get_logging_priority(), "Entering...");
 
+      // Only vertices of the same bucket are compared
+      matrix_.build(view_);
+      const std::vector<const geomtools::blur_spot *> & the_vertices = view_.get_vertices();
+      const std::vector<size_t> & the_offsets = matrix_.get_bucket_offsets();
+      const std::vector<size_t> & the_bucket_vertices = matrix_.get_bucket_vertices();
+      const std::vector<size_t> & the_bucket_particles = matrix_.get_bucket_particles();
+      geomtools::vector_3d barycenter;
+      for (size_t ibucket = 0; ibucket < matrix_.get_number_of_buckets(); ++ibucket) {
+        for (size_t i = the_offsets[ibucket]; i < the_offsets[ibucket + 1]; ++i) {
+          for (size_t j = i + 1; j < the_offsets[ibucket + 1]; ++j) {
+            if (the_bucket_particles[i] == the_bucket_particles[j]) continue;
+            const double probability = _compute_common_vertex(*the_vertices[the_bucket_vertices[i]],
+                                                              *the_vertices[the_bucket_vertices[j]],
+                                                              barycenter);
+            matrix_.update(the_bucket_particles[i], the_bucket_vertices[i],
+                           the_bucket_particles[j], the_bucket_vertices[j], probability);
+          }
+        }
+      }
+      DT_LOG_DEBUG(get_logging_priority(), matrix_.get_number_of_buckets() << " vertex buckets for "
+                   << matrix_.get_bucket_vertices().size() << " vertices");
+
+      DT_LOG_TRACE(get_logging_priority(), "Exiting...");
+      return;
+    }
+
+    void vertex_driver::_process_algo(const vertex_matrix & matrix_,
+                                      const particle_kinematics & k1_,
+                                      const particle_kinematics & k2_,
+                                      snemo::datamodel::vertex_measurement & vertex_)
+    {
+      DT_LOG_TRACE(get_logging_priority(), "Entering...");
+
+      if (k1_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA ||
+          k2_.type == snemo::datamodel::pid_utils::PARTICLE_GAMMA) {
+        DT_LOG_WARNING(get_logging_priority(),
+                       "Vertex measurement cannot be computed if one particle is a gamma!");
+        return;
+      }
+      DT_THROW_IF(k1_.view != &matrix_.get_view() || k2_.view != &matrix_.get_view(), std::logic_error,
+                  "Particles do not belong to the event view of the vertex matrix !");
+
+      const vertex_matrix::entry_type an_entry = matrix_.get(k1_.particle, k2_.particle);
+      if (! an_entry.shared_bucket) {
+        DT_LOG_TRACE(get_logging_priority(), "Vertices do not come from the same origin !");
+        _set_no_common_vertex(vertex_);
+      } else if (an_entry.vertex1 != vertex_matrix::INVALID_VERTEX) {
+        const topology_event_view & a_view = matrix_.get_view();
+        _find_common_vertex(*a_view.get_vertices()[an_entry.vertex1], *a_view.get_vertices()[an_entry.vertex2],
+                            a_view.get_vertex_locations()[an_entry.vertex1], vertex_);
+      }
+
+      DT_LOG_TRACE(get_logging_priority(), "Exiting...");
+      return;
+    }
+
+    void vertex_driver::_set_no_common_vertex(snemo::datamodel::vertex_measurement & vertex_) const
+    {
+      vertex_.set_probability(0);
+      geomtools::blur_spot & a_spot = vertex_.grab_vertex();
+      a_spot.set_blur_dimension(3);
+      const double epsilon = 1e-13;
+      a_spot.set_errors(epsilon,epsilon,epsilon);
+      vertex_.set_location(snemo::datamodel::vertex_measurement::LOCATION_NONE);
+      return;
+    }
+
+    double vertex_driver::_compute_common_vertex(const geomtools::blur_spot & vtx1_,
+                                                 const geomtools::blur_spot & vtx2_,
+                                                 geomtools::vector_3d & barycenter_) const
     {
       DT_THROW_IF(vtx1_.get_blur_dimension() != vtx2_.get_blur_dimension(),
                   std::logic_error, "Blur dimensions are differents !");
@@ -283,12 +371,13 @@ namespace snemo {
       const geomtools::vector_3d & pos2 = vtx2_.get_position();
       if (! geomtools::is_valid(pos1) || ! geomtools::is_valid(pos2)) {
         DT_LOG_DEBUG(get_logging_priority(), "Vertex position is invalid !");
-        return;
+        return datatools::invalid_real();
       }
 
       const double sigma1 = sigma(vtx1_);
       const double sigma2 = sigma(vtx2_);
       const geomtools::vector_3d bary = (pos1/sigma1 + pos2/sigma2)/(1/sigma1 + 1/sigma2);
+      barycenter_ = bary;
 
       const double sigma1_x = vtx1_.get_x_error();
       const double sigma1_y = vtx1_.get_y_error();
@@ -301,9 +390,22 @@ namespace snemo {
       const double chi2_y = (std::pow(bary.y()-pos1.y(),2) + std::pow(bary.y()-pos2.y(),2))/(sigma1_y*sigma1_y + sigma2_y*sigma2_y);
       const double chi2_z = (std::pow(bary.z()-pos1.z(),2) + std::pow(bary.z()-pos2.z(),2))/(sigma1_z*sigma1_z + sigma2_z*sigma2_z);
 
-      const double probability = gsl_cdf_chisq_Q(chi2_x+chi2_y+chi2_z, 1);
+      return _chi2_probability_.survival(chi2_x+chi2_y+chi2_z, 1);
+    }
+
+    void vertex_driver::_find_common_vertex(const geomtools::blur_spot & vtx1_,
+                                            const geomtools::blur_spot & vtx2_,
+                                            const topology_event_view::vertex_location_type location_,
+                                            snemo::datamodel::vertex_measurement & vertex_)
+
+    {
+      geomtools::vector_3d bary;
+      const double probability = _compute_common_vertex(vtx1_, vtx2_, bary);
+      if (! datatools::is_valid(probability)) return;
 
       if (! vertex_.has_probability() || vertex_.get_probability() < probability) {
+        const geomtools::vector_3d & pos1 = vtx1_.get_position();
+        const geomtools::vector_3d & pos2 = vtx2_.get_position();
         // Update vertex value
         vertex_.set_probability(probability);
         geomtools::blur_spot & a_spot = vertex_.grab_vertex();
@@ -318,24 +420,11 @@ namespace snemo {
         const double dz = std::abs(pos1.z()-pos2.z());
         a_spot.set_z_error(dz < epsilon ? epsilon : dz);
 
-        std::string location;
-        if(snemo::datamodel::particle_track::vertex_is_on_source_foil(vtx1_))
-          location = snemo::datamodel::particle_track::vertex_on_source_foil_label();
-        else if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vtx1_))
-          location = snemo::datamodel::particle_track::vertex_on_main_calorimeter_label();
-        else if (snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vtx1_))
-          location = snemo::datamodel::particle_track::vertex_on_x_calorimeter_label();
-        else if (snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vtx1_))
-          location = snemo::datamodel::particle_track::vertex_on_gamma_veto_label();
-        else if (snemo::datamodel::particle_track::vertex_is_on_wire(vtx1_))
-          location = snemo::datamodel::particle_track::vertex_on_wire_label();
-        else {
-          location = snemo::datamodel::particle_track::vertex_none_label();
+        // Location shared by both vertices, as cached in the event view
+        vertex_.set_location(topology_event_view::to_measurement_location(location_));
+        if (location_ == topology_event_view::VERTEX_NONE) {
           DT_LOG_WARNING(get_logging_priority(), "No valid vertex was found for the particle !");
         }
-
-        a_spot.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(), location);
-
       }
 
       return ;
@@ -346,6 +435,28 @@ namespace snemo {
     {
       // Prefix "VD" stands for "Vertex Driver" :
       datatools::logger::declare_ocd_logging_configuration(ocd_, "fatal", "VD.");
+
+      {
+        // Description of the 'chi2_probability.method' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("VD.chi2_probability.method")
+          .set_terse_description("The method computing the chi-square probabilities")
+          .set_traits(datatools::TYPE_STRING)
+          .set_mandatory(false)
+          .set_long_description("The vertex probability is the chi-square survival function \n"
+                                "of the vertices chi2 (one degree of freedom).              \n"
+                                "Possible values are : 'gsl' (reference), 'exact' (closed   \n"
+                                "form), 'fast' (approximation, absolute error < 1.5e-7) and \n"
+                                "'tabulated' (interpolation, absolute error < 1e-5).         \n")
+          .set_default_value_string("gsl")
+          .add_example("Use the closed form::                               \n"
+                       "                                                    \n"
+                       "  VD.chi2_probability.method : string = \"exact\"  \n"
+                       "                                                    \n"
+                       );
+      }
+      return;
     }
 
   } // end of namespace reconstruction
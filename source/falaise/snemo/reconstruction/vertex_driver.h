@@ -34,6 +34,13 @@
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/logger.h>
+// - Bayeux/geomtools:
+#include <bayeux/geomtools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+#include <falaise/snemo/reconstruction/topology_event_view.h>
 
 // Forward declaration
 namespace geomtools {
@@ -49,6 +56,9 @@ namespace snemo {
 
   namespace reconstruction {
 
+    struct particle_kinematics;
+    class vertex_matrix;
+
     /// Driver for the gamma clustering algorithms
     class vertex_driver
     {
@@ -78,6 +88,37 @@ namespace snemo {
                    const snemo::datamodel::particle_track & pt2_,
                    snemo::datamodel::vertex_measurement & vertex_);
 
+      /// Main process for single particle with particle type already identified
+      void process(const snemo::datamodel::particle_track & pt_,
+                   const snemo::datamodel::pid_utils::particle_type type_,
+                   snemo::datamodel::vertex_measurement & vertex_);
+
+      /// Main process for two particles with particle types already identified
+      void process(const snemo::datamodel::particle_track & pt1_,
+                   const snemo::datamodel::pid_utils::particle_type type1_,
+                   const snemo::datamodel::particle_track & pt2_,
+                   const snemo::datamodel::pid_utils::particle_type type2_,
+                   snemo::datamodel::vertex_measurement & vertex_);
+
+      /// Main process for single particle from the cached particle kinematics
+      void process(const particle_kinematics & k_,
+                   snemo::datamodel::vertex_measurement & vertex_);
+
+      /// Main process for two particles from the cached particle kinematics
+      void process(const particle_kinematics & k1_,
+                   const particle_kinematics & k2_,
+                   snemo::datamodel::vertex_measurement & vertex_);
+
+      /// Main process for the vertex compatibility of all the charged particles of an event
+      void process(const topology_event_view & view_,
+                   vertex_matrix & matrix_);
+
+      /// Main process for two particles from the vertex compatibility of the event
+      void process(const vertex_matrix & matrix_,
+                   const particle_kinematics & k1_,
+                   const particle_kinematics & k2_,
+                   snemo::datamodel::vertex_measurement & vertex_);
+
       /// Check if theclusterizer is initialized
       bool is_initialized() const;
 
@@ -99,22 +140,42 @@ namespace snemo {
       void _set_defaults();
 
       /// Special method to process and determine single particle vertex
-      void _process_algo(const snemo::datamodel::particle_track & pt_,
+      void _process_algo(const particle_kinematics & k_,
                          snemo::datamodel::vertex_measurement & vertex_);
 
       /// Special method to process and determine common vertex between particle tracks
-      void _process_algo(const snemo::datamodel::particle_track & pt1_,
-                         const snemo::datamodel::particle_track & pt2_,
+      void _process_algo(const particle_kinematics & k1_,
+                         const particle_kinematics & k2_,
                          snemo::datamodel::vertex_measurement & vertex_);
 
-      /// Find the common vertex between two vertices
+      /// Special method to compute the vertex compatibility of the charged particles of an event
+      void _process_algo(const topology_event_view & view_,
+                         vertex_matrix & matrix_);
+
+      /// Special method to determine common vertex between particle tracks from the vertex compatibility
+      void _process_algo(const vertex_matrix & matrix_,
+                         const particle_kinematics & k1_,
+                         const particle_kinematics & k2_,
+                         snemo::datamodel::vertex_measurement & vertex_);
+
+      /// Compute the barycenter of two vertices and return their common vertex probability (invalid if undefined)
+      double _compute_common_vertex(const geomtools::blur_spot & vtx1_,
+                                    const geomtools::blur_spot & vtx2_,
+                                    geomtools::vector_3d & barycenter_) const;
+
+      /// Mark the vertex measurement as having no common vertex
+      void _set_no_common_vertex(snemo::datamodel::vertex_measurement & vertex_) const;
+
+      /// Find the common vertex between two vertices sharing a location
       void _find_common_vertex(const geomtools::blur_spot & vtx1_,
                                const geomtools::blur_spot & vtx2_,
+                               const topology_event_view::vertex_location_type location_,
                                snemo::datamodel::vertex_measurement & vertex_);
 
     private:
       bool                        _initialized_;      //!< Initialization status
       datatools::logger::priority _logging_priority_; //!< Logging priority
+      chi2_probability            _chi2_probability_; //!< Chi-square probability method
     };
 
   }  // end of namespace reconstruction
@@ -0,0 +1,213 @@
+// falaise/snemo/reconstruction/vertex_matrix.cc
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/vertex_matrix.h>
+
+// Standard library:
+#include <algorithm>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    // static
+    vertex_matrix::bucket_key_type
+    vertex_matrix::make_bucket_key(const topology_event_view::vertex_location_type location_,
+                                   const size_t calorimeter_index_)
+    {
+      bucket_key_type cell = 0xFFFFFFFF;
+      if (topology_event_view::is_calorimeter_location(location_) &&
+          calorimeter_index_ != snemo::datamodel::calorimeter_index::INVALID_INDEX) {
+        cell = static_cast<bucket_key_type>(calorimeter_index_);
+      }
+      return (static_cast<bucket_key_type>(location_) << 32) | cell;
+    }
+
+    vertex_matrix::vertex_matrix()
+    {
+      _view_ = 0;
+      clear();
+      return;
+    }
+
+    vertex_matrix::~vertex_matrix()
+    {
+      return;
+    }
+
+    void vertex_matrix::clear()
+    {
+      _view_ = 0;
+      _number_of_particles_ = 0;
+      _sorted_.clear();
+      _bucket_offsets_.assign(1, 0);
+      _bucket_vertices_.clear();
+      _bucket_particles_.clear();
+      _entries_.clear();
+      return;
+    }
+
+    void vertex_matrix::build(const topology_event_view & view_)
+    {
+      clear();
+      _view_ = &view_;
+      _number_of_particles_ = view_.get_number_of_particles();
+      entry_type no_entry;
+      no_entry.shared_bucket = false;
+      no_entry.vertex1 = INVALID_VERTEX;
+      no_entry.vertex2 = INVALID_VERTEX;
+      no_entry.probability = datatools::invalid_real();
+      _entries_.assign(_number_of_particles_ * _number_of_particles_, no_entry);
+
+      // Vertices of charged particles with a known location
+      const std::vector<snemo::datamodel::pid_utils::particle_type> & the_types = view_.get_particle_types();
+      const std::vector<size_t> & the_offsets = view_.get_vertex_offsets();
+      const std::vector<topology_event_view::vertex_location_type> & the_locations
+        = view_.get_vertex_locations();
+      const std::vector<size_t> & the_indexes = view_.get_vertex_calorimeter_indexes();
+      for (size_t i_particle = 0; i_particle < _number_of_particles_; ++i_particle) {
+        if (the_types[i_particle] == snemo::datamodel::pid_utils::PARTICLE_GAMMA) continue;
+        for (size_t ivtx = the_offsets[i_particle]; ivtx < the_offsets[i_particle + 1]; ++ivtx) {
+          if (the_locations[ivtx] == topology_event_view::VERTEX_NONE) continue;
+          bucketed_vertex a_vertex;
+          a_vertex.key = make_bucket_key(the_locations[ivtx], the_indexes[ivtx]);
+          a_vertex.vertex = ivtx;
+          a_vertex.particle = i_particle;
+          _sorted_.push_back(a_vertex);
+        }
+      }
+
+      // Group the vertices by bucket
+      std::sort(_sorted_.begin(), _sorted_.end());
+      for (size_t i = 0; i < _sorted_.size(); ++i) {
+        if (i != 0 && _sorted_[i].key != _sorted_[i - 1].key) {
+          _bucket_offsets_.push_back(i);
+        }
+        _bucket_vertices_.push_back(_sorted_[i].vertex);
+        _bucket_particles_.push_back(_sorted_[i].particle);
+      }
+      if (! _sorted_.empty()) {
+        _bucket_offsets_.push_back(_sorted_.size());
+      }
+
+      // Pairs of particles sharing a bucket
+      for (size_t ibucket = 0; ibucket + 1 < _bucket_offsets_.size(); ++ibucket) {
+        for (size_t i = _bucket_offsets_[ibucket]; i < _bucket_offsets_[ibucket + 1]; ++i) {
+          for (size_t j = i + 1; j < _bucket_offsets_[ibucket + 1]; ++j) {
+            if (_bucket_particles_[i] == _bucket_particles_[j]) continue;
+            _grab_entry_(_bucket_particles_[i], _bucket_particles_[j]).shared_bucket = true;
+          }
+        }
+      }
+      return;
+    }
+
+    bool vertex_matrix::is_built() const
+    {
+      return _view_ != 0;
+    }
+
+    const topology_event_view & vertex_matrix::get_view() const
+    {
+      DT_THROW_IF(! is_built(), std::logic_error, "Vertex matrix has not been built !");
+      return *_view_;
+    }
+
+    size_t vertex_matrix::get_number_of_particles() const
+    {
+      return _number_of_particles_;
+    }
+
+    size_t vertex_matrix::get_number_of_buckets() const
+    {
+      return _bucket_offsets_.size() - 1;
+    }
+
+    const std::vector<size_t> & vertex_matrix::get_bucket_offsets() const
+    {
+      return _bucket_offsets_;
+    }
+
+    const std::vector<size_t> & vertex_matrix::get_bucket_vertices() const
+    {
+      return _bucket_vertices_;
+    }
+
+    const std::vector<size_t> & vertex_matrix::get_bucket_particles() const
+    {
+      return _bucket_particles_;
+    }
+
+    void vertex_matrix::update(const size_t particle1_, const size_t vertex1_,
+                               const size_t particle2_, const size_t vertex2_,
+                               const double probability_)
+    {
+      if (! datatools::is_valid(probability_)) return;
+      const bool ordered = particle1_ < particle2_;
+      const size_t vertex1 = ordered ? vertex1_ : vertex2_;
+      const size_t vertex2 = ordered ? vertex2_ : vertex1_;
+      entry_type & an_entry = _grab_entry_(particle1_, particle2_);
+      // Ties are given to the first vertices, as a loop over the vertices of
+      // the first particle then over the vertices of the second one would do
+      if (datatools::is_valid(an_entry.probability)) {
+        if (probability_ < an_entry.probability) return;
+        if (probability_ == an_entry.probability &&
+            (vertex1 > an_entry.vertex1 || (vertex1 == an_entry.vertex1 && vertex2 > an_entry.vertex2))) {
+          return;
+        }
+      }
+      an_entry.vertex1 = vertex1;
+      an_entry.vertex2 = vertex2;
+      an_entry.probability = probability_;
+      return;
+    }
+
+    vertex_matrix::entry_type vertex_matrix::get(const size_t particle1_, const size_t particle2_) const
+    {
+      DT_THROW_IF(particle1_ == particle2_ ||
+                  particle1_ >= _number_of_particles_ || particle2_ >= _number_of_particles_,
+                  std::range_error, "Invalid pair of particles (" << particle1_ << ", " << particle2_ << ") !");
+      const size_t first = std::min(particle1_, particle2_);
+      const size_t second = std::max(particle1_, particle2_);
+      entry_type an_entry = _entries_[first * _number_of_particles_ + second];
+      if (particle1_ > particle2_) {
+        std::swap(an_entry.vertex1, an_entry.vertex2);
+      }
+      return an_entry;
+    }
+
+    bool vertex_matrix::has_common_vertex(const size_t particle1_, const size_t particle2_) const
+    {
+      return datatools::is_valid(get(particle1_, particle2_).probability);
+    }
+
+    vertex_matrix::entry_type & vertex_matrix::_grab_entry_(const size_t particle1_, const size_t particle2_)
+    {
+      DT_THROW_IF(particle1_ == particle2_ ||
+                  particle1_ >= _number_of_particles_ || particle2_ >= _number_of_particles_,
+                  std::range_error, "Invalid pair of particles (" << particle1_ << ", " << particle2_ << ") !");
+      const size_t first = std::min(particle1_, particle2_);
+      const size_t second = std::max(particle1_, particle2_);
+      return _entries_[first * _number_of_particles_ + second];
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
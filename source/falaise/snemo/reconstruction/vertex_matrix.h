@@ -0,0 +1,143 @@
+/// \file falaise/snemo/reconstruction/vertex_matrix.h
+/* Creation date: 2026-10-18
+ * Last modified: 2026-10-18
+ *
+ * Description: Pairwise vertex compatibility of the particles of an event
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_VERTEX_MATRIX_H
+#define FALAISE_SNEMO_RECONSTRUCTION_VERTEX_MATRIX_H 1
+
+// Standard library:
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/cstdint.hpp>
+
+// This project:
+#include <falaise/snemo/reconstruction/topology_event_view.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Pairwise vertex compatibility of the particles of an event
+    ///
+    /// The vertices of the charged particles of an event view are bucketed
+    /// once by location and, on calorimeters, by calorimeter block (if the
+    /// event view has been given a dense calorimeter index): only two
+    /// vertices of the same bucket may be a common vertex. The pairwise
+    /// vertex measurement compares the bucket keys of the vertices as well,
+    /// so that both give the same result. The vertex driver then keeps, for
+    /// every pair of particles, the most probable common vertex of the
+    /// buckets they share. Source foil vertices are not split by foil strip
+    /// since a common vertex may lie on a strip boundary.
+    class vertex_matrix
+    {
+    public:
+
+      /// Typedef for the bucket key (vertex location and calorimeter block)
+      typedef boost::uint64_t bucket_key_type;
+
+      /// Invalid vertex
+      static const size_t INVALID_VERTEX = static_cast<size_t>(-1);
+
+      /// \brief Most probable common vertex of a pair of particles
+      struct entry_type
+      {
+        bool   shared_bucket; //!< At least one vertex of each particle in the same bucket
+        size_t vertex1;       //!< Vertex of the first particle (INVALID_VERTEX if none)
+        size_t vertex2;       //!< Vertex of the second particle (INVALID_VERTEX if none)
+        double probability;   //!< Common vertex probability (invalid if none)
+      };
+
+      /// Return the bucket key of a vertex
+      static bucket_key_type make_bucket_key(const topology_event_view::vertex_location_type location_,
+                                             const size_t calorimeter_index_);
+
+      /// Constructor
+      vertex_matrix();
+
+      /// Destructor
+      ~vertex_matrix();
+
+      /// Remove all the vertices (allocated storage is kept)
+      void clear();
+
+      /// Bucket the vertices of the charged particles of an event view and reset the entries
+      void build(const topology_event_view & view_);
+
+      /// Check if the matrix has been built
+      bool is_built() const;
+
+      /// Return the event view
+      const topology_event_view & get_view() const;
+
+      /// Return the number of particles
+      size_t get_number_of_particles() const;
+
+      /// Return the number of buckets
+      size_t get_number_of_buckets() const;
+
+      /// Return the first bucketed vertex of each bucket (one extra entry for the end)
+      const std::vector<size_t> & get_bucket_offsets() const;
+
+      /// Return the bucketed vertices, sorted by bucket then by vertex
+      const std::vector<size_t> & get_bucket_vertices() const;
+
+      /// Return the particles of the bucketed vertices
+      const std::vector<size_t> & get_bucket_particles() const;
+
+      /// Record a candidate common vertex, kept if more probable than the current one
+      void update(const size_t particle1_, const size_t vertex1_,
+                  const size_t particle2_, const size_t vertex2_,
+                  const double probability_);
+
+      /// Return the most probable common vertex of two particles (vertex1 belongs to particle1_)
+      entry_type get(const size_t particle1_, const size_t particle2_) const;
+
+      /// Check if two particles have a common vertex
+      bool has_common_vertex(const size_t particle1_, const size_t particle2_) const;
+
+    private:
+
+      /// \brief Bucketed vertex
+      struct bucketed_vertex
+      {
+        bucket_key_type key; //!< Bucket key
+        size_t vertex;       //!< Vertex
+        size_t particle;     //!< Particle of the vertex
+        bool operator<(const bucketed_vertex & other_) const
+        {
+          return key < other_.key || (key == other_.key && vertex < other_.vertex);
+        }
+      };
+
+      /// Return the entry of a pair of particles
+      entry_type & _grab_entry_(const size_t particle1_, const size_t particle2_);
+
+    private:
+
+      const topology_event_view * _view_;           //!< Event view
+      size_t _number_of_particles_;                 //!< Number of particles of the view
+      std::vector<bucketed_vertex> _sorted_;        //!< Bucketed vertices being sorted
+      std::vector<size_t> _bucket_offsets_;         //!< First bucketed vertex of each bucket
+      std::vector<size_t> _bucket_vertices_;        //!< Bucketed vertices
+      std::vector<size_t> _bucket_particles_;       //!< Particles of the bucketed vertices
+      std::vector<entry_type> _entries_;            //!< Entries of the pairs (first particle < second particle)
+    };
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_VERTEX_MATRIX_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
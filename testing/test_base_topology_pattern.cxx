@@ -9,6 +9,7 @@
 // This project:
 #include <falaise/snemo/datamodels/topology_2e_pattern.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
 
 int main()
 {
@@ -45,13 +46,76 @@ int main()
     };
     for (size_t i = 0; i < keys.size(); i++) {
       const std::string & a_key = keys.at(i);
+      const snemo::datamodel::measurement_matcher a_matcher(a_key);
       std::clog << "Topology pattern has ";
-      if (! a_pattern.has_measurement(a_key)) {
+      if (! a_pattern.has_matching_measurement(a_matcher)) {
         std::clog << "no ";
       }
       std::clog << "'" << a_key << "' measurement" << std::endl;
     }
 
+    // Exact lookup does not interpret regular expressions
+    DT_THROW_IF(! a_pattern.has_measurement("fake_tof_10"), std::logic_error, "Missing 'fake_tof_10' measurement !");
+    DT_THROW_IF(a_pattern.has_measurement("fake_tof_.?"), std::logic_error, "Label used as regular expression !");
+
+    // Deferred measurement computation :
+    {
+      size_t ncomputations = 0;
+      snemo::datamodel::tof_measurement & a_tof
+        = dynamic_cast<snemo::datamodel::tof_measurement &>(meas_dict["fake_tof_1"].grab());
+      a_pattern.set_pending_measurement("fake_tof_1", [&ncomputations, &a_tof]() {
+          a_tof.grab_internal_probabilities().push_back(0.5);
+          ncomputations++;
+        });
+      DT_THROW_IF(! a_pattern.has_pending_measurements(), std::logic_error, "Missing pending measurement !");
+      DT_THROW_IF(ncomputations != 0, std::logic_error, "Measurement computed too early !");
+      a_pattern.get_measurement_as<snemo::datamodel::tof_measurement>("fake_tof_1");
+      a_pattern.get_measurement("fake_tof_1");
+      DT_THROW_IF(ncomputations != 1, std::logic_error, "Measurement not computed once !");
+      DT_THROW_IF(a_pattern.has_pending_measurements(), std::logic_error, "Pending measurement left !");
+    }
+
+    // Reading the measurement dictionary computes pending measurements :
+    {
+      size_t ncomputations = 0;
+      snemo::datamodel::tof_measurement & a_tof
+        = dynamic_cast<snemo::datamodel::tof_measurement &>(meas_dict["fake_tof_2"].grab());
+      a_pattern.set_pending_measurement("fake_tof_2", [&ncomputations, &a_tof]() {
+          a_tof.grab_internal_probabilities().push_back(0.25);
+          ncomputations++;
+        });
+      const snemo::datamodel::base_topology_pattern & a_const_pattern = a_pattern;
+      const snemo::datamodel::base_topology_pattern::measurement_dict_type & a_dict
+        = a_const_pattern.get_measurement_dictionary();
+      DT_THROW_IF(ncomputations != 1, std::logic_error, "Measurement handed out before its computation !");
+      DT_THROW_IF(a_const_pattern.has_pending_measurements(), std::logic_error, "Pending measurement left !");
+      const snemo::datamodel::tof_measurement & a_read_tof
+        = dynamic_cast<const snemo::datamodel::tof_measurement &>(a_dict.find("fake_tof_2")->second.get());
+      DT_THROW_IF(a_read_tof.get_internal_probabilities().size() != 1, std::logic_error,
+                  "Missing computed probability !");
+    }
+
+    // Derived quantities of the electron pair :
+    {
+      const snemo::datamodel::topology_2e_pattern & a_2e
+        = dynamic_cast<const snemo::datamodel::topology_2e_pattern &>(a_pattern);
+      DT_THROW_IF(a_2e.has_electrons_energy(), std::logic_error, "Unexpected electron energies !");
+      snemo::datamodel::energy_measurement * e1 = new snemo::datamodel::energy_measurement;
+      e1->set_energy(1.5);
+      snemo::datamodel::energy_measurement * e2 = new snemo::datamodel::energy_measurement;
+      e2->set_energy(0.5);
+      // Grabbing the dictionary forgets the quantities computed so far
+      a_pattern.grab_measurement_dictionary().insert(std::make_pair("energy_e1", e1));
+      a_pattern.grab_measurement_dictionary().insert(std::make_pair("energy_e2", e2));
+      DT_THROW_IF(! a_2e.has_electrons_energy(), std::logic_error, "Missing electron energies !");
+      DT_THROW_IF(a_2e.get_electrons_energy_sum() != 2.0 || a_2e.get_electrons_energy_difference() != 1.0,
+                  std::logic_error, "Invalid electron energy sum or difference !");
+      DT_THROW_IF(a_2e.get_minimal_energy_electron_name() != "e2" || a_2e.get_maximal_energy_electron_name() != "e1",
+                  std::logic_error, "Invalid minimal/maximal energy electron names !");
+      DT_THROW_IF(a_2e.has_electrons_angle() || a_2e.get_electrons_summary().has_vertex(),
+                  std::logic_error, "Unexpected electron pair measurements !");
+    }
+
   } catch (std::exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
     error_code = EXIT_FAILURE;
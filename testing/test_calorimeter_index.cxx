@@ -0,0 +1,84 @@
+// test_calorimeter_index.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+#include <set>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+
+// This project:
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'calorimeter_index' class." << std::endl;
+
+    typedef snemo::datamodel::calorimeter_index ci_type;
+
+    // SuperNEMO demonstrator layout
+    ci_type CI;
+    CI.tree_dump(std::clog, "Calorimeter index:", "[notice]: ");
+    DT_THROW_IF(CI.size() != 520 + 128 + 64, std::logic_error, "Invalid number of blocks !");
+
+    // Every main calorimeter block has its own index whatever the part
+    std::set<size_t> indexes;
+    for (uint32_t side = 0; side < 2; ++side) {
+      for (uint32_t column = 0; column < 20; ++column) {
+        for (uint32_t row = 0; row < 13; ++row) {
+          const geomtools::geom_id gid(1302, 0, side, column, row, 1);
+          const size_t index = CI.get_index(gid);
+          DT_THROW_IF(index != CI.get_index(geomtools::geom_id(1302, 0, side, column, row, 0)),
+                      std::logic_error, "Part changes the index of " << gid << " !");
+          DT_THROW_IF(CI.get_category(index) != ci_type::CATEGORY_MAIN_CALORIMETER,
+                      std::logic_error, "Invalid category for " << gid << " !");
+          indexes.insert(index);
+        }
+      }
+    }
+    DT_THROW_IF(indexes.size() != 520, std::logic_error, "Main calorimeter indexes are not unique !");
+
+    const size_t xcalo = CI.get_index(geomtools::geom_id(1232, 0, 1, 1, 1, 15));
+    DT_THROW_IF(xcalo != CI.size() - 64 - 1, std::logic_error, "Invalid X-calorimeter index !");
+    DT_THROW_IF(CI.get_category(xcalo) != ci_type::CATEGORY_X_CALORIMETER,
+                std::logic_error, "Invalid X-calorimeter category !");
+    const size_t gveto = CI.get_index(geomtools::geom_id(1252, 0, 0, 0, 0));
+    DT_THROW_IF(gveto != 520 + 128, std::logic_error, "Invalid gamma veto index !");
+
+    // Out of range addresses and other geometry types
+    DT_THROW_IF(CI.has_index(geomtools::geom_id(1302, 0, 2, 0, 0, 0)),
+                std::logic_error, "Invalid side has an index !");
+    DT_THROW_IF(CI.has_index(geomtools::geom_id(1204, 0, 0, 0, 0)),
+                std::logic_error, "Geiger cell has an index !");
+
+    // Reduced layout from properties
+    datatools::properties config;
+    std::vector<int> extents;
+    extents.push_back(1);
+    extents.push_back(2);
+    extents.push_back(2);
+    extents.push_back(13);
+    extents.push_back(0);
+    config.store("main_calorimeter.extents", extents);
+    ci_type CI2;
+    CI2.initialize(config);
+    DT_THROW_IF(CI2.get_number_of_blocks(ci_type::CATEGORY_MAIN_CALORIMETER) != 52,
+                std::logic_error, "Invalid number of configured blocks !");
+    DT_THROW_IF(CI2.has_index(geomtools::geom_id(1302, 0, 0, 2, 0, 0)),
+                std::logic_error, "Invalid column has an index !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
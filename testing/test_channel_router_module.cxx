@@ -0,0 +1,267 @@
+// test_channel_router_module.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/multi_properties.h>
+#include <datatools/service_manager.h>
+#include <datatools/things.h>
+// - Bayeux/dpp:
+#include <dpp/base_module.h>
+#include <dpp/module_manager.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/processing/services.h>
+#include <falaise/snemo/reconstruction/channel_router_module.h>
+
+typedef snemo::datamodel::pid_utils pu;
+
+/// Module counting the events it processes
+class counting_module : public dpp::base_module
+{
+public:
+
+  /// Number of processed events per module name
+  static std::map<std::string, size_t> & counts()
+  {
+    static std::map<std::string, size_t> _counts;
+    return _counts;
+  }
+
+  counting_module(datatools::logger::priority logging_priority_ = datatools::logger::PRIO_FATAL)
+    : dpp::base_module(logging_priority_)
+  {
+    return;
+  }
+
+  virtual ~counting_module()
+  {
+    if (is_initialized()) counting_module::reset();
+    return;
+  }
+
+  virtual void initialize(const datatools::properties & setup_,
+                          datatools::service_manager & /* service_manager_ */,
+                          dpp::module_handle_dict_type & /* module_dict_ */)
+  {
+    _common_initialize(setup_);
+    _set_initialized(true);
+    return;
+  }
+
+  virtual void reset()
+  {
+    _set_initialized(false);
+    return;
+  }
+
+  virtual process_status process(datatools::things & /* data_ */)
+  {
+    counts()[get_name()]++;
+    return dpp::base_module::PROCESS_SUCCESS;
+  }
+
+  DPP_MODULE_REGISTRATION_INTERFACE(counting_module)
+};
+
+DPP_MODULE_REGISTRATION_IMPLEMENT(counting_module, "test::counting_module")
+
+// Declare a classification cut
+void add_classification_cut(datatools::multi_properties & cuts_,
+                            const std::string & name_,
+                            const std::string & label_,
+                            const std::string & description_ = "")
+{
+  cuts_.add_section(name_, "snemo::cut::topology_data_cut");
+  datatools::properties & a_config = cuts_.grab_section(name_);
+  if (! description_.empty()) a_config.store("cut.description", description_);
+  a_config.store_flag("mode.classification");
+  a_config.store("classification.label", label_);
+  return;
+}
+
+// Build an event record given its classification
+void make_event(datatools::things & event_, const std::string & label_, const bool with_code_)
+{
+  event_.clear();
+  snemo::datamodel::topology_data & TD = event_.add<snemo::datamodel::topology_data>("TD");
+  if (label_.empty()) return;
+  datatools::properties & td_aux = TD.grab_auxiliaries();
+  td_aux.store(pu::classification_label_key(), label_);
+  pu::classification_code_type a_code = 0;
+  if (with_code_ && pu::parse_classification_label(label_, a_code)) {
+    td_aux.store_integer(pu::classification_code_key(), a_code);
+  }
+  return;
+}
+
+// Declare a channel of a router
+void add_channel(datatools::properties & setup_,
+                 std::vector<std::string> & channels_,
+                 const std::string & name_,
+                 const std::string & cut_,
+                 const std::string & module_ = "")
+{
+  channels_.push_back(name_);
+  setup_.store(name_ + ".cut", cut_);
+  if (! module_.empty()) setup_.store(name_ + ".module", module_);
+  return;
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'channel_router_module' class." << std::endl;
+
+    // Cut service :
+    datatools::multi_properties the_cuts("name", "type", "Cuts of the channel router test");
+    add_classification_cut(the_cuts, "is_2e", "2e");
+    add_classification_cut(the_cuts, "is_1e1g", "1e1g");
+    add_classification_cut(the_cuts, "is_2e_bis", "2e", "Same selection as 'is_2e'");
+    the_cuts.add_section("has_classification", "snemo::cut::topology_data_cut");
+    the_cuts.grab_section("has_classification").store_flag("mode.has_classification");
+    const std::string cuts_file = "test_channel_router_module_cuts.def";
+    the_cuts.write(cuts_file);
+    datatools::properties CM_config;
+    CM_config.store("logging.priority", "fatal");
+    CM_config.store("cuts.configuration_files", std::vector<std::string>(1, cuts_file));
+    const std::string cut_manager_file = "test_channel_router_module_cut_manager.conf";
+    datatools::properties::write_config(cut_manager_file, CM_config);
+
+    datatools::service_manager SM;
+    datatools::properties Cut_config;
+    Cut_config.store("cut_manager.config", cut_manager_file);
+    SM.load(snemo::processing::service_info::default_cut_service_label(), "cuts::cut_service", Cut_config);
+    SM.initialize();
+
+    // Modules processing the events of the channels :
+    dpp::module_manager MM;
+    MM.set_service_manager(SM);
+    datatools::properties a_module_config;
+    MM.load_module("count_2e", "test::counting_module", a_module_config);
+    MM.load_module("count_1e1g", "test::counting_module", a_module_config);
+    MM.load_module("count_default", "test::counting_module", a_module_config);
+    datatools::properties MM_config;
+    MM.initialize(MM_config);
+
+    // Channels in configuration order :
+    //  0: '2e' events
+    //  1: '1e1g' events
+    //  2: any classified event
+    //  3: '2e' events through a cut merged with the first channel
+    datatools::properties CR_config;
+    CR_config.store("logging.priority", "fatal");
+    std::vector<std::string> channels;
+    add_channel(CR_config, channels, "ch_2e", "is_2e", "count_2e");
+    add_channel(CR_config, channels, "ch_1e1g", "is_1e1g", "count_1e1g");
+    add_channel(CR_config, channels, "ch_any", "has_classification");
+    add_channel(CR_config, channels, "ch_2e_bis", "is_2e_bis");
+    CR_config.store("channels", channels);
+    CR_config.store("default_module", "count_default");
+
+    snemo::reconstruction::channel_router_module router;
+    router.initialize(CR_config, SM, MM.grab_modules());
+    DT_THROW_IF(router.get_number_of_channels() != 4, std::logic_error, "Invalid number of channels !");
+
+    // Events and the channels they belong to (as bit masks), in an order
+    // checking the results of an event are not reused for the next one
+    struct event_case {
+      std::string label;
+      bool with_code;
+      snemo::reconstruction::channel_router_module::mask_type mask;
+    };
+    const std::vector<event_case> events = {
+      {"2e", true, 0xD},     // dispatched to the '2e' channels and the unclassified one
+      {"1e1g", true, 0x6},   // dispatched to the '1e1g' channel and the unclassified one
+      {"2e", false, 0xD},    // no classification code: every channel is tried
+      {"1e1g", false, 0x6},
+      {"3e", true, 0x4},     // no dedicated channel: only the unclassified one
+      {"", false, 0x0},      // no classification: default module
+      {"2e", true, 0xD}
+    };
+    counting_module::counts().clear();
+    for (size_t ievent = 0; ievent < events.size(); ++ievent) {
+      datatools::things event;
+      make_event(event, events[ievent].label, events[ievent].with_code);
+      DT_THROW_IF(router.process(event) != dpp::base_module::PROCESS_SUCCESS, std::logic_error,
+                  "Event #" << ievent << " has not been routed !");
+      DT_THROW_IF(! event.has("CR"), std::logic_error, "Missing channel routing bank !");
+      const int a_mask = event.get<datatools::properties>("CR").fetch_integer("mask");
+      DT_THROW_IF(a_mask != static_cast<int>(events[ievent].mask), std::logic_error,
+                  "Event #" << ievent << " ('" << events[ievent].label << "') routed to channels "
+                  << a_mask << " instead of " << events[ievent].mask << " !");
+    }
+    DT_THROW_IF(counting_module::counts()["count_2e"] != 3, std::logic_error,
+                "Invalid number of '2e' events !");
+    DT_THROW_IF(counting_module::counts()["count_1e1g"] != 2, std::logic_error,
+                "Invalid number of '1e1g' events !");
+    DT_THROW_IF(counting_module::counts()["count_default"] != 1, std::logic_error,
+                "Invalid number of events processed by the default module !");
+
+    // Stop at the first matching channel :
+    {
+      datatools::properties first_config = CR_config;
+      first_config.store_boolean("first_match_only", true);
+      snemo::reconstruction::channel_router_module first_router;
+      first_router.initialize(first_config, SM, MM.grab_modules());
+      datatools::things event;
+      make_event(event, "2e", true);
+      DT_THROW_IF(first_router.route(event) != 0x1, std::logic_error,
+                  "Event routed to more than its first channel !");
+      make_event(event, "3e", true);
+      DT_THROW_IF(first_router.route(event) != 0x4, std::logic_error,
+                  "Event not routed to the unclassified channel !");
+    }
+
+    // Maximal number of channels :
+    {
+      datatools::properties max_config;
+      max_config.store("logging.priority", "fatal");
+      std::vector<std::string> max_channels;
+      for (size_t i = 0; i < snemo::reconstruction::channel_router_module::MAX_NUMBER_OF_CHANNELS; ++i) {
+        std::ostringstream a_name;
+        a_name << "ch_" << i;
+        add_channel(max_config, max_channels, a_name.str(), "is_2e");
+      }
+      max_config.store("channels", max_channels);
+      snemo::reconstruction::channel_router_module max_router;
+      max_router.initialize(max_config, SM, MM.grab_modules());
+      datatools::things event;
+      make_event(event, "2e", true);
+      DT_THROW_IF(max_router.route(event) != 0x7FFFFFFF, std::logic_error,
+                  "Event not routed to every channel !");
+
+      add_channel(max_config, max_channels, "ch_too_many", "is_2e");
+      max_config.update("channels", max_channels);
+      snemo::reconstruction::channel_router_module too_many_router;
+      bool rejected = false;
+      try {
+        too_many_router.initialize(max_config, SM, MM.grab_modules());
+      } catch (std::logic_error &) {
+        rejected = true;
+      }
+      DT_THROW_IF(! rejected, std::logic_error, "Too many channels have been accepted !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
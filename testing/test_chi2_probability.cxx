@@ -0,0 +1,65 @@
+// test_chi2_probability.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <exception>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'chi2_probability' class." << std::endl;
+
+    typedef snemo::reconstruction::chi2_probability cp_type;
+
+    // Compare every method to the GSL reference
+    const double tolerances[] = {0.0, 1e-12, 1.5e-7, 1e-5};
+    for (int imethod = cp_type::METHOD_GSL; imethod <= cp_type::METHOD_TABULATED; ++imethod) {
+      const cp_type CP(cp_type::method_from_label(cp_type::method_label(static_cast<cp_type::method_type>(imethod))));
+      DT_THROW_IF(CP.get_method() != imethod, std::logic_error, "Invalid method !");
+      for (unsigned int dof = 1; dof <= 4; ++dof) {
+        double max_error = 0.0;
+        std::vector<double> chi2s;
+        for (double chi2 = 0.0; chi2 < 150.0; chi2 += 0.0173) {
+          chi2s.push_back(chi2);
+          const double error = std::abs(CP.survival(chi2, dof) - cp_type::gsl_survival(chi2, dof));
+          if (error > max_error) max_error = error;
+        }
+        std::clog << "Method '" << cp_type::method_label(CP.get_method()) << "', dof = " << dof
+                  << " : maximal absolute error = " << max_error << std::endl;
+        DT_THROW_IF(max_error > tolerances[imethod], std::logic_error,
+                    "Method '" << cp_type::method_label(CP.get_method()) << "' is not accurate enough !");
+
+        // Array version gives the same values
+        std::vector<double> probabilities(chi2s.size());
+        CP.survival(chi2s.data(), probabilities.data(), chi2s.size(), dof);
+        for (size_t i = 0; i < chi2s.size(); ++i) {
+          DT_THROW_IF(probabilities[i] != CP.survival(chi2s[i], dof), std::logic_error,
+                      "Array and scalar values differ !");
+        }
+      }
+    }
+
+    // Closed form for one degree of freedom
+    DT_THROW_IF(std::abs(cp_type::exact_survival(1.0, 1) - std::erfc(std::sqrt(0.5))) > 1e-15,
+                std::logic_error, "Invalid closed form !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,268 @@
+// test_cut_graph.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/service_manager.h>
+// - Bayeux/cuts:
+#include <cuts/i_cut.h>
+#include <cuts/cut_manager.h>
+
+// This project:
+#include <falaise/snemo/cuts/cut_graph.h>
+
+/// Cut accepting properties holding a given flag, counting its evaluations
+class flag_cut : public cuts::i_cut
+{
+public:
+
+  /// Number of evaluations per flag
+  static std::map<std::string, size_t> & evaluations()
+  {
+    static std::map<std::string, size_t> _evaluations;
+    return _evaluations;
+  }
+
+  flag_cut(datatools::logger::priority logging_priority_ = datatools::logger::PRIO_FATAL)
+    : cuts::i_cut(logging_priority_)
+  {
+    return;
+  }
+
+  virtual ~flag_cut()
+  {
+    if (is_initialized()) this->flag_cut::reset();
+    return;
+  }
+
+  virtual void initialize(const datatools::properties & configuration_,
+                          datatools::service_manager & /* service_manager_ */,
+                          cuts::cut_handle_dict_type & /* cut_dict_ */)
+  {
+    this->i_cut::_common_initialize(configuration_);
+    _flag_ = configuration_.fetch_string("flag");
+    this->i_cut::_set_initialized(true);
+    return;
+  }
+
+  virtual void reset()
+  {
+    _flag_.clear();
+    this->i_cut::_reset();
+    this->i_cut::_set_initialized(false);
+    return;
+  }
+
+protected:
+
+  virtual int _accept()
+  {
+    evaluations()[_flag_]++;
+    const datatools::properties & data = get_user_data<datatools::properties>();
+    return data.has_flag(_flag_) ? cuts::SELECTION_ACCEPTED : cuts::SELECTION_REJECTED;
+  }
+
+private:
+
+  std::string _flag_; //!< Flag to be found
+
+  CUT_REGISTRATION_INTERFACE(flag_cut)
+};
+
+CUT_REGISTRATION_IMPLEMENT(flag_cut, "test::flag_cut")
+
+// Declare a leaf cut
+void add_leaf(cuts::cut_manager & cut_manager_, const std::string & name_, const std::string & flag_)
+{
+  datatools::properties a_config;
+  a_config.store("flag", flag_);
+  cut_manager_.load_cut(name_, "test::flag_cut", a_config);
+  return;
+}
+
+// Declare a logical cut combining other cuts
+void add_combination(cuts::cut_manager & cut_manager_, const std::string & name_,
+                     const std::string & cut_id_, const std::vector<std::string> & cuts_)
+{
+  datatools::properties a_config;
+  if (cut_id_ == "cuts::not_cut") {
+    a_config.store("cut", cuts_.front());
+  } else {
+    a_config.store("cuts", cuts_);
+  }
+  cut_manager_.load_cut(name_, cut_id_, a_config);
+  return;
+}
+
+// Return the names of the leaves required by a cut
+std::vector<std::string> required_leaves(snemo::cut::cut_graph & graph_, const std::string & cut_name_)
+{
+  std::vector<size_t> leaves;
+  graph_.fetch_required_leaves(graph_.add_cut(cut_name_), leaves);
+  std::vector<std::string> names;
+  for (size_t i = 0; i < leaves.size(); ++i) {
+    names.push_back(graph_.get_node(leaves[i]).cut_name);
+  }
+  return names;
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'cut_graph' class." << std::endl;
+
+    datatools::service_manager SM;
+    SM.initialize();
+    cuts::cut_manager CM;
+    CM.set_service_manager(SM);
+    datatools::properties CM_config;
+    CM.initialize(CM_config);
+
+    add_leaf(CM, "A", "a");
+    add_leaf(CM, "B", "b");
+    add_leaf(CM, "C", "c");
+    add_combination(CM, "A_and_B", "cuts::multi_and_cut", {"A", "B"});
+    add_combination(CM, "A_and_C", "cuts::multi_and_cut", {"A", "C"});
+    add_combination(CM, "A_or_B", "cuts::multi_or_cut", {"A", "B"});
+    add_combination(CM, "AB_or_AC", "cuts::multi_or_cut", {"A_and_B", "A_and_C"});
+    add_combination(CM, "not_A", "cuts::not_cut", {"A"});
+    add_combination(CM, "not_B", "cuts::not_cut", {"B"});
+    add_combination(CM, "not_not_A", "cuts::not_cut", {"not_A"});
+    add_combination(CM, "not_A_or_not_B", "cuts::multi_or_cut", {"not_A", "not_B"});
+    add_combination(CM, "A_and_B_by_De_Morgan", "cuts::not_cut", {"not_A_or_not_B"});
+    add_combination(CM, "not_A_and_B", "cuts::not_cut", {"A_and_B"});
+    add_combination(CM, "C_and_not_A_or_B", "cuts::multi_and_cut", {"C", "not_A_or_not_B"});
+
+    // Cuts doing the same thing under other names
+    add_leaf(CM, "A_again", "a");
+    {
+      datatools::properties a_config;
+      a_config.store("flag", "a");
+      a_config.store("cut.description", "Same selection as 'A'");
+      a_config.store("logging.priority", "debug");
+      CM.load_cut("A_described", "test::flag_cut", a_config);
+    }
+    add_combination(CM, "A_again_and_B", "cuts::multi_and_cut", {"A_again", "B"});
+    {
+      datatools::properties a_config;
+      a_config.store_integer("seed", 314159);
+      a_config.store_real("accept_probability", 0.5);
+      CM.load_cut("R1", "cuts::random_cut", a_config);
+      CM.load_cut("R2", "cuts::random_cut", a_config);
+    }
+
+    snemo::cut::cut_graph graph;
+    graph.set_cut_manager(CM);
+
+    // Expansion of the logical nodes :
+    {
+      const std::vector<std::string> A_and_B = {"A", "B"};
+      const std::vector<std::string> A = {"A"};
+      const std::vector<std::string> C = {"C"};
+      const std::vector<std::string> none;
+      DT_THROW_IF(required_leaves(graph, "A") != A, std::logic_error, "Leaf does not require itself !");
+      DT_THROW_IF(required_leaves(graph, "A_and_B") != A_and_B, std::logic_error,
+                  "AND node does not require all its children !");
+      DT_THROW_IF(required_leaves(graph, "A_or_B") != none, std::logic_error,
+                  "OR node requires one of its children !");
+      DT_THROW_IF(required_leaves(graph, "AB_or_AC") != A, std::logic_error,
+                  "OR node does not require the leaves common to its children !");
+      DT_THROW_IF(required_leaves(graph, "not_A") != none, std::logic_error,
+                  "NOT node requires its child !");
+      DT_THROW_IF(required_leaves(graph, "not_not_A") != A, std::logic_error,
+                  "Double negation not expanded !");
+      DT_THROW_IF(required_leaves(graph, "A_and_B_by_De_Morgan") != A_and_B, std::logic_error,
+                  "Negation of OR node not expanded !");
+      DT_THROW_IF(required_leaves(graph, "not_A_and_B") != none, std::logic_error,
+                  "Negation of AND node requires some leaves !");
+      DT_THROW_IF(required_leaves(graph, "C_and_not_A_or_B") != C, std::logic_error,
+                  "Invalid leaves for a mixed combination !");
+    }
+
+    // Merging of the nodes :
+    {
+      const size_t A = graph.add_cut("A");
+      DT_THROW_IF(graph.add_cut("A_again") != A, std::logic_error,
+                  "Cuts with the same type and configuration are not merged !");
+      DT_THROW_IF(graph.add_cut("A_described") != A, std::logic_error,
+                  "Description or logging prevent cuts from being merged !");
+      DT_THROW_IF(graph.add_cut("A_again_and_B") != graph.add_cut("A_and_B"), std::logic_error,
+                  "Combinations of merged cuts are not merged !");
+      DT_THROW_IF(graph.add_cut("B") == A, std::logic_error, "Different cuts are merged !");
+      const size_t nnodes = graph.get_number_of_nodes();
+      DT_THROW_IF(graph.add_cut("R1") == graph.add_cut("R2"), std::logic_error,
+                  "Random cuts are merged !");
+      DT_THROW_IF(graph.get_number_of_nodes() != nnodes + 2, std::logic_error,
+                  "Random cuts do not have their own node !");
+      DT_THROW_IF(graph.get_node(graph.get_node_index("R2")).cut_name != "R2", std::logic_error,
+                  "Random cut not keyed by its name !");
+    }
+
+    // Evaluation of the logical nodes :
+    {
+      datatools::properties data;
+      data.store_flag("a");
+      data.store_flag("c");
+      graph.reset_results();
+      const std::map<std::string, int> expected = {
+        {"A_and_B", cuts::SELECTION_REJECTED}, {"A_and_C", cuts::SELECTION_ACCEPTED},
+        {"A_or_B", cuts::SELECTION_ACCEPTED}, {"AB_or_AC", cuts::SELECTION_ACCEPTED},
+        {"not_A", cuts::SELECTION_REJECTED}, {"not_not_A", cuts::SELECTION_ACCEPTED},
+        {"A_and_B_by_De_Morgan", cuts::SELECTION_REJECTED}, {"not_A_and_B", cuts::SELECTION_ACCEPTED},
+        {"C_and_not_A_or_B", cuts::SELECTION_ACCEPTED}
+      };
+      for (std::map<std::string, int>::const_iterator i = expected.begin(); i != expected.end(); ++i) {
+        DT_THROW_IF(graph.evaluate(graph.get_node_index(i->first), data) != i->second,
+                    std::logic_error, "Invalid result for cut '" << i->first << "' !");
+      }
+    }
+
+    // Memoization of the sub-cuts shared by several channels :
+    {
+      const size_t channel1 = graph.get_node_index("A_and_B");
+      const size_t channel2 = graph.get_node_index("A_and_C");
+      DT_THROW_IF(graph.get_node(channel1).children.front() != graph.get_node(channel2).children.front(),
+                  std::logic_error, "Sub-cut 'A' is not shared !");
+      datatools::properties data;
+      data.store_flag("a");
+      data.store_flag("b");
+      flag_cut::evaluations().clear();
+      graph.reset_results();
+      DT_THROW_IF(graph.evaluate(channel1, data) != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "First channel rejected !");
+      DT_THROW_IF(graph.evaluate(channel2, data) != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Second channel accepted !");
+      DT_THROW_IF(flag_cut::evaluations()["a"] != 1, std::logic_error,
+                  "Shared sub-cut evaluated " << flag_cut::evaluations()["a"] << " times !");
+      DT_THROW_IF(flag_cut::evaluations()["b"] != 1 || flag_cut::evaluations()["c"] != 1,
+                  std::logic_error, "Sub-cuts not evaluated once !");
+
+      // Results are forgotten for the next user data
+      datatools::properties other_data;
+      other_data.store_flag("c");
+      graph.reset_results();
+      DT_THROW_IF(graph.evaluate(channel2, other_data) != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Result of the previous data reused !");
+      DT_THROW_IF(flag_cut::evaluations()["a"] != 2, std::logic_error,
+                  "Shared sub-cut not evaluated for the next data !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,197 @@
+// test_particle_identification_driver.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/service_manager.h>
+// - Bayeux/cuts:
+#include <cuts/i_cut.h>
+#include <cuts/cut_manager.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/reconstruction/particle_identification_driver.h>
+
+typedef snemo::datamodel::pid_utils pu;
+
+/// Particle cut accepting a given 'kind' auxiliary
+class kind_cut : public cuts::i_cut
+{
+public:
+
+  kind_cut(datatools::logger::priority logging_priority_ = datatools::logger::PRIO_FATAL)
+    : cuts::i_cut(logging_priority_)
+  {
+    return;
+  }
+
+  virtual ~kind_cut()
+  {
+    if (is_initialized()) this->kind_cut::reset();
+    return;
+  }
+
+  virtual void initialize(const datatools::properties & configuration_,
+                          datatools::service_manager & /* service_manager_ */,
+                          cuts::cut_handle_dict_type & /* cut_dict_ */)
+  {
+    this->i_cut::_common_initialize(configuration_);
+    _kind_ = configuration_.fetch_string("kind");
+    this->i_cut::_set_initialized(true);
+    return;
+  }
+
+  virtual void reset()
+  {
+    _kind_.clear();
+    this->i_cut::_reset();
+    this->i_cut::_set_initialized(false);
+    return;
+  }
+
+protected:
+
+  virtual int _accept()
+  {
+    const snemo::datamodel::particle_track & a_particle
+      = get_user_data<snemo::datamodel::particle_track>();
+    const datatools::properties & aux = a_particle.get_auxiliaries();
+    if (aux.has_key("kind") && aux.fetch_string("kind") == _kind_) {
+      return cuts::SELECTION_ACCEPTED;
+    }
+    return cuts::SELECTION_REJECTED;
+  }
+
+private:
+
+  std::string _kind_; //!< Accepted kind of particle
+
+  CUT_REGISTRATION_INTERFACE(kind_cut)
+};
+
+CUT_REGISTRATION_IMPLEMENT(kind_cut, "test::kind_cut")
+
+// Declare a PID definition and its cut
+void add_definition(cuts::cut_manager & cut_manager_,
+                    datatools::properties & setup_,
+                    std::vector<std::string> & definitions_,
+                    const std::string & name_,
+                    const std::string & kind_,
+                    const std::string & label_)
+{
+  datatools::properties a_config;
+  a_config.store("kind", kind_);
+  cut_manager_.load_cut(name_, "test::kind_cut", a_config);
+  definitions_.push_back(name_);
+  setup_.store(name_ + ".label", label_);
+  return;
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'particle_identification_driver' class." << std::endl;
+
+    datatools::service_manager SM;
+    SM.initialize();
+    cuts::cut_manager CM;
+    CM.set_service_manager(SM);
+    datatools::properties CM_config;
+    CM.initialize(CM_config);
+
+    // Mutually exclusive definitions, the least selective one being
+    // configured last (definitions are sorted by name)
+    datatools::properties PID_config;
+    PID_config.store("logging.priority", "fatal");
+    PID_config.store_flag("mode.label");
+    PID_config.store_boolean("export_labels", false);
+    PID_config.store_boolean("exclusive_definitions", true);
+    std::vector<std::string> definitions;
+    add_definition(CM, PID_config, definitions, "a_alpha", "alpha", pu::alpha_label());
+    add_definition(CM, PID_config, definitions, "b_positron", "positron", pu::positron_label());
+    add_definition(CM, PID_config, definitions, "c_electron", "electron", pu::electron_label());
+    add_definition(CM, PID_config, definitions, "d_gamma", "gamma", pu::gamma_label());
+    PID_config.store("definitions", definitions);
+
+    snemo::reconstruction::particle_identification_driver static_PID;
+    static_PID.set_cut_manager(CM);
+    static_PID.initialize(PID_config);
+
+    PID_config.store_boolean("adaptive_ordering", true);
+    snemo::reconstruction::particle_identification_driver adaptive_PID;
+    adaptive_PID.set_cut_manager(CM);
+    adaptive_PID.initialize(PID_config);
+
+    // Kinds of particles with differing frequencies, some being accepted by no cut
+    const char * kinds[] = {"gamma", "gamma", "gamma", "gamma", "gamma", "gamma",
+                            "electron", "electron", "electron", "positron", "positron", "alpha",
+                            "unknown"};
+    const size_t nkinds = sizeof(kinds) / sizeof(kinds[0]);
+    std::mt19937 generator(314159);
+    std::uniform_int_distribution<size_t> kind_distribution(0, nkinds - 1);
+    std::uniform_int_distribution<size_t> size_distribution(1, 8);
+
+    const size_t nevents = 200;
+    for (size_t ievent = 0; ievent < nevents; ++ievent) {
+      snemo::datamodel::particle_track_data PTD;
+      const size_t nparticles = size_distribution(generator);
+      for (size_t i = 0; i < nparticles; ++i) {
+        snemo::datamodel::particle_track::handle_type hPT(new snemo::datamodel::particle_track);
+        hPT.grab().set_track_id(i);
+        hPT.grab().grab_auxiliaries().store("kind", kinds[kind_distribution(generator)]);
+        PTD.add_particle(hPT);
+      }
+
+      snemo::datamodel::pid_data static_pid;
+      static_PID.identify(PTD, static_pid);
+      snemo::datamodel::pid_data adaptive_pid;
+      adaptive_PID.identify(PTD, adaptive_pid);
+
+      // Same particles accepted and rejected whatever the evaluation order
+      DT_THROW_IF(static_pid.get_number_of_particles() != adaptive_pid.get_number_of_particles(),
+                  std::logic_error, "Invalid number of identified particles !");
+      for (size_t i = 0; i < nparticles; ++i) {
+        DT_THROW_IF(static_pid.get_particle_type(i) != adaptive_pid.get_particle_type(i),
+                    std::logic_error, "Particle #" << i << " of event #" << ievent
+                    << " identified differently with adaptive ordering !");
+      }
+      for (size_t itype = 0; itype < pu::NUMBER_OF_PARTICLE_TYPES; ++itype) {
+        const pu::particle_type a_type = static_cast<pu::particle_type>(itype);
+        DT_THROW_IF(static_pid.get_particle_count(a_type) != adaptive_pid.get_particle_count(a_type),
+                    std::logic_error, "Invalid number of '" << pu::classification_symbol(a_type)
+                    << "' particles in event #" << ievent << " !");
+      }
+    }
+
+    // The most accepting definition is now evaluated first
+    std::vector<std::string> static_order;
+    static_PID.fetch_definition_order(static_order);
+    std::vector<std::string> adaptive_order;
+    adaptive_PID.fetch_definition_order(adaptive_order);
+    std::clog << "Definition order : static = " << static_order.front()
+              << ", adaptive = " << adaptive_order.front() << std::endl;
+    DT_THROW_IF(static_order.front() != "a_alpha", std::logic_error, "Static order has changed !");
+    DT_THROW_IF(adaptive_order.front() != "d_gamma" || adaptive_order.back() != "a_alpha",
+                std::logic_error, "Definitions have not been reordered !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,142 @@
+// test_particle_kinematics.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_keys.h>
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
+#include <falaise/snemo/reconstruction/topology_event_view.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_event_view', 'particle_kinematics' and 'kinematics_cache' classes." << std::endl;
+
+    // Fake gamma track :
+    snemo::datamodel::particle_track gamma;
+    gamma.grab_auxiliaries().update(snemo::datamodel::pid_utils::pid_label_key(),
+                                    snemo::datamodel::pid_utils::gamma_label());
+    geomtools::geom_id a_gid;
+    std::istringstream iss("[1302:0.1.4.6.*]");
+    iss >> a_gid;
+    // Add gamma source foil vertex
+    {
+      snemo::datamodel::particle_track::vertex_collection_type & the_vertices
+        = gamma.grab_vertices();
+      the_vertices.push_back(new geomtools::blur_spot);
+      geomtools::blur_spot & a_vertex = the_vertices.back().grab();
+      a_vertex.set_position(geomtools::vector_3d(0, 0, 0));
+      a_vertex.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(),
+                                         snemo::datamodel::particle_track::vertex_on_source_foil_label());
+    }
+    // Add gamma calo vertex
+    {
+      snemo::datamodel::particle_track::vertex_collection_type & the_vertices
+        = gamma.grab_vertices();
+      the_vertices.push_back(new geomtools::blur_spot);
+      geomtools::blur_spot & a_vertex = the_vertices.back().grab();
+      a_vertex.set_position(geomtools::vector_3d(30*CLHEP::cm, 40*CLHEP::cm, 0));
+      a_vertex.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(),
+                                         snemo::datamodel::particle_track::vertex_on_main_calorimeter_label());
+      a_vertex.set_geom_id(a_gid);
+    }
+    // Push some fake gamma calorimeter hits
+    for (size_t i = 0; i < 2; ++i) {
+      snemo::datamodel::calibrated_calorimeter_hit::collection_type & the_calos
+        = gamma.grab_associated_calorimeter_hits();
+      the_calos.push_back(new snemo::datamodel::calibrated_calorimeter_hit);
+      snemo::datamodel::calibrated_calorimeter_hit & a_calo = the_calos.back().grab();
+      a_calo.set_energy((i + 1) * 500 * CLHEP::keV);
+      a_calo.set_sigma_energy(50 * CLHEP::keV);
+      a_calo.set_time((i + 2) * CLHEP::ns);
+      a_calo.set_sigma_time(0.05 * CLHEP::ns);
+      // The part of the hit differs from the one of the vertex
+      geomtools::geom_id a_hit_gid = a_gid;
+      a_hit_gid.set(4, i);
+      if (i == 1) a_hit_gid.set(2, 5);
+      a_calo.set_geom_id(a_hit_gid);
+    }
+
+    // Event view
+    typedef snemo::reconstruction::topology_event_view tev_type;
+    const snemo::datamodel::calorimeter_index CI;
+    tev_type V;
+    DT_THROW_IF(V.add_particle(gamma, snemo::datamodel::pid_utils::PARTICLE_GAMMA, &CI) != 0,
+                std::logic_error, "Invalid particle position !");
+    DT_THROW_IF(V.get_number_of_vertices() != 2 || V.get_number_of_calorimeter_hits() != 2,
+                std::logic_error, "Invalid number of vertices or calorimeter hits !");
+    DT_THROW_IF(V.get_vertex_offsets().size() != 2 || V.get_vertex_offsets().back() != 2,
+                std::logic_error, "Invalid vertex offsets !");
+    DT_THROW_IF(V.get_vertex_locations()[0] != tev_type::VERTEX_ON_SOURCE_FOIL ||
+                V.get_vertex_locations()[1] != tev_type::VERTEX_ON_MAIN_CALORIMETER,
+                std::logic_error, "Invalid vertex locations !");
+    DT_THROW_IF(tev_type::vertex_location_label(V.get_vertex_locations()[1])
+                != snemo::datamodel::particle_track::vertex_on_main_calorimeter_label(),
+                std::logic_error, "Invalid vertex location label !");
+    DT_THROW_IF(V.get_vertex_calorimeter_indexes()[0] != snemo::datamodel::calorimeter_index::INVALID_INDEX,
+                std::logic_error, "Source foil vertex has a calorimeter index !");
+    DT_THROW_IF(! V.is_same_block(1, 0) || V.is_same_block(1, 1),
+                std::logic_error, "Invalid calorimeter block matching !");
+    DT_THROW_IF(std::abs(V.get_total_energies()[0] - 1500 * CLHEP::keV) > 1e-9,
+                std::logic_error, "Invalid view total energy !");
+
+    snemo::reconstruction::particle_kinematics K;
+    K.compute(V, 0);
+    DT_THROW_IF(std::abs(K.energy - 500 * CLHEP::keV) > 1e-9, std::logic_error, "Invalid energy !");
+    DT_THROW_IF(std::abs(K.total_energy - 1500 * CLHEP::keV) > 1e-9, std::logic_error, "Invalid total energy !");
+    DT_THROW_IF(std::abs(K.time - 2 * CLHEP::ns) > 1e-9, std::logic_error, "Invalid time !");
+    DT_THROW_IF(K.mass != 0.0, std::logic_error, "Invalid gamma mass !");
+    DT_THROW_IF(datatools::is_valid(K.track_length), std::logic_error, "Gamma has a track length !");
+    DT_THROW_IF(K.origin_vertex != &gamma.get_vertices().front().get(), std::logic_error, "Invalid origin vertex !");
+    DT_THROW_IF(K.origin_location != tev_type::VERTEX_ON_SOURCE_FOIL, std::logic_error, "Invalid origin location !");
+    DT_THROW_IF((K.direction - geomtools::vector_3d(0.6, 0.8, 0)).mag() > 1e-9, std::logic_error, "Invalid direction !");
+    DT_THROW_IF(K.calorimeter_vertices.size() != 1, std::logic_error, "Invalid number of calorimeter vertices !");
+    DT_THROW_IF(K.calorimeter_vertices.front().hit != &gamma.get_associated_calorimeter_hits().front().get(),
+                std::logic_error, "Calorimeter vertex is not matched with the first hit !");
+
+    // Cache
+    const snemo::datamodel::particle_slot g1_label(snemo::datamodel::pid_utils::PARTICLE_GAMMA, 1);
+    const snemo::datamodel::particle_slot g2_label(snemo::datamodel::pid_utils::PARTICLE_GAMMA, 2);
+    snemo::reconstruction::kinematics_cache KC;
+    for (size_t ievent = 0; ievent < 2; ++ievent) {
+      KC.clear();
+      DT_THROW_IF(KC.size() != 0, std::logic_error, "Cache is not empty !");
+      DT_THROW_IF(KC.add(g1_label, gamma, &CI) != 0, std::logic_error, "Invalid first index !");
+      DT_THROW_IF(KC.add(g2_label, gamma, &CI) != 1, std::logic_error, "Invalid second index !");
+      DT_THROW_IF(KC.get_index(g2_label) != 1, std::logic_error, "Invalid index of '" << g2_label << "' !");
+      DT_THROW_IF(&KC.get(g1_label) != &KC.get(0), std::logic_error, "Invalid kinematics of '" << g1_label << "' !");
+      DT_THROW_IF(KC.get(1).type != snemo::datamodel::pid_utils::PARTICLE_GAMMA, std::logic_error, "Invalid type !");
+      DT_THROW_IF(KC.get(1).view != &KC.get_view() || KC.get_view().get_number_of_particles() != 2,
+                  std::logic_error, "Invalid event view !");
+      bool duplicate = false;
+      try {
+        KC.add(g1_label, gamma, &CI);
+      } catch (std::logic_error &) {
+        duplicate = true;
+      }
+      DT_THROW_IF(! duplicate, std::logic_error, "Duplicate particle is accepted !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,94 @@
+// test_pid_data.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_data.h>
+#include <falaise/snemo/datamodels/particle_track_data.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'pid_data' class." << std::endl;
+
+    typedef snemo::datamodel::pid_utils pu;
+
+    // Fake 2e1g event
+    snemo::datamodel::pid_data PID;
+    PID.reset(3);
+    PID.set_particle_type(0, pu::PARTICLE_ELECTRON);
+    PID.set_particle_type(2, pu::PARTICLE_ELECTRON);
+    PID.set_particle_type(1, pu::PARTICLE_GAMMA);
+    PID.increment_particle_count(pu::PARTICLE_ELECTRON);
+    PID.increment_particle_count(pu::PARTICLE_ELECTRON);
+    PID.increment_particle_count(pu::PARTICLE_GAMMA);
+    PID.tree_dump(std::clog, "PID data dump:", "[notice]: ");
+    DT_THROW_IF(! PID.particle_is(1, pu::PARTICLE_GAMMA), std::logic_error, "Invalid particle type !");
+    DT_THROW_IF(pu::classification_label(PID.get_classification_code()) != "2e1g",
+                std::logic_error, "Invalid classification !");
+
+    // Classification labels parsed back into codes
+    pu::classification_code_type a_code = 0;
+    DT_THROW_IF(! pu::parse_classification_label("2e1g", a_code) || a_code != PID.get_classification_code(),
+                std::logic_error, "Invalid parsed classification !");
+    DT_THROW_IF(pu::parse_classification_label("1g2e", a_code), std::logic_error,
+                "Non canonical classification label parsed !");
+    DT_THROW_IF(pu::parse_classification_label("[0-9]e", a_code), std::logic_error,
+                "Classification pattern parsed !");
+
+    // Counts that do not fit in a classification code are flagged, not saturated
+    PID.set_particle_count(pu::PARTICLE_GAMMA, pu::CLASSIFICATION_COUNT_MAX);
+    DT_THROW_IF(pu::is_overflow_classification_code(PID.get_classification_code()),
+                std::logic_error, "Maximal count has overflowed !");
+    PID.set_particle_count(pu::PARTICLE_GAMMA, pu::CLASSIFICATION_COUNT_MAX + 1);
+    DT_THROW_IF(! pu::is_overflow_classification_code(PID.get_classification_code()),
+                std::logic_error, "Overflow has not been flagged !");
+    DT_THROW_IF(PID.get_classification_label() != "2e" + std::to_string(pu::CLASSIFICATION_COUNT_MAX + 1) + "g",
+                std::logic_error, "Invalid classification label with overflow !");
+    bool overflow_label = false;
+    try {
+      pu::classification_label(PID.get_classification_code());
+    } catch (std::range_error &) {
+      overflow_label = true;
+    }
+    DT_THROW_IF(! overflow_label, std::logic_error, "Label of an overflowed code has been built !");
+    DT_THROW_IF(pu::parse_classification_label("2e" + std::to_string(pu::CLASSIFICATION_COUNT_MAX + 1) + "g", a_code),
+                std::logic_error, "Overflowing label parsed !");
+
+    // PID bank rebuilt from the labels stored within particle tracks
+    snemo::datamodel::particle_track_data PTD;
+    const std::string labels[] = {pu::electron_label(), pu::gamma_label(), "electron|gamma"};
+    for (size_t i = 0; i < 3; ++i) {
+      snemo::datamodel::particle_track::handle_type hPT(new snemo::datamodel::particle_track);
+      hPT.grab().grab_auxiliaries().update(pu::pid_label_key(), labels[i]);
+      PTD.add_particle(hPT);
+    }
+    PTD.grab_auxiliaries().update_integer(pu::electron_label(), 2);
+    PTD.grab_auxiliaries().update_integer(pu::gamma_label(), 2);
+    snemo::datamodel::pid_data PID2;
+    pu::fetch_pid_data(PTD, PID2);
+    PID2.tree_dump(std::clog, "PID data from labels:", "[notice]: ");
+    DT_THROW_IF(PID2.get_number_of_particles() != 3, std::logic_error, "Invalid number of particles !");
+    DT_THROW_IF(! PID2.particle_is(0, pu::PARTICLE_ELECTRON), std::logic_error, "Invalid particle type !");
+    DT_THROW_IF(! PID2.particle_is(2, pu::PARTICLE_UNDEFINED), std::logic_error, "Invalid particle type !");
+    DT_THROW_IF(PID2.get_particle_count(pu::PARTICLE_GAMMA) != 2, std::logic_error, "Invalid gamma count !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
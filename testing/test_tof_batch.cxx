@@ -0,0 +1,82 @@
+// test_tof_batch.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <exception>
+#include <vector>
+
+// Third party:
+// - GSL:
+#include <gsl/gsl_cdf.h>
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/tof_batch.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'tof_batch' class." << std::endl;
+
+    typedef snemo::reconstruction::tof_driver::tof_tool tt;
+    const double me = CLHEP::electron_mass_c2;
+    const size_t nevents = 10;
+    std::vector<snemo::reconstruction::tof_batch::probability_type> probas_int(nevents);
+    std::vector<snemo::reconstruction::tof_batch::probability_type> probas_ext(nevents);
+
+    snemo::reconstruction::tof_batch batch;
+    for (size_t i = 0; i < nevents; ++i) {
+      const double E1 = (0.5 + 0.1 * i) * CLHEP::MeV;
+      const double tl1 = (40. + i) * CLHEP::cm;
+      const double t1 = (2. + 0.2 * i) * CLHEP::ns;
+      // Electron/electron and electron/gamma hypotheses
+      batch.add(E1, me, tl1, t1, 0.2 * CLHEP::ns,
+                1.2 * CLHEP::MeV, me, 50 * CLHEP::cm, 2.5 * CLHEP::ns, 0.2 * CLHEP::ns,
+                0.1 * CLHEP::ns, probas_int[i], probas_ext[i]);
+      batch.add(E1, me, tl1, t1, 0.2 * CLHEP::ns,
+                1, 0, 60 * CLHEP::cm, 3.0 * CLHEP::ns, 0.3 * CLHEP::ns,
+                0.6 * CLHEP::ns, probas_int[i], probas_ext[i]);
+    }
+    DT_THROW_IF(batch.size() != 2 * nevents, std::logic_error, "Invalid batch size !");
+    batch.compute();
+    DT_THROW_IF(! batch.empty(), std::logic_error, "Batch has not been cleared !");
+
+    // Compare with the scalar computation
+    for (size_t i = 0; i < nevents; ++i) {
+      DT_THROW_IF(probas_int[i].size() != 2 || probas_ext[i].size() != 2, std::logic_error,
+                  "Invalid number of probabilities for event #" << i << " !");
+      const double E1 = (0.5 + 0.1 * i) * CLHEP::MeV;
+      const double tl1 = (40. + i) * CLHEP::cm;
+      const double t1 = (2. + 0.2 * i) * CLHEP::ns;
+      const double t1_th = tt::get_theoretical_time(E1, me, tl1);
+      const double t2_th = tt::get_theoretical_time(1.2 * CLHEP::MeV, me, 50 * CLHEP::cm);
+      const double t2 = 2.5 * CLHEP::ns;
+      const double sigma_exp = std::pow(0.2 * CLHEP::ns, 2) + std::pow(0.2 * CLHEP::ns, 2)
+        + std::pow(0.1 * CLHEP::ns, 2);
+      const double chi2_int = std::pow(t1 - t2 - (t1_th - t2_th), 2)/sigma_exp;
+      const double chi2_ext = std::pow(std::abs(t1 - t2) - (t1_th + t2_th), 2)/sigma_exp;
+      const double p_int = gsl_cdf_chisq_Q(chi2_int, 1)*100.*CLHEP::perCent;
+      const double p_ext = gsl_cdf_chisq_Q(chi2_ext, 1)*100.*CLHEP::perCent;
+      std::clog << "Event #" << i << " : P_int = " << probas_int[i].front()/CLHEP::perCent << " % "
+                << "P_ext = " << probas_ext[i].front()/CLHEP::perCent << " %" << std::endl;
+      DT_THROW_IF(std::abs(probas_int[i].front() - p_int) > 1e-12, std::logic_error,
+                  "Internal probability mismatch for event #" << i << " !");
+      DT_THROW_IF(std::abs(probas_ext[i].front() - p_ext) > 1e-12, std::logic_error,
+                  "External probability mismatch for event #" << i << " !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -2,15 +2,21 @@
 
 // Standard library:
 #include <cstdlib>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <exception>
 
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
 // This project:
 #include <falaise/snemo/datamodels/line_trajectory_pattern.h>
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/event_time_measurement.h>
 #include <falaise/snemo/reconstruction/tof_driver.h>
 
 int main()
@@ -162,6 +168,84 @@ int main()
     tof_e1_e2.tree_dump();
     std::clog << "TOF measurement for e1/g1" << std::endl;
     tof_e1_g1.tree_dump();
+
+    // Configured track length uncertainty
+    {
+      snemo::reconstruction::tof_driver TOFD_wide;
+      datatools::properties TOFD_wide_config;
+      TOFD_wide_config.store_real_with_explicit_unit("pairwise.charged_sigma_length", 10 * CLHEP::ns);
+      TOFD_wide_config.set_unit_symbol("pairwise.charged_sigma_length", "ns");
+      TOFD_wide.initialize(TOFD_wide_config);
+      snemo::datamodel::tof_measurement tof_wide;
+      TOFD_wide.process(electron1, electron2, tof_wide);
+      DT_THROW_IF(tof_wide.get_internal_probabilities().front()
+                  < tof_e1_e2.get_internal_probabilities().front(),
+                  std::logic_error, "Larger uncertainty gives a lower internal probability !");
+      // Same driver, same pair: same result
+      snemo::datamodel::tof_measurement tof_wide_again;
+      TOFD_wide.process(electron1, electron2, tof_wide_again);
+      DT_THROW_IF(tof_wide_again.get_internal_probabilities().front()
+                  != tof_wide.get_internal_probabilities().front(),
+                  std::logic_error, "Internal probability depends on the previous call !");
+    }
+
+    // Event time fit
+    {
+      snemo::reconstruction::tof_driver TOFD_ET;
+      datatools::properties TOFD_ET_config;
+      TOFD_ET_config.store("mode", "event_time");
+      // Default track length uncertainties, derived from the pairwise ones
+      TOFD_ET.initialize(TOFD_ET_config);
+      DT_THROW_IF(TOFD_ET.is_pairwise_mode() || ! TOFD_ET.is_event_time_mode(),
+                  std::logic_error, "Invalid TOF mode !");
+
+      snemo::reconstruction::kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 1), electron1);
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 2), electron2);
+      snemo::datamodel::event_time_measurement et_e1_e2;
+      TOFD_ET.process(kc, et_e1_e2);
+      std::clog << "Event time measurement for e1/e2" << std::endl;
+      et_e1_e2.tree_dump();
+      // Two particles: the fit gives back the pair probabilities
+      DT_THROW_IF(! et_e1_e2.has_internal_fit() || ! et_e1_e2.has_external_fit() || et_e1_e2.get_ndof() != 1,
+                  std::logic_error, "Missing event time fit !");
+      DT_THROW_IF(std::abs(et_e1_e2.get_internal_probability()
+                           - tof_e1_e2.get_internal_probabilities().front()) > 1e-9,
+                  std::logic_error, "Event time and pair internal probabilities differ !");
+      DT_THROW_IF(std::abs(et_e1_e2.get_external_probability()
+                           - tof_e1_e2.get_external_probabilities().front()) > 1e-9,
+                  std::logic_error, "Event time and pair external probabilities differ !");
+      DT_THROW_IF(et_e1_e2.get_incoming_particle() != "e2",
+                  std::logic_error, "Invalid incoming particle !");
+
+      // Charged particle and gamma: the fit gives back the pair probabilities
+      // of the first calorimeter vertex of the gamma
+      {
+        snemo::reconstruction::kinematics_cache kc_e1_g1;
+        kc_e1_g1.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 1), electron1);
+        kc_e1_g1.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_GAMMA, 1), gamma);
+        snemo::datamodel::event_time_measurement et_e1_g1;
+        TOFD_ET.process(kc_e1_g1, et_e1_g1);
+        DT_THROW_IF(! et_e1_g1.has_internal_fit() || et_e1_g1.get_ndof() != 1,
+                    std::logic_error, "Missing event time fit !");
+        DT_THROW_IF(std::abs(et_e1_g1.get_internal_probability()
+                             - tof_e1_g1.get_internal_probabilities().front()) > 1e-9,
+                    std::logic_error, "Event time and charged/gamma pair internal probabilities differ !");
+        DT_THROW_IF(std::abs(et_e1_g1.get_external_probability()
+                             - tof_e1_g1.get_external_probabilities().front()) > 1e-9,
+                    std::logic_error, "Event time and charged/gamma pair external probabilities differ !");
+      }
+
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_GAMMA, 1), gamma);
+      snemo::datamodel::event_time_measurement et_e1_e2_g1;
+      TOFD_ET.process(kc, et_e1_e2_g1);
+      std::clog << "Event time measurement for e1/e2/g1" << std::endl;
+      et_e1_e2_g1.tree_dump();
+      DT_THROW_IF(et_e1_e2_g1.get_particle_labels().size() != 3 ||
+                  et_e1_e2_g1.get_internal_pulls().size() != 3 ||
+                  et_e1_e2_g1.get_external_pulls().size() != 3,
+                  std::logic_error, "Invalid number of fitted particles !");
+    }
     }
 
   } catch (std::exception & x) {
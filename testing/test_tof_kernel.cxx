@@ -0,0 +1,90 @@
+// test_tof_kernel.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <exception>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/tof_kernel.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+#include <falaise/snemo/reconstruction/chi2_probability.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'tof_kernel' class." << std::endl;
+    typedef snemo::reconstruction::tof_kernel tk;
+    typedef snemo::reconstruction::tof_driver::tof_tool tt;
+    std::clog << "Instruction set : " << tk::get_instruction_set() << std::endl;
+
+    // Size not multiple of the vector width so that the scalar tail is used
+    const size_t n = 29;
+    std::vector<double> E1(n), m1(n), tl1(n), t1(n), st1(n);
+    std::vector<double> E2(n), m2(n), tl2(n), t2(n), st2(n);
+    std::vector<double> sl(n);
+    for (size_t i = 0; i < n; ++i) {
+      E1[i] = (0.3 + 0.1 * i) * CLHEP::MeV;
+      m1[i] = CLHEP::electron_mass_c2;
+      tl1[i] = (40. + i) * CLHEP::cm;
+      t1[i] = (2. + 0.1 * i) * CLHEP::ns;
+      st1[i] = 0.2 * CLHEP::ns;
+      // Alternate electron and gamma hypotheses for the second particle
+      const bool gamma = (i % 2 == 1);
+      E2[i] = gamma ? 1 : 1.2 * CLHEP::MeV;
+      m2[i] = gamma ? 0 : CLHEP::electron_mass_c2;
+      tl2[i] = (60. - i) * CLHEP::cm;
+      t2[i] = (3. - 0.05 * i) * CLHEP::ns;
+      st2[i] = 0.3 * CLHEP::ns;
+      sl[i] = gamma ? 0.6 * CLHEP::ns : 0.1 * CLHEP::ns;
+    }
+
+    // Theoretical times
+    std::vector<double> t1_th(n);
+    tk::compute_theoretical_times(E1.data(), m1.data(), tl1.data(), t1_th.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      const double expected = tt::get_theoretical_time(E1[i], m1[i], tl1[i]);
+      DT_THROW_IF(std::abs(t1_th[i] - expected) > 1e-12 * expected, std::logic_error,
+                  "Invalid theoretical time #" << i << " !");
+    }
+
+    // Chi2 and probabilities
+    tk::particle_arrays p1 = {E1.data(), m1.data(), tl1.data(), t1.data(), st1.data()};
+    tk::particle_arrays p2 = {E2.data(), m2.data(), tl2.data(), t2.data(), st2.data()};
+    std::vector<double> chi2_int(n), chi2_ext(n), q_int(n), q_ext(n);
+    const snemo::reconstruction::chi2_probability method;
+    tk::compute(p1, p2, sl.data(), n, method,
+                chi2_int.data(), chi2_ext.data(), q_int.data(), q_ext.data());
+    for (size_t i = 0; i < n; ++i) {
+      const double th1 = tt::get_theoretical_time(E1[i], m1[i], tl1[i]);
+      const double th2 = tt::get_theoretical_time(E2[i], m2[i], tl2[i]);
+      const double sigma_exp = std::pow(st1[i], 2) + std::pow(st2[i], 2) + std::pow(sl[i], 2);
+      const double expected_int = std::pow(t1[i] - t2[i] - (th1 - th2), 2)/sigma_exp;
+      const double expected_ext = std::pow(std::abs(t1[i] - t2[i]) - (th1 + th2), 2)/sigma_exp;
+      DT_THROW_IF(std::abs(chi2_int[i] - expected_int) > 1e-9 * (1 + expected_int), std::logic_error,
+                  "Invalid internal chi2 #" << i << " !");
+      DT_THROW_IF(std::abs(chi2_ext[i] - expected_ext) > 1e-9 * (1 + expected_ext), std::logic_error,
+                  "Invalid external chi2 #" << i << " !");
+      DT_THROW_IF(std::abs(q_int[i] - method.survival(expected_int, 1)) > 1e-9, std::logic_error,
+                  "Invalid internal probability #" << i << " !");
+      DT_THROW_IF(std::abs(q_ext[i] - method.survival(expected_ext, 1)) > 1e-9, std::logic_error,
+                  "Invalid external probability #" << i << " !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
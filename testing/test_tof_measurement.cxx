@@ -2,11 +2,14 @@
 
 // Standard library:
 #include <iostream>
+#include <limits>
 #include <exception>
 
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/exception.h>
+#include <bayeux/datatools/utils.h>
 
 // This project:
 #include <falaise/snemo/datamodels/tof_measurement.h>
@@ -29,6 +32,36 @@ int main()
     ext_probs.push_back(1e-4 * CLHEP::perCent);
     ext_probs.push_back(1e-5 * CLHEP::perCent);
     TM.tree_dump(std::cout, "TOF measurement dump:", "[notice]: ");
+    DT_THROW_IF(int_probs.get_min() != 10 * CLHEP::perCent || int_probs.get_max() != 40 * CLHEP::perCent,
+                std::logic_error, "Invalid internal probability summaries !");
+    DT_THROW_IF(ext_probs.get_min() != 1e-5 * CLHEP::perCent || ext_probs.get_max() != 1e-1 * CLHEP::perCent,
+                std::logic_error, "Invalid external probability summaries !");
+
+    // Go beyond the inline storage
+    const size_t nprobs = 2 * snemo::datamodel::probability_array::INLINE_CAPACITY + 1;
+    for (size_t i = int_probs.size(); i < nprobs; i++) {
+      int_probs.push_back((50 + i) * CLHEP::perCent);
+    }
+    const snemo::datamodel::tof_measurement::probability_type int_copy = int_probs;
+    DT_THROW_IF(int_copy.size() != nprobs, std::logic_error, "Invalid number of internal probabilities !");
+    DT_THROW_IF(int_copy.at(1) != 30 * CLHEP::perCent || int_copy.back() != (50 + nprobs - 1) * CLHEP::perCent,
+                std::logic_error, "Invalid internal probability values !");
+    DT_THROW_IF(int_copy.get_min() != int_probs.get_min() || int_copy.get_max() != int_probs.get_max(),
+                std::logic_error, "Invalid copied probability summaries !");
+    TM.clear();
+    DT_THROW_IF(TM.has_internal_probabilities() || datatools::is_valid(int_probs.get_min()),
+                std::logic_error, "Internal probabilities have not been cleared !");
+
+    // A leading NaN must not hide the range of the following values
+    int_probs.push_back(std::numeric_limits<double>::quiet_NaN());
+    DT_THROW_IF(datatools::is_valid(int_probs.get_min()) || datatools::is_valid(int_probs.get_max()),
+                std::logic_error, "NaN probability has entered the summaries !");
+    int_probs.push_back(2.0);
+    int_probs.push_back(20 * CLHEP::perCent);
+    int_probs.push_back(std::numeric_limits<double>::quiet_NaN());
+    DT_THROW_IF(int_probs.size() != 4, std::logic_error, "NaN probabilities have not been stored !");
+    DT_THROW_IF(int_probs.get_min() != 20 * CLHEP::perCent || int_probs.get_max() != 2.0,
+                std::logic_error, "Invalid probability summaries with NaN values !");
 
   } catch (std::exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
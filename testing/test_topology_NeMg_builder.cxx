@@ -0,0 +1,134 @@
+// test_topology_NeMg_builder.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/calorimeter_index.h>
+#include <falaise/snemo/reconstruction/topology_driver.h>
+#include <falaise/snemo/reconstruction/topology_2e_builder.h>
+#include <falaise/snemo/reconstruction/topology_NeMg_builder.h>
+#include <falaise/snemo/reconstruction/vertex_driver.h>
+
+// Add a vertex to a fake electron track
+void add_vertex(snemo::datamodel::particle_track & electron_,
+                const geomtools::vector_3d & position_,
+                const std::string & location_,
+                const std::string & gid_ = "")
+{
+  snemo::datamodel::particle_track::vertex_collection_type & the_vertices
+    = electron_.grab_vertices();
+  the_vertices.push_back(new geomtools::blur_spot);
+  geomtools::blur_spot & a_vertex = the_vertices.back().grab();
+  a_vertex.set_blur_dimension(geomtools::blur_spot::dimension_three);
+  a_vertex.set_position(position_);
+  a_vertex.set_errors(1 * CLHEP::mm, 2 * CLHEP::mm, 7 * CLHEP::mm);
+  a_vertex.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(), location_);
+  if (! gid_.empty()) {
+    geomtools::geom_id a_gid;
+    std::istringstream iss(gid_);
+    iss >> a_gid;
+    a_vertex.set_geom_id(a_gid);
+  }
+  return;
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_NeMg_builder' class." << std::endl;
+
+    typedef snemo::datamodel::pid_utils pu;
+    typedef snemo::datamodel::particle_track pt;
+
+    snemo::reconstruction::measurement_drivers drivers;
+    drivers.VD.reset(new snemo::reconstruction::vertex_driver);
+    datatools::properties VD_config;
+    drivers.VD->initialize(VD_config);
+
+    // Fake 2e event: source foil vertices far apart, calorimeter vertices
+    // close to each other but on neighbouring calorimeter blocks
+    snemo::datamodel::particle_track_data PTD;
+    snemo::datamodel::pid_data PID;
+    PID.reset(2);
+    for (size_t i = 0; i < 2; ++i) {
+      snemo::datamodel::particle_track::handle_type hPT(new snemo::datamodel::particle_track);
+      snemo::datamodel::particle_track & an_electron = hPT.grab();
+      an_electron.grab_auxiliaries().update(pu::pid_label_key(), pu::electron_label());
+      add_vertex(an_electron, geomtools::vector_3d(0, i * 200 * CLHEP::mm, i * 300 * CLHEP::mm),
+                 pt::vertex_on_source_foil_label());
+      add_vertex(an_electron, geomtools::vector_3d(435 * CLHEP::mm, 255 * CLHEP::mm + i * 2 * CLHEP::mm, 0),
+                 pt::vertex_on_main_calorimeter_label(), i == 0 ? "[1302:0.1.4.6.*]" : "[1302:0.1.5.6.*]");
+      PTD.add_particle(hPT);
+      PID.set_particle_type(i, pu::PARTICLE_ELECTRON);
+      PID.increment_particle_count(pu::PARTICLE_ELECTRON);
+    }
+
+    // NeMg and 2e builders must agree, with or without a calorimeter index,
+    // the NeMg measurements being computed right away or at first access
+    const snemo::datamodel::measurement_key vertex_label
+      (snemo::datamodel::measurement_key::KIND_VERTEX,
+       snemo::datamodel::particle_slot(pu::PARTICLE_ELECTRON, 1),
+       snemo::datamodel::particle_slot(pu::PARTICLE_ELECTRON, 2));
+    const snemo::datamodel::calorimeter_index CI;
+    for (size_t icase = 0; icase < 4; ++icase) {
+      const snemo::datamodel::calorimeter_index * a_index = (icase % 2 == 0 ? 0 : &CI);
+      const bool lazy = (icase >= 2);
+
+      snemo::reconstruction::topology_2e_builder B2e;
+      B2e.set_measurement_drivers(drivers);
+      B2e.set_calorimeter_index(a_index);
+      snemo::datamodel::base_topology_pattern::handle_type hTP2e = B2e.create_pattern();
+      B2e.build(PTD, PID, hTP2e.grab());
+
+      snemo::reconstruction::topology_NeMg_builder BNeMg;
+      BNeMg.set_measurement_drivers(drivers);
+      BNeMg.set_calorimeter_index(a_index);
+      BNeMg.set_lazy_measurements(lazy);
+      snemo::datamodel::base_topology_pattern::handle_type hTPNeMg = BNeMg.create_pattern();
+      BNeMg.build(PTD, PID, hTPNeMg.grab());
+      DT_THROW_IF(hTPNeMg.get().has_pending_measurements() != lazy, std::logic_error,
+                  "Invalid pending measurements !");
+
+      const snemo::datamodel::vertex_measurement * VM2e
+        = hTP2e.get().find_measurement_as<snemo::datamodel::vertex_measurement>(vertex_label);
+      const snemo::datamodel::vertex_measurement * VMNeMg
+        = hTPNeMg.get().find_measurement_as<snemo::datamodel::vertex_measurement>(vertex_label);
+      DT_THROW_IF(VM2e == 0 || VMNeMg == 0, std::logic_error, "Missing vertex measurement !");
+      std::clog << "Vertices probability (" << (a_index ? "with" : "without") << " calorimeter index"
+                << (lazy ? ", lazy" : "") << "): 2e = "
+                << VM2e->get_probability()/CLHEP::perCent << "%, NeMg = "
+                << VMNeMg->get_probability()/CLHEP::perCent << "%" << std::endl;
+      // Calorimeter vertices on different blocks are not a common vertex
+      // once the blocks are known
+      const std::string expected_location = a_index == 0 ? pt::vertex_on_main_calorimeter_label()
+                                                         : pt::vertex_on_source_foil_label();
+      DT_THROW_IF(VM2e->get_location() != expected_location, std::logic_error,
+                  "Common vertex is expected on the " << expected_location << " !");
+      DT_THROW_IF(VMNeMg->get_probability() != VM2e->get_probability() ||
+                  VMNeMg->get_location() != VM2e->get_location(), std::logic_error,
+                  "NeMg and 2e vertex measurements differ !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,121 @@
+// test_topology_data_cut.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/service_manager.h>
+#include <datatools/things.h>
+// - Bayeux/cuts:
+#include <cuts/i_cut.h>
+
+// This project:
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/cuts/topology_data_cut.h>
+
+typedef snemo::datamodel::pid_utils pu;
+
+// Build an event record given its classification label and code
+void make_event(datatools::things & event_, const std::string & label_, const std::string & code_label_)
+{
+  event_.clear();
+  snemo::datamodel::topology_data & TD = event_.add<snemo::datamodel::topology_data>("TD");
+  datatools::properties & td_aux = TD.grab_auxiliaries();
+  if (! label_.empty()) td_aux.store(pu::classification_label_key(), label_);
+  pu::classification_code_type a_code = 0;
+  if (! code_label_.empty() && pu::parse_classification_label(code_label_, a_code)) {
+    td_aux.store_integer(pu::classification_code_key(), a_code);
+  }
+  return;
+}
+
+// Apply a classification cut to an event
+int apply(snemo::cut::topology_data_cut & cut_, const std::string & label_, const std::string & code_label_)
+{
+  datatools::things event;
+  make_event(event, label_, code_label_);
+  cut_.set_user_data(event);
+  const int status = cut_.process();
+  cut_.reset_user_data();
+  return status;
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_data_cut' class." << std::endl;
+
+    datatools::service_manager SM;
+    cuts::cut_handle_dict_type cut_dict;
+
+    // Plain label, compared through its classification code :
+    {
+      datatools::properties config;
+      config.store_flag("mode.classification");
+      config.store("classification.label", "2e");
+      snemo::cut::topology_data_cut exact_cut;
+      exact_cut.initialize(config, SM, cut_dict);
+
+      DT_THROW_IF(apply(exact_cut, "2e", "2e") != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "Event with the '2e' code rejected !");
+      // The code takes precedence over the label when both are present
+      DT_THROW_IF(apply(exact_cut, "2e", "1e1g") != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Event with the '1e1g' code accepted !");
+      DT_THROW_IF(apply(exact_cut, "1e1g", "2e") != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "Classification code not used !");
+      // Events without code (i.e. overflowing counters) fall back to the label
+      DT_THROW_IF(apply(exact_cut, "2e", "") != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "Event with the '2e' label rejected !");
+      DT_THROW_IF(apply(exact_cut, "1e", "") != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Event with the '1e' label accepted !");
+      // Labels are not matched as prefixes
+      DT_THROW_IF(apply(exact_cut, "2e1g", "2e1g") != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Event with the '2e1g' code accepted !");
+      DT_THROW_IF(apply(exact_cut, "", "") != cuts::SELECTION_INAPPLICABLE, std::logic_error,
+                  "Event without classification is not inapplicable !");
+    }
+
+    // Regular expression, matched against the classification label :
+    {
+      datatools::properties config;
+      config.store_flag("mode.classification");
+      config.store("classification.label", "2e[0-9]*g?");
+      snemo::cut::topology_data_cut regex_cut;
+      regex_cut.initialize(config, SM, cut_dict);
+
+      DT_THROW_IF(apply(regex_cut, "2e", "2e") != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "Event with the '2e' label rejected !");
+      DT_THROW_IF(apply(regex_cut, "2e3g", "2e3g") != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "Event with the '2e3g' label rejected !");
+      DT_THROW_IF(apply(regex_cut, "2e3g", "") != cuts::SELECTION_ACCEPTED, std::logic_error,
+                  "Event with the '2e3g' label and no code rejected !");
+      // The whole label must match
+      DT_THROW_IF(apply(regex_cut, "2e1p", "2e1p") != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Event with the '2e1p' label accepted !");
+      DT_THROW_IF(apply(regex_cut, "1e", "1e") != cuts::SELECTION_REJECTED, std::logic_error,
+                  "Event with the '1e' label accepted !");
+      // The regular expression is compiled once for all the events
+      for (size_t i = 0; i < 100; ++i) {
+        DT_THROW_IF(apply(regex_cut, i % 2 ? "2e1g" : "1e1g", "") != (i % 2 ? cuts::SELECTION_ACCEPTED
+                                                                     : cuts::SELECTION_REJECTED),
+                    std::logic_error, "Invalid result for event #" << i << " !");
+      }
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
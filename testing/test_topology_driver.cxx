@@ -0,0 +1,241 @@
+// test_topology_driver.cxx
+
+// Standard library:
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+
+// This project:
+#include <falaise/snemo/datamodels/line_trajectory_pattern.h>
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/reconstruction/topology_driver.h>
+
+typedef snemo::datamodel::pid_utils pu;
+typedef snemo::datamodel::particle_track pt;
+
+// Add a vertex to a fake particle track
+void add_vertex(snemo::datamodel::particle_track & particle_,
+                const geomtools::vector_3d & position_,
+                const std::string & location_,
+                const std::string & gid_ = "")
+{
+  particle_.grab_vertices().push_back(new geomtools::blur_spot);
+  geomtools::blur_spot & a_vertex = particle_.grab_vertices().back().grab();
+  a_vertex.set_blur_dimension(geomtools::blur_spot::dimension_three);
+  a_vertex.set_position(position_);
+  a_vertex.set_errors(1 * CLHEP::mm, 2 * CLHEP::mm, 7 * CLHEP::mm);
+  a_vertex.grab_auxiliaries().update(pt::vertex_type_key(), location_);
+  if (! gid_.empty()) {
+    geomtools::geom_id a_gid;
+    std::istringstream iss(gid_);
+    iss >> a_gid;
+    a_vertex.set_geom_id(a_gid);
+  }
+  return;
+}
+
+// Add a calorimeter hit to a fake particle track
+void add_calorimeter_hit(snemo::datamodel::particle_track & particle_,
+                         const double energy_, const double time_,
+                         const std::string & gid_)
+{
+  particle_.grab_associated_calorimeter_hits().push_back(new snemo::datamodel::calibrated_calorimeter_hit);
+  snemo::datamodel::calibrated_calorimeter_hit & a_calo
+    = particle_.grab_associated_calorimeter_hits().back().grab();
+  a_calo.set_energy(energy_);
+  a_calo.set_sigma_energy(0.08 * energy_);
+  a_calo.set_time(time_);
+  a_calo.set_sigma_time(0.05 * CLHEP::ns);
+  geomtools::geom_id a_gid;
+  std::istringstream iss(gid_);
+  iss >> a_gid;
+  a_calo.set_geom_id(a_gid);
+  return;
+}
+
+// Build a fake event with electrons leaving the source foil and gammas
+void make_event(const size_t nelectrons_, const size_t ngammas_,
+                snemo::datamodel::particle_track_data & ptd_,
+                snemo::datamodel::pid_data & pid_)
+{
+  pid_.reset(nelectrons_ + ngammas_);
+  for (size_t i = 0; i < nelectrons_ + ngammas_; ++i) {
+    snemo::datamodel::particle_track::handle_type hPT(new snemo::datamodel::particle_track);
+    snemo::datamodel::particle_track & a_particle = hPT.grab();
+    std::ostringstream gid;
+    gid << "[1302:0.1." << i << ".6.*]";
+    const geomtools::vector_3d calo_position(435 * CLHEP::mm, (i * 259.0 - 500.0) * CLHEP::mm, 0);
+    if (i < nelectrons_) {
+      a_particle.grab_auxiliaries().update(pu::pid_label_key(), pu::electron_label());
+      add_vertex(a_particle, geomtools::vector_3d(0, i * CLHEP::mm, 0), pt::vertex_on_source_foil_label());
+      add_vertex(a_particle, calo_position, pt::vertex_on_main_calorimeter_label(), gid.str());
+      snemo::datamodel::line_trajectory_pattern * ltp = new snemo::datamodel::line_trajectory_pattern;
+      ltp->grab_segment().set_first(geomtools::vector_3d(0, i * CLHEP::mm, 0));
+      ltp->grab_segment().set_last(calo_position);
+      snemo::datamodel::tracker_trajectory::handle_pattern a_pattern;
+      a_pattern.reset(ltp);
+      snemo::datamodel::tracker_trajectory::handle_type a_trajectory(new snemo::datamodel::tracker_trajectory);
+      a_trajectory.grab().set_pattern_handle(a_pattern);
+      a_particle.set_trajectory_handle(a_trajectory);
+      add_calorimeter_hit(a_particle, (800 + 100 * i) * CLHEP::keV, (1.5 + 0.1 * i) * CLHEP::ns, gid.str());
+      pid_.set_particle_type(i, pu::PARTICLE_ELECTRON);
+      pid_.increment_particle_count(pu::PARTICLE_ELECTRON);
+    } else {
+      a_particle.grab_auxiliaries().update(pu::pid_label_key(), pu::gamma_label());
+      add_vertex(a_particle, calo_position, pt::vertex_on_main_calorimeter_label(), gid.str());
+      add_calorimeter_hit(a_particle, (300 + 50 * i) * CLHEP::keV, (1.8 + 0.3 * i) * CLHEP::ns, gid.str());
+      pid_.set_particle_type(i, pu::PARTICLE_GAMMA);
+      pid_.increment_particle_count(pu::PARTICLE_GAMMA);
+    }
+    ptd_.add_particle(hPT);
+  }
+  return;
+}
+
+// Dump every measurement of a pattern
+std::string dump_measurements(const snemo::datamodel::base_topology_pattern & pattern_)
+{
+  std::ostringstream out;
+  const snemo::datamodel::base_topology_pattern::measurement_dict_type & meas
+    = pattern_.get_measurement_dictionary();
+  for (snemo::datamodel::base_topology_pattern::measurement_dict_type::const_iterator
+         it = meas.begin(); it != meas.end(); ++it) {
+    out << it->first << std::endl;
+    if (it->second.has_data()) it->second.get().tree_dump(out);
+  }
+  return out.str();
+}
+
+// Compare the TOF probabilities of two patterns built from the same event
+bool same_tof_probabilities(const snemo::datamodel::base_topology_pattern & pattern1_,
+                            const snemo::datamodel::base_topology_pattern & pattern2_)
+{
+  typedef snemo::datamodel::base_topology_pattern::measurement_dict_type dict_type;
+  const dict_type & meas1 = pattern1_.get_measurement_dictionary();
+  const dict_type & meas2 = pattern2_.get_measurement_dictionary();
+  if (meas1.size() != meas2.size()) return false;
+  for (dict_type::const_iterator it1 = meas1.begin(), it2 = meas2.begin();
+       it1 != meas1.end(); ++it1, ++it2) {
+    if (it1->first != it2->first) return false;
+    const snemo::datamodel::tof_measurement * tof1
+      = dynamic_cast<const snemo::datamodel::tof_measurement *>(&it1->second.get());
+    const snemo::datamodel::tof_measurement * tof2
+      = dynamic_cast<const snemo::datamodel::tof_measurement *>(&it2->second.get());
+    if (! tof1 || ! tof2) continue;
+    const snemo::datamodel::tof_measurement::probability_type * probas1[2]
+      = {&tof1->get_internal_probabilities(), &tof1->get_external_probabilities()};
+    const snemo::datamodel::tof_measurement::probability_type * probas2[2]
+      = {&tof2->get_internal_probabilities(), &tof2->get_external_probabilities()};
+    for (size_t i = 0; i < 2; ++i) {
+      if (probas1[i]->size() != probas2[i]->size()) return false;
+      for (size_t j = 0; j < probas1[i]->size(); ++j) {
+        if (std::abs((*probas1[i])[j] - (*probas2[i])[j]) > 1e-9) return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_driver' class." << std::endl;
+
+    datatools::properties TD_config;
+    TD_config.store("logging.priority", "fatal");
+    snemo::reconstruction::topology_driver serial_TD;
+    serial_TD.initialize(TD_config);
+
+    // TOF hypotheses of every event computed in one kernel pass
+    datatools::properties batch_config = TD_config;
+    batch_config.store_flag("batch_tof");
+    snemo::reconstruction::topology_driver batch_TD;
+    batch_TD.initialize(batch_config);
+
+    // Batched TOF computations and lazy measurements are exclusive
+    {
+      batch_config.store_flag("lazy_measurements");
+      snemo::reconstruction::topology_driver lazy_batch_TD;
+      bool rejected = false;
+      try {
+        lazy_batch_TD.initialize(batch_config);
+      } catch (std::logic_error &) {
+        rejected = true;
+      }
+      DT_THROW_IF(! rejected, std::logic_error, "Lazy measurements with batched TOF have been accepted !");
+    }
+
+    // Measurements computed when the pattern is read
+    datatools::properties lazy_config = TD_config;
+    lazy_config.store_flag("lazy_measurements");
+    snemo::reconstruction::topology_driver lazy_TD;
+    lazy_TD.initialize(lazy_config);
+
+    // Per-gamma measurements computed in 3 concurrent lanes
+    TD_config.store_integer("parallel_gammas.threshold", 2);
+    TD_config.store_integer("parallel_gammas.lanes", 3);
+    snemo::reconstruction::topology_driver parallel_TD;
+    parallel_TD.initialize(TD_config);
+
+    const size_t nelectrons[2] = {1, 2};
+    for (size_t ievent = 0; ievent < 2; ++ievent) {
+      snemo::datamodel::particle_track_data PTD;
+      snemo::datamodel::pid_data PID;
+      make_event(nelectrons[ievent], 5, PTD, PID);
+
+      snemo::datamodel::topology_data serial_data;
+      serial_TD.process(PTD, PID, serial_data);
+      snemo::datamodel::topology_data parallel_data;
+      parallel_TD.process(PTD, PID, parallel_data);
+      DT_THROW_IF(! serial_data.has_pattern() || ! parallel_data.has_pattern(),
+                  std::logic_error, "Missing topology pattern !");
+
+      const std::string serial_dump = dump_measurements(serial_data.get_pattern());
+      const std::string parallel_dump = dump_measurements(parallel_data.get_pattern());
+      std::clog << "Measurements of the " << PID.get_classification_label() << " event:" << std::endl
+                << serial_dump;
+      DT_THROW_IF(serial_data.get_pattern().get_measurement_dictionary().size() < 15,
+                  std::logic_error, "Missing per-gamma measurements !");
+      DT_THROW_IF(parallel_dump != serial_dump, std::logic_error,
+                  "Parallel and serial measurements differ !");
+
+      snemo::datamodel::topology_data lazy_data;
+      lazy_TD.process(PTD, PID, lazy_data);
+      DT_THROW_IF(! lazy_data.has_pattern(), std::logic_error, "Missing topology pattern !");
+      DT_THROW_IF(! lazy_data.get_pattern().has_pending_measurements(), std::logic_error,
+                  "Measurements computed before their first access !");
+      DT_THROW_IF(dump_measurements(lazy_data.get_pattern()) != serial_dump, std::logic_error,
+                  "Lazy and serial measurements differ !");
+      DT_THROW_IF(lazy_data.get_pattern().has_pending_measurements(), std::logic_error,
+                  "Pending measurements left after reading !");
+
+      snemo::datamodel::topology_data batch_data;
+      batch_TD.process(PTD, PID, batch_data);
+      DT_THROW_IF(! batch_data.has_pattern(), std::logic_error, "Missing topology pattern !");
+      DT_THROW_IF(! same_tof_probabilities(serial_data.get_pattern(), batch_data.get_pattern()),
+                  std::logic_error, "Batched and serial TOF probabilities differ !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
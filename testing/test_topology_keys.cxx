@@ -0,0 +1,112 @@
+// test_topology_keys.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_keys.h>
+#include <falaise/snemo/datamodels/flat_dict.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the topology pattern keys." << std::endl;
+
+    using snemo::datamodel::particle_slot;
+    using snemo::datamodel::measurement_key;
+    typedef snemo::datamodel::pid_utils pu;
+
+    // Particle slots :
+    const particle_slot e1(pu::PARTICLE_ELECTRON, 1);
+    DT_THROW_IF(e1 != particle_slot("e1"), std::logic_error, "Slot 'e1' not parsed !");
+    DT_THROW_IF(e1.is_interned(), std::logic_error, "Slot 'e1' is interned !");
+    DT_THROW_IF(e1.to_string() != "e1", std::logic_error, "Invalid 'e1' label !");
+    const particle_slot g12("g12");
+    DT_THROW_IF(g12.get_type() != pu::PARTICLE_GAMMA || g12.get_rank() != 12,
+                std::logic_error, "Slot 'g12' not parsed !");
+    const particle_slot fake("fake_electron0");
+    DT_THROW_IF(! fake.is_interned(), std::logic_error, "Slot 'fake_electron0' not interned !");
+    DT_THROW_IF(fake != particle_slot("fake_electron0"), std::logic_error, "Slot not interned once !");
+    DT_THROW_IF(fake.to_string() != "fake_electron0", std::logic_error, "Invalid interned label !");
+    DT_THROW_IF(! particle_slot("e01").is_interned(), std::logic_error, "Slot 'e01' not interned !");
+
+    // Measurement keys built from labels and from slots must match :
+    const std::vector<std::string> labels = {
+      "tof_e1_e2", "vertex_e1", "energy_g10", "angle_e2_g3", "tof_e1_fake", "fake_tof_1", "tof"
+    };
+    for (size_t i = 0; i < labels.size(); ++i) {
+      const measurement_key a_key(labels[i]);
+      std::clog << "Key '" << a_key << "' : kind = " << a_key.get_kind()
+                << ", interned = " << a_key.is_interned() << std::endl;
+      DT_THROW_IF(a_key.to_string() != labels[i], std::logic_error,
+                  "Invalid label for key '" << labels[i] << "' !");
+    }
+    const measurement_key tof_e1_g3(measurement_key::KIND_TOF, e1, particle_slot(pu::PARTICLE_GAMMA, 3));
+    DT_THROW_IF(tof_e1_g3 != measurement_key("tof_e1_g3"), std::logic_error, "Key 'tof_e1_g3' not parsed !");
+    DT_THROW_IF(tof_e1_g3.get_second() != particle_slot("g3"), std::logic_error, "Invalid second slot !");
+    DT_THROW_IF(measurement_key("energy_e1").get_second().is_valid(), std::logic_error,
+                "Single particle key has a second slot !");
+
+    // Dictionary :
+    snemo::datamodel::flat_dict<measurement_key, int> dict;
+    dict["vertex_e1"] = 1;
+    dict["tof_e1_e2"] = 2;
+    dict["fake"] = 3;
+    DT_THROW_IF(dict.size() != 3, std::logic_error, "Invalid dictionary size !");
+    DT_THROW_IF(dict.at("tof_e1_e2") != 2, std::logic_error, "Invalid dictionary value !");
+    DT_THROW_IF(! dict.insert(std::make_pair("energy_e1", 4)).second, std::logic_error, "Entry not inserted !");
+    DT_THROW_IF(dict.insert(std::make_pair("fake", 5)).second, std::logic_error, "Entry inserted twice !");
+    DT_THROW_IF(dict.erase("fake") != 1 || dict.count("fake") != 0, std::logic_error, "Entry not erased !");
+
+    // Interned labels :
+    {
+      const size_t ninterned = measurement_key::get_number_of_interned_labels();
+      measurement_key a_key;
+      DT_THROW_IF(! measurement_key::lookup("angle_e1_g2", a_key) || a_key != measurement_key("angle_e1_g2"),
+                  std::logic_error, "Key 'angle_e1_g2' not found !");
+      DT_THROW_IF(measurement_key::lookup("never_interned", a_key), std::logic_error,
+                  "Unknown label found !");
+      DT_THROW_IF(! measurement_key::lookup("fake_tof_1", a_key) || a_key != measurement_key("fake_tof_1"),
+                  std::logic_error, "Interned label 'fake_tof_1' not found !");
+      DT_THROW_IF(measurement_key::get_number_of_interned_labels() != ninterned, std::logic_error,
+                  "Lookups have interned labels !");
+      const measurement_key once("interned_once");
+      const measurement_key twice("interned_once");
+      DT_THROW_IF(measurement_key::get_number_of_interned_labels() != ninterned + 1, std::logic_error,
+                  "Label not interned once !");
+
+      // The registry is bounded
+      bool overflow = false;
+      try {
+        for (size_t i = 0; i <= measurement_key::INTERNED_LABELS_MAX; ++i) {
+          measurement_key("overflow_" + std::to_string(i));
+        }
+      } catch (std::length_error &) {
+        overflow = true;
+      }
+      DT_THROW_IF(! overflow, std::logic_error, "Interned labels are not bounded !");
+      DT_THROW_IF(measurement_key::get_number_of_interned_labels() != measurement_key::INTERNED_LABELS_MAX,
+                  std::logic_error, "Invalid number of interned labels !");
+      DT_THROW_IF(measurement_key("interned_once") != once, std::logic_error,
+                  "Interned label lost !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,62 @@
+// test_topology_pool.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+
+// This project:
+#include <falaise/snemo/reconstruction/topology_pool.h>
+#include <falaise/snemo/datamodels/topology_2e_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_pool' class." << std::endl;
+
+    snemo::reconstruction::topology_pool pool;
+
+    // First event: everything is allocated
+    snemo::datamodel::base_topology_pattern::handle_type hTP0
+      = pool.create_pattern<snemo::datamodel::topology_2e_pattern>();
+    const snemo::datamodel::base_topology_pattern * first_pattern = &hTP0.get();
+    snemo::datamodel::tof_measurement & TM0
+      = pool.create_measurement<snemo::datamodel::tof_measurement>(hTP0.grab().grab_measurement_dictionary()["tof_e1_e2"]);
+    TM0.grab_internal_probabilities().push_back(0.5);
+    const snemo::datamodel::tof_measurement * first_tof = &TM0;
+
+    // Pattern still referenced: nothing to recycle
+    pool.recycle();
+    DT_THROW_IF(pool.get_number_of_used_patterns() != 1, std::logic_error,
+                "Referenced pattern has been recycled !");
+
+    // Release the pattern as the topology data bank would do
+    hTP0.reset();
+    pool.recycle();
+    DT_THROW_IF(pool.get_number_of_used_patterns() != 0, std::logic_error,
+                "Released pattern has not been recycled !");
+
+    // Second event: pattern and measurement are reused and cleared
+    snemo::datamodel::base_topology_pattern::handle_type hTP1
+      = pool.create_pattern<snemo::datamodel::topology_2e_pattern>();
+    DT_THROW_IF(&hTP1.get() != first_pattern, std::logic_error, "Pattern has not been reused !");
+    DT_THROW_IF(! hTP1.get().get_measurement_dictionary().empty(), std::logic_error,
+                "Recycled pattern has not been cleared !");
+    snemo::datamodel::tof_measurement & TM1
+      = pool.create_measurement<snemo::datamodel::tof_measurement>(hTP1.grab().grab_measurement_dictionary()["tof_e1_e2"]);
+    DT_THROW_IF(&TM1 != first_tof, std::logic_error, "Measurement has not been reused !");
+    DT_THROW_IF(TM1.has_internal_probabilities(), std::logic_error,
+                "Recycled measurement has not been cleared !");
+    hTP1.get().tree_dump(std::clog, "Recycled pattern:");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
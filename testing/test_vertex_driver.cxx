@@ -6,11 +6,17 @@
 #include <string>
 #include <exception>
 
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
 // This project:
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/vertex_measurement.h>
 #include <falaise/snemo/reconstruction/vertex_driver.h>
+#include <falaise/snemo/reconstruction/vertex_matrix.h>
+#include <falaise/snemo/reconstruction/particle_kinematics.h>
 
 int main()
 {
@@ -63,6 +69,49 @@ int main()
       VD.process(electron1, electron2, VM);
       const double vertices_probability = VM.get_probability();
       std::clog << "Vertices probability = " << vertices_probability/CLHEP::perCent << "%" << std::endl;
+      // Legacy location label of the common vertex
+      const datatools::properties & VM_aux = VM.get_vertex().get_auxiliaries();
+      DT_THROW_IF(! VM_aux.has_key(snemo::datamodel::particle_track::vertex_type_key()) ||
+                  VM_aux.fetch_string(snemo::datamodel::particle_track::vertex_type_key())
+                  != snemo::datamodel::particle_track::vertex_on_source_foil_label(),
+                  std::logic_error, "Missing vertex location auxiliary !");
+
+      // Third electron far from the two others
+      snemo::datamodel::particle_track electron3;
+      electron3.grab_auxiliaries().update(snemo::datamodel::pid_utils::pid_label_key(),
+                                          snemo::datamodel::pid_utils::electron_label());
+      {
+        snemo::datamodel::particle_track::vertex_collection_type & the_vertices
+          = electron3.grab_vertices();
+        the_vertices.push_back(new geomtools::blur_spot);
+        geomtools::blur_spot & a_vertex = the_vertices.back().grab();
+        a_vertex.set_blur_dimension(geomtools::blur_spot::dimension_three);
+        a_vertex.set_position(geomtools::vector_3d(0, 20*CLHEP::mm, 30*CLHEP::mm));
+        a_vertex.set_errors(0.1 * CLHEP::mm, 2 * CLHEP::mm, 7 * CLHEP::mm);
+        a_vertex.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(),
+                                           snemo::datamodel::particle_track::vertex_on_source_foil_label());
+      }
+
+      // Vertex compatibility of the three electrons
+      snemo::reconstruction::kinematics_cache kc;
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 1), electron1);
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 2), electron2);
+      kc.add(snemo::datamodel::particle_slot(snemo::datamodel::pid_utils::PARTICLE_ELECTRON, 3), electron3);
+      snemo::reconstruction::vertex_matrix VMX;
+      VD.process(kc.get_view(), VMX);
+      DT_THROW_IF(VMX.get_number_of_buckets() != 1, std::logic_error,
+                  "Source foil vertices must share a single bucket !");
+      DT_THROW_IF(! VMX.has_common_vertex(0, 1) || ! VMX.has_common_vertex(0, 2) || ! VMX.has_common_vertex(1, 2),
+                  std::logic_error, "Missing common vertex !");
+      DT_THROW_IF(VMX.get(0, 2).probability >= VMX.get(0, 1).probability,
+                  std::logic_error, "Far electrons are more compatible than close ones !");
+
+      // Same measurement as the pairwise processing
+      snemo::datamodel::vertex_measurement VM12;
+      VD.process(VMX, kc.get(0), kc.get(1), VM12);
+      std::clog << "Vertices probability (matrix) = " << VM12.get_probability()/CLHEP::perCent << "%" << std::endl;
+      DT_THROW_IF(VM12.get_probability() != vertices_probability, std::logic_error,
+                  "Matrix and pairwise vertex probabilities differ !");
     }
 
   } catch (std::exception & x) {
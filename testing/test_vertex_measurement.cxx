@@ -7,9 +7,11 @@
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/exception.h>
 
 // This project:
 #include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/particle_track.h>
 
 int main()
 {
@@ -20,6 +22,12 @@ int main()
     snemo::datamodel::vertex_measurement VM;
     geomtools::blur_spot & a_vertex = VM.grab_vertex();
     geomtools::placement::from_string("10 -15 20 (mm)", a_vertex.grab_placement());
+    VM.set_location(snemo::datamodel::vertex_measurement::LOCATION_SOURCE_FOIL);
+    DT_THROW_IF(! VM.has_location(), std::logic_error, "Missing vertex location !");
+    DT_THROW_IF(snemo::datamodel::vertex_measurement::location_from_label(VM.get_location())
+                != VM.get_location_type(), std::logic_error, "Vertex location label mismatch !");
+    DT_THROW_IF(a_vertex.get_auxiliaries().fetch_string(snemo::datamodel::particle_track::vertex_type_key())
+                != VM.get_location(), std::logic_error, "Vertex location auxiliary mismatch !");
     VM.tree_dump(std::cout, "Vertex measurement dump:", "[notice]: ");
 
   } catch (std::exception & x) {